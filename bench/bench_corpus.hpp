@@ -0,0 +1,62 @@
+#ifndef CPPBP_BENCH_CORPUS_HPP
+#define CPPBP_BENCH_CORPUS_HPP
+
+#include <cppbp/random.hpp>         // cppbp::xoshiro256ss, cppbp::uniform_below
+
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+namespace bench {
+
+// Deterministic generator of benchmark input.
+class corpus final
+{
+public:
+    explicit corpus(std::uint64_t seed = 42)
+        : m_engine{seed}
+    { }
+
+    std::uint64_t next()
+    {
+        return m_engine();
+    }
+
+    std::size_t uniform(std::size_t bound)
+    {
+        return static_cast<std::size_t>(cppbp::uniform_below(m_engine, bound));
+    }
+
+    // Dotted identifiers like "service.eu3.requests.4711", similar to metric names.
+    std::vector<std::string> keys(std::size_t count)
+    {
+        static const char *const parts[] = {
+            "service", "cache", "db", "http", "queue", "requests", "errors", "latency", "bytes", "hits"
+        };
+        std::vector<std::string> result;
+        result.reserve(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            std::string key = parts[uniform(10)];
+            key += '.';
+            key += parts[uniform(10)];
+            key += '.';
+            key += std::to_string(i);
+            result.push_back(key);
+        }
+        return result;
+    }
+
+private:
+    cppbp::xoshiro256ss m_engine;
+};
+
+inline double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace bench
+
+#endif // CPPBP_BENCH_CORPUS_HPP
@@ -0,0 +1,111 @@
+// Throughput of concurrent_string_map against a mutex protected std::unordered_map with
+// std::string keys, for 1 to 64 threads and a 90% find / 10% insert_or_assign mix.
+
+#include "bench_corpus.hpp"
+
+#include <cppbp/concurrent_string_map.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t key_count = 100000;
+constexpr std::size_t operations_per_thread = 200000;
+
+class locked_map final
+{
+public:
+    bool find(const char *data, std::size_t size, long &out)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        // The baseline pays for the std::string a lookup from a string_view needs.
+        const auto it = m_map.find(std::string(data, size));
+        if(it == m_map.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    void insert_or_assign(const char *data, std::size_t size, long value)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_map[std::string(data, size)] = value;
+    }
+
+private:
+    std::mutex                              m_mutex;
+    std::unordered_map<std::string, long>   m_map;
+};
+
+template<typename Find, typename Assign>
+double run(std::size_t threads, const std::vector<std::string> &keys, Find find, Assign assign)
+{
+    std::atomic<long> sink{0};
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for(std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            bench::corpus rng{t + 1};
+            long local = 0;
+            for(std::size_t i = 0; i < operations_per_thread; ++i) {
+                const std::string &key = keys[rng.uniform(keys.size())];
+                if(rng.uniform(10) == 0) {
+                    assign(key, static_cast<long>(i));
+                } else {
+                    long value = 0;
+                    if(find(key, value)) {
+                        local += value;
+                    }
+                }
+            }
+            sink += local;
+        });
+    }
+    for(auto &worker : workers) {
+        worker.join();
+    }
+    return static_cast<double>(threads * operations_per_thread) / bench::seconds_since(start) / 1e6;
+}
+
+} // namespace
+
+int main()
+{
+    bench::corpus corpus;
+    const std::vector<std::string> keys = corpus.keys(key_count);
+
+    std::printf("%8s %22s %22s\n", "threads", "concurrent (Mops/s)", "mutex+umap (Mops/s)");
+    for(std::size_t threads = 1; threads <= 64; threads *= 2) {
+        cppbp::concurrent_string_map<long> map{64, key_count};
+        locked_map baseline;
+        for(std::size_t i = 0; i < keys.size(); i += 2) {
+            map.insert(cppbp::string_view{keys[i].data(), keys[i].size()}, static_cast<long>(i));
+            baseline.insert_or_assign(keys[i].data(), keys[i].size(), static_cast<long>(i));
+        }
+
+        const double concurrent = run(threads, keys,
+            [&](const std::string &key, long &out) {
+                return map.find(cppbp::string_view{key.data(), key.size()}, out);
+            },
+            [&](const std::string &key, long value) {
+                map.insert_or_assign(cppbp::string_view{key.data(), key.size()}, value);
+            });
+        const double locked = run(threads, keys,
+            [&](const std::string &key, long &out) {
+                return baseline.find(key.data(), key.size(), out);
+            },
+            [&](const std::string &key, long value) {
+                baseline.insert_or_assign(key.data(), key.size(), value);
+            });
+        std::printf("%8zu %22.2f %22.2f\n", threads, concurrent, locked);
+    }
+    return 0;
+}
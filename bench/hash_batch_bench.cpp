@@ -0,0 +1,63 @@
+// Throughput of hash_batch against hashing the same keys one at a time with hash_bytes, for
+// short metric-name keys and for long keys.
+
+#include "bench_corpus.hpp"
+
+#include <cppbp/hash_batch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t key_count = 1 << 16;
+constexpr int rounds = 200;
+
+void run(const char *name, const std::vector<std::string> &strings)
+{
+    std::vector<cppbp::string_view> keys;
+    for(const auto &s : strings) {
+        keys.emplace_back(s.data(), s.size());
+    }
+    std::vector<std::uint64_t> out(keys.size());
+    std::uint64_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        for(std::size_t i = 0; i < keys.size(); ++i) {
+            out[i] = cppbp::hash_bytes(keys[i].data(), keys[i].size());
+        }
+        sink += out[static_cast<std::size_t>(r) % out.size()];
+    }
+    const double scalar = static_cast<double>(rounds * keys.size()) / bench::seconds_since(start) / 1e6;
+
+    start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        cppbp::hash_batch(cppbp::span<const cppbp::string_view>{keys.data(), keys.size()},
+                          cppbp::span<std::uint64_t>{out.data(), out.size()});
+        sink += out[static_cast<std::size_t>(r) % out.size()];
+    }
+    const double batch = static_cast<double>(rounds * keys.size()) / bench::seconds_since(start) / 1e6;
+
+    std::printf("%-12s %18.1f %18.1f %10llu\n", name, scalar, batch, static_cast<unsigned long long>(sink % 10));
+}
+
+} // namespace
+
+int main()
+{
+    bench::corpus corpus;
+    std::vector<std::string> short_keys = corpus.keys(key_count);
+    std::vector<std::string> long_keys;
+    for(const auto &key : short_keys) {
+        long_keys.push_back(key + "/" + key + "/" + key);
+    }
+
+    std::printf("%-12s %18s %18s\n", "keys", "scalar (Mkeys/s)", "batch (Mkeys/s)");
+    run("short", short_keys);
+    run("long", long_keys);
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Throughput of parallel_find_all for 1 to 64 threads over a 512 MiB buffer of log-like lines,
+// with one needle and with a set of patterns. The one thread row is the sequential baseline.
+
+#include "bench_corpus.hpp"
+
+#include <cppbp/parallel_search.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t haystack_size = std::size_t{512} << 20;
+
+std::string make_haystack(bench::corpus &corpus)
+{
+    const std::vector<std::string> keys = corpus.keys(100000);
+    std::string text;
+    text.reserve(haystack_size + 256);
+    while(text.size() < haystack_size) {
+        text += keys[corpus.uniform(keys.size())];
+        text += corpus.uniform(1000) == 0 ? " status=timeout\n" : " status=ok\n";
+    }
+    return text;
+}
+
+} // namespace
+
+int main()
+{
+    bench::corpus corpus;
+    const std::string text = make_haystack(corpus);
+    const cppbp::string_view haystack{text.data(), text.size()};
+    const cppbp::multi_searcher patterns{{"timeout", "errors.4711", "cache.db.99"}};
+
+    std::printf("%8s %18s %18s %10s\n", "threads", "needle (GB/s)", "patterns (GB/s)", "matches");
+    for(std::size_t threads = 1; threads <= 64; threads *= 2) {
+        cppbp::thread_pool pool{threads};
+
+        auto start = std::chrono::steady_clock::now();
+        const std::size_t single = cppbp::parallel_find_all(haystack, "timeout", pool).size();
+        const double needle = static_cast<double>(haystack.size()) / bench::seconds_since(start) / 1e9;
+
+        start = std::chrono::steady_clock::now();
+        const std::size_t multi = cppbp::parallel_find_all(haystack, patterns, pool).size();
+        const double multiple = static_cast<double>(haystack.size()) / bench::seconds_since(start) / 1e9;
+
+        std::printf("%8zu %18.2f %18.2f %10zu\n", threads, needle, multiple, single + multi);
+    }
+    return 0;
+}
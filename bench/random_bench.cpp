@@ -0,0 +1,65 @@
+// Throughput of the random engines, of bounded integers drawn with uniform_below against
+// std::uniform_int_distribution, and of the bulk filler, in millions of numbers per second.
+
+#include "bench_corpus.hpp"
+
+#include <cppbp/random.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t count = 1 << 24;
+
+template<typename Function>
+double measure(Function f)
+{
+    std::uint64_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < count; ++i) {
+        sink += f();
+    }
+    const double result = static_cast<double>(count) / bench::seconds_since(start) / 1e6;
+    // Keeps the loop from being optimized away.
+    if(sink == 42) {
+        std::printf("!");
+    }
+    return result;
+}
+
+template<typename Engine>
+void run(const char *name, Engine engine)
+{
+    // A bound that is not a power of two, like a table size or a number of servers.
+    const std::uint64_t bound = 1000003;
+    std::uniform_int_distribution<std::uint64_t> distribution{0, bound - 1};
+    const double raw = measure([&] { return static_cast<std::uint64_t>(engine()); });
+    const double std_bounded = measure([&] { return distribution(engine); });
+    const double bounded = measure([&] { return cppbp::uniform_below(engine, bound); });
+    std::printf("%-14s %12.1f %18.1f %18.1f\n", name, raw, std_bounded, bounded);
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("%-14s %12s %18s %18s\n", "engine", "raw (M/s)", "std bounded (M/s)", "uniform_below (M/s)");
+    run("mt19937_64", std::mt19937_64{1});
+    run("xoshiro256ss", cppbp::xoshiro256ss{1});
+    run("wyrand", cppbp::wyrand{1});
+    run("pcg32", cppbp::pcg32{1});
+
+    std::vector<std::uint64_t> out(1 << 12);
+    cppbp::xoshiro256ss_x4 bulk{1};
+    const auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < count; i += out.size()) {
+        bulk.fill(cppbp::span<std::uint64_t>{out.data(), out.size()});
+    }
+    std::printf("%-14s %12.1f %18s %18s %llu\n", "xoshiro256ss_x4", static_cast<double>(count) / bench::seconds_since(start) / 1e6,
+                "", "", static_cast<unsigned long long>(out[7] % 10));
+    return 0;
+}
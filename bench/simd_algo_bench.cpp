@@ -0,0 +1,82 @@
+// Throughput of the simd_algo functions against their std counterparts on arrays of bytes and of
+// 32 bit integers, in billions of elements per second. Searches look for a value that is not
+// there and the compared arrays are equal, so every call walks the whole array.
+
+#include "bench_corpus.hpp"
+
+#include <cppbp/simd_algo.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t element_count = 1 << 16;
+constexpr int rounds = 2000;
+
+// Calls f(first, last, other) on arrays read through volatile pointers, so that the compiler
+// cannot hoist the call out of the loop.
+template<typename T, typename Function>
+double measure(const std::vector<T> &a, const std::vector<T> &b, Function f, std::uint64_t &sink)
+{
+    const T *volatile a_data = a.data();
+    const T *volatile b_data = b.data();
+    const auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        const T *first = a_data;
+        sink += static_cast<std::uint64_t>(f(first, first + a.size(), b_data));
+    }
+    return static_cast<double>(rounds * element_count) / bench::seconds_since(start) / 1e9;
+}
+
+template<typename T>
+void run(const char *type, bench::corpus &corpus)
+{
+    std::vector<T> a(element_count);
+    for(auto &v : a) {
+        v = static_cast<T>(corpus.uniform(100));
+    }
+    const std::vector<T> b = a;
+    const T absent = 100;
+    const T present = 7;
+    const T *end_of_b = nullptr;
+    std::uint64_t sink = 0;
+
+    const auto report = [&](const char *name, double scalar, double simd) {
+        std::printf("%-8s %-24s %12.2f %12.2f\n", type, name, scalar, simd);
+    };
+    report("find",
+           measure(a, b, [&](const T *first, const T *last, const T*) { return std::find(first, last, absent) - first; }, sink),
+           measure(a, b, [&](const T *first, const T *last, const T*) { return cppbp::simd_algo::find(first, last, absent) - first; }, sink));
+    report("count",
+           measure(a, b, [&](const T *first, const T *last, const T*) { return std::count(first, last, present); }, sink),
+           measure(a, b, [&](const T *first, const T *last, const T*) { return cppbp::simd_algo::count(first, last, present); }, sink));
+    report("min_element",
+           measure(a, b, [](const T *first, const T *last, const T*) { return std::min_element(first, last) - first; }, sink),
+           measure(a, b, [](const T *first, const T *last, const T*) { return cppbp::simd_algo::min_element(first, last) - first; }, sink));
+    report("minmax_element",
+           measure(a, b, [](const T *first, const T *last, const T*) { return std::minmax_element(first, last).second - first; }, sink),
+           measure(a, b, [](const T *first, const T *last, const T*) { return cppbp::simd_algo::minmax_element(first, last).second - first; }, sink));
+    report("mismatch",
+           measure(a, b, [](const T *first, const T *last, const T *other) { return std::mismatch(first, last, other).first - first; }, sink),
+           measure(a, b, [](const T *first, const T *last, const T *other) { return cppbp::simd_algo::mismatch(first, last, other).first - first; }, sink));
+    end_of_b = b.data() + b.size();
+    report("lexicographical_compare",
+           measure(a, b, [&](const T *first, const T *last, const T *other) { return std::lexicographical_compare(first, last, other, end_of_b); }, sink),
+           measure(a, b, [&](const T *first, const T *last, const T *other) { return cppbp::simd_algo::lexicographical_compare(first, last, other, end_of_b); }, sink));
+    std::printf("%-8s %-24s %12s %12s %llu\n", type, "(checksum)", "", "", static_cast<unsigned long long>(sink % 10));
+}
+
+} // namespace
+
+int main()
+{
+    bench::corpus corpus;
+    std::printf("%-8s %-24s %12s %12s\n", "type", "algorithm", "std (G/s)", "simd (G/s)");
+    run<std::uint8_t>("uint8", corpus);
+    run<std::int32_t>("int32", corpus);
+    return 0;
+}
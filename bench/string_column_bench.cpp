@@ -0,0 +1,83 @@
+// Throughput of the string_column kernels against the same predicates evaluated row by row over a
+// vector of string_views, for metric-name keys.
+
+#include "bench_corpus.hpp"
+
+#include <cppbp/string_column.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t key_count = 1 << 16;
+constexpr int rounds = 200;
+
+using mask = std::vector<std::uint64_t>;
+
+template<typename Predicate, typename Kernel>
+void run(const char *name, const std::vector<cppbp::string_view> &views, Predicate predicate, Kernel kernel)
+{
+    std::uint64_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        mask m((views.size() + 63) / 64, 0);
+        for(std::size_t i = 0; i < views.size(); ++i) {
+            m[i / 64] |= static_cast<std::uint64_t>(predicate(views[i]) ? 1u : 0u) << (i % 64);
+        }
+        sink += m[static_cast<std::size_t>(r) % m.size()];
+    }
+    const double scalar = static_cast<double>(rounds * views.size()) / bench::seconds_since(start) / 1e6;
+
+    start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        const mask m = kernel();
+        sink += m[static_cast<std::size_t>(r) % m.size()];
+    }
+    const double column = static_cast<double>(rounds * views.size()) / bench::seconds_since(start) / 1e6;
+
+    std::printf("%-20s %18.1f %18.1f %10llu\n", name, scalar, column, static_cast<unsigned long long>(sink % 10));
+}
+
+} // namespace
+
+int main()
+{
+    bench::corpus corpus;
+    const std::vector<std::string> keys = corpus.keys(key_count);
+    cppbp::string_column column;
+    for(const auto &key : keys) {
+        column.push_back(cppbp::string_view{key.data(), key.size()});
+    }
+    std::vector<cppbp::string_view> views;
+    for(std::size_t i = 0; i < column.size(); ++i) {
+        views.push_back(column[i]);
+    }
+
+    // Read the probes through volatile pointers so that the loops cannot be specialised for them.
+    const std::string probes[] = {"db.hits.4711", "db.", "http.requests.", "latency"};
+    const char *volatile p[] = {probes[0].data(), probes[1].data(), probes[2].data(), probes[3].data()};
+    const cppbp::string_view key{p[0], probes[0].size()};
+    const cppbp::string_view short_prefix{p[1], probes[1].size()};
+    const cppbp::string_view long_prefix{p[2], probes[2].size()};
+    const cppbp::string_view needle{p[3], probes[3].size()};
+
+    std::printf("%-20s %18s %18s\n", "kernel", "rows (Mrows/s)", "column (Mrows/s)");
+    run("equals", views,
+        [&](cppbp::string_view v) { return v == key; },
+        [&] { return column.equals(key); });
+    run("starts_with short", views,
+        [&](cppbp::string_view v) { return v.substr(0, short_prefix.size()) == short_prefix; },
+        [&] { return column.starts_with(short_prefix); });
+    run("starts_with long", views,
+        [&](cppbp::string_view v) { return v.substr(0, long_prefix.size()) == long_prefix; },
+        [&] { return column.starts_with(long_prefix); });
+    run("contains", views,
+        [&](cppbp::string_view v) { return v.find(needle) != cppbp::string_view::npos; },
+        [&] { return column.contains(needle); });
+    return 0;
+}
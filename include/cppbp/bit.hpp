@@ -0,0 +1,153 @@
+#ifndef CPPBP_BIT_HPP
+#define CPPBP_BIT_HPP
+
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::enable_if, std::is_unsigned
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // __popcnt, __popcnt64, _BitScanForward64, _BitScanReverse64
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+template<typename T>
+using enable_if_unsigned_t = typename std::enable_if<std::is_unsigned<T>::value, int>::type;
+
+inline int popcount64(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// Precondition: x != 0
+inline int ctz64(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    int n = 0;
+    while((x & 1u) == 0) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Precondition: x != 0
+inline int clz64(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<int>(index);
+#else
+    int n = 0;
+    while((x & (1ull << 63)) == 0) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+} // namespace detail
+
+// Counting                                                                         [bit.count]
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline int popcount(T x) noexcept
+{
+    return detail::popcount64(static_cast<std::uint64_t>(x));
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline int countr_zero(T x) noexcept
+{
+    return x == 0 ? std::numeric_limits<T>::digits
+                  : detail::ctz64(static_cast<std::uint64_t>(x));
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline int countl_zero(T x) noexcept
+{
+    return x == 0 ? std::numeric_limits<T>::digits
+                  : detail::clz64(static_cast<std::uint64_t>(x)) - (64 - std::numeric_limits<T>::digits);
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline int countr_one(T x) noexcept
+{
+    return countr_zero(static_cast<T>(~x));
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline int countl_one(T x) noexcept
+{
+    return countl_zero(static_cast<T>(~x));
+}
+
+// Integral powers of 2                                                            [bit.pow.two]
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+constexpr bool has_single_bit(T x) noexcept
+{
+    return x != 0 && (x & (x - 1)) == 0;
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline int bit_width(T x) noexcept
+{
+    return std::numeric_limits<T>::digits - countl_zero(x);
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline T bit_floor(T x) noexcept
+{
+    return x == 0 ? T{0} : static_cast<T>(T{1} << (bit_width(x) - 1));
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+inline T bit_ceil(T x) noexcept
+{
+    return x <= 1 ? T{1} : static_cast<T>(T{1} << bit_width(static_cast<T>(x - 1)));
+}
+
+// Rotating                                                                          [bit.rotate]
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+constexpr T rotl(T x, int s) noexcept
+{
+    return static_cast<T>((x << (static_cast<unsigned>(s) % std::numeric_limits<T>::digits))
+         | (x >> ((std::numeric_limits<T>::digits - static_cast<unsigned>(s) % std::numeric_limits<T>::digits)
+                  % std::numeric_limits<T>::digits)));
+}
+
+template<typename T, detail::enable_if_unsigned_t<T> = 0>
+constexpr T rotr(T x, int s) noexcept
+{
+    return static_cast<T>((x >> (static_cast<unsigned>(s) % std::numeric_limits<T>::digits))
+         | (x << ((std::numeric_limits<T>::digits - static_cast<unsigned>(s) % std::numeric_limits<T>::digits)
+                  % std::numeric_limits<T>::digits)));
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_BIT_HPP
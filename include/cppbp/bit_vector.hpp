@@ -0,0 +1,482 @@
+#ifndef CPPBP_BIT_VECTOR_HPP
+#define CPPBP_BIT_VECTOR_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::popcount, cppbp::countr_zero
+#include <cppbp/span.hpp>           // cppbp::span, cppbp::detail::read_aligned
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::logic_error, std::out_of_range
+#include <utility>      // std::swap
+#include <vector>       // std::vector
+
+#if defined(__BMI2__)
+#include <immintrin.h>  // _pdep_u64
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// Position of the k-th (0-based) set bit of word, which must have more than k set bits.
+inline int select_in_word(std::uint64_t word, unsigned k) noexcept
+{
+#if defined(__BMI2__)
+    return countr_zero(_pdep_u64(std::uint64_t{1} << k, word));
+#else
+    for(unsigned i = 0; i < k; ++i) {
+        word &= word - 1;
+    }
+    return countr_zero(word);
+#endif
+}
+
+} // namespace detail
+
+// Bit vector with constant time rank and fast select.
+//
+// Bits are appended or set first; build_index() then samples the number of ones before every
+// 512 bit block and the block of every 512th one and zero. rank() adds at most eight word
+// popcounts to a sample, select() binary searches between two samples. The vector and its index
+// serialize to a flat buffer that can be borrowed in place like the filters.
+class bit_vector final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Construction and Assignment
+public:
+    bit_vector() noexcept
+        : m_size{0}
+        , m_ones{0}
+        , m_words{nullptr}
+        , m_rank{nullptr}
+        , m_select1{nullptr}
+        , m_select0{nullptr}
+        , m_word_count{0}
+        , m_rank_count{0}
+        , m_select1_count{0}
+        , m_select0_count{0}
+        , m_indexed{false}
+        , m_borrowed{false}
+    { }
+
+    explicit bit_vector(size_type size, bool value = false)
+        : bit_vector{}
+    {
+        m_bits.assign((size + 63) / 64, value ? ~std::uint64_t{0} : 0);
+        m_size = size;
+        if(value && size % 64 != 0) {
+            m_bits.back() &= (std::uint64_t{1} << (size % 64)) - 1;
+        }
+        sync();
+    }
+
+    bit_vector(const bit_vector &other)
+        : bit_vector{}
+    {
+        copy_from(other);
+    }
+
+    bit_vector(bit_vector &&other) noexcept
+        : bit_vector{}
+    {
+        swap(other);
+    }
+
+    bit_vector& operator=(bit_vector other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    // Copies a bit vector out of a buffer written by serialize().
+    static bit_vector deserialize(span<const unsigned char> bytes)
+    {
+        return detail::read_aligned(bytes, [](span<const unsigned char> copy) {
+            const bit_vector borrowed = borrow(copy, false);
+            bit_vector result;
+            result.copy_from(borrowed);
+            return result;
+        });
+    }
+
+    // Uses a buffer written by serialize() in place. It must be 8 byte aligned and outlive the
+    // result, which is read only.
+    static bit_vector borrow(span<const unsigned char> bytes)
+    {
+        return borrow(bytes, true);
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    // Element access
+public:
+    bool operator[](size_type i) const noexcept
+    {
+        return (m_words[i / 64] >> (i % 64)) & 1u;
+    }
+
+    bool test(size_type i) const
+    {
+        if(i >= m_size) {
+            throw std::out_of_range("bit_vector::test: index out of range");
+        }
+        return (*this)[i];
+    }
+
+    span<const std::uint64_t> words() const noexcept
+    {
+        return span<const std::uint64_t>{m_words, m_word_count};
+    }
+
+    // Modifiers
+public:
+    void push_back(bool bit)
+    {
+        check_writable();
+        if(m_size % 64 == 0) {
+            m_bits.push_back(0);
+        }
+        m_bits.back() |= static_cast<std::uint64_t>(bit) << (m_size % 64);
+        ++m_size;
+        m_indexed = false;
+        sync();
+    }
+
+    // Threads may set bits in different words at the same time until build_index() is called.
+    void set(size_type i, bool bit = true)
+    {
+        check_writable();
+        if(i >= m_size) {
+            throw std::out_of_range("bit_vector::set: index out of range");
+        }
+        const std::uint64_t mask = std::uint64_t{1} << (i % 64);
+        m_bits[i / 64] = bit ? (m_bits[i / 64] | mask) : (m_bits[i / 64] & ~mask);
+        if(m_indexed) {
+            m_indexed = false;
+        }
+    }
+
+    // Builds the rank and select samples. Required after the last modification.
+    void build_index()
+    {
+        check_writable();
+        const size_type blocks = (m_word_count + words_per_block - 1) / words_per_block;
+        m_rank_samples.assign(blocks + 1, 0);
+        m_select1_samples.clear();
+        m_select0_samples.clear();
+        std::uint64_t ones = 0;
+        for(size_type b = 0; b < blocks; ++b) {
+            m_rank_samples[b] = ones;
+            const size_type end = (b + 1) * words_per_block < m_word_count ? (b + 1) * words_per_block : m_word_count;
+            for(size_type w = b * words_per_block; w < end; ++w) {
+                ones += static_cast<std::uint64_t>(popcount(m_bits[w]));
+                // Record the block of every sample_rate-th one and zero.
+                while(m_select1_samples.size() * sample_rate < ones) {
+                    m_select1_samples.push_back(b);
+                }
+                const std::uint64_t zeros = zeros_before(w + 1, ones);
+                while(m_select0_samples.size() * sample_rate < zeros) {
+                    m_select0_samples.push_back(b);
+                }
+            }
+        }
+        m_rank_samples[blocks] = ones;
+        m_ones = static_cast<size_type>(ones);
+        m_indexed = true;
+        sync();
+    }
+
+    // Rank and Select
+public:
+    size_type count_ones() const
+    {
+        check_indexed();
+        return m_ones;
+    }
+
+    // Number of set bits in [0, i).
+    size_type rank1(size_type i) const noexcept
+    {
+        const size_type word = i / 64;
+        const size_type block = word / words_per_block;
+        std::uint64_t result = m_rank[block];
+        for(size_type w = block * words_per_block; w < word; ++w) {
+            result += static_cast<std::uint64_t>(popcount(m_words[w]));
+        }
+        if(i % 64 != 0) {
+            result += static_cast<std::uint64_t>(popcount(m_words[word] & ((std::uint64_t{1} << (i % 64)) - 1)));
+        }
+        return static_cast<size_type>(result);
+    }
+
+    size_type rank0(size_type i) const noexcept
+    {
+        return i - rank1(i);
+    }
+
+    // Position of the k-th (0-based) set bit, or npos if there are not that many.
+    size_type select1(size_type k) const noexcept
+    {
+        if(k >= m_ones) {
+            return npos;
+        }
+        size_type lo = m_select1[k / sample_rate];
+        size_type hi = k / sample_rate + 1 < m_select1_count ? m_select1[k / sample_rate + 1] + 1 : m_rank_count - 1;
+        // Last block whose rank sample is <= k.
+        while(hi - lo > 1) {
+            const size_type mid = lo + (hi - lo) / 2;
+            if(m_rank[mid] <= k) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        size_type remaining = k - static_cast<size_type>(m_rank[lo]);
+        // Bounded only for a borrowed buffer whose samples disagree with its bits.
+        for(size_type w = lo * words_per_block; w < m_word_count; ++w) {
+            const size_type ones = static_cast<size_type>(popcount(m_words[w]));
+            if(remaining < ones) {
+                return w * 64 + static_cast<size_type>(detail::select_in_word(m_words[w], static_cast<unsigned>(remaining)));
+            }
+            remaining -= ones;
+        }
+        return npos;
+    }
+
+    // Position of the k-th (0-based) clear bit, or npos if there are not that many.
+    size_type select0(size_type k) const noexcept
+    {
+        if(k >= m_size - m_ones) {
+            return npos;
+        }
+        size_type lo = m_select0[k / sample_rate];
+        size_type hi = k / sample_rate + 1 < m_select0_count ? m_select0[k / sample_rate + 1] + 1 : m_rank_count - 1;
+        while(hi - lo > 1) {
+            const size_type mid = lo + (hi - lo) / 2;
+            if(mid * block_bits - m_rank[mid] <= k) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        size_type remaining = k - (lo * block_bits - static_cast<size_type>(m_rank[lo]));
+        for(size_type w = lo * words_per_block; w < m_word_count; ++w) {
+            const std::uint64_t inverted = ~m_words[w];
+            const size_type zeros = static_cast<size_type>(popcount(inverted));
+            if(remaining < zeros) {
+                return w * 64 + static_cast<size_type>(detail::select_in_word(inverted, static_cast<unsigned>(remaining)));
+            }
+            remaining -= zeros;
+        }
+        return npos;
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const
+    {
+        check_indexed();
+        return header_size + (m_word_count + m_rank_count + m_select1_count + m_select0_count) * 8;
+    }
+
+    void serialize(span<unsigned char> out) const
+    {
+        if(out.size() < serialized_size()) {
+            throw std::length_error("bit_vector::serialize: buffer too small");
+        }
+        const std::uint64_t header[header_size / 8] = {
+            m_size, m_ones, m_word_count, m_rank_count, m_select1_count, m_select0_count
+        };
+        unsigned char *p = out.data();
+        std::memcpy(p, header, header_size);
+        p += header_size;
+        p = write_words(p, m_words, m_word_count);
+        p = write_words(p, m_rank, m_rank_count);
+        p = write_words(p, m_select1, m_select1_count);
+        write_words(p, m_select0, m_select0_count);
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> result(serialized_size());
+        serialize(span<unsigned char>{result.data(), result.size()});
+        return result;
+    }
+
+    void swap(bit_vector &other) noexcept
+    {
+        std::swap(m_size, other.m_size);
+        std::swap(m_ones, other.m_ones);
+        std::swap(m_word_count, other.m_word_count);
+        std::swap(m_rank_count, other.m_rank_count);
+        std::swap(m_select1_count, other.m_select1_count);
+        std::swap(m_select0_count, other.m_select0_count);
+        std::swap(m_indexed, other.m_indexed);
+        std::swap(m_borrowed, other.m_borrowed);
+        m_bits.swap(other.m_bits);
+        m_rank_samples.swap(other.m_rank_samples);
+        m_select1_samples.swap(other.m_select1_samples);
+        m_select0_samples.swap(other.m_select0_samples);
+        // Owned vectors keep their buffers when swapped, so the pointers stay valid.
+        std::swap(m_words, other.m_words);
+        std::swap(m_rank, other.m_rank);
+        std::swap(m_select1, other.m_select1);
+        std::swap(m_select0, other.m_select0);
+    }
+
+    // Helper
+private:
+    static constexpr size_type words_per_block = 8;
+    static constexpr size_type block_bits = words_per_block * 64;
+    static constexpr size_type sample_rate = 512;
+    static constexpr size_type header_size = 48;
+
+    // Zeros in the first word_end words; bits past size() do not count.
+    std::uint64_t zeros_before(size_type word_end, std::uint64_t ones) const noexcept
+    {
+        const std::uint64_t bits = word_end * 64 < m_size ? word_end * 64 : m_size;
+        return bits - ones;
+    }
+
+    static bit_vector borrow(span<const unsigned char> bytes, bool keep)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(std::uint64_t) != 0) {
+            throw std::invalid_argument("bit_vector::borrow: buffer is not 8 byte aligned");
+        }
+        if(bytes.size() < header_size) {
+            throw std::invalid_argument("bit_vector: truncated buffer");
+        }
+        const std::uint64_t *header = reinterpret_cast<const std::uint64_t*>(bytes.data());
+        const std::uint64_t words = header[2];
+        const std::uint64_t ranks = header[3];
+        const std::uint64_t select1 = header[4];
+        const std::uint64_t select0 = header[5];
+        const std::uint64_t available = (bytes.size() - header_size) / 8;
+        // build_index() keeps one select sample per sample_rate ones and zeros, rounded up.
+        if(header[0] / 64 > available || words != (header[0] + 63) / 64 || ranks != (words + words_per_block - 1) / words_per_block + 1
+           || header[1] > header[0]
+           || select1 != (header[1] + sample_rate - 1) / sample_rate
+           || select0 != (header[0] - header[1] + sample_rate - 1) / sample_rate
+           || words + ranks + select1 + select0 > available
+           || header[header_size / 8 + words] != 0 || header[header_size / 8 + words + ranks - 1] != header[1]) {
+            throw std::invalid_argument("bit_vector: corrupt or truncated buffer");
+        }
+        // select() indexes the rank samples and words with the samples, so they must be ordered
+        // block numbers; a block holds at most block_bits ones. Checking them against the bits
+        // themselves would read the whole buffer.
+        const std::uint64_t *rank = header + header_size / 8 + words;
+        for(std::uint64_t b = 0; b + 1 < ranks; ++b) {
+            if(rank[b + 1] < rank[b] || rank[b + 1] - rank[b] > block_bits) {
+                throw std::invalid_argument("bit_vector: corrupt rank samples");
+            }
+        }
+        const std::uint64_t *samples = rank + ranks;
+        for(std::uint64_t i = 0; i < select1 + select0; ++i) {
+            if(samples[i] >= ranks - 1 || (i != 0 && i != select1 && samples[i] < samples[i - 1])) {
+                throw std::invalid_argument("bit_vector: corrupt select samples");
+            }
+        }
+
+        bit_vector result;
+        result.m_size = static_cast<size_type>(header[0]);
+        result.m_ones = static_cast<size_type>(header[1]);
+        result.m_word_count = static_cast<size_type>(words);
+        result.m_rank_count = static_cast<size_type>(ranks);
+        result.m_select1_count = static_cast<size_type>(select1);
+        result.m_select0_count = static_cast<size_type>(select0);
+        result.m_words = header + header_size / 8;
+        result.m_rank = result.m_words + words;
+        result.m_select1 = result.m_rank + ranks;
+        result.m_select0 = result.m_select1 + select1;
+        result.m_indexed = true;
+        result.m_borrowed = keep;
+        return result;
+    }
+
+    void copy_from(const bit_vector &other)
+    {
+        m_bits.assign(other.m_words, other.m_words + other.m_word_count);
+        m_rank_samples.assign(other.m_rank, other.m_rank + other.m_rank_count);
+        m_select1_samples.assign(other.m_select1, other.m_select1 + other.m_select1_count);
+        m_select0_samples.assign(other.m_select0, other.m_select0 + other.m_select0_count);
+        m_size = other.m_size;
+        m_ones = other.m_ones;
+        m_indexed = other.m_indexed;
+        m_borrowed = false;
+        sync();
+    }
+
+    static unsigned char* write_words(unsigned char *p, const std::uint64_t *words, size_type count) noexcept
+    {
+        if(count != 0) {
+            std::memcpy(p, words, count * 8);
+        }
+        return p + count * 8;
+    }
+
+    // Points the accessors at the owned storage.
+    void sync() noexcept
+    {
+        m_words = m_bits.data();
+        m_rank = m_rank_samples.data();
+        m_select1 = m_select1_samples.data();
+        m_select0 = m_select0_samples.data();
+        m_word_count = m_bits.size();
+        m_rank_count = m_rank_samples.size();
+        m_select1_count = m_select1_samples.size();
+        m_select0_count = m_select0_samples.size();
+    }
+
+    void check_writable() const
+    {
+        if(m_borrowed) {
+            throw std::logic_error("bit_vector: a borrowed bit vector is read only");
+        }
+    }
+
+    void check_indexed() const
+    {
+        if(!m_indexed) {
+            throw std::logic_error("bit_vector: build_index() has not been called");
+        }
+    }
+
+    // Private Member
+private:
+    size_type                   m_size;
+    size_type                   m_ones;
+    std::vector<std::uint64_t>  m_bits;
+    std::vector<std::uint64_t>  m_rank_samples;
+    std::vector<std::uint64_t>  m_select1_samples;
+    std::vector<std::uint64_t>  m_select0_samples;
+    const std::uint64_t        *m_words;
+    const std::uint64_t        *m_rank;
+    const std::uint64_t        *m_select1;
+    const std::uint64_t        *m_select0;
+    size_type                   m_word_count;
+    size_type                   m_rank_count;
+    size_type                   m_select1_count;
+    size_type                   m_select0_count;
+    bool                        m_indexed;
+    bool                        m_borrowed;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_BIT_VECTOR_HPP
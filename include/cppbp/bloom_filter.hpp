@@ -0,0 +1,405 @@
+#ifndef CPPBP_BLOOM_FILTER_HPP
+#define CPPBP_BLOOM_FILTER_HPP
+
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view, cppbp::detail::hash_key
+
+#include <cmath>        // std::ceil, std::exp, std::lgamma, std::log, std::pow, std::sqrt
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy, std::memcmp, std::memset
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::logic_error
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_and_si128, _mm_cmpeq_epi32, _mm256_testc_si256, ...
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// Odd multipliers picking the bits of a key within its block, one per hash.
+constexpr std::uint32_t bloom_salts[16] = {
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u,
+    0x7f041729u, 0xd802db89u, 0xdb54e35fu, 0x75bd5125u, 0x16b4aa27u, 0x20cbf68bu, 0x60e04457u, 0x08ce66d9u,
+};
+
+// Maps a 32 bit value uniformly onto [0, range) without a division.
+inline std::uint64_t reduce_range(std::uint32_t x, std::uint64_t range) noexcept
+{
+    return (static_cast<std::uint64_t>(x) * range) >> 32;
+}
+
+// Tests whether every bit of mask is set in the 512 bit block.
+inline bool block_contains(const std::uint64_t *block, const std::uint64_t *mask) noexcept
+{
+#if defined(__AVX2__)
+    const __m256i* b = reinterpret_cast<const __m256i*>(block);
+    const __m256i* m = reinterpret_cast<const __m256i*>(mask);
+    return _mm256_testc_si256(_mm256_loadu_si256(b), _mm256_loadu_si256(m))
+        && _mm256_testc_si256(_mm256_loadu_si256(b + 1), _mm256_loadu_si256(m + 1));
+#elif defined(CPPBP_HAS_SSE2)
+    const __m128i* b = reinterpret_cast<const __m128i*>(block);
+    const __m128i* m = reinterpret_cast<const __m128i*>(mask);
+    __m128i all = _mm_set1_epi32(-1);
+    for(int i = 0; i < 4; ++i) {
+        const __m128i bits = _mm_loadu_si128(m + i);
+        all = _mm_and_si128(all, _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(b + i), bits), bits));
+    }
+    return _mm_movemask_epi8(all) == 0xffff;
+#else
+    std::uint64_t missing = 0;
+    for(int i = 0; i < 8; ++i) {
+        missing |= mask[i] & ~block[i];
+    }
+    return missing == 0;
+#endif
+}
+
+} // namespace detail
+
+// Blocked Bloom filter for string keys.
+//
+// Every key touches exactly one 64 byte block (one cache line), and its k bits within the block
+// are picked by multiplying the hash with one odd salt per bit. A lookup builds the block mask and
+// tests it with one SIMD comparison. The filter serializes to a flat byte buffer that can be
+// loaded by copying or used in place, e.g. from a memory mapped file.
+class bloom_filter final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type block_bits = 512;
+    static constexpr int max_hashes = 16;
+
+    // Construction and Assignment
+public:
+    // A filter with at least bits bits and hashes probes per key.
+    bloom_filter(size_type bits, int hashes, std::uint64_t seed = detail::default_hash_seed)
+        : m_hashes{hashes}
+        , m_block_count{(bits + block_bits - 1) / block_bits}
+        , m_seed{seed}
+        , m_storage(m_block_count * words_per_block)
+        , m_blocks{m_storage.data()}
+        , m_borrowed{false}
+    {
+        if(m_block_count == 0 || hashes < 1 || hashes > max_hashes) {
+            throw std::invalid_argument("bloom_filter: invalid size or number of hashes");
+        }
+    }
+
+    // A filter sized for expected_keys keys at the given false positive rate. Confining keys to
+    // blocks costs accuracy, so the classic size is grown until the blocked filter reaches rate.
+    static bloom_filter for_false_positive_rate(size_type expected_keys, double rate)
+    {
+        size_type low = (optimal_bits(expected_keys, rate) + block_bits - 1) / block_bits;
+        if(blocked_false_positive_rate(low * block_bits, best_hashes(low * block_bits, expected_keys), expected_keys) <= rate) {
+            return bloom_filter{low * block_bits, best_hashes(low * block_bits, expected_keys)};
+        }
+        size_type high = low + low / 8 + 1;
+        while(blocked_false_positive_rate(high * block_bits, best_hashes(high * block_bits, expected_keys), expected_keys) > rate) {
+            low = high;
+            high += high / 8 + 1;
+        }
+        while(high - low > 1) {
+            const size_type middle = low + (high - low) / 2;
+            const int hashes = best_hashes(middle * block_bits, expected_keys);
+            if(blocked_false_positive_rate(middle * block_bits, hashes, expected_keys) > rate) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        return bloom_filter{high * block_bits, best_hashes(high * block_bits, expected_keys)};
+    }
+
+    // Copies a filter out of a buffer written by serialize().
+    static bloom_filter deserialize(span<const unsigned char> bytes)
+    {
+        bloom_filter result{read_header(bytes)};
+        std::memcpy(result.m_storage.data(), bytes.data() + header_size, result.data_size());
+        return result;
+    }
+
+    // Uses the blocks of a buffer written by serialize() in place. The buffer must stay valid
+    // and be 8 byte aligned; the resulting filter is read only.
+    static bloom_filter borrow(span<const unsigned char> bytes)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(std::uint64_t) != 0) {
+            throw std::invalid_argument("bloom_filter::borrow: buffer is not 8 byte aligned");
+        }
+        return bloom_filter{read_header(bytes), reinterpret_cast<const std::uint64_t*>(bytes.data() + header_size)};
+    }
+
+    bloom_filter(bloom_filter &&other) noexcept
+        : m_hashes{other.m_hashes}
+        , m_block_count{other.m_block_count}
+        , m_seed{other.m_seed}
+        , m_storage(std::move(other.m_storage))
+        , m_blocks{other.m_borrowed ? other.m_blocks : m_storage.data()}
+        , m_borrowed{other.m_borrowed}
+    { }
+
+    bloom_filter(const bloom_filter &other)
+        : m_hashes{other.m_hashes}
+        , m_block_count{other.m_block_count}
+        , m_seed{other.m_seed}
+        , m_storage(other.m_storage)
+        , m_blocks{other.m_borrowed ? other.m_blocks : m_storage.data()}
+        , m_borrowed{other.m_borrowed}
+    { }
+
+    bloom_filter& operator=(bloom_filter other) noexcept
+    {
+        m_hashes = other.m_hashes;
+        m_block_count = other.m_block_count;
+        m_seed = other.m_seed;
+        m_storage.swap(other.m_storage);
+        m_blocks = other.m_borrowed ? other.m_blocks : m_storage.data();
+        m_borrowed = other.m_borrowed;
+        return *this;
+    }
+
+    // Sizing
+public:
+    // Number of bits of a classic Bloom filter with the given false positive rate.
+    static size_type optimal_bits(size_type expected_keys, double rate)
+    {
+        if(!(rate > 0.0 && rate < 1.0)) {
+            throw std::invalid_argument("bloom_filter: false positive rate must be in (0, 1)");
+        }
+        const double ln2 = 0.6931471805599453;
+        const double n = static_cast<double>(expected_keys == 0 ? 1 : expected_keys);
+        return static_cast<size_type>(std::ceil(-n * std::log(rate) / (ln2 * ln2)));
+    }
+
+    static int optimal_hashes(size_type bits, size_type expected_keys) noexcept
+    {
+        const double n = static_cast<double>(expected_keys == 0 ? 1 : expected_keys);
+        const int k = static_cast<int>(static_cast<double>(bits) / n * 0.6931471805599453 + 0.5);
+        return k < 1 ? 1 : (k > max_hashes ? max_hashes : k);
+    }
+
+    // Expected false positive rate of a blocked filter. The number of keys per block is Poisson
+    // distributed, and the crowded blocks answer yes much more often than an average one.
+    static double blocked_false_positive_rate(size_type bits, int hashes, size_type expected_keys) noexcept
+    {
+        const size_type blocks = (bits + block_bits - 1) / block_bits;
+        if(blocks == 0 || expected_keys == 0) {
+            return blocks == 0 ? 1.0 : 0.0;
+        }
+        const double mean = static_cast<double>(expected_keys) / static_cast<double>(blocks);
+        const double miss = std::pow(1.0 - 1.0 / static_cast<double>(block_bits), hashes);
+        const double last = mean + 12.0 * std::sqrt(mean) + 20.0;
+        double result = 0.0;
+        double empty_share = 1.0;  // miss^keys: chance that one bit is still clear
+        for(double keys = 0.0; keys <= last; keys += 1.0) {
+            const double weight = std::exp(keys * std::log(mean) - mean - std::lgamma(keys + 1.0));
+            result += weight * std::pow(1.0 - empty_share, hashes);
+            empty_share *= miss;
+        }
+        return result;
+    }
+
+    // Observers
+public:
+    size_type bit_count() const noexcept
+    {
+        return m_block_count * block_bits;
+    }
+
+    int hash_count() const noexcept
+    {
+        return m_hashes;
+    }
+
+    bool borrowed() const noexcept
+    {
+        return m_borrowed;
+    }
+
+    // The hash a key is inserted and looked up with.
+    template<typename CharT, typename Traits>
+    std::uint64_t hash(basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return detail::hash_key(key, m_seed);
+    }
+
+    // Lookup
+public:
+    template<typename CharT, typename Traits>
+    bool contains(basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return contains_hash(hash(key));
+    }
+
+    bool contains_hash(std::uint64_t h) const noexcept
+    {
+        std::uint64_t mask[words_per_block];
+        make_mask(h, mask);
+        return detail::block_contains(block_of(h), mask);
+    }
+
+    // Modifiers
+public:
+    template<typename CharT, typename Traits>
+    void insert(basic_string_view<CharT, Traits> key)
+    {
+        insert_hash(hash(key));
+    }
+
+    void insert_hash(std::uint64_t h)
+    {
+        if(m_borrowed) {
+            throw std::logic_error("bloom_filter: a borrowed filter is read only");
+        }
+        std::uint64_t mask[words_per_block];
+        make_mask(h, mask);
+        std::uint64_t *block = const_cast<std::uint64_t*>(block_of(h));
+        for(size_type i = 0; i < words_per_block; ++i) {
+            block[i] |= mask[i];
+        }
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const noexcept
+    {
+        return header_size + data_size();
+    }
+
+    // Writes the filter into out, which must hold serialized_size() bytes. The blocks start at an
+    // 8 byte aligned offset so an aligned copy of the buffer can be borrowed.
+    void serialize(span<unsigned char> out) const
+    {
+        if(out.size() < serialized_size()) {
+            throw std::length_error("bloom_filter::serialize: buffer too small");
+        }
+        const std::uint32_t version = format_version;
+        const std::uint32_t hashes = static_cast<std::uint32_t>(m_hashes);
+        const std::uint64_t blocks = m_block_count;
+        unsigned char *p = out.data();
+        std::memcpy(p, magic(), 4);
+        std::memcpy(p + 4, &version, 4);
+        std::memcpy(p + 8, &hashes, 4);
+        std::memset(p + 12, 0, 4);
+        std::memcpy(p + 16, &blocks, 8);
+        std::memcpy(p + 24, &m_seed, 8);
+        std::memcpy(p + header_size, m_blocks, data_size());
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> result(serialized_size());
+        serialize(span<unsigned char>{result.data(), result.size()});
+        return result;
+    }
+
+    // Helper
+private:
+    static constexpr size_type words_per_block = block_bits / 64;
+    static constexpr size_type header_size = 32;
+    static constexpr std::uint32_t format_version = 2;
+
+    static const char* magic() noexcept
+    {
+        return "CBF1";
+    }
+
+    // The number of hashes with the lowest blocked false positive rate.
+    static int best_hashes(size_type bits, size_type expected_keys) noexcept
+    {
+        int best = 1;
+        double best_rate = blocked_false_positive_rate(bits, 1, expected_keys);
+        for(int hashes = 2; hashes <= max_hashes; ++hashes) {
+            const double rate = blocked_false_positive_rate(bits, hashes, expected_keys);
+            if(rate < best_rate) {
+                best = hashes;
+                best_rate = rate;
+            }
+        }
+        return best;
+    }
+
+    struct header
+    {
+        int             hashes;
+        size_type       blocks;
+        std::uint64_t   seed;
+    };
+
+    explicit bloom_filter(const header &h)
+        : bloom_filter{h.blocks * block_bits, h.hashes, h.seed}
+    { }
+
+    // A read only filter over blocks owned by the caller; allocates nothing.
+    bloom_filter(const header &h, const std::uint64_t *blocks) noexcept
+        : m_hashes{h.hashes}
+        , m_block_count{h.blocks}
+        , m_seed{h.seed}
+        , m_storage()
+        , m_blocks{const_cast<std::uint64_t*>(blocks)}
+        , m_borrowed{true}
+    { }
+
+    static header read_header(span<const unsigned char> bytes)
+    {
+        std::uint32_t version;
+        std::uint32_t hashes;
+        std::uint64_t blocks;
+        std::uint64_t seed;
+        if(bytes.size() < header_size || std::memcmp(bytes.data(), magic(), 4) != 0) {
+            throw std::invalid_argument("bloom_filter: not a serialized bloom filter");
+        }
+        std::memcpy(&version, bytes.data() + 4, 4);
+        std::memcpy(&hashes, bytes.data() + 8, 4);
+        std::memcpy(&blocks, bytes.data() + 16, 8);
+        std::memcpy(&seed, bytes.data() + 24, 8);
+        if(version != format_version || blocks == 0 || hashes < 1 || hashes > max_hashes
+           || (bytes.size() - header_size) / (words_per_block * 8) < blocks) {
+            throw std::invalid_argument("bloom_filter: corrupt or truncated buffer");
+        }
+        return header{static_cast<int>(hashes), static_cast<size_type>(blocks), seed};
+    }
+
+    size_type data_size() const noexcept
+    {
+        return m_block_count * words_per_block * sizeof(std::uint64_t);
+    }
+
+    const std::uint64_t* block_of(std::uint64_t h) const noexcept
+    {
+        return m_blocks + detail::reduce_range(static_cast<std::uint32_t>(h >> 32), m_block_count) * words_per_block;
+    }
+
+    // Multiply-shift: bit i of the block is the top 9 bits of the low hash half times salt i.
+    // Unlike double hashing this never collapses a key onto a handful of bits.
+    void make_mask(std::uint64_t h, std::uint64_t *mask) const noexcept
+    {
+        for(size_type i = 0; i < words_per_block; ++i) {
+            mask[i] = 0;
+        }
+        const std::uint32_t x = static_cast<std::uint32_t>(h);
+        for(int i = 0; i < m_hashes; ++i) {
+            const std::uint32_t bit = static_cast<std::uint32_t>(x * detail::bloom_salts[i]) >> 23;
+            mask[bit >> 6] |= std::uint64_t{1} << (bit & 63);
+        }
+    }
+
+    // Private Member
+private:
+    int                         m_hashes;
+    size_type                   m_block_count;
+    std::uint64_t               m_seed;
+    std::vector<std::uint64_t>  m_storage;
+    std::uint64_t              *m_blocks;
+    bool                        m_borrowed;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_BLOOM_FILTER_HPP
@@ -0,0 +1,26 @@
+#ifndef CPPBP_CACHE_PADDED_HPP
+#define CPPBP_CACHE_PADDED_HPP
+
+#include <cstddef>      // std::size_t
+
+namespace cppbp {
+
+namespace detail {
+
+constexpr std::size_t cache_line_size = 64;
+
+// Keeps value on its own cache line(s) without relying on over-aligned allocation, which is not
+// guaranteed for heap objects before C++17.
+template<typename T>
+struct cache_padded
+{
+    char    before[cache_line_size];
+    T       value;
+    char    after[cache_line_size - sizeof(T) % cache_line_size];
+};
+
+} // namespace detail
+
+} // namespace cppbp
+
+#endif // CPPBP_CACHE_PADDED_HPP
@@ -0,0 +1,523 @@
+#ifndef CPPBP_CONCURRENT_STRING_MAP_HPP
+#define CPPBP_CONCURRENT_STRING_MAP_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_ceil, cppbp::bit_width
+#include <cppbp/cache_padded.hpp>   // cppbp::detail::cache_padded
+#include <cppbp/key_arena.hpp>      // cppbp::detail::key_arena
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::hash
+
+#include <atomic>       // std::atomic, std::atomic_thread_fence
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::mutex, std::lock_guard
+#include <new>          // placement new
+#include <thread>       // std::this_thread::yield
+#include <type_traits>  // std::is_trivially_copyable, std::aligned_storage
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Values that fit into a lock-free atomic word are read optimistically without taking a lock.
+template<typename V>
+using is_optimistic_value = std::integral_constant<bool,
+    std::is_trivially_copyable<V>::value && sizeof(V) <= sizeof(std::uint64_t)>;
+
+template<typename V, bool Optimistic = is_optimistic_value<V>::value>
+class map_value_cell;
+
+template<typename V>
+class map_value_cell<V, true> final
+{
+public:
+    void construct(const V &value) noexcept
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    void assign(const V &value) noexcept
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    V load() const noexcept
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    void destroy() noexcept
+    { }
+
+private:
+    std::atomic<V> m_value;
+};
+
+template<typename V>
+class map_value_cell<V, false> final
+{
+public:
+    void construct(const V &value)
+    {
+        new (&m_storage) V(value);
+    }
+
+    void assign(const V &value)
+    {
+        get() = value;
+    }
+
+    V load() const
+    {
+        return get();
+    }
+
+    V& get() noexcept
+    {
+        return *reinterpret_cast<V*>(&m_storage);
+    }
+
+    const V& get() const noexcept
+    {
+        return *reinterpret_cast<const V*>(&m_storage);
+    }
+
+    void destroy() noexcept
+    {
+        get().~V();
+    }
+
+private:
+    typename std::aligned_storage<sizeof(V), alignof(V)>::type m_storage;
+};
+
+} // namespace detail
+
+// Hash map from strings to V for many concurrent readers and writers.
+//
+// Keys are spread over lock-striped shards; each shard is an open addressing table with linear
+// probing. Writers serialize on the shard mutex and bump a per-shard sequence counter (seqlock).
+// Lookups of values that are trivially copyable and at most 8 bytes are optimistic: they read the
+// table without any store to shared memory and retry only if a writer interfered. Other values
+// are read under the shard mutex. Lookups take a string_view and never allocate.
+//
+// A shard that grows publishes a new table while readers may still be probing the old one, so
+// replaced tables are retired and only released with the map. Key storage of erased entries is
+// recycled for later inserts.
+template<typename V, typename Hash = cppbp::hash<string_view>>
+class concurrent_string_map final
+{
+    // Types
+public:
+    using key_type      = string_view;
+    using mapped_type   = V;
+    using size_type     = std::size_t;
+    using hasher        = Hash;
+
+    static constexpr size_type default_shard_count = 64;
+
+    // Construction and Assignment
+public:
+    explicit concurrent_string_map(size_type shard_count = default_shard_count,
+                                   size_type expected_size = 0,
+                                   const Hash &hash = Hash())
+        : m_hash{hash}
+        , m_shard_count{bit_ceil(shard_count == 0 ? size_type{1} : shard_count)}
+        , m_shard_shift{64 - bit_width(m_shard_count - 1)}
+        , m_shards{new detail::cache_padded<shard>[m_shard_count]}
+    {
+        const size_type per_shard = bit_ceil(expected_size * 2 / m_shard_count + initial_capacity);
+        for(size_type i = 0; i < m_shard_count; ++i) {
+            shard &s = m_shards[i].value;
+            s.tables.emplace_back(new table{per_shard});
+            s.current.store(s.tables.back().get(), std::memory_order_relaxed);
+        }
+    }
+
+    concurrent_string_map(const concurrent_string_map&) = delete;
+    concurrent_string_map& operator=(const concurrent_string_map&) = delete;
+
+    ~concurrent_string_map()
+    {
+        for(size_type i = 0; i < m_shard_count; ++i) {
+            shard &s = m_shards[i].value;
+            destroy_values(*s.current.load(std::memory_order_relaxed));
+        }
+    }
+
+    // Capacity
+public:
+    size_type size() const
+    {
+        size_type result = 0;
+        for(size_type i = 0; i < m_shard_count; ++i) {
+            result += m_shards[i].value.size.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_type shard_count() const noexcept
+    {
+        return m_shard_count;
+    }
+
+    // Lookup
+public:
+    // Copies the value of key to out. Returns false if the key is not present.
+    bool find(string_view key, V &out) const
+    {
+        const std::uint64_t h = hash_of(key);
+        return find(shard_for(h), key, make_tag(h), out, detail::is_optimistic_value<V>{});
+    }
+
+    bool contains(string_view key) const
+    {
+        V value;
+        return find(key, value);
+    }
+
+    // Modifiers
+public:
+    // Inserts key if it is not present. Returns false (and leaves the value alone) otherwise.
+    bool insert(string_view key, const V &value)
+    {
+        return emplace(key, value, false);
+    }
+
+    // Inserts key or overwrites its value. Returns true if the key was inserted.
+    bool insert_or_assign(string_view key, const V &value)
+    {
+        return emplace(key, value, true);
+    }
+
+    // Calls f(V&) on the value of key under the shard lock. Returns false if key is not present.
+    template<typename Function>
+    bool update(string_view key, Function f)
+    {
+        const std::uint64_t h = hash_of(key);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+        table &t = *s.current.load(std::memory_order_relaxed);
+        const size_type index = probe(t, key, make_tag(h));
+        if(index == npos_index) {
+            return false;
+        }
+        V value = t.slots[index].value.load();
+        f(value);
+        write_begin(s);
+        t.slots[index].value.assign(value);
+        write_end(s);
+        return true;
+    }
+
+    bool erase(string_view key)
+    {
+        const std::uint64_t h = hash_of(key);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+        table &t = *s.current.load(std::memory_order_relaxed);
+        const size_type index = probe(t, key, make_tag(h));
+        if(index == npos_index) {
+            return false;
+        }
+        slot &sl = t.slots[index];
+        const char *block = sl.key.load(std::memory_order_relaxed);
+        write_begin(s);
+        sl.tag.store(deleted_tag, std::memory_order_relaxed);
+        sl.value.destroy();
+        write_end(s);
+        s.keys.release(block);
+        s.size.store(s.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void clear()
+    {
+        for(size_type i = 0; i < m_shard_count; ++i) {
+            shard &s = m_shards[i].value;
+            std::lock_guard<std::mutex> lock{s.mutex};
+            table &t = *s.current.load(std::memory_order_relaxed);
+            write_begin(s);
+            for(size_type j = 0; j <= t.mask; ++j) {
+                slot &sl = t.slots[j];
+                if(sl.tag.load(std::memory_order_relaxed) > deleted_tag) {
+                    s.keys.release(sl.key.load(std::memory_order_relaxed));
+                    sl.value.destroy();
+                }
+                sl.tag.store(empty_tag, std::memory_order_relaxed);
+            }
+            write_end(s);
+            s.size.store(0, std::memory_order_relaxed);
+            s.used = 0;
+        }
+    }
+
+    // Calls f(string_view key, const V &value) for every entry, one shard lock at a time.
+    template<typename Function>
+    void for_each(Function f) const
+    {
+        for(size_type i = 0; i < m_shard_count; ++i) {
+            const shard &s = m_shards[i].value;
+            std::lock_guard<std::mutex> lock{s.mutex};
+            const table &t = *s.current.load(std::memory_order_relaxed);
+            for(size_type j = 0; j <= t.mask; ++j) {
+                const slot &sl = t.slots[j];
+                if(sl.tag.load(std::memory_order_relaxed) > deleted_tag) {
+                    f(detail::key_arena::view_of(sl.key.load(std::memory_order_relaxed)), sl.value.load());
+                }
+            }
+        }
+    }
+
+    // Helper
+private:
+    static constexpr std::uint64_t empty_tag = 0;
+    static constexpr std::uint64_t deleted_tag = 1;
+    static constexpr size_type npos_index = static_cast<size_type>(-1);
+    static constexpr size_type initial_capacity = 16;
+    static constexpr int optimistic_attempts = 64;
+
+    struct slot
+    {
+        std::atomic<std::uint64_t>      tag;
+        std::atomic<const char*>        key;
+        detail::map_value_cell<V>       value;
+    };
+
+    struct table
+    {
+        explicit table(size_type capacity)
+            : mask{capacity - 1}
+            , slots{new slot[capacity]()}
+        { }
+
+        size_type                   mask;
+        std::unique_ptr<slot[]>     slots;
+    };
+
+    struct shard
+    {
+        shard()
+            : seq{0}
+            , current{nullptr}
+            , size{0}
+            , used{0}
+        { }
+
+        mutable std::mutex                  mutex;
+        std::atomic<std::uint64_t>          seq;
+        std::atomic<table*>                 current;
+        std::atomic<size_type>              size;
+        size_type                           used;       // live entries plus tombstones
+        std::vector<std::unique_ptr<table>> tables;     // current and retired tables
+        detail::key_arena                   keys;
+    };
+
+    std::uint64_t hash_of(string_view key) const
+    {
+        return static_cast<std::uint64_t>(m_hash(key));
+    }
+
+    static std::uint64_t make_tag(std::uint64_t h) noexcept
+    {
+        return h > deleted_tag ? h : h + 2;
+    }
+
+    shard& shard_for(std::uint64_t h) const noexcept
+    {
+        return m_shards[m_shard_count == 1 ? 0 : static_cast<size_type>(h >> m_shard_shift)].value;
+    }
+
+    static void write_begin(shard &s) noexcept
+    {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    static void write_end(shard &s) noexcept
+    {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Returns the slot index of key or npos_index. The probe is bounded by the table size so
+    // that an optimistic reader racing with a writer always terminates.
+    static size_type probe(const table &t, string_view key, std::uint64_t tag) noexcept
+    {
+        size_type index = static_cast<size_type>(tag) & t.mask;
+        for(size_type step = 0; step <= t.mask; ++step) {
+            const slot &sl = t.slots[index];
+            const std::uint64_t current = sl.tag.load(std::memory_order_relaxed);
+            if(current == empty_tag) {
+                return npos_index;
+            }
+            if(current == tag) {
+                const char *block = sl.key.load(std::memory_order_acquire);
+                if(block && detail::key_arena::view_of(block) == key) {
+                    return index;
+                }
+            }
+            index = (index + 1) & t.mask;
+        }
+        return npos_index;
+    }
+
+    bool find(shard &s, string_view key, std::uint64_t tag, V &out, std::true_type) const
+    {
+        for(int attempt = 0; attempt < optimistic_attempts; ++attempt) {
+            const std::uint64_t before = s.seq.load(std::memory_order_acquire);
+            if(before & 1u) {
+                std::this_thread::yield();
+                continue;
+            }
+            const table &t = *s.current.load(std::memory_order_acquire);
+            const size_type index = probe(t, key, tag);
+            V value{};
+            if(index != npos_index) {
+                value = t.slots[index].value.load();
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(s.seq.load(std::memory_order_relaxed) == before) {
+                if(index == npos_index) {
+                    return false;
+                }
+                out = value;
+                return true;
+            }
+        }
+        // Heavy write traffic on this shard: stop spinning and queue up behind the writers.
+        return find(s, key, tag, out, std::false_type{});
+    }
+
+    bool find(shard &s, string_view key, std::uint64_t tag, V &out, std::false_type) const
+    {
+        std::lock_guard<std::mutex> lock{s.mutex};
+        const table &t = *s.current.load(std::memory_order_relaxed);
+        const size_type index = probe(t, key, tag);
+        if(index == npos_index) {
+            return false;
+        }
+        out = t.slots[index].value.load();
+        return true;
+    }
+
+    bool emplace(string_view key, const V &value, bool assign)
+    {
+        const std::uint64_t h = hash_of(key);
+        const std::uint64_t tag = make_tag(h);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+
+        table *t = s.current.load(std::memory_order_relaxed);
+        size_type index = probe(*t, key, tag);
+        if(index != npos_index) {
+            if(assign) {
+                write_begin(s);
+                t->slots[index].value.assign(value);
+                write_end(s);
+            }
+            return false;
+        }
+
+        if((s.used + 1) * 2 > t->mask + 1) {
+            t = rehash(s);
+        }
+
+        index = static_cast<size_type>(tag) & t->mask;
+        std::uint64_t current;
+        while((current = t->slots[index].tag.load(std::memory_order_relaxed)) > deleted_tag) {
+            index = (index + 1) & t->mask;
+        }
+        const char *block = s.keys.store(key);
+        slot &sl = t->slots[index];
+        write_begin(s);
+        sl.key.store(block, std::memory_order_release);
+        sl.value.construct(value);
+        sl.tag.store(tag, std::memory_order_relaxed);
+        write_end(s);
+
+        if(current == empty_tag) {
+            ++s.used;
+        }
+        s.size.store(s.size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Grows the shard if it is more than a quarter full with live entries, otherwise drops the
+    // tombstones in place.
+    table* rehash(shard &s)
+    {
+        table *old = s.current.load(std::memory_order_relaxed);
+        const size_type live = s.size.load(std::memory_order_relaxed);
+        const size_type capacity = old->mask + 1;
+
+        std::vector<std::pair<std::uint64_t, const char*>> keys;
+        std::vector<V> values;
+        keys.reserve(live);
+        values.reserve(live);
+        for(size_type i = 0; i < capacity; ++i) {
+            slot &sl = old->slots[i];
+            if(sl.tag.load(std::memory_order_relaxed) > deleted_tag) {
+                keys.emplace_back(sl.tag.load(std::memory_order_relaxed), sl.key.load(std::memory_order_relaxed));
+                values.push_back(sl.value.load());
+            }
+        }
+
+        table *target = old;
+        write_begin(s);
+        if(live * 4 >= capacity) {
+            s.tables.emplace_back(new table{capacity * 2});
+            target = s.tables.back().get();
+        }
+        for(size_type i = 0; i < capacity; ++i) {
+            slot &sl = old->slots[i];
+            if(sl.tag.load(std::memory_order_relaxed) > deleted_tag) {
+                sl.value.destroy();
+            }
+            if(target == old) {
+                sl.tag.store(empty_tag, std::memory_order_relaxed);
+            }
+        }
+        for(size_type i = 0; i < keys.size(); ++i) {
+            size_type index = static_cast<size_type>(keys[i].first) & target->mask;
+            while(target->slots[index].tag.load(std::memory_order_relaxed) != empty_tag) {
+                index = (index + 1) & target->mask;
+            }
+            slot &sl = target->slots[index];
+            sl.key.store(keys[i].second, std::memory_order_relaxed);
+            sl.value.construct(values[i]);
+            sl.tag.store(keys[i].first, std::memory_order_relaxed);
+        }
+        s.current.store(target, std::memory_order_release);
+        write_end(s);
+
+        s.used = keys.size();
+        return target;
+    }
+
+    static void destroy_values(table &t) noexcept
+    {
+        for(size_type i = 0; i <= t.mask; ++i) {
+            if(t.slots[i].tag.load(std::memory_order_relaxed) > deleted_tag) {
+                t.slots[i].value.destroy();
+            }
+        }
+    }
+
+    // Private Member
+private:
+    Hash                                                m_hash;
+    size_type                                           m_shard_count;
+    int                                                 m_shard_shift;
+    std::unique_ptr<detail::cache_padded<shard>[]>      m_shards;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_CONCURRENT_STRING_MAP_HPP
@@ -0,0 +1,23 @@
+#ifndef CPPBP_CONFIG_HPP
+#define CPPBP_CONFIG_HPP
+
+// Relaxed constexpr functions (multiple statements, mutation of members) are C++14.
+#if __cplusplus >= 201402L
+#define CPPBP_CONSTEXPR14 constexpr
+#else
+#define CPPBP_CONSTEXPR14 inline
+#endif
+
+// x86 vector extensions used by the SIMD kernels; AVX2 paths additionally check __AVX2__.
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#define CPPBP_HAS_SSE2 1
+#endif
+
+// Signature of the enclosing function as a string literal, template arguments included.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CPPBP_PRETTY_FUNCTION __FUNCSIG__
+#else
+#define CPPBP_PRETTY_FUNCTION __PRETTY_FUNCTION__
+#endif
+
+#endif // CPPBP_CONFIG_HPP
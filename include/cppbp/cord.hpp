@@ -0,0 +1,626 @@
+#ifndef CPPBP_CORD_HPP
+#define CPPBP_CORD_HPP
+
+#include <cppbp/string_search.hpp>  // cppbp::basic_searcher
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view
+
+#include <algorithm>    // std::min, std::max
+#include <cassert>      // assert
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <iterator>     // std::forward_iterator_tag
+#include <memory>       // std::shared_ptr, std::make_shared
+#include <stdexcept>    // std::out_of_range
+#include <string>       // std::basic_string, std::char_traits
+#include <utility>      // std::move
+
+namespace cppbp {
+
+// A cord is an immutable sequence of characters stored as an AVL balanced tree of chunks.
+// Chunks are string views that are either borrowed (the caller keeps the bytes alive) or kept
+// alive by a reference counted owner. Concatenation and substring share all existing chunks and
+// run in O(log n); nothing is ever flattened unless explicitly requested with to_string().
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_cord final
+{
+    // Types
+public:
+    using traits_type   = Traits;
+    using value_type    = CharT;
+    using view_type     = basic_string_view<CharT, Traits>;
+    using string_type   = std::basic_string<CharT, Traits>;
+    using size_type     = std::size_t;
+
+    static constexpr size_type npos = view_type::npos;
+
+private:
+    struct node;
+    using node_ptr = std::shared_ptr<const node>;
+
+    // Leaves have no children. Internal nodes carry no characters.
+    struct node
+    {
+        size_type                   size;
+        int                         height;
+        view_type                   chunk;
+        std::shared_ptr<const void> owner;
+        node_ptr                    left;
+        node_ptr                    right;
+    };
+
+    // An AVL tree over 2^64 characters is never deeper than this.
+    static constexpr int max_height = 96;
+
+public:
+    // Forward iterator over the chunks in order; suitable for building an iovec array.
+    class chunk_iterator final
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = view_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const view_type*;
+        using reference         = const view_type&;
+
+        chunk_iterator() noexcept
+            : m_stack{}
+            , m_right{}
+            , m_depth{0}
+        { }
+
+        reference operator*() const noexcept
+        {
+            return m_stack[m_depth - 1]->chunk;
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &m_stack[m_depth - 1]->chunk;
+        }
+
+        chunk_iterator& operator++() noexcept
+        {
+            // Pop the current leaf and every parent whose right subtree is finished. Subtrees may
+            // be shared, so the way down is recorded rather than recovered from the pointers.
+            --m_depth;
+            while(m_depth > 0 && m_right[m_depth - 1]) {
+                --m_depth;
+            }
+            if(m_depth > 0) {
+                m_right[m_depth - 1] = true;
+                descend(m_stack[m_depth - 1]->right.get());
+            }
+            return *this;
+        }
+
+        chunk_iterator operator++(int) noexcept
+        {
+            chunk_iterator tmp{*this};
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const chunk_iterator &lhs, const chunk_iterator &rhs) noexcept
+        {
+            if(lhs.m_depth != rhs.m_depth) {
+                return false;
+            }
+            if(lhs.m_depth == 0) {
+                return true;
+            }
+            if(lhs.m_stack[0] != rhs.m_stack[0]) {
+                return false;
+            }
+            for(int i = 0; i + 1 < lhs.m_depth; ++i) {
+                if(lhs.m_right[i] != rhs.m_right[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const chunk_iterator &lhs, const chunk_iterator &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class basic_cord;
+
+        explicit chunk_iterator(const node *root) noexcept
+            : m_stack{}
+            , m_right{}
+            , m_depth{0}
+        {
+            if(root) {
+                descend(root);
+            }
+        }
+
+        void descend(const node *n) noexcept
+        {
+            m_stack[m_depth++] = n;
+            while(n->left) {
+                m_right[m_depth - 1] = false;
+                n = n->left.get();
+                m_stack[m_depth++] = n;
+            }
+        }
+
+        const node *m_stack[max_height];
+        bool        m_right[max_height];    // m_stack[i + 1] is the right child of m_stack[i]
+        int         m_depth;
+    };
+
+    class chunk_range final
+    {
+    public:
+        chunk_iterator begin() const noexcept
+        {
+            return chunk_iterator{m_root};
+        }
+
+        chunk_iterator end() const noexcept
+        {
+            return chunk_iterator{};
+        }
+
+    private:
+        friend class basic_cord;
+
+        explicit chunk_range(const node *root) noexcept
+            : m_root{root}
+        { }
+
+        const node *m_root;
+    };
+
+    // Construction and Assignment
+public:
+    basic_cord() noexcept = default;
+
+    // Borrows the characters of view.
+    explicit basic_cord(view_type view)
+        : m_root{make_leaf(view, nullptr)}
+    { }
+
+    // Keeps the characters of view alive through owner.
+    basic_cord(view_type view, std::shared_ptr<const void> owner)
+        : m_root{make_leaf(view, std::move(owner))}
+    { }
+
+    // Takes ownership of str in a reference counted chunk.
+    explicit basic_cord(string_type &&str)
+    {
+        if(!str.empty()) {
+            auto owned = std::make_shared<const string_type>(std::move(str));
+            m_root = make_leaf(view_type{owned->data(), owned->size()}, owned);
+        }
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_root ? m_root->size : 0;
+    }
+
+    size_type length() const noexcept
+    {
+        return size();
+    }
+
+    bool empty() const noexcept
+    {
+        return !m_root;
+    }
+
+    // Element Access
+public:
+    value_type operator[](size_type pos) const noexcept
+    {
+        assert(pos < size());
+        const node *n = m_root.get();
+        while(n->left) {
+            if(pos < n->left->size) {
+                n = n->left.get();
+            } else {
+                pos -= n->left->size;
+                n = n->right.get();
+            }
+        }
+        return n->chunk[pos];
+    }
+
+    value_type at(size_type pos) const
+    {
+        if(pos >= size()) {
+            throw std::out_of_range("basic_cord::at: position out of range");
+        }
+        return (*this)[pos];
+    }
+
+    chunk_range chunks() const noexcept
+    {
+        return chunk_range{m_root.get()};
+    }
+
+    template<typename Function>
+    void for_each_chunk(Function f) const
+    {
+        for(auto chunk : chunks()) {
+            f(chunk);
+        }
+    }
+
+    // Modifiers
+public:
+    basic_cord& append(const basic_cord &other)
+    {
+        m_root = join(m_root, other.m_root);
+        return *this;
+    }
+
+    basic_cord& append(view_type view)
+    {
+        return append(basic_cord{view});
+    }
+
+    basic_cord& append(string_type &&str)
+    {
+        return append(basic_cord{std::move(str)});
+    }
+
+    basic_cord& prepend(const basic_cord &other)
+    {
+        m_root = join(other.m_root, m_root);
+        return *this;
+    }
+
+    basic_cord& operator+=(const basic_cord &other)
+    {
+        return append(other);
+    }
+
+    void clear() noexcept
+    {
+        m_root.reset();
+    }
+
+    void swap(basic_cord &other) noexcept
+    {
+        m_root.swap(other.m_root);
+    }
+
+    // Operations
+public:
+    basic_cord substr(size_type pos = 0, size_type n = npos) const
+    {
+        if(pos > size()) {
+            throw std::out_of_range("basic_cord::substr: position out of range");
+        }
+        basic_cord result;
+        result.m_root = sub(m_root, pos, std::min(n, size() - pos));
+        return result;
+    }
+
+    size_type copy(value_type *dst, size_type n, size_type pos = 0) const
+    {
+        if(pos > size()) {
+            throw std::out_of_range("basic_cord::copy: position out of range");
+        }
+        const size_type rlen = std::min(n, size() - pos);
+        const basic_cord range = substr(pos, rlen);
+        size_type copied = 0;
+        for(auto chunk : range.chunks()) {
+            traits_type::copy(dst + copied, chunk.data(), chunk.size());
+            copied += chunk.size();
+        }
+        return rlen;
+    }
+
+    string_type to_string() const
+    {
+        string_type result;
+        result.reserve(size());
+        for(auto chunk : chunks()) {
+            result.append(chunk.data(), chunk.size());
+        }
+        return result;
+    }
+
+    int compare(const basic_cord &other) const noexcept
+    {
+        return compare_chunks(chunks(), other.chunks(), size(), other.size());
+    }
+
+    int compare(view_type view) const noexcept
+    {
+        return compare_chunks(chunks(), view_range{&view, &view + 1}, size(), view.size());
+    }
+
+    bool starts_with(view_type prefix) const noexcept
+    {
+        return prefix.size() <= size() && matches_at(chunk_iterator{m_root.get()}, 0, prefix);
+    }
+
+    // Searching
+public:
+    size_type find(view_type needle, size_type pos = 0) const noexcept
+    {
+        if(pos > size() || needle.size() > size() - pos) {
+            return npos;
+        }
+        if(needle.empty()) {
+            return pos;
+        }
+
+        const basic_searcher<CharT, Traits> searcher{needle};
+        const size_type m = needle.size();
+        size_type offset = 0;
+        for(auto it = chunks().begin(), last = chunks().end(); it != last; ++it) {
+            const view_type chunk = *it;
+            const size_type chunk_end = offset + chunk.size();
+            if(chunk_end <= pos) {
+                offset = chunk_end;
+                continue;
+            }
+            const size_type local = pos > offset ? pos - offset : 0;
+
+            // Matches that lie completely inside this chunk come first.
+            const size_type hit = searcher.search(chunk, local);
+            if(hit != npos) {
+                return offset + hit;
+            }
+
+            // Then candidates that start in the last m - 1 characters and continue in later chunks.
+            size_type candidate = std::max(local, chunk.size() >= m ? chunk.size() - m + 1 : 0);
+            while(candidate < chunk.size()) {
+                const CharT *first = traits_type::find(chunk.data() + candidate, chunk.size() - candidate,
+                                                       needle[0]);
+                if(!first) {
+                    break;
+                }
+                candidate = static_cast<size_type>(first - chunk.data());
+                if(offset + candidate + m > size()) {
+                    return npos;
+                }
+                if(matches_at(it, candidate, needle)) {
+                    return offset + candidate;
+                }
+                ++candidate;
+            }
+            offset = chunk_end;
+        }
+        return npos;
+    }
+
+    size_type find(value_type ch, size_type pos = 0) const noexcept
+    {
+        return find(view_type{&ch, 1}, pos);
+    }
+
+    bool contains(view_type needle) const noexcept
+    {
+        return find(needle) != npos;
+    }
+
+    // Helper
+private:
+    struct view_range
+    {
+        const view_type *first;
+        const view_type *last;
+
+        const view_type* begin() const noexcept
+        {
+            return first;
+        }
+
+        const view_type* end() const noexcept
+        {
+            return last;
+        }
+    };
+
+    static int height(const node_ptr &n) noexcept
+    {
+        return n ? n->height : -1;
+    }
+
+    static node_ptr make_leaf(view_type view, std::shared_ptr<const void> owner)
+    {
+        if(view.empty()) {
+            return nullptr;
+        }
+        return std::make_shared<const node>(node{view.size(), 0, view, std::move(owner), nullptr, nullptr});
+    }
+
+    static node_ptr make_node(node_ptr left, node_ptr right)
+    {
+        const size_type size = left->size + right->size;
+        const int h = std::max(left->height, right->height) + 1;
+        return std::make_shared<const node>(node{size, h, view_type{}, nullptr, std::move(left), std::move(right)});
+    }
+
+    // Joins two subtrees whose heights differ by at most two.
+    static node_ptr balance(const node_ptr &a, const node_ptr &b)
+    {
+        if(height(b) > height(a) + 1) {
+            if(height(b->left) > height(b->right)) {
+                return make_node(make_node(a, b->left->left), make_node(b->left->right, b->right));
+            }
+            return make_node(make_node(a, b->left), b->right);
+        }
+        if(height(a) > height(b) + 1) {
+            if(height(a->right) > height(a->left)) {
+                return make_node(make_node(a->left, a->right->left), make_node(a->right->right, b));
+            }
+            return make_node(a->left, make_node(a->right, b));
+        }
+        return make_node(a, b);
+    }
+
+    // AVL join: O(|height(l) - height(r)|).
+    static node_ptr join(const node_ptr &l, const node_ptr &r)
+    {
+        if(!l) {
+            return r;
+        }
+        if(!r) {
+            return l;
+        }
+        if(l->height > r->height + 1) {
+            return balance(l->left, join(l->right, r));
+        }
+        if(r->height > l->height + 1) {
+            return balance(join(l, r->left), r->right);
+        }
+        return make_node(l, r);
+    }
+
+    static node_ptr sub(const node_ptr &n, size_type pos, size_type count)
+    {
+        if(count == 0) {
+            return nullptr;
+        }
+        if(pos == 0 && count == n->size) {
+            return n;
+        }
+        if(!n->left) {
+            return make_leaf(n->chunk.substr(pos, count), n->owner);
+        }
+        const size_type left_size = n->left->size;
+        if(pos + count <= left_size) {
+            return sub(n->left, pos, count);
+        }
+        if(pos >= left_size) {
+            return sub(n->right, pos - left_size, count);
+        }
+        return join(sub(n->left, pos, left_size - pos), sub(n->right, 0, count - (left_size - pos)));
+    }
+
+    // Compares needle against the characters starting at offset in *it and the following chunks.
+    static bool matches_at(chunk_iterator it, size_type offset, view_type needle) noexcept
+    {
+        const chunk_iterator last{};
+        while(!needle.empty() && it != last) {
+            const view_type chunk = it->substr(offset);
+            const size_type n = std::min(chunk.size(), needle.size());
+            if(traits_type::compare(chunk.data(), needle.data(), n) != 0) {
+                return false;
+            }
+            needle.remove_prefix(n);
+            offset = 0;
+            ++it;
+        }
+        return needle.empty();
+    }
+
+    template<typename LhsRange, typename RhsRange>
+    static int compare_chunks(const LhsRange &lhs, const RhsRange &rhs,
+                              size_type lhs_size, size_type rhs_size) noexcept
+    {
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+        view_type lchunk;
+        view_type rchunk;
+        size_type remaining = std::min(lhs_size, rhs_size);
+        while(remaining > 0) {
+            if(lchunk.empty()) {
+                lchunk = *l++;
+            }
+            if(rchunk.empty()) {
+                rchunk = *r++;
+            }
+            const size_type n = std::min(lchunk.size(), rchunk.size());
+            const int ret = traits_type::compare(lchunk.data(), rchunk.data(), n);
+            if(ret != 0) {
+                return ret;
+            }
+            lchunk.remove_prefix(n);
+            rchunk.remove_prefix(n);
+            remaining -= n;
+        }
+        if(lhs_size < rhs_size) {
+            return -1;
+        }
+        if(lhs_size > rhs_size) {
+            return 1;
+        }
+        return 0;
+    }
+
+    // Private Member
+private:
+    node_ptr m_root;
+};
+
+template<typename CharT, typename Traits>
+constexpr typename basic_cord<CharT, Traits>::size_type basic_cord<CharT, Traits>::npos;
+
+template<typename CharT, typename Traits>
+constexpr int basic_cord<CharT, Traits>::max_height;
+
+// Concatenation
+
+template<typename CharT, typename Traits>
+basic_cord<CharT, Traits> operator+(basic_cord<CharT, Traits> lhs, const basic_cord<CharT, Traits> &rhs)
+{
+    lhs.append(rhs);
+    return lhs;
+}
+
+// Comparison functions
+
+template<typename CharT, typename Traits>
+bool operator==(const basic_cord<CharT, Traits> &lhs, const basic_cord<CharT, Traits> &rhs) noexcept
+{
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template<typename CharT, typename Traits>
+bool operator!=(const basic_cord<CharT, Traits> &lhs, const basic_cord<CharT, Traits> &rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template<typename CharT, typename Traits>
+bool operator<(const basic_cord<CharT, Traits> &lhs, const basic_cord<CharT, Traits> &rhs) noexcept
+{
+    return lhs.compare(rhs) < 0;
+}
+
+template<typename CharT, typename Traits>
+bool operator==(const basic_cord<CharT, Traits> &lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template<typename CharT, typename Traits>
+bool operator!=(const basic_cord<CharT, Traits> &lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+// Inserters
+
+template<typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits> &os, const basic_cord<CharT, Traits> &cord)
+{
+    for(auto chunk : cord.chunks()) {
+        os.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    }
+    return os;
+}
+
+// Type aliases
+
+using cord      = basic_cord<char>;
+using wcord     = basic_cord<wchar_t>;
+using u16cord   = basic_cord<char16_t>;
+using u32cord   = basic_cord<char32_t>;
+
+} // namespace cppbp
+
+#endif // CPPBP_CORD_HPP
@@ -0,0 +1,365 @@
+#ifndef CPPBP_COUNT_MIN_SKETCH_HPP
+#define CPPBP_COUNT_MIN_SKETCH_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_ceil
+#include <cppbp/hash_batch.hpp>     // cppbp::hash_batch
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::hash, cppbp::detail::hash_key
+
+#include <algorithm>    // std::sort
+#include <cmath>        // std::ceil, std::log
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument
+#include <string>       // std::string
+#include <unordered_map> // std::unordered_map
+#include <utility>      // std::move, std::pair, std::swap
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+// Count-Min sketch: approximate frequencies of strings in a stream.
+//
+// depth rows of width counters each; a key increments one counter per row, picked by double
+// hashing of a single 64 bit hash, and its estimate is the minimum over the rows. Estimates never
+// undercount and overcount by at most epsilon * total() with probability 1 - delta when sized by
+// for_error(). Counters are 32 bit and saturate.
+class count_min_sketch final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+    using counter_type  = std::uint32_t;
+
+    // Construction and Assignment
+public:
+    count_min_sketch(size_type width, size_type depth, std::uint64_t seed = detail::default_hash_seed)
+        : m_width{bit_ceil(width == 0 ? size_type{1} : width)}
+        , m_depth{depth}
+        , m_seed{seed}
+        , m_total{0}
+        , m_counters(m_width * depth)
+    {
+        if(depth == 0) {
+            throw std::invalid_argument("count_min_sketch: depth must not be zero");
+        }
+    }
+
+    // A sketch whose error is at most epsilon * total() with probability 1 - delta.
+    static count_min_sketch for_error(double epsilon, double delta)
+    {
+        if(!(epsilon > 0.0 && epsilon < 1.0) || !(delta > 0.0 && delta < 1.0)) {
+            throw std::invalid_argument("count_min_sketch: epsilon and delta must be in (0, 1)");
+        }
+        const double e = 2.718281828459045;
+        return count_min_sketch{static_cast<size_type>(std::ceil(e / epsilon)),
+                                static_cast<size_type>(std::ceil(std::log(1.0 / delta)))};
+    }
+
+    // Observers
+public:
+    size_type width() const noexcept
+    {
+        return m_width;
+    }
+
+    size_type depth() const noexcept
+    {
+        return m_depth;
+    }
+
+    // Sum of all counts added.
+    std::uint64_t total() const noexcept
+    {
+        return m_total;
+    }
+
+    std::uint64_t seed() const noexcept
+    {
+        return m_seed;
+    }
+
+    template<typename CharT, typename Traits>
+    std::uint64_t hash(basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return detail::hash_key(key, m_seed);
+    }
+
+    // Lookup
+public:
+    template<typename CharT, typename Traits>
+    counter_type estimate(basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return estimate_hash(hash(key));
+    }
+
+    counter_type estimate_hash(std::uint64_t h) const noexcept
+    {
+        counter_type result = std::numeric_limits<counter_type>::max();
+        std::uint64_t index = h;
+        const std::uint64_t step = second_hash(h);
+        for(size_type row = 0; row < m_depth; ++row) {
+            const counter_type c = m_counters[row * m_width + (index & (m_width - 1))];
+            result = c < result ? c : result;
+            index += step;
+        }
+        return result;
+    }
+
+    // Modifiers
+public:
+    template<typename CharT, typename Traits>
+    void add(basic_string_view<CharT, Traits> key, counter_type count = 1)
+    {
+        add_hash(hash(key), count);
+    }
+
+    void add_hash(std::uint64_t h, counter_type count = 1) noexcept
+    {
+        std::uint64_t index = h;
+        const std::uint64_t step = second_hash(h);
+        for(size_type row = 0; row < m_depth; ++row) {
+            counter_type &c = m_counters[row * m_width + (index & (m_width - 1))];
+            c = c > std::numeric_limits<counter_type>::max() - count ? std::numeric_limits<counter_type>::max() : c + count;
+            index += step;
+        }
+        m_total += count;
+    }
+
+    // Hashes up to batch_size keys at a time with hash_batch(), which prepares the seed once per
+    // batch, before updating the counters.
+    void add_batch(span<const string_view> keys)
+    {
+        std::uint64_t hashes[batch_size];
+        size_type i = 0;
+        while(i < keys.size()) {
+            const size_type n = keys.size() - i < batch_size ? keys.size() - i : batch_size;
+            hash_batch(keys.subspan(i, n), span<std::uint64_t>{hashes, n}, m_seed);
+            for(size_type j = 0; j < n; ++j) {
+                add_hash(hashes[j]);
+            }
+            i += n;
+        }
+    }
+
+    // Adds the counts of other, which needs the same dimensions and seed.
+    void merge(const count_min_sketch &other)
+    {
+        if(other.m_width != m_width || other.m_depth != m_depth || other.m_seed != m_seed) {
+            throw std::invalid_argument("count_min_sketch::merge: dimensions or seed differ");
+        }
+        for(size_type i = 0; i < m_counters.size(); ++i) {
+            const counter_type add = other.m_counters[i];
+            counter_type &c = m_counters[i];
+            c = c > std::numeric_limits<counter_type>::max() - add ? std::numeric_limits<counter_type>::max() : c + add;
+        }
+        m_total += other.m_total;
+    }
+
+    void clear() noexcept
+    {
+        for(auto &c : m_counters) {
+            c = 0;
+        }
+        m_total = 0;
+    }
+
+    // Helper
+private:
+    static constexpr size_type batch_size = 16;
+
+    static std::uint64_t second_hash(std::uint64_t h) noexcept
+    {
+        return ((h >> 32) | (h << 32)) * 0x9e3779b97f4a7c15ull | 1u;
+    }
+
+    // Private Member
+private:
+    size_type                   m_width;
+    size_type                   m_depth;
+    std::uint64_t               m_seed;
+    std::uint64_t               m_total;
+    std::vector<counter_type>   m_counters;
+};
+
+// Tracks the k most frequent strings of a stream with a Count-Min sketch.
+//
+// Every key is counted in the sketch; a key whose estimate beats the smallest tracked count
+// replaces it. Candidates are kept in a min-heap and found through a map of string_views into
+// their own storage, so counting a key that is already tracked does not allocate.
+class heavy_hitters final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+    using counter_type  = count_min_sketch::counter_type;
+    using value_type    = std::pair<std::string, counter_type>;
+
+    // Construction and Assignment
+public:
+    heavy_hitters(size_type k, count_min_sketch sketch)
+        : m_k{k}
+        , m_sketch(std::move(sketch))
+    {
+        if(k == 0) {
+            throw std::invalid_argument("heavy_hitters: k must not be zero");
+        }
+        // The views in m_index point into the entries; they must never be reallocated.
+        m_entries.reserve(k);
+        m_heap.reserve(k);
+    }
+
+    heavy_hitters(size_type k, size_type width, size_type depth)
+        : heavy_hitters{k, count_min_sketch{width, depth}}
+    { }
+
+    heavy_hitters(const heavy_hitters&) = delete;
+    heavy_hitters& operator=(const heavy_hitters&) = delete;
+
+    // Observers
+public:
+    const count_min_sketch& sketch() const noexcept
+    {
+        return m_sketch;
+    }
+
+    // Tracked keys with their estimated counts, most frequent first.
+    std::vector<value_type> top() const
+    {
+        std::vector<value_type> result;
+        result.reserve(m_entries.size());
+        for(const auto &e : m_entries) {
+            result.emplace_back(e.key, e.count);
+        }
+        std::sort(result.begin(), result.end(), [](const value_type &a, const value_type &b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return result;
+    }
+
+    // Modifiers
+public:
+    void add(string_view key, counter_type count = 1)
+    {
+        add(key, m_sketch.hash(key), count);
+    }
+
+    // Hashes up to batch_size keys at a time with hash_batch(), as count_min_sketch::add_batch()
+    // does; the candidates are then updated key by key.
+    void add_batch(span<const string_view> keys)
+    {
+        std::uint64_t hashes[batch_size];
+        size_type i = 0;
+        while(i < keys.size()) {
+            const size_type n = keys.size() - i < batch_size ? keys.size() - i : batch_size;
+            hash_batch(keys.subspan(i, n), span<std::uint64_t>{hashes, n}, m_sketch.seed());
+            for(size_type j = 0; j < n; ++j) {
+                add(keys[i + j], hashes[j], 1);
+            }
+            i += n;
+        }
+    }
+
+    // Helper
+private:
+    static constexpr size_type batch_size = 16;
+
+    struct entry
+    {
+        std::string     key;
+        counter_type    count;
+        size_type       heap_index;
+    };
+
+    void add(string_view key, std::uint64_t h, counter_type count)
+    {
+        m_sketch.add_hash(h, count);
+        const counter_type estimate = m_sketch.estimate_hash(h);
+
+        const auto it = m_index.find(key);
+        if(it != m_index.end()) {
+            entry &e = m_entries[it->second];
+            e.count = estimate;
+            sift_down(e.heap_index);
+            return;
+        }
+
+        if(m_entries.size() < m_k) {
+            m_entries.push_back(entry{std::string(key.data(), key.size()), estimate, m_heap.size()});
+            const size_type index = m_entries.size() - 1;
+            m_index.emplace(view_of(m_entries[index]), index);
+            m_heap.push_back(index);
+            sift_up(m_heap.size() - 1);
+            return;
+        }
+
+        const size_type smallest = m_heap.front();
+        entry &e = m_entries[smallest];
+        if(estimate <= e.count) {
+            return;
+        }
+        m_index.erase(view_of(e));
+        e.key.assign(key.data(), key.size());
+        e.count = estimate;
+        m_index.emplace(view_of(e), smallest);
+        sift_down(0);
+    }
+
+    static string_view view_of(const entry &e) noexcept
+    {
+        return string_view{e.key.data(), e.key.size()};
+    }
+
+    bool less(size_type a, size_type b) const noexcept
+    {
+        return m_entries[m_heap[a]].count < m_entries[m_heap[b]].count;
+    }
+
+    void swap_heap(size_type a, size_type b) noexcept
+    {
+        std::swap(m_heap[a], m_heap[b]);
+        m_entries[m_heap[a]].heap_index = a;
+        m_entries[m_heap[b]].heap_index = b;
+    }
+
+    void sift_up(size_type i) noexcept
+    {
+        while(i > 0 && less(i, (i - 1) / 2)) {
+            swap_heap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void sift_down(size_type i) noexcept
+    {
+        for(;;) {
+            const size_type left = 2 * i + 1;
+            const size_type right = left + 1;
+            size_type smallest = i;
+            if(left < m_heap.size() && less(left, smallest)) {
+                smallest = left;
+            }
+            if(right < m_heap.size() && less(right, smallest)) {
+                smallest = right;
+            }
+            if(smallest == i) {
+                return;
+            }
+            swap_heap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    // Private Member
+private:
+    size_type                                                       m_k;
+    count_min_sketch                                                m_sketch;
+    std::vector<entry>                                              m_entries;
+    std::vector<size_type>                                          m_heap;
+    std::unordered_map<string_view, size_type, hash<string_view>>   m_index;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_COUNT_MIN_SKETCH_HPP
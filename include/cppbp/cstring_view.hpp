@@ -0,0 +1,238 @@
+#ifndef CPPBP_CSTRING_VIEW_HPP
+#define CPPBP_CSTRING_VIEW_HPP
+
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view
+
+#include <cassert>      // assert
+#include <cstddef>      // std::size_t
+#include <iostream>     // std::basic_ostream
+#include <stdexcept>    // std::out_of_range
+#include <string>       // std::basic_string, std::char_traits
+#include <utility>      // std::forward
+
+namespace cppbp {
+
+namespace detail {
+
+template<typename CharT>
+struct null_terminator
+{
+    static constexpr CharT value[1] = {CharT()};
+};
+
+template<typename CharT>
+constexpr CharT null_terminator<CharT>::value[1];
+
+// Views shorter than this are terminated in a stack buffer by with_cstr().
+constexpr std::size_t with_cstr_buffer = 256;
+
+} // namespace detail
+
+// View of a null terminated string (P1402 cstring_view). It can only be created from sources
+// that are known to be terminated: C strings, std::basic_string and other cstring_views. So
+// c_str() can be passed to a C API as is, where a basic_string_view would need a copy.
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_cstring_view final
+{
+    // Types
+public:
+    using traits_type       = Traits;
+    using value_type        = CharT;
+    using const_pointer     = const value_type*;
+    using const_reference   = const value_type&;
+    using const_iterator    = const value_type*;
+    using iterator          = const_iterator;
+    using size_type         = std::size_t;
+    using view_type         = basic_string_view<CharT, Traits>;
+
+    // Construction and Assignment
+public:
+    constexpr basic_cstring_view() noexcept
+        : m_str{detail::null_terminator<CharT>::value}
+        , m_size{0u}
+    { }
+
+    constexpr basic_cstring_view(const_pointer str)
+        : m_str{str}
+        , m_size{traits_type::length(str)}
+    { }
+
+    // str[count] must be the terminating null.
+    basic_cstring_view(const_pointer str, size_type count)
+        : m_str{str}
+        , m_size{count}
+    {
+        assert(traits_type::eq(str[count], CharT()));
+    }
+
+    template<typename Allocator>
+    basic_cstring_view(const std::basic_string<CharT, Traits, Allocator> &str) noexcept
+        : m_str{str.c_str()}
+        , m_size{str.size()}
+    { }
+
+    basic_cstring_view(std::nullptr_t) = delete;
+
+    // Iterators
+public:
+    constexpr const_iterator begin() const noexcept
+    {
+        return m_str;
+    }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return m_str + m_size;
+    }
+
+    // Capacity
+public:
+    constexpr size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr size_type length() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    // Element Access
+public:
+    CPPBP_CONSTEXPR14 const_reference operator[](size_type pos) const noexcept
+    {
+        assert(pos <= m_size);
+        return m_str[pos];
+    }
+
+    CPPBP_CONSTEXPR14 const_reference at(size_type pos) const
+    {
+        if(pos >= m_size) {
+            throw std::out_of_range("basic_cstring_view::at: position out of range");
+        }
+        return m_str[pos];
+    }
+
+    // Always followed by a null character.
+    constexpr const_pointer c_str() const noexcept
+    {
+        return m_str;
+    }
+
+    constexpr const_pointer data() const noexcept
+    {
+        return m_str;
+    }
+
+    constexpr view_type view() const noexcept
+    {
+        return view_type{m_str, m_size};
+    }
+
+    constexpr operator view_type() const noexcept
+    {
+        return view_type{m_str, m_size};
+    }
+
+    // Modifiers
+public:
+    // Only the front can be removed; the end has to stay at the terminator.
+    CPPBP_CONSTEXPR14 void remove_prefix(size_type n)
+    {
+        assert(n <= m_size);
+        m_str += n;
+        m_size -= n;
+    }
+
+    CPPBP_CONSTEXPR14 void swap(basic_cstring_view &other) noexcept
+    {
+        const basic_cstring_view tmp{*this};
+        *this = other;
+        other = tmp;
+    }
+
+    // Operations
+public:
+    // The suffix starting at pos, which is still terminated.
+    CPPBP_CONSTEXPR14 basic_cstring_view substr(size_type pos) const
+    {
+        if(pos > m_size) {
+            throw std::out_of_range("basic_cstring_view::substr: position out of range");
+        }
+        basic_cstring_view result{*this};
+        result.remove_prefix(pos);
+        return result;
+    }
+
+    // Comparison functions are hidden friends, so C strings and std::strings convert on either
+    // side.
+    friend CPPBP_CONSTEXPR14 bool operator==(basic_cstring_view lhs, basic_cstring_view rhs) noexcept
+    {
+        return lhs.view() == rhs.view();
+    }
+
+    friend CPPBP_CONSTEXPR14 bool operator!=(basic_cstring_view lhs, basic_cstring_view rhs) noexcept
+    {
+        return lhs.view() != rhs.view();
+    }
+
+    friend CPPBP_CONSTEXPR14 bool operator<(basic_cstring_view lhs, basic_cstring_view rhs) noexcept
+    {
+        return lhs.view() < rhs.view();
+    }
+
+    // Private Member
+private:
+    const_pointer   m_str;
+    size_type       m_size;
+};
+
+// Inserters
+
+template<typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits> &os, basic_cstring_view<CharT, Traits> str)
+{
+    return os << str.view();
+}
+
+// Calls fn with a null terminated copy of view and returns its result. Views shorter than
+// detail::with_cstr_buffer characters are copied to the stack; longer ones to a temporary
+// std::basic_string. The cstring_view passed to fn is only valid during the call.
+template<typename CharT, typename Traits, typename Function>
+auto with_cstr(basic_string_view<CharT, Traits> view, Function &&fn)
+    -> decltype(std::forward<Function>(fn)(basic_cstring_view<CharT, Traits>{}))
+{
+    if(view.size() < detail::with_cstr_buffer) {
+        CharT buffer[detail::with_cstr_buffer];
+        Traits::copy(buffer, view.data(), view.size());
+        buffer[view.size()] = CharT();
+        return std::forward<Function>(fn)(basic_cstring_view<CharT, Traits>{buffer, view.size()});
+    }
+    const std::basic_string<CharT, Traits> copy{view.data(), view.size()};
+    return std::forward<Function>(fn)(basic_cstring_view<CharT, Traits>{copy});
+}
+
+// Already terminated: no copy.
+template<typename CharT, typename Traits, typename Function>
+auto with_cstr(basic_cstring_view<CharT, Traits> str, Function &&fn)
+    -> decltype(std::forward<Function>(fn)(str))
+{
+    return std::forward<Function>(fn)(str);
+}
+
+// Type aliases
+
+using cstring_view      = basic_cstring_view<char>;
+using u16cstring_view   = basic_cstring_view<char16_t>;
+using u32cstring_view   = basic_cstring_view<char32_t>;
+using wcstring_view     = basic_cstring_view<wchar_t>;
+
+} // namespace cppbp
+
+#endif // CPPBP_CSTRING_VIEW_HPP
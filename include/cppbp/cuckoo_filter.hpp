@@ -0,0 +1,441 @@
+#ifndef CPPBP_CUCKOO_FILTER_HPP
+#define CPPBP_CUCKOO_FILTER_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_ceil
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view, cppbp::detail::hash_key
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint16_t, std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy, std::memcmp, std::memset
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::logic_error
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+// Cuckoo filter for string keys with 16 bit fingerprints and buckets of four slots.
+//
+// Unlike a Bloom filter it supports erase(). A key hashes once; the low bits pick its first
+// bucket, the high bits its fingerprint, and the second bucket is the first xor a hash of the
+// fingerprint. A bucket is one 64 bit word that is searched for the fingerprint with a single
+// SWAR comparison. The false positive rate is about 8 / 65536 at any load. Serialization
+// works as for bloom_filter.
+class cuckoo_filter final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type slots_per_bucket = 4;
+    static constexpr int max_kicks = 500;
+
+    // Construction and Assignment
+public:
+    // A filter able to hold about capacity keys (at a load factor of 95%).
+    explicit cuckoo_filter(size_type capacity, std::uint64_t seed = detail::default_hash_seed)
+        : cuckoo_filter{bucket_count_for(capacity), seed, 0}
+    { }
+
+    static cuckoo_filter deserialize(span<const unsigned char> bytes)
+    {
+        cuckoo_filter result{read_header(bytes)};
+        std::memcpy(result.m_storage.data(), bytes.data() + header_size, result.data_size());
+        return result;
+    }
+
+    // Uses the buckets of a buffer written by serialize() in place. The buffer must stay valid
+    // and be 8 byte aligned; the resulting filter is read only.
+    static cuckoo_filter borrow(span<const unsigned char> bytes)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(std::uint64_t) != 0) {
+            throw std::invalid_argument("cuckoo_filter::borrow: buffer is not 8 byte aligned");
+        }
+        return cuckoo_filter{read_header(bytes), reinterpret_cast<const std::uint64_t*>(bytes.data() + header_size)};
+    }
+
+    cuckoo_filter(cuckoo_filter &&other) noexcept
+        : m_mask{other.m_mask}
+        , m_seed{other.m_seed}
+        , m_size{other.m_size}
+        , m_victim{other.m_victim}
+        , m_kick_state{other.m_kick_state}
+        , m_storage(std::move(other.m_storage))
+        , m_buckets{other.m_borrowed ? other.m_buckets : m_storage.data()}
+        , m_borrowed{other.m_borrowed}
+    { }
+
+    cuckoo_filter(const cuckoo_filter &other)
+        : m_mask{other.m_mask}
+        , m_seed{other.m_seed}
+        , m_size{other.m_size}
+        , m_victim{other.m_victim}
+        , m_kick_state{other.m_kick_state}
+        , m_storage(other.m_storage)
+        , m_buckets{other.m_borrowed ? other.m_buckets : m_storage.data()}
+        , m_borrowed{other.m_borrowed}
+    { }
+
+    cuckoo_filter& operator=(cuckoo_filter other) noexcept
+    {
+        m_mask = other.m_mask;
+        m_seed = other.m_seed;
+        m_size = other.m_size;
+        m_victim = other.m_victim;
+        m_kick_state = other.m_kick_state;
+        m_storage.swap(other.m_storage);
+        m_buckets = other.m_borrowed ? other.m_buckets : m_storage.data();
+        m_borrowed = other.m_borrowed;
+        return *this;
+    }
+
+    // Sizing
+public:
+    // Expected false positive rate: two buckets of four 16 bit fingerprints are compared.
+    static double false_positive_rate() noexcept
+    {
+        return 8.0 / 65536.0;
+    }
+
+    // Observers
+public:
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return bucket_count() * slots_per_bucket;
+    }
+
+    size_type bucket_count() const noexcept
+    {
+        return static_cast<size_type>(m_mask) + 1;
+    }
+
+    double load_factor() const noexcept
+    {
+        return static_cast<double>(m_size) / static_cast<double>(capacity());
+    }
+
+    bool borrowed() const noexcept
+    {
+        return m_borrowed;
+    }
+
+    template<typename CharT, typename Traits>
+    std::uint64_t hash(basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return detail::hash_key(key, m_seed);
+    }
+
+    // Lookup
+public:
+    template<typename CharT, typename Traits>
+    bool contains(basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return contains_hash(hash(key));
+    }
+
+    bool contains_hash(std::uint64_t h) const noexcept
+    {
+        const std::uint16_t fp = fingerprint(h);
+        const std::uint64_t i1 = h & m_mask;
+        const std::uint64_t i2 = alternate(i1, fp);
+        if(bucket_has(m_buckets[i1], fp) || bucket_has(m_buckets[i2], fp)) {
+            return true;
+        }
+        return m_victim.fingerprint == fp && (m_victim.index == i1 || m_victim.index == i2);
+    }
+
+    // Modifiers
+public:
+    // Returns false, without storing the key, once the filter is full: an earlier insert that ran
+    // out of kicks parks its fingerprint in a victim slot, and inserts fail until an erase.
+    template<typename CharT, typename Traits>
+    bool insert(basic_string_view<CharT, Traits> key)
+    {
+        return insert_hash(hash(key));
+    }
+
+    bool insert_hash(std::uint64_t h)
+    {
+        check_writable();
+        if(m_victim.fingerprint != 0) {
+            return false;
+        }
+        const std::uint16_t fp = fingerprint(h);
+        const std::uint64_t i1 = h & m_mask;
+        const std::uint64_t i2 = alternate(i1, fp);
+        ++m_size;
+        if(try_place(i1, fp) || try_place(i2, fp)) {
+            return true;
+        }
+
+        std::uint64_t index = next_random() & 1 ? i1 : i2;
+        std::uint16_t current = fp;
+        for(int kick = 0; kick < max_kicks; ++kick) {
+            const unsigned slot = static_cast<unsigned>(next_random() % slots_per_bucket);
+            const std::uint16_t evicted = get_slot(m_buckets[index], slot);
+            set_slot(m_buckets[index], slot, current);
+            current = evicted;
+            index = alternate(index, current);
+            if(try_place(index, current)) {
+                return true;
+            }
+        }
+        m_victim.index = index;
+        m_victim.fingerprint = current;
+        return true;
+    }
+
+    // Removes one copy of the key's fingerprint. Erasing a key that was never inserted can
+    // remove a different key with the same fingerprint and buckets.
+    template<typename CharT, typename Traits>
+    bool erase(basic_string_view<CharT, Traits> key)
+    {
+        return erase_hash(hash(key));
+    }
+
+    bool erase_hash(std::uint64_t h)
+    {
+        check_writable();
+        const std::uint16_t fp = fingerprint(h);
+        const std::uint64_t i1 = h & m_mask;
+        const std::uint64_t i2 = alternate(i1, fp);
+        if(remove_from(i1, fp) || remove_from(i2, fp)) {
+            --m_size;
+            if(m_victim.fingerprint != 0 && (try_place(m_victim.index, m_victim.fingerprint)
+               || try_place(alternate(m_victim.index, m_victim.fingerprint), m_victim.fingerprint))) {
+                m_victim = victim{};
+            }
+            return true;
+        }
+        if(m_victim.fingerprint == fp && (m_victim.index == i1 || m_victim.index == i2)) {
+            m_victim = victim{};
+            --m_size;
+            return true;
+        }
+        return false;
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const noexcept
+    {
+        return header_size + data_size();
+    }
+
+    void serialize(span<unsigned char> out) const
+    {
+        if(out.size() < serialized_size()) {
+            throw std::length_error("cuckoo_filter::serialize: buffer too small");
+        }
+        const std::uint32_t version = format_version;
+        const std::uint32_t victim_fp = m_victim.fingerprint;
+        const std::uint64_t buckets = bucket_count();
+        const std::uint64_t size = m_size;
+        unsigned char *p = out.data();
+        std::memcpy(p, magic(), 4);
+        std::memcpy(p + 4, &version, 4);
+        std::memcpy(p + 8, &victim_fp, 4);
+        std::memset(p + 12, 0, 4);
+        std::memcpy(p + 16, &buckets, 8);
+        std::memcpy(p + 24, &m_seed, 8);
+        std::memcpy(p + 32, &size, 8);
+        std::memcpy(p + 40, &m_victim.index, 8);
+        std::memcpy(p + header_size, m_buckets, data_size());
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> result(serialized_size());
+        serialize(span<unsigned char>{result.data(), result.size()});
+        return result;
+    }
+
+    // Helper
+private:
+    static constexpr size_type header_size = 48;
+    static constexpr std::uint32_t format_version = 1;
+
+    struct victim
+    {
+        std::uint64_t index = 0;
+        std::uint16_t fingerprint = 0;
+    };
+
+    struct header
+    {
+        size_type       buckets;
+        std::uint64_t   seed;
+        size_type       size;
+        victim          spilled;
+    };
+
+    cuckoo_filter(size_type buckets, std::uint64_t seed, int)
+        : m_mask{static_cast<std::uint64_t>(buckets - 1)}
+        , m_seed{seed}
+        , m_size{0}
+        , m_kick_state{seed | 1u}
+        , m_storage(buckets)
+        , m_buckets{m_storage.data()}
+        , m_borrowed{false}
+    { }
+
+    explicit cuckoo_filter(const header &h)
+        : cuckoo_filter{h.buckets, h.seed, 0}
+    {
+        m_size = h.size;
+        m_victim = h.spilled;
+    }
+
+    // A read only filter over buckets owned by the caller; allocates nothing.
+    cuckoo_filter(const header &h, const std::uint64_t *buckets) noexcept
+        : m_mask{static_cast<std::uint64_t>(h.buckets - 1)}
+        , m_seed{h.seed}
+        , m_size{h.size}
+        , m_victim{h.spilled}
+        , m_kick_state{h.seed | 1u}
+        , m_storage()
+        , m_buckets{const_cast<std::uint64_t*>(buckets)}
+        , m_borrowed{true}
+    { }
+
+    static const char* magic() noexcept
+    {
+        return "CCF1";
+    }
+
+    static size_type bucket_count_for(size_type capacity) noexcept
+    {
+        const size_type buckets = (capacity * 100 / 95 + slots_per_bucket - 1) / slots_per_bucket;
+        return bit_ceil(buckets == 0 ? size_type{1} : buckets);
+    }
+
+    static header read_header(span<const unsigned char> bytes)
+    {
+        std::uint32_t version;
+        std::uint32_t victim_fp;
+        std::uint64_t buckets;
+        std::uint64_t seed;
+        std::uint64_t size;
+        std::uint64_t victim_index;
+        if(bytes.size() < header_size || std::memcmp(bytes.data(), magic(), 4) != 0) {
+            throw std::invalid_argument("cuckoo_filter: not a serialized cuckoo filter");
+        }
+        std::memcpy(&version, bytes.data() + 4, 4);
+        std::memcpy(&victim_fp, bytes.data() + 8, 4);
+        std::memcpy(&buckets, bytes.data() + 16, 8);
+        std::memcpy(&seed, bytes.data() + 24, 8);
+        std::memcpy(&size, bytes.data() + 32, 8);
+        std::memcpy(&victim_index, bytes.data() + 40, 8);
+        if(version != format_version || buckets == 0 || (buckets & (buckets - 1)) != 0
+           || victim_index >= buckets || victim_fp > 0xffffu
+           || (bytes.size() - header_size) / sizeof(std::uint64_t) < buckets) {
+            throw std::invalid_argument("cuckoo_filter: corrupt or truncated buffer");
+        }
+        header result;
+        result.buckets = static_cast<size_type>(buckets);
+        result.seed = seed;
+        result.size = static_cast<size_type>(size);
+        result.spilled.index = victim_index;
+        result.spilled.fingerprint = static_cast<std::uint16_t>(victim_fp);
+        return result;
+    }
+
+    size_type data_size() const noexcept
+    {
+        return bucket_count() * sizeof(std::uint64_t);
+    }
+
+    void check_writable() const
+    {
+        if(m_borrowed) {
+            throw std::logic_error("cuckoo_filter: a borrowed filter is read only");
+        }
+    }
+
+    // Fingerprints are never zero; zero marks an empty slot.
+    static std::uint16_t fingerprint(std::uint64_t h) noexcept
+    {
+        const std::uint16_t fp = static_cast<std::uint16_t>(h >> 48);
+        return fp == 0 ? 1 : fp;
+    }
+
+    std::uint64_t alternate(std::uint64_t index, std::uint16_t fp) const noexcept
+    {
+        return (index ^ (static_cast<std::uint64_t>(fp) * 0xc6a4a7935bd1e995ull)) & m_mask;
+    }
+
+    // Whether any of the four 16 bit lanes of bucket equals fp.
+    static bool bucket_has(std::uint64_t bucket, std::uint16_t fp) noexcept
+    {
+        const std::uint64_t lanes = 0x0001000100010001ull;
+        const std::uint64_t x = bucket ^ (lanes * fp);
+        return ((x - lanes) & ~x & (lanes << 15)) != 0;
+    }
+
+    static std::uint16_t get_slot(std::uint64_t bucket, unsigned slot) noexcept
+    {
+        return static_cast<std::uint16_t>(bucket >> (slot * 16));
+    }
+
+    static void set_slot(std::uint64_t &bucket, unsigned slot, std::uint16_t fp) noexcept
+    {
+        bucket = (bucket & ~(std::uint64_t{0xffff} << (slot * 16))) | (static_cast<std::uint64_t>(fp) << (slot * 16));
+    }
+
+    bool try_place(std::uint64_t index, std::uint16_t fp) noexcept
+    {
+        std::uint64_t &bucket = m_buckets[index];
+        for(unsigned slot = 0; slot < slots_per_bucket; ++slot) {
+            if(get_slot(bucket, slot) == 0) {
+                set_slot(bucket, slot, fp);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool remove_from(std::uint64_t index, std::uint16_t fp) noexcept
+    {
+        std::uint64_t &bucket = m_buckets[index];
+        for(unsigned slot = 0; slot < slots_per_bucket; ++slot) {
+            if(get_slot(bucket, slot) == fp) {
+                set_slot(bucket, slot, 0);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::uint64_t next_random() noexcept
+    {
+        m_kick_state ^= m_kick_state << 13;
+        m_kick_state ^= m_kick_state >> 7;
+        m_kick_state ^= m_kick_state << 17;
+        return m_kick_state;
+    }
+
+    // Private Member
+private:
+    std::uint64_t               m_mask;
+    std::uint64_t               m_seed;
+    size_type                   m_size;
+    victim                      m_victim;
+    std::uint64_t               m_kick_state;
+    std::vector<std::uint64_t>  m_storage;
+    std::uint64_t              *m_buckets;
+    bool                        m_borrowed;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_CUCKOO_FILTER_HPP
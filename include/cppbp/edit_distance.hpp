@@ -0,0 +1,322 @@
+#ifndef CPPBP_EDIT_DISTANCE_HPP
+#define CPPBP_EDIT_DISTANCE_HPP
+
+#include <cppbp/string_search.hpp>  // cppbp::detail::is_byte_char
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view
+
+#include <algorithm>    // std::min
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <string>       // std::char_traits
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+// Patterns (the shorter of both strings) up to this many 64-character blocks are processed
+// entirely on the stack. Longer patterns fall back to a heap allocated block table.
+constexpr std::size_t edit_distance_inline_blocks = 8;
+
+namespace detail {
+
+// Match masks of one 64-character pattern block: bit i of peq[c] is set if pattern[i] == c.
+
+template<typename CharT, bool IsByte>
+class peq_block;
+
+template<typename CharT>
+class peq_block<CharT, true> final
+{
+public:
+    void clear() noexcept
+    {
+        for(auto &mask : m_masks) {
+            mask = 0;
+        }
+    }
+
+    void add(CharT c, std::uint64_t bit) noexcept
+    {
+        m_masks[static_cast<unsigned char>(c)] |= bit;
+    }
+
+    std::uint64_t operator[](CharT c) const noexcept
+    {
+        return m_masks[static_cast<unsigned char>(c)];
+    }
+
+private:
+    std::uint64_t m_masks[256];
+};
+
+// Wide characters: open addressing over at most 64 distinct characters.
+template<typename CharT>
+class peq_block<CharT, false> final
+{
+public:
+    void clear() noexcept
+    {
+        for(auto &mask : m_masks) {
+            mask = 0;
+        }
+    }
+
+    void add(CharT c, std::uint64_t bit) noexcept
+    {
+        std::size_t i = slot(c);
+        while(m_masks[i] != 0 && m_keys[i] != c) {
+            i = (i + 1) % slots;
+        }
+        m_keys[i] = c;
+        m_masks[i] |= bit;
+    }
+
+    std::uint64_t operator[](CharT c) const noexcept
+    {
+        std::size_t i = slot(c);
+        while(m_masks[i] != 0) {
+            if(m_keys[i] == c) {
+                return m_masks[i];
+            }
+            i = (i + 1) % slots;
+        }
+        return 0;
+    }
+
+private:
+    static constexpr std::size_t slots = 128;
+
+    static std::size_t slot(CharT c) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(c) * 0x9e3779b97f4a7c15ull >> 57);
+    }
+
+    CharT           m_keys[slots];
+    std::uint64_t   m_masks[slots];
+};
+
+// Myers' bit-vector algorithm in Hyyrö's blocked formulation. Each step consumes one text
+// character and updates the last row of the DP matrix for all pattern blocks.
+template<typename CharT, typename Traits>
+class bit_parallel_matcher final
+{
+public:
+    using peq_type = peq_block<CharT, is_byte_char<CharT, Traits>::value>;
+
+    // In global mode the first row is 0, 1, 2, ... (edit distance); otherwise it is all zero
+    // and a match may start anywhere in the text (approximate search).
+    template<typename Iterator>
+    bit_parallel_matcher(Iterator pattern, std::size_t size, bool global)
+        : m_size{size}
+        , m_block_count{(size + 63) / 64}
+        , m_score{size}
+        , m_global{global}
+    {
+        if(m_block_count > edit_distance_inline_blocks) {
+            m_heap_peq.resize(m_block_count);
+            m_heap_pv.resize(m_block_count);
+            m_heap_mv.resize(m_block_count);
+            m_peq = m_heap_peq.data();
+            m_pv = m_heap_pv.data();
+            m_mv = m_heap_mv.data();
+        } else {
+            m_peq = m_inline_peq;
+            m_pv = m_inline_pv;
+            m_mv = m_inline_mv;
+        }
+
+        for(std::size_t b = 0; b < m_block_count; ++b) {
+            m_peq[b].clear();
+            m_pv[b] = ~std::uint64_t{0};
+            m_mv[b] = 0;
+        }
+        for(std::size_t i = 0; i < size; ++i, ++pattern) {
+            m_peq[i / 64].add(*pattern, std::uint64_t{1} << (i % 64));
+        }
+        m_last_bit = std::uint64_t{1} << ((size - 1) % 64);
+    }
+
+    bit_parallel_matcher(const bit_parallel_matcher&) = delete;
+    bit_parallel_matcher& operator=(const bit_parallel_matcher&) = delete;
+
+    // Returns the distance of the whole pattern against the text consumed so far.
+    std::size_t step(CharT c) noexcept
+    {
+        int carry = m_global ? 1 : 0;
+        const std::size_t last = m_block_count - 1;
+        for(std::size_t b = 0; b < last; ++b) {
+            carry = advance_block(b, m_peq[b][c], carry, std::uint64_t{1} << 63);
+        }
+        carry = advance_block(last, m_peq[last][c], carry, m_last_bit);
+        m_score += static_cast<std::size_t>(static_cast<std::ptrdiff_t>(carry));
+        return m_score;
+    }
+
+private:
+    int advance_block(std::size_t b, std::uint64_t eq, int hin, std::uint64_t high) noexcept
+    {
+        std::uint64_t pv = m_pv[b];
+        std::uint64_t mv = m_mv[b];
+
+        const std::uint64_t xv = eq | mv;
+        if(hin < 0) {
+            eq |= 1;
+        }
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+
+        const int hout = (ph & high) ? 1 : ((mh & high) ? -1 : 0);
+
+        ph <<= 1;
+        mh <<= 1;
+        if(hin < 0) {
+            mh |= 1;
+        } else if(hin > 0) {
+            ph |= 1;
+        }
+
+        m_pv[b] = mh | ~(xv | ph);
+        m_mv[b] = ph & xv;
+        return hout;
+    }
+
+    std::size_t             m_size;
+    std::size_t             m_block_count;
+    std::size_t             m_score;
+    std::uint64_t           m_last_bit;
+    bool                    m_global;
+
+    peq_type               *m_peq;
+    std::uint64_t          *m_pv;
+    std::uint64_t          *m_mv;
+
+    peq_type                m_inline_peq[edit_distance_inline_blocks];
+    std::uint64_t           m_inline_pv[edit_distance_inline_blocks];
+    std::uint64_t           m_inline_mv[edit_distance_inline_blocks];
+
+    std::vector<peq_type>       m_heap_peq;
+    std::vector<std::uint64_t>  m_heap_pv;
+    std::vector<std::uint64_t>  m_heap_mv;
+};
+
+} // namespace detail
+
+// Levenshtein distance
+
+// Returns the Levenshtein distance of a and b. If the distance exceeds max, the computation stops
+// as soon as this is certain and max + 1 is returned.
+template<typename CharT, typename Traits>
+std::size_t edit_distance(basic_string_view<CharT, Traits> a,
+                          cppbp::type_identity_t<basic_string_view<CharT, Traits>> b,
+                          std::size_t max = basic_string_view<CharT, Traits>::npos)
+{
+    const std::size_t exceeded = (max == basic_string_view<CharT, Traits>::npos) ? max : max + 1;
+
+    // Common prefix and suffix do not contribute to the distance.
+    std::size_t prefix = 0;
+    while(prefix < a.size() && prefix < b.size() && Traits::eq(a[prefix], b[prefix])) {
+        ++prefix;
+    }
+    a.remove_prefix(prefix);
+    b.remove_prefix(prefix);
+    std::size_t suffix = 0;
+    while(suffix < a.size() && suffix < b.size()
+          && Traits::eq(a[a.size() - 1 - suffix], b[b.size() - 1 - suffix])) {
+        ++suffix;
+    }
+    a.remove_suffix(suffix);
+    b.remove_suffix(suffix);
+
+    // The shorter string is the pattern, it determines the number of blocks.
+    if(a.size() < b.size()) {
+        a.swap(b);
+    }
+    const auto &text = a;
+    const auto &pattern = b;
+
+    if(text.size() - pattern.size() > max) {
+        return exceeded;
+    }
+    if(pattern.empty()) {
+        return text.size();
+    }
+
+    detail::bit_parallel_matcher<CharT, Traits> matcher{pattern.begin(), pattern.size(), true};
+    std::size_t score = pattern.size();
+    for(std::size_t j = 0; j < text.size(); ++j) {
+        score = matcher.step(text[j]);
+        // Each remaining column lowers the final distance by at most one.
+        const std::size_t remaining = text.size() - 1 - j;
+        if(score > remaining && score - remaining > max) {
+            return exceeded;
+        }
+    }
+    return score <= max ? score : exceeded;
+}
+
+// Approximate search
+
+struct fuzzy_match
+{
+    std::size_t position;
+    std::size_t length;
+    std::size_t distance;
+};
+
+// Finds the first substring of text (by end position) that is within k edits of pattern; the end
+// is moved forward while that lowers the distance. position is npos if there is no such substring.
+template<typename CharT, typename Traits>
+fuzzy_match fuzzy_find(basic_string_view<CharT, Traits> text,
+                       cppbp::type_identity_t<basic_string_view<CharT, Traits>> pattern,
+                       std::size_t k)
+{
+    const std::size_t m = pattern.size();
+    if(m <= k) {
+        return fuzzy_match{0, 0, m};
+    }
+
+    std::size_t end = basic_string_view<CharT, Traits>::npos;
+    std::size_t distance = m;
+    {
+        detail::bit_parallel_matcher<CharT, Traits> matcher{pattern.begin(), m, false};
+        for(std::size_t j = 0; j < text.size(); ++j) {
+            distance = matcher.step(text[j]);
+            if(distance <= k) {
+                end = j + 1;
+                break;
+            }
+        }
+        // Extend the first hit while the distance keeps improving, so that a match is not
+        // reported a few characters before its best end.
+        while(end < text.size()) {
+            const std::size_t next = matcher.step(text[end]);
+            if(next >= distance) {
+                break;
+            }
+            distance = next;
+            ++end;
+        }
+    }
+    if(end == basic_string_view<CharT, Traits>::npos) {
+        return fuzzy_match{end, 0, distance};
+    }
+
+    // Recover the start by aligning the reversed pattern globally against the text that ends at
+    // the match; the shortest candidate with the minimal distance wins.
+    detail::bit_parallel_matcher<CharT, Traits> matcher{pattern.rbegin(), m, true};
+    std::size_t best_length = 0;
+    std::size_t best_distance = m;
+    const std::size_t window = std::min(end, m + k);
+    for(std::size_t l = 1; l <= window; ++l) {
+        const std::size_t score = matcher.step(text[end - l]);
+        if(score < best_distance) {
+            best_distance = score;
+            best_length = l;
+        }
+    }
+    return fuzzy_match{end - best_length, best_length, best_distance};
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_EDIT_DISTANCE_HPP
@@ -0,0 +1,555 @@
+#ifndef CPPBP_ENUM_NAMES_HPP
+#define CPPBP_ENUM_NAMES_HPP
+
+#include <cppbp/config.hpp>         // CPPBP_PRETTY_FUNCTION
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::detail::hash_key
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint16_t, std::uint64_t
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument
+#include <type_traits>  // std::is_enum, std::underlying_type, std::is_base_of, std::is_convertible
+#include <utility>      // std::declval
+
+namespace cppbp {
+
+namespace detail {
+
+// Base of the unspecialized enum_range.
+struct enum_default_range { };
+
+} // namespace detail
+
+// Values enum_name and enum_from_name try for an enum that is not registered with
+// CPPBP_ENUM_NAMES, clipped to its underlying type. Specialize for enums with values outside of
+// it; every value in the range instantiates a function, which costs compile time.
+//
+// An unscoped enum without a fixed underlying type only has the values its enumerators need
+// bits for, and making a constant of any other value is an error in Clang 16 and later. Such an
+// enum needs a specialization covering no more than its values, a fixed underlying type or a
+// registration.
+template<typename E>
+struct enum_range : detail::enum_default_range
+{
+    static constexpr int min = -128;
+    static constexpr int max = 127;
+};
+
+// What CPPBP_ENUM_NAMES records: the enumerator list as written, and their N values.
+template<typename E, std::size_t N>
+struct enum_registration
+{
+    const char *names;
+    const E    *values;
+};
+
+namespace detail {
+
+constexpr std::size_t enum_none = static_cast<std::size_t>(-1);
+
+template<typename... Values>
+char (&enum_count_args(Values...))[sizeof...(Values)];
+
+// Found by ordinary lookup from here; a CPPBP_ENUM_NAMES function is found by argument dependent
+// lookup and is the better match.
+struct enum_not_registered { };
+enum_not_registered cppbp_enum_names(...);
+
+template<typename Registration>
+struct enum_registration_size : std::integral_constant<std::size_t, 0> { };
+
+template<typename E, std::size_t N>
+struct enum_registration_size<enum_registration<E, N>> : std::integral_constant<std::size_t, N> { };
+
+template<typename E>
+using is_enum_registered = std::integral_constant<bool,
+    !std::is_same<decltype(cppbp_enum_names(std::declval<E>())), enum_not_registered>::value>;
+
+// Whether every value of the underlying type is a value of E. Scoped enums always have a fixed
+// underlying type; for unscoped ones only C++17, where such enums alone can be list initialized
+// from an integer, tells.
+template<typename E, typename = void>
+struct enum_has_fixed_type
+    : std::integral_constant<bool, !std::is_convertible<E, typename std::underlying_type<E>::type>::value> { };
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+template<typename E>
+struct enum_has_fixed_type<E, decltype(void(E{std::declval<typename std::underlying_type<E>::type>()}))>
+    : std::true_type { };
+#endif
+
+constexpr std::size_t enum_ceil_pow2(std::size_t n, std::size_t p = 1)
+{
+    return p >= n ? p : enum_ceil_pow2(n, 2 * p);
+}
+
+// Murmur3 finalizer: a bijection, so distinct keys stay distinct.
+inline std::uint64_t enum_mix(std::uint64_t x) noexcept
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    return x ^ (x >> 33);
+}
+
+// Perfect hash table from 64 bit keys to indices below Capacity, in fixed size arrays.
+//
+// The keys are grouped into buckets of about two, and every bucket gets a 16 bit pilot that sends
+// all of its keys to free slots of a table twice the size of the set. A lookup mixes the key,
+// reads the pilot of its bucket and then the one slot the key can be in; the caller compares the
+// key stored at that index, since keys outside the set land on arbitrary slots.
+template<std::size_t Capacity>
+class enum_hash_table final
+{
+    static_assert(Capacity < 0xffff, "enum_hash_table: at most 65534 keys");
+
+    static constexpr std::size_t slot_capacity   = 2 * enum_ceil_pow2(Capacity);
+    static constexpr std::size_t bucket_capacity = slot_capacity / 4 > 0 ? slot_capacity / 4 : 1;
+
+    // Types
+public:
+    // Working memory of build(), kept by the caller so that it need not be on the stack.
+    struct scratch
+    {
+        std::uint16_t next[Capacity > 0 ? Capacity : 1];
+        std::uint16_t head[bucket_capacity];
+        std::uint16_t size[bucket_capacity];
+    };
+
+    // Construction
+public:
+    enum_hash_table() noexcept
+        : m_seed{0}
+        , m_bucket_mask{0}
+        , m_slot_mask{0}
+        , m_count{0}
+        , m_pilots{}
+        , m_slots{}
+    { }
+
+    // Places keys[i] to find indices[i]. Returns false, leaving the table empty, if two keys are
+    // equal.
+    bool build(const std::uint64_t *keys, const std::uint16_t *indices, std::size_t count, scratch &work) noexcept
+    {
+        const std::size_t slots = 2 * enum_ceil_pow2(count);
+        m_slot_mask = slots - 1;
+        m_bucket_mask = (slots / 4 > 0 ? slots / 4 : 1) - 1;
+
+        std::uint16_t *const next = work.next;
+        std::uint16_t *const head = work.head;
+        std::uint16_t *const size = work.size;
+        for(std::uint64_t attempt = 0; ; ++attempt) {
+            m_seed = enum_mix(attempt + 0x9e3779b97f4a7c15ull);
+            std::size_t max_size = 0;
+            for(std::size_t b = 0; b <= m_bucket_mask; ++b) {
+                head[b] = 0xffff;
+                size[b] = 0;
+                m_pilots[b] = 0;
+            }
+            for(std::size_t i = 0; i < count; ++i) {
+                const std::size_t b = enum_mix(keys[i] ^ m_seed) & m_bucket_mask;
+                for(std::uint16_t j = head[b]; attempt == 0 && j != 0xffff; j = next[j]) {
+                    if(keys[j] == keys[i]) {
+                        m_count = 0;
+                        return false;
+                    }
+                }
+                next[i] = head[b];
+                head[b] = static_cast<std::uint16_t>(i);
+                max_size = ++size[b] > max_size ? size[b] : max_size;
+            }
+            for(std::size_t s = 0; s <= m_slot_mask; ++s) {
+                m_slots[s] = 0;
+            }
+
+            // Crowded buckets first, while most slots are free.
+            bool placed = true;
+            for(std::size_t bucket_size = max_size; placed && bucket_size > 0; --bucket_size) {
+                for(std::size_t b = 0; placed && b <= m_bucket_mask; ++b) {
+                    if(size[b] == bucket_size) {
+                        placed = place(keys, indices, next, head[b], b);
+                    }
+                }
+            }
+            if(placed) {
+                m_count = count;
+                return true;
+            }
+        }
+    }
+
+    // Lookup
+public:
+    // The index stored for key if key is in the set, an arbitrary one or enum_none otherwise.
+    std::size_t find(std::uint64_t key) const noexcept
+    {
+        if(m_count == 0) {
+            return enum_none;
+        }
+        const std::uint64_t x = enum_mix(key ^ m_seed);
+        const std::uint16_t slot = m_slots[slot_of(x, m_pilots[x & m_bucket_mask])];
+        return slot == 0 ? enum_none : std::size_t{slot} - 1;
+    }
+
+    // Helper
+private:
+    std::size_t slot_of(std::uint64_t x, std::uint16_t pilot) const noexcept
+    {
+        return static_cast<std::size_t>(enum_mix(x + (pilot + std::uint64_t{1}) * 0x9e3779b97f4a7c15ull) & m_slot_mask);
+    }
+
+    // Finds a pilot that sends every key of the bucket to a free slot, and fills those slots.
+    bool place(const std::uint64_t *keys, const std::uint16_t *indices, const std::uint16_t *next,
+               std::uint16_t first, std::size_t bucket) noexcept
+    {
+        for(std::uint32_t pilot = 0; pilot <= 0xffff; ++pilot) {
+            std::uint16_t i = first;
+            for(; i != 0xffff; i = next[i]) {
+                const std::size_t slot = slot_of(enum_mix(keys[i] ^ m_seed), static_cast<std::uint16_t>(pilot));
+                if(m_slots[slot] != 0) {
+                    break;
+                }
+                m_slots[slot] = static_cast<std::uint16_t>(indices[i] + 1);
+            }
+            if(i == 0xffff) {
+                m_pilots[bucket] = static_cast<std::uint16_t>(pilot);
+                return true;
+            }
+            for(std::uint16_t j = first; j != i; j = next[j]) {
+                m_slots[slot_of(enum_mix(keys[j] ^ m_seed), static_cast<std::uint16_t>(pilot))] = 0;
+            }
+        }
+        return false;
+    }
+
+    // Private Member
+private:
+    std::uint64_t   m_seed;
+    std::size_t     m_bucket_mask;
+    std::size_t     m_slot_mask;
+    std::size_t     m_count;
+    std::uint16_t   m_pilots[bucket_capacity];
+    std::uint16_t   m_slots[slot_capacity];     // index + 1, 0 for a free slot
+};
+
+// The names of at most Capacity enumerators, with perfect hash tables for both directions.
+template<typename E, std::size_t Capacity>
+class enum_table final
+{
+    // Construction
+public:
+    enum_table() noexcept
+        : m_size{0}
+        , m_scan_names{false}
+        , m_values{}
+        , m_names{}
+    { }
+
+    // Adds a name for value; empty names and names already added are skipped.
+    void add(E value, string_view name) noexcept
+    {
+        if(name.empty() || m_size == Capacity) {
+            return;
+        }
+        for(std::size_t i = 0; i < m_size; ++i) {
+            if(m_names[i] == name) {
+                return;
+            }
+        }
+        m_values[m_size] = value;
+        m_names[m_size] = name;
+        ++m_size;
+    }
+
+    // Builds the hash tables once all names are added. Values with several names, aliases, are
+    // named by the first one.
+    void build() noexcept
+    {
+        std::uint64_t *const keys = m_scratch.keys;
+        std::uint16_t *const indices = m_scratch.indices;
+        for(std::size_t i = 0; i < m_size; ++i) {
+            keys[i] = hash_key(m_names[i]);
+            indices[i] = static_cast<std::uint16_t>(i);
+        }
+        // Two names with the same 64 bit hash are not worth a second scheme; scan instead.
+        m_scan_names = !m_by_name.build(keys, indices, m_size, m_scratch.table);
+
+        std::size_t distinct = 0;
+        for(std::size_t i = 0; i < m_size; ++i) {
+            std::size_t j = 0;
+            for(; j < i && m_values[j] != m_values[i]; ++j) { }
+            if(j == i) {
+                keys[distinct] = key(m_values[i]);
+                indices[distinct] = static_cast<std::uint16_t>(i);
+                ++distinct;
+            }
+        }
+        m_by_value.build(keys, indices, distinct, m_scratch.table);
+    }
+
+    // Lookup
+public:
+    string_view name(E value) const noexcept
+    {
+        const std::size_t i = m_by_value.find(key(value));
+        return i != enum_none && m_values[i] == value ? m_names[i] : string_view{};
+    }
+
+    bool find(string_view name, E &value) const noexcept
+    {
+        std::size_t i = enum_none;
+        if(m_scan_names) {
+            for(i = 0; i < m_size && m_names[i] != name; ++i) { }
+        } else {
+            i = m_by_name.find(hash_key(name));
+        }
+        if(i >= m_size || m_names[i] != name) {
+            return false;
+        }
+        value = m_values[i];
+        return true;
+    }
+
+    span<const E> values() const noexcept
+    {
+        return span<const E>{m_values, m_size};
+    }
+
+    span<const string_view> names() const noexcept
+    {
+        return span<const string_view>{m_names, m_size};
+    }
+
+    // Helper
+private:
+    static std::uint64_t key(E value) noexcept
+    {
+        return static_cast<std::uint64_t>(static_cast<typename std::underlying_type<E>::type>(value));
+    }
+
+    // Working memory of build(). The tables live in static storage, which unlike the stack has
+    // room for it whatever the capacity.
+    struct scratch
+    {
+        std::uint64_t                               keys[Capacity > 0 ? Capacity : 1];
+        std::uint16_t                               indices[Capacity > 0 ? Capacity : 1];
+        typename enum_hash_table<Capacity>::scratch table;
+    };
+
+    // Private Member
+private:
+    std::size_t                 m_size;
+    bool                        m_scan_names;
+    E                           m_values[Capacity > 0 ? Capacity : 1];
+    string_view                 m_names[Capacity > 0 ? Capacity : 1];
+    enum_hash_table<Capacity>   m_by_name;
+    enum_hash_table<Capacity>   m_by_value;
+    scratch                     m_scratch;
+};
+
+// Reflection
+
+template<typename E, E Value>
+const char* enum_pretty_function() noexcept
+{
+    return CPPBP_PRETTY_FUNCTION;
+}
+
+// The enumerator name in the signature of enum_pretty_function<E, Value>, without qualifiers,
+// or an empty view if Value has no name and the compiler printed it as a number or a cast.
+inline string_view enum_pretty_name(const char *signature) noexcept
+{
+    const string_view s{signature};
+#if defined(_MSC_VER) && !defined(__clang__)
+    // "const char *__cdecl cppbp::detail::enum_pretty_function<enum ns::color,ns::color::red>(void)"
+    const std::size_t end = s.rfind('>');
+    std::size_t begin = s.rfind(',', end) + 1;
+#else
+    // "const char* cppbp::detail::enum_pretty_function() [with E = ns::color; E V = ns::color::red]"
+    const std::size_t end = s.rfind(']');
+    std::size_t begin = s.rfind('=', end) + 1;
+#endif
+    for(; begin < end && s[begin] == ' '; ++begin) { }
+    const string_view value = s.substr(begin, end - begin);
+    if(value.empty() || !((value[0] >= 'a' && value[0] <= 'z') || (value[0] >= 'A' && value[0] <= 'Z') || value[0] == '_')) {
+        return string_view{};
+    }
+    const std::size_t colon = value.rfind(':');
+    return colon == string_view::npos ? value : value.substr(colon + 1);
+}
+
+// Adds the names of the values in [Low, High), splitting the range in halves so that the
+// template recursion stays logarithmic.
+template<typename E, long long Low, long long High, bool = (High - Low == 1)>
+struct enum_scan
+{
+    template<typename Table>
+    static void run(Table &table) noexcept
+    {
+        enum_scan<E, Low, Low + (High - Low) / 2>::run(table);
+        enum_scan<E, Low + (High - Low) / 2, High>::run(table);
+    }
+};
+
+template<typename E, long long Low, long long High>
+struct enum_scan<E, Low, High, true>
+{
+    template<typename Table>
+    static void run(Table &table) noexcept
+    {
+        table.add(static_cast<E>(Low), enum_pretty_name(enum_pretty_function<E, static_cast<E>(Low)>()));
+    }
+};
+
+constexpr long long enum_clamp_low(long long requested, long long lowest)
+{
+    return requested < lowest ? lowest : requested;
+}
+
+constexpr long long enum_clamp_high(long long requested, unsigned long long highest)
+{
+    return requested >= 0 && static_cast<unsigned long long>(requested) > highest ? static_cast<long long>(highest)
+                                                                                  : requested;
+}
+
+template<typename E, bool = is_enum_registered<E>::value>
+struct enum_source
+{
+    using underlying = typename std::underlying_type<E>::type;
+
+    static_assert(enum_has_fixed_type<E>::value || !std::is_base_of<enum_default_range, enum_range<E>>::value,
+                  "enum_name: E may have no fixed underlying type, so the default enum_range can exceed its "
+                  "values; specialize enum_range for E, give E an underlying type or use CPPBP_ENUM_NAMES");
+
+    static constexpr long long low = enum_clamp_low(enum_range<E>::min, std::numeric_limits<underlying>::min());
+    static constexpr long long high = enum_clamp_high(enum_range<E>::max, std::numeric_limits<underlying>::max());
+    static_assert(low <= high, "enum_range: the range of values is empty");
+
+    using table_type = enum_table<E, static_cast<std::size_t>(high - low + 1)>;
+
+    static void fill(table_type &table) noexcept
+    {
+        enum_scan<E, low, high + 1>::run(table);
+        table.build();
+    }
+};
+
+template<typename E>
+struct enum_source<E, true>
+{
+    using registration = decltype(cppbp_enum_names(std::declval<E>()));
+    using table_type = enum_table<E, enum_registration_size<registration>::value>;
+
+    // Splits the enumerator list at the commas and drops qualifiers.
+    static void fill(table_type &table) noexcept
+    {
+        const registration r = cppbp_enum_names(E{});
+        const char *p = r.names;
+        for(std::size_t i = 0; i < enum_registration_size<registration>::value; ++i) {
+            const char *end = p;
+            for(; *end != '\0' && *end != ','; ++end) { }
+            const char *begin = end;
+            for(; begin != p && begin[-1] != ':'; --begin) { }
+            for(; begin != end && *begin == ' '; ++begin) { }
+            const char *last = end;
+            for(; last != begin && last[-1] == ' '; --last) { }
+            table.add(r.values[i], string_view{begin, static_cast<std::size_t>(last - begin)});
+            p = *end == ',' ? end + 1 : end;
+        }
+        table.build();
+    }
+};
+
+// Fills the table in place, so that it is never copied through the stack.
+template<typename E>
+struct enum_table_holder
+{
+    enum_table_holder() noexcept
+    {
+        enum_source<E>::fill(table);
+    }
+
+    typename enum_source<E>::table_type table;
+};
+
+// Built on first use, once, in static storage.
+template<typename E>
+const typename enum_source<E>::table_type& enum_table_of() noexcept
+{
+    static const enum_table_holder<E> holder;
+    return holder.table;
+}
+
+} // namespace detail
+
+// Names of enumerators
+//
+// Names come from a CPPBP_ENUM_NAMES registration if the enum has one. Otherwise every value of
+// enum_range<E> is put into a template argument and its name read back from the function
+// signature the compiler generates; values without an enumerator print as casts or numbers and
+// have no name. Both directions are looked up in perfect hash tables that are built on first use
+// in static storage and never allocate.
+
+// The name of value, or an empty view if it has none.
+template<typename E>
+string_view enum_name(E value) noexcept
+{
+    static_assert(std::is_enum<E>::value, "enum_name: E must be an enumeration");
+    return detail::enum_table_of<E>().name(value);
+}
+
+// Stores the enumerator called name in value. Returns false and leaves value alone if there is
+// none.
+template<typename E>
+bool enum_from_name(string_view name, E &value) noexcept
+{
+    static_assert(std::is_enum<E>::value, "enum_from_name: E must be an enumeration");
+    return detail::enum_table_of<E>().find(name, value);
+}
+
+// The enumerator called name. Throws std::invalid_argument if there is none.
+template<typename E>
+E enum_from_name(string_view name)
+{
+    E value{};
+    if(!enum_from_name(name, value)) {
+        throw std::invalid_argument("enum_from_name: unknown enumerator name");
+    }
+    return value;
+}
+
+// All named values, in increasing order for reflected enums and in registration order otherwise.
+template<typename E>
+span<const E> enum_values() noexcept
+{
+    return detail::enum_table_of<E>().values();
+}
+
+// The names of enum_values<E>(), element by element.
+template<typename E>
+span<const string_view> enum_names() noexcept
+{
+    return detail::enum_table_of<E>().names();
+}
+
+} // namespace cppbp
+
+// Registers the names of an enum explicitly, for enums whose values lie outside of any sensible
+// enum_range or for compilers without usable function signatures. Use it in the namespace of the
+// enum, listing the enumerators as they are named there:
+//
+//     enum class status { ok = 200, not_found = 404 };
+//     CPPBP_ENUM_NAMES(status, status::ok, status::not_found)
+//
+// Enums declared inside a class cannot be registered.
+#define CPPBP_ENUM_NAMES(Enum, ...)                                                                     \
+    inline ::cppbp::enum_registration<Enum, sizeof(::cppbp::detail::enum_count_args(__VA_ARGS__))>     \
+    cppbp_enum_names(Enum) noexcept                                                                     \
+    {                                                                                                   \
+        static const Enum values[] = {__VA_ARGS__};                                                     \
+        return {#__VA_ARGS__, values};                                                                  \
+    }
+
+#endif // CPPBP_ENUM_NAMES_HPP
@@ -0,0 +1,139 @@
+#ifndef CPPBP_HASH_HPP
+#define CPPBP_HASH_HPP
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t, std::uint32_t
+#include <cstring>      // std::memcpy
+
+namespace cppbp {
+
+namespace detail {
+
+constexpr std::uint64_t hash_secret0 = 0xa0761d6478bd642full;
+constexpr std::uint64_t hash_secret1 = 0xe7037ed1a0b428dbull;
+constexpr std::uint64_t hash_secret2 = 0x8ebc6af09c88c6e3ull;
+constexpr std::uint64_t hash_secret3 = 0x589965cc75374cc3ull;
+
+constexpr std::uint64_t default_hash_seed = 0x2d358dccaa6c78a5ull;
+
+// 64x64 -> 128 bit multiplication: a receives the low, b the high half.
+inline void hash_mul128(std::uint64_t &a, std::uint64_t &b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    const uint128 r = static_cast<uint128>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    const std::uint64_t ha = a >> 32;
+    const std::uint64_t hb = b >> 32;
+    const std::uint64_t la = static_cast<std::uint32_t>(a);
+    const std::uint64_t lb = static_cast<std::uint32_t>(b);
+    const std::uint64_t rh = ha * hb;
+    const std::uint64_t rm0 = ha * lb;
+    const std::uint64_t rm1 = hb * la;
+    const std::uint64_t rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    const std::uint64_t lo = t + (rm1 << 32);
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+    a = lo;
+#endif
+}
+
+inline std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept
+{
+    hash_mul128(a, b);
+    return a ^ b;
+}
+
+inline std::uint64_t read64(const unsigned char *p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t read32(const unsigned char *p) noexcept
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Keys of at most 16 bytes are folded into two words without a loop.
+inline void hash_short_words(const unsigned char *p, std::size_t len,
+                             std::uint64_t &a, std::uint64_t &b) noexcept
+{
+    if(len >= 4) {
+        const std::size_t shift = (len >> 3) << 2;
+        a = (read32(p) << 32) | read32(p + shift);
+        b = (read32(p + len - 4) << 32) | read32(p + len - 4 - shift);
+    } else if(len > 0) {
+        a = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+        b = 0;
+    } else {
+        a = 0;
+        b = 0;
+    }
+}
+
+inline std::uint64_t hash_finish(std::uint64_t a, std::uint64_t b, std::uint64_t seed, std::size_t len) noexcept
+{
+    a ^= hash_secret1;
+    b ^= seed;
+    hash_mul128(a, b);
+    return hash_mix(a ^ hash_secret0 ^ static_cast<std::uint64_t>(len), b ^ hash_secret1);
+}
+
+// The user seed as the hash uses it; it does not depend on the key.
+inline std::uint64_t hash_prepare_seed(std::uint64_t seed) noexcept
+{
+    return seed ^ hash_mix(seed ^ hash_secret0, hash_secret1);
+}
+
+// The hash of len bytes at p for a seed returned by hash_prepare_seed().
+inline std::uint64_t hash_prepared(const unsigned char *p, std::size_t len, std::uint64_t seed) noexcept
+{
+    std::uint64_t a;
+    std::uint64_t b;
+    if(len <= 16) {
+        hash_short_words(p, len, a, b);
+    } else {
+        std::size_t i = len;
+        if(i > 48) {
+            std::uint64_t see1 = seed;
+            std::uint64_t see2 = seed;
+            do {
+                seed = hash_mix(read64(p) ^ hash_secret1, read64(p + 8) ^ seed);
+                see1 = hash_mix(read64(p + 16) ^ hash_secret2, read64(p + 24) ^ see1);
+                see2 = hash_mix(read64(p + 32) ^ hash_secret3, read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while(i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while(i > 16) {
+            seed = hash_mix(read64(p) ^ hash_secret1, read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    return hash_finish(a, b, seed, len);
+}
+
+} // namespace detail
+
+// Hashes len bytes at data (wyhash construction). The result only depends on the bytes, the
+// length and the seed, so it is stable across runs and processes on the same byte order and can
+// be persisted in files.
+inline std::uint64_t hash_bytes(const void *data, std::size_t len,
+                                std::uint64_t seed = detail::default_hash_seed) noexcept
+{
+    return detail::hash_prepared(static_cast<const unsigned char*>(data), len, detail::hash_prepare_seed(seed));
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_HASH_HPP
@@ -0,0 +1,35 @@
+#ifndef CPPBP_HASH_BATCH_HPP
+#define CPPBP_HASH_BATCH_HPP
+
+#include <cppbp/hash.hpp>           // cppbp::detail::hash_prepared, cppbp::detail::hash_prepare_seed
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <stdexcept>    // std::length_error
+
+namespace cppbp {
+
+// Writes hash_bytes(keys[i], seed) to out[i] for every key.
+//
+// The part of the hash that only depends on the seed is computed once instead of once per key,
+// which saves one of the three 64x64 bit multiplications of a short key. The keys are hashed in
+// a plain loop: they do not depend on each other, so the out-of-order core already overlaps the
+// multiplications of neighbouring keys. Interleaving them by hand into lanes measured slower,
+// and there is no vector 64x64 -> 128 bit multiply below AVX-512 to make SIMD lanes pay off.
+inline void hash_batch(span<const string_view> keys, span<std::uint64_t> out,
+                       std::uint64_t seed = detail::default_hash_seed)
+{
+    if(out.size() < keys.size()) {
+        throw std::length_error("hash_batch: output is smaller than the input");
+    }
+    const std::uint64_t prepared = detail::hash_prepare_seed(seed);
+    for(std::size_t i = 0; i < keys.size(); ++i) {
+        out[i] = detail::hash_prepared(reinterpret_cast<const unsigned char*>(keys[i].data()), keys[i].size(), prepared);
+    }
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_HASH_BATCH_HPP
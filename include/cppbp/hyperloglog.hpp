@@ -0,0 +1,293 @@
+#ifndef CPPBP_HYPERLOGLOG_HPP
+#define CPPBP_HYPERLOGLOG_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::countl_zero
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/hash_batch.hpp>     // cppbp::hash_batch
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view, cppbp::detail::hash_key
+
+#include <algorithm>    // std::copy, std::sort, std::max
+#include <cmath>        // std::log, std::ldexp
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint32_t, std::uint64_t
+#include <stdexcept>    // std::invalid_argument
+#include <vector>       // std::vector
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_max_epu8, _mm256_max_epu8, ...
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// dst[i] = max(dst[i], src[i])
+inline void max_bytes(std::uint8_t *dst, const std::uint8_t *src, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for(; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_max_epu8(a, b));
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    for(; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(a, b));
+    }
+#endif
+    for(; i < n; ++i) {
+        dst[i] = dst[i] < src[i] ? src[i] : dst[i];
+    }
+}
+
+} // namespace detail
+
+// HyperLogLog estimator of the number of distinct strings in a stream.
+//
+// The precision p selects 2^p registers and a standard error of about 1.04 / sqrt(2^p). Small
+// sketches are sparse, a sorted list of (register, rank) pairs, and switch to one byte per
+// register once that is smaller. Sketches of equal precision and seed merge into the sketch of
+// the union; dense registers are merged with SIMD byte maxima.
+class hyperloglog final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr int min_precision = 4;
+    static constexpr int max_precision = 18;
+    static constexpr int default_precision = 14;
+
+    // Construction and Assignment
+public:
+    explicit hyperloglog(int precision = default_precision, std::uint64_t seed = detail::default_hash_seed)
+        : m_precision{precision}
+        , m_seed{seed}
+    {
+        if(precision < min_precision || precision > max_precision) {
+            throw std::invalid_argument("hyperloglog: precision must be in [4, 18]");
+        }
+    }
+
+    // Observers
+public:
+    int precision() const noexcept
+    {
+        return m_precision;
+    }
+
+    size_type register_count() const noexcept
+    {
+        return size_type{1} << m_precision;
+    }
+
+    bool is_sparse() const noexcept
+    {
+        return m_dense.empty();
+    }
+
+    // Approximate number of bytes used by the registers.
+    size_type memory_usage() const noexcept
+    {
+        return is_sparse() ? (m_sparse.capacity() + m_pending.capacity()) * sizeof(std::uint32_t) : m_dense.size();
+    }
+
+    // Estimated number of distinct keys added so far.
+    double estimate() const
+    {
+        const double m = static_cast<double>(register_count());
+        double sum = 0.0;
+        size_type zeros = 0;
+        if(is_sparse()) {
+            // Sorts the few pending entries on the stack and merges them with the sparse list on
+            // the fly; add_hash() compacts before there are pending_limit of them.
+            std::uint32_t pending[pending_limit];
+            const size_type n = m_pending.size();
+            std::copy(m_pending.begin(), m_pending.end(), pending);
+            std::sort(pending, pending + n);
+            size_type used = 0;
+            size_type i = 0;
+            size_type j = 0;
+            while(i < m_sparse.size() || j < n) {
+                const std::uint32_t index = j == n || (i < m_sparse.size() && m_sparse[i] < pending[j])
+                                          ? m_sparse[i] >> rank_bits : pending[j] >> rank_bits;
+                std::uint32_t rank = 0;
+                for(; i < m_sparse.size() && (m_sparse[i] >> rank_bits) == index; ++i) {
+                    rank = std::max(rank, m_sparse[i] & rank_mask);
+                }
+                for(; j < n && (pending[j] >> rank_bits) == index; ++j) {
+                    rank = std::max(rank, pending[j] & rank_mask);
+                }
+                sum += std::ldexp(1.0, -static_cast<int>(rank));
+                ++used;
+            }
+            zeros = register_count() - used;
+            sum += static_cast<double>(zeros);
+        } else {
+            for(const std::uint8_t rank : m_dense) {
+                sum += std::ldexp(1.0, -static_cast<int>(rank));
+                zeros += (rank == 0);
+            }
+        }
+        const double raw = alpha(m) * m * m / sum;
+        if(raw <= 2.5 * m && zeros != 0) {
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+        return raw;
+    }
+
+    // Modifiers
+public:
+    template<typename CharT, typename Traits>
+    void add(basic_string_view<CharT, Traits> key)
+    {
+        add_hash(detail::hash_key(key, m_seed));
+    }
+
+    void add_hash(std::uint64_t h)
+    {
+        const std::uint32_t index = static_cast<std::uint32_t>(h >> (64 - m_precision));
+        const std::uint64_t rest = h << m_precision;
+        const int limit = 64 - m_precision + 1;
+        const int zeros = rest == 0 ? limit - 1 : countl_zero(rest);
+        const std::uint8_t rank = static_cast<std::uint8_t>(zeros + 1 < limit ? zeros + 1 : limit);
+        if(!is_sparse()) {
+            if(m_dense[index] < rank) {
+                m_dense[index] = rank;
+            }
+            return;
+        }
+        m_pending.push_back((index << rank_bits) | rank);
+        if(m_pending.size() >= pending_limit) {
+            compact();
+        }
+    }
+
+    // Hashes up to batch_size keys at a time with hash_batch(), which prepares the seed once per
+    // batch, before touching the registers.
+    void add_batch(span<const string_view> keys)
+    {
+        std::uint64_t hashes[batch_size];
+        size_type i = 0;
+        while(i < keys.size()) {
+            const size_type n = keys.size() - i < batch_size ? keys.size() - i : batch_size;
+            hash_batch(keys.subspan(i, n), span<std::uint64_t>{hashes, n}, m_seed);
+            for(size_type j = 0; j < n; ++j) {
+                add_hash(hashes[j]);
+            }
+            i += n;
+        }
+    }
+
+    void add_hashes(span<const std::uint64_t> hashes)
+    {
+        for(const std::uint64_t h : hashes) {
+            add_hash(h);
+        }
+    }
+
+    // Adds all keys of other. Both sketches need the same precision and seed.
+    void merge(const hyperloglog &other)
+    {
+        if(other.m_precision != m_precision || other.m_seed != m_seed) {
+            throw std::invalid_argument("hyperloglog::merge: precision or seed differ");
+        }
+        if(&other == this) {
+            return;
+        }
+        if(is_sparse() && other.is_sparse()) {
+            m_pending.insert(m_pending.end(), other.m_sparse.begin(), other.m_sparse.end());
+            m_pending.insert(m_pending.end(), other.m_pending.begin(), other.m_pending.end());
+            compact();
+            return;
+        }
+        to_dense();
+        if(other.is_sparse()) {
+            apply(other.m_sparse);
+            apply(other.m_pending);
+        } else {
+            detail::max_bytes(m_dense.data(), other.m_dense.data(), m_dense.size());
+        }
+    }
+
+    void clear()
+    {
+        m_sparse.clear();
+        m_pending.clear();
+        m_dense.clear();
+        m_dense.shrink_to_fit();
+    }
+
+    // Helper
+private:
+    static constexpr int rank_bits = 6;
+    static constexpr std::uint32_t rank_mask = (1u << rank_bits) - 1;
+    static constexpr size_type pending_limit = 256;
+    static constexpr size_type batch_size = 16;
+
+    static double alpha(double m) noexcept
+    {
+        return m <= 16.0 ? 0.673 : (m <= 32.0 ? 0.697 : (m <= 64.0 ? 0.709 : 0.7213 / (1.0 + 1.079 / m)));
+    }
+
+    // Sorts the pending entries into the sparse list, keeping the highest rank per register,
+    // and switches to dense registers once the list outgrows them.
+    void compact()
+    {
+        if(m_pending.empty()) {
+            return;
+        }
+        m_sparse.insert(m_sparse.end(), m_pending.begin(), m_pending.end());
+        m_pending.clear();
+        // The rank sits in the low bits, so the last entry of each register has the highest.
+        std::sort(m_sparse.begin(), m_sparse.end());
+        size_type out = 0;
+        for(size_type i = 0; i < m_sparse.size(); ++i) {
+            if(i + 1 < m_sparse.size() && (m_sparse[i] >> rank_bits) == (m_sparse[i + 1] >> rank_bits)) {
+                continue;
+            }
+            m_sparse[out++] = m_sparse[i];
+        }
+        m_sparse.resize(out);
+        if(m_sparse.size() * sizeof(std::uint32_t) > register_count()) {
+            to_dense();
+        }
+    }
+
+    void to_dense()
+    {
+        if(!is_sparse()) {
+            return;
+        }
+        m_dense.assign(register_count(), 0);
+        apply(m_sparse);
+        apply(m_pending);
+        std::vector<std::uint32_t>().swap(m_sparse);
+        std::vector<std::uint32_t>().swap(m_pending);
+    }
+
+    void apply(const std::vector<std::uint32_t> &entries) noexcept
+    {
+        for(const std::uint32_t entry : entries) {
+            std::uint8_t &reg = m_dense[entry >> rank_bits];
+            reg = std::max(reg, static_cast<std::uint8_t>(entry & rank_mask));
+        }
+    }
+
+    // Private Member
+private:
+    int                         m_precision;
+    std::uint64_t               m_seed;
+    std::vector<std::uint32_t>  m_sparse;
+    std::vector<std::uint32_t>  m_pending;
+    std::vector<std::uint8_t>   m_dense;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_HYPERLOGLOG_HPP
@@ -0,0 +1,198 @@
+#ifndef CPPBP_IOVEC_WRITER_HPP
+#define CPPBP_IOVEC_WRITER_HPP
+
+#include <cppbp/cord.hpp>           // cppbp::cord
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <algorithm>    // std::min
+#include <cerrno>       // errno, EINTR, EIO
+#include <climits>      // IOV_MAX
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstring>      // std::memcpy
+#include <system_error> // std::system_error, std::system_category
+#include <vector>       // std::vector
+
+#include <sys/uio.h>    // ::iovec, ::writev
+#include <unistd.h>     // ::sysconf
+
+namespace cppbp {
+
+// Collects pieces of output and writes them with as few writev(2) calls as possible.
+//
+// Pieces larger than the coalescing threshold are referenced in place (zero-copy) and must stay
+// valid until the next flush(). Smaller pieces are copied into an inline buffer. Pieces that are
+// adjacent in memory, including consecutive copies, share one iovec entry. Nothing is written
+// before flush() is called (or the inline buffer runs full); the destructor does not flush.
+class iovec_writer final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type buffer_capacity = 4096;
+    static constexpr size_type default_coalesce_threshold = 128;
+
+    // Construction and Assignment
+public:
+    explicit iovec_writer(int fd, size_type coalesce_threshold = default_coalesce_threshold)
+        : m_fd{fd}
+        , m_coalesce_threshold{coalesce_threshold < buffer_capacity ? coalesce_threshold : buffer_capacity}
+        , m_buffer_size{0}
+        , m_pending{0}
+    { }
+
+    iovec_writer(const iovec_writer&) = delete;
+    iovec_writer& operator=(const iovec_writer&) = delete;
+
+    // Observers
+public:
+    int fd() const noexcept
+    {
+        return m_fd;
+    }
+
+    // Number of bytes queued but not yet written.
+    size_type pending() const noexcept
+    {
+        return m_pending;
+    }
+
+    // Number of iovec entries the next flush() hands to the kernel.
+    size_type piece_count() const noexcept
+    {
+        return m_iov.size();
+    }
+
+    // Modifiers
+public:
+    iovec_writer& write(string_view piece)
+    {
+        append(piece.data(), piece.size());
+        return *this;
+    }
+
+    iovec_writer& write(const char *str)
+    {
+        return write(string_view{str});
+    }
+
+    iovec_writer& write(span<const char> piece)
+    {
+        append(piece.data(), piece.size());
+        return *this;
+    }
+
+    iovec_writer& write(span<const unsigned char> piece)
+    {
+        append(reinterpret_cast<const char*>(piece.data()), piece.size());
+        return *this;
+    }
+
+    iovec_writer& write(const cord &pieces)
+    {
+        for(auto chunk : pieces.chunks()) {
+            append(chunk.data(), chunk.size());
+        }
+        return *this;
+    }
+
+    iovec_writer& operator<<(string_view piece)
+    {
+        return write(piece);
+    }
+
+    // Writes everything queued so far. Partial writes are continued and EINTR is retried; any
+    // other error, or a write that makes no progress, throws std::system_error and leaves the
+    // unwritten rest queued.
+    void flush()
+    {
+        const int batch = iov_max();
+        size_type first = 0;
+        while(first < m_iov.size()) {
+            const int count = static_cast<int>(std::min<size_type>(m_iov.size() - first,
+                                                                   static_cast<size_type>(batch)));
+            const ssize_t written = ::writev(m_fd, m_iov.data() + first, count);
+            if(written <= 0) {
+                if(written < 0 && errno == EINTR) {
+                    continue;
+                }
+                // Every queued entry is non-empty, so writing nothing would repeat forever.
+                const int error = written < 0 ? errno : EIO;
+                m_iov.erase(m_iov.begin(), m_iov.begin() + static_cast<std::ptrdiff_t>(first));
+                throw std::system_error(error, std::system_category(), "iovec_writer::flush: writev failed");
+            }
+
+            size_type remaining = static_cast<size_type>(written);
+            m_pending -= remaining;
+            while(remaining > 0 && remaining >= m_iov[first].iov_len) {
+                remaining -= m_iov[first].iov_len;
+                ++first;
+            }
+            if(remaining > 0) {
+                m_iov[first].iov_base = static_cast<char*>(m_iov[first].iov_base) + remaining;
+                m_iov[first].iov_len -= remaining;
+            }
+        }
+        m_iov.clear();
+        m_buffer_size = 0;
+    }
+
+    // Helper
+private:
+    static int iov_max() noexcept
+    {
+#if defined(IOV_MAX)
+        return IOV_MAX;
+#else
+        const long limit = ::sysconf(_SC_IOV_MAX);
+        return limit > 0 ? static_cast<int>(limit) : 1024;
+#endif
+    }
+
+    void append(const char *data, size_type size)
+    {
+        if(size == 0) {
+            return;
+        }
+        if(size > m_coalesce_threshold) {
+            push(const_cast<char*>(data), size);
+            return;
+        }
+        if(m_buffer_size + size > buffer_capacity) {
+            flush();
+        }
+
+        char *dst = m_buffer + m_buffer_size;
+        std::memcpy(dst, data, size);
+        m_buffer_size += size;
+        push(dst, size);
+    }
+
+    void push(char *data, size_type size)
+    {
+        m_pending += size;
+        // Pieces that continue the previous one in memory extend its entry.
+        if(!m_iov.empty() && static_cast<char*>(m_iov.back().iov_base) + m_iov.back().iov_len == data) {
+            m_iov.back().iov_len += size;
+            return;
+        }
+        ::iovec entry;
+        entry.iov_base = data;
+        entry.iov_len = size;
+        m_iov.push_back(entry);
+    }
+
+    // Private Member
+private:
+    int                     m_fd;
+    size_type               m_coalesce_threshold;
+    size_type               m_buffer_size;
+    size_type               m_pending;
+    std::vector<::iovec>    m_iov;
+    char                    m_buffer[buffer_capacity];
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_IOVEC_WRITER_HPP
@@ -0,0 +1,111 @@
+#ifndef CPPBP_KEY_ARENA_HPP
+#define CPPBP_KEY_ARENA_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_width
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <cstring>      // std::memcpy
+#include <memory>       // std::unique_ptr
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Key storage with power of two size classes. Blocks are recycled but never returned to the
+// system before the arena is destroyed, so optimistic readers never touch unmapped memory.
+class key_arena final
+{
+public:
+    key_arena() noexcept
+        : m_cursor{nullptr}
+        , m_remaining{0}
+        , m_allocated{0}
+    { }
+
+    // Returns a block holding the 32 bit key size followed by the key bytes.
+    const char* store(string_view key)
+    {
+        const std::size_t cls = size_class(key.size());
+        char *block;
+        if(cls < m_free.size() && !m_free[cls].empty()) {
+            block = m_free[cls].back();
+            m_free[cls].pop_back();
+        } else {
+            block = allocate(std::size_t{1} << cls);
+        }
+        const std::uint32_t size = static_cast<std::uint32_t>(key.size());
+        std::memcpy(block, &size, sizeof(size));
+        std::memcpy(block + sizeof(size), key.data(), key.size());
+        return block;
+    }
+
+    void release(const char *block)
+    {
+        const std::size_t cls = size_class(size_of(block));
+        if(cls >= m_free.size()) {
+            m_free.resize(cls + 1);
+        }
+        m_free[cls].push_back(const_cast<char*>(block));
+    }
+
+    // Bytes obtained from the system, including free blocks.
+    std::size_t allocated() const noexcept
+    {
+        return m_allocated;
+    }
+
+    static std::size_t size_of(const char *block) noexcept
+    {
+        std::uint32_t size;
+        std::memcpy(&size, block, sizeof(size));
+        return size;
+    }
+
+    static string_view view_of(const char *block) noexcept
+    {
+        return string_view{block + sizeof(std::uint32_t), size_of(block)};
+    }
+
+private:
+    static constexpr std::size_t chunk_size = 64 * 1024;
+
+    static std::size_t size_class(std::size_t key_size) noexcept
+    {
+        const std::size_t need = key_size + sizeof(std::uint32_t);
+        return static_cast<std::size_t>(bit_width(need < 16 ? std::size_t{15} : need - 1));
+    }
+
+    char* allocate(std::size_t size)
+    {
+        if(size > chunk_size / 4) {
+            m_chunks.emplace_back(new char[size]);
+            m_allocated += size;
+            return m_chunks.back().get();
+        }
+        if(size > m_remaining) {
+            m_chunks.emplace_back(new char[chunk_size]);
+            m_allocated += chunk_size;
+            m_cursor = m_chunks.back().get();
+            m_remaining = chunk_size;
+        }
+        char *block = m_cursor;
+        m_cursor += size;
+        m_remaining -= size;
+        return block;
+    }
+
+    std::vector<std::unique_ptr<char[]>>    m_chunks;
+    std::vector<std::vector<char*>>         m_free;
+    char                                   *m_cursor;
+    std::size_t                             m_remaining;
+    std::size_t                             m_allocated;
+};
+
+} // namespace detail
+
+} // namespace cppbp
+
+#endif // CPPBP_KEY_ARENA_HPP
@@ -0,0 +1,415 @@
+#ifndef CPPBP_LINE_INDEX_HPP
+#define CPPBP_LINE_INDEX_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_width, cppbp::countr_zero
+#include <cppbp/bit_vector.hpp>     // cppbp::bit_vector
+#include <cppbp/span.hpp>           // cppbp::span, cppbp::detail::read_aligned
+#include <cppbp/string_search.hpp>  // cppbp::detail::count_byte, cppbp::detail::for_each_byte
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+#include <cppbp/thread_pool.hpp>    // cppbp::thread_pool, cppbp::detail::for_range
+
+#include <cassert>      // assert
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::out_of_range
+#include <utility>      // std::move, std::swap
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Bytes of text scanned by one task while building a line_index.
+constexpr std::size_t line_index_chunk = std::size_t{1} << 20;
+
+// The first and last word of a chunk's share of a bit array, which the neighbouring chunks may
+// write as well. Their bits are collected here and merged once every chunk is done.
+struct line_index_edges
+{
+    std::size_t   word[2];
+    std::uint64_t bits[2];
+
+    bool put(std::size_t w, std::uint64_t b) noexcept
+    {
+        for(int k = 0; k < 2; ++k) {
+            if(w == word[k]) {
+                bits[k] |= b;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace detail
+
+// Offsets of the newlines of a text, for jumping to line n without scanning from the start.
+//
+// Lines end at '\n', which is not part of the line; the last line may lack it, so "a\nb" and
+// "a\nb\n" both have two lines. The newline offsets are stored Elias-Fano coded: the low
+// log2(size / newlines) bits of each offset packed in an array, the rest in unary in a bit
+// vector, which takes about 2 + log2(average line length) bits per line. line(n) needs two
+// select queries. Construction counts the newlines of every chunk in parallel, turns the counts
+// into each chunk's first line number with a prefix sum, and then encodes the offsets of every
+// chunk in parallel, straight into the low bits and the bit vector.
+//
+// The index keeps a view of the text, which must outlive it. A serialized index does not contain
+// the text; borrow() and deserialize() take it again.
+class line_index final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    // Construction and Assignment
+public:
+    line_index()
+        : m_text_size{0}
+        , m_newlines{0}
+        , m_lines{0}
+        , m_low_bits{0}
+        , m_low{nullptr}
+        , m_low_count{0}
+    {
+        build(string_view{}, nullptr);
+    }
+
+    explicit line_index(string_view text)
+        : line_index{}
+    {
+        build(text, nullptr);
+    }
+
+    // Scans the text on the threads of pool.
+    line_index(string_view text, thread_pool &pool)
+        : line_index{}
+    {
+        build(text, &pool);
+    }
+
+    line_index(const line_index &other)
+        : m_text{other.m_text}
+        , m_text_size{other.m_text_size}
+        , m_newlines{other.m_newlines}
+        , m_lines{other.m_lines}
+        , m_low_bits{other.m_low_bits}
+        , m_low_storage(other.m_low, other.m_low + other.m_low_count)
+        , m_low{m_low_storage.data()}
+        , m_low_count{other.m_low_count}
+        , m_high{other.m_high}
+    { }
+
+    line_index(line_index &&other) noexcept
+        : line_index{}
+    {
+        swap(other);
+    }
+
+    line_index& operator=(line_index other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    // Reads the low bits and the bit vector straight from a serialize() buffer, which must be 8
+    // byte aligned and stay valid while the result is used. text is the indexed text again; an
+    // index of a text with another size is rejected with std::invalid_argument.
+    static line_index borrow(span<const unsigned char> bytes, string_view text)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % 8 != 0) {
+            throw std::invalid_argument("line_index::borrow: buffer is not 8 byte aligned");
+        }
+        if(bytes.size() < header_size || std::memcmp(bytes.data(), magic(), 4) != 0) {
+            throw std::invalid_argument("line_index: not a serialized index");
+        }
+        std::uint64_t header[header_size / 8];
+        std::memcpy(header, bytes.data(), header_size);
+        const std::uint64_t text_size = header[1];
+        const std::uint64_t newlines = header[2];
+        const std::uint64_t low_bits = header[3];
+        const std::uint64_t low_count = header[4];
+        if(text_size != text.size()) {
+            throw std::invalid_argument("line_index: the index belongs to a text of another size");
+        }
+        if(newlines > text_size || low_bits >= 64 || low_count != (newlines * low_bits + 63) / 64
+           || low_count > (bytes.size() - header_size) / 8) {
+            throw std::invalid_argument("line_index: corrupt or truncated buffer");
+        }
+        const unsigned char *p = bytes.data() + header_size;
+        bit_vector high = bit_vector::borrow(span<const unsigned char>{
+            p + low_count * 8, bytes.size() - header_size - static_cast<size_type>(low_count) * 8});
+        if(high.size() != (text_size >> low_bits) + newlines + 1 || high.count_ones() != newlines) {
+            throw std::invalid_argument("line_index: corrupt buffer");
+        }
+
+        line_index result;
+        result.m_text = text;
+        result.m_text_size = static_cast<size_type>(text_size);
+        result.m_newlines = static_cast<size_type>(newlines);
+        result.m_low_bits = static_cast<unsigned>(low_bits);
+        result.m_low = reinterpret_cast<const std::uint64_t*>(p);
+        result.m_low_count = static_cast<size_type>(low_count);
+        result.m_high = std::move(high);
+        result.count_lines();
+        return result;
+    }
+
+    // Copies an index out of a buffer written by serialize().
+    static line_index deserialize(span<const unsigned char> bytes, string_view text)
+    {
+        return detail::read_aligned(bytes, [text](span<const unsigned char> copy) {
+            const line_index borrowed = borrow(copy, text);
+            return line_index{borrowed};
+        });
+    }
+
+    // Capacity
+public:
+    // Number of lines.
+    size_type size() const noexcept
+    {
+        return m_lines;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_lines == 0;
+    }
+
+    size_type text_size() const noexcept
+    {
+        return m_text_size;
+    }
+
+    // Lookup
+public:
+    // Line n without its newline.
+    string_view line(size_type n) const noexcept
+    {
+        assert(n < m_lines);
+        const size_type begin = line_start(n);
+        const size_type end = n < m_newlines ? newline(n) : m_text_size;
+        return string_view{m_text.data() + begin, end - begin};
+    }
+
+    string_view at(size_type n) const
+    {
+        if(n >= m_lines) {
+            throw std::out_of_range("line_index::at: line out of range");
+        }
+        return line(n);
+    }
+
+    // Offset of the first byte of line n; n == size() gives the end of the text.
+    size_type line_start(size_type n) const noexcept
+    {
+        assert(n <= m_lines);
+        if(n == 0) {
+            return 0;
+        }
+        return n <= m_newlines ? newline(n - 1) + 1 : m_text_size;
+    }
+
+    // Line holding the byte at offset; a newline belongs to the line it ends. offset must not
+    // exceed text_size(), which belongs to the last line unless the text ends with a newline.
+    size_type line_number(size_type offset) const noexcept
+    {
+        assert(offset <= m_text_size);
+        // Newlines whose high part is smaller than that of offset come first.
+        const size_type high = offset >> m_low_bits;
+        size_type i = high == 0 ? 0 : m_high.select0(high - 1) - (high - 1);
+        while(i < m_newlines && newline(i) < offset) {
+            ++i;
+        }
+        return i;
+    }
+
+    // Offset of the i-th newline.
+    size_type newline(size_type i) const noexcept
+    {
+        assert(i < m_newlines);
+        return ((m_high.select1(i) - i) << m_low_bits) | low(i);
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const
+    {
+        return header_size + m_low_count * 8 + m_high.serialized_size();
+    }
+
+    void serialize(span<unsigned char> out) const
+    {
+        if(out.size() < serialized_size()) {
+            throw std::length_error("line_index::serialize: buffer too small");
+        }
+        const std::uint64_t header[header_size / 8] = {0, m_text_size, m_newlines, m_low_bits, m_low_count, 0};
+        unsigned char *p = out.data();
+        std::memcpy(p, header, header_size);
+        std::memcpy(p, magic(), 4);
+        p += header_size;
+        if(m_low_count != 0) {
+            std::memcpy(p, m_low, m_low_count * 8);
+        }
+        p += m_low_count * 8;
+        m_high.serialize(span<unsigned char>{p, m_high.serialized_size()});
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> result(serialized_size());
+        serialize(span<unsigned char>{result.data(), result.size()});
+        return result;
+    }
+
+    void swap(line_index &other) noexcept
+    {
+        std::swap(m_text, other.m_text);
+        std::swap(m_text_size, other.m_text_size);
+        std::swap(m_newlines, other.m_newlines);
+        std::swap(m_lines, other.m_lines);
+        std::swap(m_low_bits, other.m_low_bits);
+        // Owned vectors keep their buffers when swapped, so the pointers stay valid.
+        m_low_storage.swap(other.m_low_storage);
+        std::swap(m_low, other.m_low);
+        std::swap(m_low_count, other.m_low_count);
+        m_high.swap(other.m_high);
+    }
+
+    // Helper
+private:
+    static constexpr size_type header_size = 48;
+
+    static const char* magic() noexcept
+    {
+        return "CLI1";
+    }
+
+    size_type low(size_type i) const noexcept
+    {
+        if(m_low_bits == 0) {
+            return 0;
+        }
+        const size_type bit = i * m_low_bits;
+        const size_type word = bit / 64;
+        const unsigned shift = static_cast<unsigned>(bit % 64);
+        std::uint64_t value = m_low[word] >> shift;
+        if(shift + m_low_bits > 64) {
+            value |= m_low[word + 1] << (64 - shift);
+        }
+        return static_cast<size_type>(value & ((std::uint64_t{1} << m_low_bits) - 1));
+    }
+
+    void build(string_view text, thread_pool *pool)
+    {
+        const unsigned char *s = reinterpret_cast<const unsigned char*>(text.data());
+        const size_type n = text.size();
+        const size_type chunks = (n + detail::line_index_chunk - 1) / detail::line_index_chunk;
+        const auto chunk_end = [&](size_type c) {
+            return n - c * detail::line_index_chunk < detail::line_index_chunk ? n : (c + 1) * detail::line_index_chunk;
+        };
+
+        // Newlines per chunk, then the index of the first newline of every chunk.
+        std::vector<size_type> first(chunks + 1, 0);
+        detail::for_range(pool, chunks, [&](size_type begin, size_type end) {
+            for(size_type c = begin; c < end; ++c) {
+                const size_type offset = c * detail::line_index_chunk;
+                first[c + 1] = detail::count_byte(s + offset, chunk_end(c) - offset, '\n');
+            }
+        });
+        for(size_type c = 0; c < chunks; ++c) {
+            first[c + 1] += first[c];
+        }
+        const size_type newlines = first[chunks];
+
+        // Every chunk encodes its own newlines. The low bits of newlines [first[c], first[c + 1])
+        // and the high bits, which land between (begin >> low_bits) + first[c] and
+        // ((end - 1) >> low_bits) + first[c + 1] - 1, are disjoint ranges for different chunks,
+        // so only the words at both ends of a range can be shared.
+        const unsigned low_bits = newlines != 0 && n / newlines > 1 ? static_cast<unsigned>(bit_width(n / newlines) - 1) : 0;
+        const std::uint64_t mask = (std::uint64_t{1} << low_bits) - 1;
+        std::vector<std::uint64_t> low_words((newlines * low_bits + 63) / 64, 0);
+        bit_vector high((n >> low_bits) + newlines + 1);
+        std::vector<detail::line_index_edges> low_edges(chunks, detail::line_index_edges{});
+        std::vector<detail::line_index_edges> high_edges(chunks, detail::line_index_edges{});
+        detail::for_range(pool, chunks, [&](size_type begin, size_type end) {
+            for(size_type c = begin; c < end; ++c) {
+                if(first[c] == first[c + 1]) {
+                    continue;
+                }
+                const size_type offset = c * detail::line_index_chunk;
+                detail::line_index_edges &low_edge = low_edges[c];
+                detail::line_index_edges &high_edge = high_edges[c];
+                low_edge.word[0] = first[c] * low_bits / 64;
+                low_edge.word[1] = (first[c + 1] * low_bits + 63) / 64 - 1;
+                high_edge.word[0] = ((offset >> low_bits) + first[c]) / 64;
+                high_edge.word[1] = (((chunk_end(c) - 1) >> low_bits) + first[c + 1] - 1) / 64;
+                size_type i = first[c];
+                detail::for_each_byte(s + offset, chunk_end(c) - offset, '\n', [&](size_type j) {
+                    const size_type at = offset + j;
+                    if(low_bits != 0) {
+                        const size_type bit = i * low_bits;
+                        const unsigned shift = static_cast<unsigned>(bit % 64);
+                        const std::uint64_t value = at & mask;
+                        if(!low_edge.put(bit / 64, value << shift)) {
+                            low_words[bit / 64] |= value << shift;
+                        }
+                        if(shift + low_bits > 64 && !low_edge.put(bit / 64 + 1, value >> (64 - shift))) {
+                            low_words[bit / 64 + 1] |= value >> (64 - shift);
+                        }
+                    }
+                    const size_type position = (at >> low_bits) + i;
+                    if(!high_edge.put(position / 64, std::uint64_t{1} << (position % 64))) {
+                        high.set(position);
+                    }
+                    ++i;
+                });
+            }
+        });
+        for(size_type c = 0; c < chunks; ++c) {
+            for(int k = 0; k < 2; ++k) {
+                if(low_edges[c].bits[k] != 0) {
+                    low_words[low_edges[c].word[k]] |= low_edges[c].bits[k];
+                }
+                for(std::uint64_t bits = high_edges[c].bits[k]; bits != 0; bits &= bits - 1) {
+                    high.set(high_edges[c].word[k] * 64 + static_cast<size_type>(countr_zero(bits)));
+                }
+            }
+        }
+        high.build_index();
+
+        m_text = text;
+        m_text_size = n;
+        m_newlines = newlines;
+        m_low_bits = low_bits;
+        m_low_storage.swap(low_words);
+        m_low = m_low_storage.data();
+        m_low_count = m_low_storage.size();
+        m_high = std::move(high);
+        count_lines();
+    }
+
+    // A text that does not end with a newline has one more line than newlines.
+    void count_lines() noexcept
+    {
+        const size_type after_last = m_newlines == 0 ? 0 : newline(m_newlines - 1) + 1;
+        m_lines = m_newlines + (after_last < m_text_size ? 1 : 0);
+    }
+
+    // Private Member
+private:
+    string_view                 m_text;
+    size_type                   m_text_size;
+    size_type                   m_newlines;
+    size_type                   m_lines;
+    unsigned                    m_low_bits;
+    std::vector<std::uint64_t>  m_low_storage;
+    const std::uint64_t        *m_low;
+    size_type                   m_low_count;
+    bit_vector                  m_high;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_LINE_INDEX_HPP
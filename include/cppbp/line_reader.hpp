@@ -0,0 +1,177 @@
+#ifndef CPPBP_LINE_READER_HPP
+#define CPPBP_LINE_READER_HPP
+
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <cerrno>       // errno, EINTR
+#include <cstddef>      // std::size_t
+#include <cstring>      // std::memchr, std::memmove
+#include <functional>   // std::function
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument, std::length_error
+#include <system_error> // std::system_error, std::system_category
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+#include <unistd.h>     // ::read, ::ssize_t
+
+namespace cppbp {
+
+// Splits a byte stream into lines without copying them out of its buffer.
+//
+// Input is read in large blocks into one reusable buffer; lines are found with memchr, which is
+// vectorized in every common C library. A line that runs past the end of the buffer is moved to
+// its front before the next read, and the buffer grows up to max_line + 1 bytes only when a
+// single line does not fit. Lines end at '\n', which is not part of the line; the last line may
+// lack it.
+class line_reader final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+
+    // Reads at most size bytes to data and returns how many, or 0 at the end of the input.
+    using read_function = std::function<size_type(char *data, size_type size)>;
+
+    static constexpr size_type default_buffer_size  = 64 * 1024;
+    static constexpr size_type default_max_line     = 1024 * 1024;
+
+    // Construction and Assignment
+public:
+    // Reads from fd until end of file. The reader does not close fd.
+    explicit line_reader(int fd, size_type buffer_size = default_buffer_size,
+                         size_type max_line = default_max_line)
+        : line_reader{fd_reader(fd), buffer_size, max_line}
+    { }
+
+    // Throws std::invalid_argument if buffer_size is 0.
+    explicit line_reader(read_function read, size_type buffer_size = default_buffer_size,
+                         size_type max_line = default_max_line)
+        : m_read{std::move(read)}
+        , m_buffer(buffer_size)
+        , m_max_line{max_line}
+    {
+        if(buffer_size == 0) {
+            throw std::invalid_argument("line_reader: buffer size must not be 0");
+        }
+    }
+
+    line_reader(const line_reader&) = delete;
+    line_reader& operator=(const line_reader&) = delete;
+
+    // Observers
+public:
+    size_type max_line() const noexcept
+    {
+        return m_max_line;
+    }
+
+    // Lines returned so far.
+    size_type line_count() const noexcept
+    {
+        return m_lines;
+    }
+
+    // Modifiers
+public:
+    // Sets line to the next line and returns true, or returns false at the end of the input. The
+    // view stays valid until the next call. Throws std::length_error for a line longer than
+    // max_line() and std::system_error if reading the file descriptor fails.
+    bool next(string_view &line)
+    {
+        for(;;) {
+            const void *newline = std::memchr(m_buffer.data() + m_scan, '\n', m_end - m_scan);
+            if(newline) {
+                const size_type end = static_cast<size_type>(static_cast<const char*>(newline) - m_buffer.data());
+                return take(line, end, end + 1);
+            }
+            m_scan = m_end;
+            if(m_end - m_begin > m_max_line) {
+                throw std::length_error("line_reader: line exceeds the maximum length");
+            }
+            if(m_eof) {
+                if(m_begin == m_end) {
+                    return false;
+                }
+                return take(line, m_end, m_end);
+            }
+            refill();
+        }
+    }
+
+    // Calls f(line) for every remaining line.
+    template<typename Function>
+    void for_each(Function f)
+    {
+        string_view line;
+        while(next(line)) {
+            f(line);
+        }
+    }
+
+    // Helper
+private:
+    static read_function fd_reader(int fd)
+    {
+        return [fd](char *data, size_type size) -> size_type {
+            for(;;) {
+                const ::ssize_t n = ::read(fd, data, size);
+                if(n >= 0) {
+                    return static_cast<size_type>(n);
+                }
+                if(errno != EINTR) {
+                    throw std::system_error(errno, std::system_category(), "line_reader: read failed");
+                }
+            }
+        };
+    }
+
+    bool take(string_view &line, size_type end, size_type next)
+    {
+        if(end - m_begin > m_max_line) {
+            throw std::length_error("line_reader: line exceeds the maximum length");
+        }
+        line = string_view{m_buffer.data() + m_begin, end - m_begin};
+        m_begin = next;
+        m_scan = next;
+        ++m_lines;
+        return true;
+    }
+
+    // Moves the unfinished line to the front, grows the buffer if the line fills it, and reads.
+    void refill()
+    {
+        if(m_begin > 0) {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_scan -= m_begin;
+            m_begin = 0;
+        }
+        if(m_end == m_buffer.size()) {
+            // The unfinished line is at most max_line bytes; one more holds its newline unless
+            // that would wrap around.
+            const size_type limit = m_max_line == std::numeric_limits<size_type>::max() ? m_max_line : m_max_line + 1;
+            m_buffer.resize(m_buffer.size() < limit / 2 ? m_buffer.size() * 2 : limit);
+        }
+        const size_type n = m_read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+        if(n == 0) {
+            m_eof = true;
+        }
+        m_end += n;
+    }
+
+    // Private Member
+private:
+    read_function       m_read;
+    std::vector<char>   m_buffer;
+    size_type           m_max_line;
+    size_type           m_begin = 0;    // start of the next line
+    size_type           m_scan  = 0;    // bytes before this have no newline
+    size_type           m_end   = 0;    // end of the data read
+    size_type           m_lines = 0;
+    bool                m_eof   = false;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_LINE_READER_HPP
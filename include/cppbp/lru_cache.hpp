@@ -0,0 +1,769 @@
+#ifndef CPPBP_LRU_CACHE_HPP
+#define CPPBP_LRU_CACHE_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_ceil, cppbp::bit_width
+#include <cppbp/key_arena.hpp>      // cppbp::detail::key_arena
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::hash
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::mutex, std::lock_guard
+#include <new>          // placement new
+#include <stdexcept>    // std::invalid_argument
+#include <type_traits>  // std::aligned_storage
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Node pool and chained hash index shared by the cache policies. Keys live in a key_arena and
+// nodes in fixed size chunks, so neither is moved once created and a lookup never allocates.
+template<typename V, typename Hash>
+class cache_table final
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr std::uint32_t npos = 0xffffffffu;
+
+    struct node
+    {
+        const char     *key;
+        std::uint64_t   hash;
+        size_type       charge;
+        std::uint32_t   chain;
+        std::uint32_t   prev;
+        std::uint32_t   next;
+        bool            used;
+        bool            referenced;
+        typename std::aligned_storage<sizeof(V), alignof(V)>::type storage;
+
+        V& value() noexcept
+        {
+            return *reinterpret_cast<V*>(&storage);
+        }
+    };
+
+    explicit cache_table(const Hash &hash)
+        : m_hash{hash}
+        , m_node_count{0}
+        , m_size{0}
+        , m_bytes{0}
+        , m_buckets(initial_buckets, npos)
+    { }
+
+    cache_table(const cache_table&) = delete;
+    cache_table& operator=(const cache_table&) = delete;
+
+    ~cache_table()
+    {
+        clear();
+    }
+
+    std::uint64_t hash_of(string_view key) const
+    {
+        return static_cast<std::uint64_t>(m_hash(key));
+    }
+
+    node& at(std::uint32_t index) noexcept
+    {
+        return m_chunks[index / chunk_nodes][index % chunk_nodes];
+    }
+
+    const node& at(std::uint32_t index) const noexcept
+    {
+        return m_chunks[index / chunk_nodes][index % chunk_nodes];
+    }
+
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    size_type bytes() const noexcept
+    {
+        return m_bytes;
+    }
+
+    // Number of node slots ever handed out; slots below it may be used or free.
+    std::uint32_t node_count() const noexcept
+    {
+        return m_node_count;
+    }
+
+    std::uint32_t find(string_view key, std::uint64_t h) const noexcept
+    {
+        std::uint32_t index = m_buckets[static_cast<size_type>(h) & (m_buckets.size() - 1)];
+        while(index != npos) {
+            const node &n = at(index);
+            if(n.hash == h && key_arena::view_of(n.key) == key) {
+                return index;
+            }
+            index = n.chain;
+        }
+        return npos;
+    }
+
+    // Adds key, which must not be present, and returns its node.
+    std::uint32_t insert(string_view key, std::uint64_t h, const V &value, size_type charge)
+    {
+        if(m_size + 1 > m_buckets.size()) {
+            grow();
+        }
+
+        std::uint32_t index;
+        if(!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            if(m_node_count % chunk_nodes == 0) {
+                m_chunks.emplace_back(new node[chunk_nodes]);
+            }
+            index = m_node_count++;
+        }
+
+        node &n = at(index);
+        new (&n.storage) V(value);
+        n.key = m_keys.store(key);
+        n.hash = h;
+        n.charge = key.size() + charge;
+        n.prev = npos;
+        n.next = npos;
+        n.used = true;
+        n.referenced = false;
+
+        std::uint32_t &bucket = m_buckets[static_cast<size_type>(h) & (m_buckets.size() - 1)];
+        n.chain = bucket;
+        bucket = index;
+
+        ++m_size;
+        m_bytes += n.charge;
+        return index;
+    }
+
+    void set_charge(std::uint32_t index, size_type key_size, size_type charge) noexcept
+    {
+        node &n = at(index);
+        m_bytes -= n.charge;
+        n.charge = key_size + charge;
+        m_bytes += n.charge;
+    }
+
+    // Unlinks a node from the index and releases its key and value.
+    void remove(std::uint32_t index)
+    {
+        node &n = at(index);
+        std::uint32_t *link = &m_buckets[static_cast<size_type>(n.hash) & (m_buckets.size() - 1)];
+        while(*link != index) {
+            link = &at(*link).chain;
+        }
+        *link = n.chain;
+
+        n.value().~V();
+        m_keys.release(n.key);
+        n.used = false;
+        --m_size;
+        m_bytes -= n.charge;
+        m_free.push_back(index);
+    }
+
+    void clear()
+    {
+        for(std::uint32_t i = 0; i < m_node_count; ++i) {
+            node &n = at(i);
+            if(n.used) {
+                n.value().~V();
+                m_keys.release(n.key);
+                n.used = false;
+                m_free.push_back(i);
+            }
+        }
+        for(auto &bucket : m_buckets) {
+            bucket = npos;
+        }
+        m_size = 0;
+        m_bytes = 0;
+    }
+
+private:
+    static constexpr size_type chunk_nodes = 256;
+    static constexpr size_type initial_buckets = 16;
+
+    void grow()
+    {
+        std::vector<std::uint32_t> buckets(m_buckets.size() * 2, npos);
+        for(std::uint32_t i = 0; i < m_node_count; ++i) {
+            node &n = at(i);
+            if(n.used) {
+                std::uint32_t &bucket = buckets[static_cast<size_type>(n.hash) & (buckets.size() - 1)];
+                n.chain = bucket;
+                bucket = i;
+            }
+        }
+        m_buckets.swap(buckets);
+    }
+
+    Hash                                    m_hash;
+    std::uint32_t                           m_node_count;
+    size_type                               m_size;
+    size_type                               m_bytes;
+    std::vector<std::uint32_t>              m_buckets;
+    std::vector<std::unique_ptr<node[]>>    m_chunks;
+    std::vector<std::uint32_t>              m_free;
+    key_arena                               m_keys;
+};
+
+template<typename V, typename Hash>
+constexpr std::uint32_t cache_table<V, Hash>::npos;
+
+inline void check_cache_capacity(std::size_t max_entries)
+{
+    if(max_entries == 0) {
+        throw std::invalid_argument("cache: max_entries must not be zero");
+    }
+}
+
+} // namespace detail
+
+template<typename Cache>
+class sharded_cache;
+
+// Least recently used cache keyed by string_view.
+//
+// Capacity is bounded by the number of entries and, if max_bytes is not zero, by the sum of the
+// key sizes and the charge given to put(). A hit moves the entry to the front of an intrusive
+// list and never allocates; keys are copied into arena memory once on insertion.
+template<typename V, typename Hash = cppbp::hash<string_view>>
+class lru_cache final
+{
+    template<typename Cache>
+    friend class sharded_cache;
+
+    // Types
+public:
+    using key_type      = string_view;
+    using mapped_type   = V;
+    using size_type     = std::size_t;
+    using hasher        = Hash;
+
+    // Construction and Assignment
+public:
+    explicit lru_cache(size_type max_entries, size_type max_bytes = 0, const Hash &hash = Hash())
+        : m_table{hash}
+        , m_max_entries{max_entries}
+        , m_max_bytes{max_bytes}
+        , m_head{table::npos}
+        , m_tail{table::npos}
+    {
+        detail::check_cache_capacity(max_entries);
+    }
+
+    lru_cache(const lru_cache&) = delete;
+    lru_cache& operator=(const lru_cache&) = delete;
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_table.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type bytes() const noexcept
+    {
+        return m_table.bytes();
+    }
+
+    size_type max_entries() const noexcept
+    {
+        return m_max_entries;
+    }
+
+    size_type max_bytes() const noexcept
+    {
+        return m_max_bytes;
+    }
+
+    // Lookup
+public:
+    // Copies the value of key to out and marks it as most recently used.
+    bool get(string_view key, V &out)
+    {
+        return get(key, m_table.hash_of(key), out);
+    }
+
+    // Calls f(const V&) with the value of key and marks it as most recently used.
+    template<typename Function>
+    bool visit(string_view key, Function f)
+    {
+        return visit(key, m_table.hash_of(key), f);
+    }
+
+    // Does not change the recency of key.
+    bool contains(string_view key) const
+    {
+        return m_table.find(key, m_table.hash_of(key)) != table::npos;
+    }
+
+    // Modifiers
+public:
+    // Inserts or replaces key and evicts least recently used entries until the cache fits its
+    // capacity again. Entries that alone exceed max_bytes are not cached.
+    void put(string_view key, const V &value, size_type charge = sizeof(V))
+    {
+        put(key, m_table.hash_of(key), value, charge);
+    }
+
+    bool erase(string_view key)
+    {
+        return erase(key, m_table.hash_of(key));
+    }
+
+    void clear()
+    {
+        m_table.clear();
+        m_head = table::npos;
+        m_tail = table::npos;
+    }
+
+    // Helper
+private:
+    using table = detail::cache_table<V, Hash>;
+
+    bool get(string_view key, std::uint64_t h, V &out)
+    {
+        const std::uint32_t index = m_table.find(key, h);
+        if(index == table::npos) {
+            return false;
+        }
+        touch(index);
+        out = m_table.at(index).value();
+        return true;
+    }
+
+    template<typename Function>
+    bool visit(string_view key, std::uint64_t h, Function &f)
+    {
+        const std::uint32_t index = m_table.find(key, h);
+        if(index == table::npos) {
+            return false;
+        }
+        touch(index);
+        f(static_cast<const V&>(m_table.at(index).value()));
+        return true;
+    }
+
+    void put(string_view key, std::uint64_t h, const V &value, size_type charge)
+    {
+        std::uint32_t index = m_table.find(key, h);
+        if(m_max_bytes != 0 && key.size() + charge > m_max_bytes) {
+            if(index != table::npos) {
+                unlink(index);
+                m_table.remove(index);
+            }
+            return;
+        }
+        if(index != table::npos) {
+            m_table.at(index).value() = value;
+            m_table.set_charge(index, key.size(), charge);
+            touch(index);
+        } else {
+            index = m_table.insert(key, h, value, charge);
+            link_front(index);
+        }
+        while(m_table.size() > m_max_entries || (m_max_bytes != 0 && m_table.bytes() > m_max_bytes)) {
+            const std::uint32_t victim = m_tail;
+            unlink(victim);
+            m_table.remove(victim);
+        }
+    }
+
+    bool erase(string_view key, std::uint64_t h)
+    {
+        const std::uint32_t index = m_table.find(key, h);
+        if(index == table::npos) {
+            return false;
+        }
+        unlink(index);
+        m_table.remove(index);
+        return true;
+    }
+
+    void touch(std::uint32_t index) noexcept
+    {
+        if(index != m_head) {
+            unlink(index);
+            link_front(index);
+        }
+    }
+
+    void link_front(std::uint32_t index) noexcept
+    {
+        auto &n = m_table.at(index);
+        n.prev = table::npos;
+        n.next = m_head;
+        if(m_head != table::npos) {
+            m_table.at(m_head).prev = index;
+        } else {
+            m_tail = index;
+        }
+        m_head = index;
+    }
+
+    void unlink(std::uint32_t index) noexcept
+    {
+        auto &n = m_table.at(index);
+        if(n.prev != table::npos) {
+            m_table.at(n.prev).next = n.next;
+        } else {
+            m_head = n.next;
+        }
+        if(n.next != table::npos) {
+            m_table.at(n.next).prev = n.prev;
+        } else {
+            m_tail = n.prev;
+        }
+    }
+
+    // Private Member
+private:
+    table           m_table;
+    size_type       m_max_entries;
+    size_type       m_max_bytes;
+    std::uint32_t   m_head;
+    std::uint32_t   m_tail;
+};
+
+// CLOCK (second chance) approximation of LRU keyed by string_view.
+//
+// A hit only sets a reference bit instead of relinking a list, which keeps the critical section
+// of the sharded variant short. On eviction a hand sweeps the node slots, clearing set bits and
+// evicting the first entry without one. Capacity works as for lru_cache.
+template<typename V, typename Hash = cppbp::hash<string_view>>
+class clock_cache final
+{
+    template<typename Cache>
+    friend class sharded_cache;
+
+    // Types
+public:
+    using key_type      = string_view;
+    using mapped_type   = V;
+    using size_type     = std::size_t;
+    using hasher        = Hash;
+
+    // Construction and Assignment
+public:
+    explicit clock_cache(size_type max_entries, size_type max_bytes = 0, const Hash &hash = Hash())
+        : m_table{hash}
+        , m_max_entries{max_entries}
+        , m_max_bytes{max_bytes}
+        , m_hand{0}
+    {
+        detail::check_cache_capacity(max_entries);
+    }
+
+    clock_cache(const clock_cache&) = delete;
+    clock_cache& operator=(const clock_cache&) = delete;
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_table.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type bytes() const noexcept
+    {
+        return m_table.bytes();
+    }
+
+    size_type max_entries() const noexcept
+    {
+        return m_max_entries;
+    }
+
+    size_type max_bytes() const noexcept
+    {
+        return m_max_bytes;
+    }
+
+    // Lookup
+public:
+    bool get(string_view key, V &out)
+    {
+        return get(key, m_table.hash_of(key), out);
+    }
+
+    template<typename Function>
+    bool visit(string_view key, Function f)
+    {
+        return visit(key, m_table.hash_of(key), f);
+    }
+
+    bool contains(string_view key) const
+    {
+        return m_table.find(key, m_table.hash_of(key)) != table::npos;
+    }
+
+    // Modifiers
+public:
+    void put(string_view key, const V &value, size_type charge = sizeof(V))
+    {
+        put(key, m_table.hash_of(key), value, charge);
+    }
+
+    bool erase(string_view key)
+    {
+        return erase(key, m_table.hash_of(key));
+    }
+
+    void clear()
+    {
+        m_table.clear();
+        m_hand = 0;
+    }
+
+    // Helper
+private:
+    using table = detail::cache_table<V, Hash>;
+
+    bool get(string_view key, std::uint64_t h, V &out)
+    {
+        const std::uint32_t index = m_table.find(key, h);
+        if(index == table::npos) {
+            return false;
+        }
+        auto &n = m_table.at(index);
+        n.referenced = true;
+        out = n.value();
+        return true;
+    }
+
+    template<typename Function>
+    bool visit(string_view key, std::uint64_t h, Function &f)
+    {
+        const std::uint32_t index = m_table.find(key, h);
+        if(index == table::npos) {
+            return false;
+        }
+        auto &n = m_table.at(index);
+        n.referenced = true;
+        f(static_cast<const V&>(n.value()));
+        return true;
+    }
+
+    void put(string_view key, std::uint64_t h, const V &value, size_type charge)
+    {
+        std::uint32_t index = m_table.find(key, h);
+        if(m_max_bytes != 0 && key.size() + charge > m_max_bytes) {
+            if(index != table::npos) {
+                m_table.remove(index);
+            }
+            return;
+        }
+        if(index != table::npos) {
+            m_table.at(index).value() = value;
+            m_table.at(index).referenced = true;
+            m_table.set_charge(index, key.size(), charge);
+        } else {
+            index = m_table.insert(key, h, value, charge);
+        }
+        while(m_table.size() > m_max_entries || (m_max_bytes != 0 && m_table.bytes() > m_max_bytes)) {
+            evict_one(index);
+        }
+    }
+
+    bool erase(string_view key, std::uint64_t h)
+    {
+        const std::uint32_t index = m_table.find(key, h);
+        if(index == table::npos) {
+            return false;
+        }
+        m_table.remove(index);
+        return true;
+    }
+
+    // Evicts one entry other than keep; the newest entry is not its own victim.
+    void evict_one(std::uint32_t keep)
+    {
+        for(;;) {
+            if(m_hand >= m_table.node_count()) {
+                m_hand = 0;
+            }
+            const std::uint32_t index = m_hand++;
+            auto &n = m_table.at(index);
+            if(!n.used || index == keep) {
+                continue;
+            }
+            if(n.referenced) {
+                n.referenced = false;
+                continue;
+            }
+            m_table.remove(index);
+            return;
+        }
+    }
+
+    // Private Member
+private:
+    table           m_table;
+    size_type       m_max_entries;
+    size_type       m_max_bytes;
+    std::uint32_t   m_hand;
+};
+
+// Splits a cache into independently locked shards for concurrent use. The key is hashed once; its
+// high bits select the shard and the shard's index uses the low bits. Capacities are divided
+// evenly between the shards.
+template<typename Cache>
+class sharded_cache final
+{
+    // Types
+public:
+    using key_type      = string_view;
+    using mapped_type   = typename Cache::mapped_type;
+    using size_type     = std::size_t;
+    using hasher        = typename Cache::hasher;
+
+    static constexpr size_type default_shard_count = 16;
+
+    // Construction and Assignment
+public:
+    explicit sharded_cache(size_type max_entries, size_type max_bytes = 0,
+                           size_type shard_count = default_shard_count, const hasher &hash = hasher())
+        : m_hash{hash}
+        , m_shard_count{bit_ceil(shard_count == 0 ? size_type{1} : shard_count)}
+        , m_shard_shift{64 - bit_width(m_shard_count - 1)}
+    {
+        detail::check_cache_capacity(max_entries);
+        const size_type entries = (max_entries + m_shard_count - 1) / m_shard_count;
+        const size_type bytes = (max_bytes + m_shard_count - 1) / m_shard_count;
+        for(size_type i = 0; i < m_shard_count; ++i) {
+            m_shards.emplace_back(new shard{entries, bytes, hash});
+        }
+    }
+
+    // Capacity
+public:
+    size_type size() const
+    {
+        size_type result = 0;
+        for(const auto &s : m_shards) {
+            std::lock_guard<std::mutex> lock{s->mutex};
+            result += s->cache.size();
+        }
+        return result;
+    }
+
+    size_type bytes() const
+    {
+        size_type result = 0;
+        for(const auto &s : m_shards) {
+            std::lock_guard<std::mutex> lock{s->mutex};
+            result += s->cache.bytes();
+        }
+        return result;
+    }
+
+    size_type shard_count() const noexcept
+    {
+        return m_shard_count;
+    }
+
+    // Lookup
+public:
+    bool get(string_view key, mapped_type &out)
+    {
+        const std::uint64_t h = hash_of(key);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+        return s.cache.get(key, h, out);
+    }
+
+    // Calls f(const mapped_type&) under the shard lock.
+    template<typename Function>
+    bool visit(string_view key, Function f)
+    {
+        const std::uint64_t h = hash_of(key);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+        return s.cache.visit(key, h, f);
+    }
+
+    // Modifiers
+public:
+    void put(string_view key, const mapped_type &value, size_type charge = sizeof(mapped_type))
+    {
+        const std::uint64_t h = hash_of(key);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+        s.cache.put(key, h, value, charge);
+    }
+
+    bool erase(string_view key)
+    {
+        const std::uint64_t h = hash_of(key);
+        shard &s = shard_for(h);
+        std::lock_guard<std::mutex> lock{s.mutex};
+        return s.cache.erase(key, h);
+    }
+
+    void clear()
+    {
+        for(auto &s : m_shards) {
+            std::lock_guard<std::mutex> lock{s->mutex};
+            s->cache.clear();
+        }
+    }
+
+    // Helper
+private:
+    struct shard
+    {
+        shard(size_type max_entries, size_type max_bytes, const hasher &hash)
+            : cache{max_entries, max_bytes, hash}
+        { }
+
+        mutable std::mutex  mutex;
+        Cache               cache;
+    };
+
+    std::uint64_t hash_of(string_view key) const
+    {
+        return static_cast<std::uint64_t>(m_hash(key));
+    }
+
+    shard& shard_for(std::uint64_t h) const noexcept
+    {
+        return *m_shards[m_shard_count == 1 ? 0 : static_cast<size_type>(h >> m_shard_shift)];
+    }
+
+    // Private Member
+private:
+    hasher                                  m_hash;
+    size_type                               m_shard_count;
+    int                                     m_shard_shift;
+    std::vector<std::unique_ptr<shard>>     m_shards;
+};
+
+template<typename V, typename Hash = cppbp::hash<string_view>>
+using concurrent_lru_cache = sharded_cache<lru_cache<V, Hash>>;
+
+template<typename V, typename Hash = cppbp::hash<string_view>>
+using concurrent_clock_cache = sharded_cache<clock_cache<V, Hash>>;
+
+} // namespace cppbp
+
+#endif // CPPBP_LRU_CACHE_HPP
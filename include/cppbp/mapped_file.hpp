@@ -0,0 +1,156 @@
+#ifndef CPPBP_MAPPED_FILE_HPP
+#define CPPBP_MAPPED_FILE_HPP
+
+#include <cppbp/cstring_view.hpp>   // cppbp::cstring_view
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t
+#include <string>       // std::string
+#include <system_error> // std::system_error, std::system_category
+#include <utility>      // std::move, std::swap
+
+#include <fcntl.h>      // ::open, O_RDONLY, O_CLOEXEC
+#include <sys/mman.h>   // ::mmap, ::munmap, ::madvise
+#include <sys/stat.h>   // ::fstat
+#include <unistd.h>     // ::close
+
+namespace cppbp {
+
+// Read only memory mapping of a whole file. Pages are loaded on first access.
+class mapped_file final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    enum class access_pattern
+    {
+        normal,
+        sequential,
+        random,
+        will_need
+    };
+
+    // Construction and Assignment
+public:
+    mapped_file() noexcept
+        : m_data{nullptr}
+        , m_size{0}
+    { }
+
+    // Throws std::system_error if the file cannot be opened or mapped.
+    explicit mapped_file(cstring_view path)
+        : mapped_file{}
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0) {
+            throw std::system_error(errno, std::system_category(), error_message("mapped_file: cannot open ", path));
+        }
+        struct ::stat info;
+        if(::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::system_category(), error_message("mapped_file: cannot stat ", path));
+        }
+        m_size = static_cast<size_type>(info.st_size);
+        if(m_size > 0) {
+            void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::system_category(), error_message("mapped_file: cannot map ", path));
+            }
+            m_data = static_cast<const unsigned char*>(data);
+        }
+        ::close(fd);
+    }
+
+    mapped_file(mapped_file &&other) noexcept
+        : m_data{other.m_data}
+        , m_size{other.m_size}
+    {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    mapped_file& operator=(mapped_file &&other) noexcept
+    {
+        mapped_file tmp{std::move(other)};
+        std::swap(m_data, tmp.m_data);
+        std::swap(m_size, tmp.m_size);
+        return *this;
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+        if(m_data) {
+            ::munmap(const_cast<unsigned char*>(m_data), m_size);
+        }
+    }
+
+    // Observers
+public:
+    const unsigned char* data() const noexcept
+    {
+        return m_data;
+    }
+
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    span<const unsigned char> bytes() const noexcept
+    {
+        return span<const unsigned char>{m_data, m_size};
+    }
+
+    string_view view() const noexcept
+    {
+        return string_view{reinterpret_cast<const char*>(m_data), m_size};
+    }
+
+    // Modifiers
+public:
+    // Tells the kernel how the mapping will be read. Advice is a hint; failures are ignored.
+    void advise(access_pattern pattern) const noexcept
+    {
+        if(!m_data) {
+            return;
+        }
+        int advice = MADV_NORMAL;
+        switch(pattern) {
+            case access_pattern::normal:     advice = MADV_NORMAL;     break;
+            case access_pattern::sequential: advice = MADV_SEQUENTIAL; break;
+            case access_pattern::random:     advice = MADV_RANDOM;     break;
+            case access_pattern::will_need:  advice = MADV_WILLNEED;   break;
+        }
+        ::madvise(const_cast<unsigned char*>(m_data), m_size, advice);
+    }
+
+    // Helper
+private:
+    static std::string error_message(const char *what, cstring_view path)
+    {
+        return std::string{what}.append(path.data(), path.size());
+    }
+
+    // Private Member
+private:
+    const unsigned char    *m_data;
+    size_type               m_size;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_MAPPED_FILE_HPP
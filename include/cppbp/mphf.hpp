@@ -0,0 +1,547 @@
+#ifndef CPPBP_MPHF_HPP
+#define CPPBP_MPHF_HPP
+
+#include <cppbp/hash.hpp>           // cppbp::detail::hash_mix, cppbp::detail::hash_mul128
+#include <cppbp/span.hpp>           // cppbp::span, cppbp::detail::read_aligned
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::detail::hash_key
+#include <cppbp/thread_pool.hpp>    // cppbp::thread_pool, cppbp::detail::for_range
+
+#include <algorithm>    // std::find, std::sort
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint16_t, std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy, std::memcmp, std::memset
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::runtime_error
+#include <utility>      // std::swap
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// One independently built part of a minimal perfect hash function.
+struct mphf_partition
+{
+    std::uint64_t   key_offset;
+    std::uint64_t   pilot_offset;
+    std::uint64_t   free_offset;
+    std::uint32_t   size;
+    std::uint32_t   table_size;
+    std::uint32_t   bucket_count;
+    std::uint32_t   reserved;
+};
+
+} // namespace detail
+
+// Minimal perfect hash function for a static set of strings (PTHash).
+//
+// Maps the n keys it was built from onto [0, n) without collisions, so a plain array indexed by
+// the result can hold their values. Keys are split into partitions of about 100k by their hash
+// and every partition is built on its own, in parallel when a thread_pool is given. Within a
+// partition the keys are grouped into buckets, and each bucket gets a 16 bit pilot that sends all
+// of its keys to free slots of a table 1% larger than the partition. Slots past the end are
+// remapped through a small array. A lookup hashes the key and reads one pilot, plus one remap
+// entry for about 1% of the keys; about 5.3 bits per key in total.
+//
+// Keys that were not in the set map to arbitrary indices; store the keys next to the values if
+// membership must be checked.
+class mphf final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    // Construction and Assignment
+public:
+    mphf() noexcept
+        : m_seed{detail::default_hash_seed}
+        , m_key_count{0}
+        , m_partitions{nullptr}
+        , m_pilots{nullptr}
+        , m_free{nullptr}
+        , m_partition_count{0}
+        , m_pilot_count{0}
+        , m_free_count{0}
+    { }
+
+    // Throws std::invalid_argument if keys contains duplicates.
+    explicit mphf(span<const string_view> keys, std::uint64_t seed = detail::default_hash_seed)
+        : mphf{}
+    {
+        build(keys, nullptr, seed);
+    }
+
+    // Hashes the keys and builds the partitions on the threads of pool.
+    mphf(span<const string_view> keys, thread_pool &pool, std::uint64_t seed = detail::default_hash_seed)
+        : mphf{}
+    {
+        build(keys, &pool, seed);
+    }
+
+    mphf(const mphf &other)
+        : mphf{}
+    {
+        copy_from(other);
+    }
+
+    mphf(mphf &&other) noexcept
+        : mphf{}
+    {
+        swap(other);
+    }
+
+    mphf& operator=(mphf other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    // Copies a function out of a buffer written by serialize().
+    static mphf deserialize(span<const unsigned char> bytes)
+    {
+        return detail::read_aligned(bytes, [](span<const unsigned char> copy) {
+            const mphf borrowed = borrow(copy);
+            mphf result;
+            result.copy_from(borrowed);
+            return result;
+        });
+    }
+
+    // Reads the pilots and free slots straight from a serialize() buffer, such as a memory mapped
+    // file, which must be 8 byte aligned and stay valid while the result is used.
+    static mphf borrow(span<const unsigned char> bytes)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % 8 != 0) {
+            throw std::invalid_argument("mphf::borrow: buffer is not 8 byte aligned");
+        }
+        if(bytes.size() < header_size || std::memcmp(bytes.data(), magic(), 4) != 0) {
+            throw std::invalid_argument("mphf: not a serialized mphf");
+        }
+        std::uint64_t header[header_size / 8];
+        std::memcpy(header, bytes.data(), header_size);
+        const std::uint64_t partitions = header[3];
+        const std::uint64_t pilots = header[4];
+        const std::uint64_t free = header[5];
+        const std::uint64_t limit = bytes.size();
+        if(partitions > limit / sizeof(detail::mphf_partition) || pilots > limit || free > limit
+           || header_size + partitions * sizeof(detail::mphf_partition) + padded(pilots * 2) + padded(free * 4) > limit) {
+            throw std::invalid_argument("mphf: truncated buffer");
+        }
+
+        mphf result;
+        result.m_seed = header[1];
+        result.m_key_count = static_cast<size_type>(header[2]);
+        result.m_partition_count = static_cast<size_type>(partitions);
+        result.m_pilot_count = static_cast<size_type>(pilots);
+        result.m_free_count = static_cast<size_type>(free);
+        const unsigned char *p = bytes.data() + header_size;
+        result.m_partitions = reinterpret_cast<const detail::mphf_partition*>(p);
+        p += partitions * sizeof(detail::mphf_partition);
+        result.m_pilots = reinterpret_cast<const std::uint16_t*>(p);
+        p += padded(pilots * 2);
+        result.m_free = reinterpret_cast<const std::uint32_t*>(p);
+
+        // Lookups trust the partitions and the remapped slots; make sure none of them reaches past
+        // the arrays or the keys of its partition. The offsets are checked first so that the
+        // remaining space cannot wrap around.
+        std::uint64_t keys = 0;
+        for(size_type i = 0; i < result.m_partition_count; ++i) {
+            const detail::mphf_partition &part = result.m_partitions[i];
+            if(part.key_offset != keys || part.table_size < part.size
+               || part.pilot_offset > pilots || part.bucket_count > pilots - part.pilot_offset
+               || part.free_offset > free || part.table_size - part.size > free - part.free_offset
+               || (part.size != 0 && part.bucket_count == 0)) {
+                throw std::invalid_argument("mphf: corrupt buffer");
+            }
+            for(std::uint64_t j = 0; j < part.table_size - part.size; ++j) {
+                if(result.m_free[part.free_offset + j] >= part.size) {
+                    throw std::invalid_argument("mphf: corrupt buffer");
+                }
+            }
+            keys += part.size;
+        }
+        if(keys != header[2]) {
+            throw std::invalid_argument("mphf: corrupt buffer");
+        }
+        return result;
+    }
+
+    // Capacity
+public:
+    // Number of keys, and the exclusive upper bound of the results.
+    size_type size() const noexcept
+    {
+        return m_key_count;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_key_count == 0;
+    }
+
+    double bits_per_key() const noexcept
+    {
+        return m_key_count == 0 ? 0.0 : static_cast<double>(serialized_size()) * 8.0 / static_cast<double>(m_key_count);
+    }
+
+    // Lookup
+public:
+    std::uint64_t hash(string_view key) const noexcept
+    {
+        return detail::hash_key(key, m_seed);
+    }
+
+    // Index of key in [0, size()). Keys outside the set give an arbitrary index in that range.
+    size_type operator()(string_view key) const noexcept
+    {
+        return lookup_hash(hash(key));
+    }
+
+    size_type lookup_hash(std::uint64_t h) const noexcept
+    {
+        if(m_partition_count == 0) {
+            return 0;
+        }
+        const detail::mphf_partition &part = m_partitions[partition_of(h, m_partition_count)];
+        if(part.size == 0) {
+            return 0;
+        }
+        const std::uint16_t pilot = m_pilots[part.pilot_offset + bucket_of(h, part.bucket_count)];
+        const std::uint64_t slot = position(position_hash(h), pilot, part.table_size);
+        if(slot < part.size) {
+            return static_cast<size_type>(part.key_offset + slot);
+        }
+        return static_cast<size_type>(part.key_offset + m_free[part.free_offset + slot - part.size]);
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const noexcept
+    {
+        return header_size + m_partition_count * sizeof(detail::mphf_partition)
+            + padded(m_pilot_count * 2) + padded(m_free_count * 4);
+    }
+
+    // Writes the function into out, which must hold serialized_size() bytes.
+    void serialize(span<unsigned char> out) const
+    {
+        if(out.size() < serialized_size()) {
+            throw std::length_error("mphf::serialize: buffer too small");
+        }
+        std::memset(out.data(), 0, serialized_size());
+        const std::uint64_t header[header_size / 8] = {
+            0, m_seed, m_key_count, m_partition_count, m_pilot_count, m_free_count
+        };
+        unsigned char *p = out.data();
+        std::memcpy(p, header, header_size);
+        std::memcpy(p, magic(), 4);
+        p += header_size;
+        p = write_array(p, m_partitions, m_partition_count * sizeof(detail::mphf_partition));
+        p = write_array(p, m_pilots, m_pilot_count * 2);
+        write_array(p, m_free, m_free_count * 4);
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> result(serialized_size());
+        serialize(span<unsigned char>{result.data(), result.size()});
+        return result;
+    }
+
+    void swap(mphf &other) noexcept
+    {
+        std::swap(m_seed, other.m_seed);
+        std::swap(m_key_count, other.m_key_count);
+        m_partition_storage.swap(other.m_partition_storage);
+        m_pilot_storage.swap(other.m_pilot_storage);
+        m_free_storage.swap(other.m_free_storage);
+        std::swap(m_partitions, other.m_partitions);
+        std::swap(m_pilots, other.m_pilots);
+        std::swap(m_free, other.m_free);
+        std::swap(m_partition_count, other.m_partition_count);
+        std::swap(m_pilot_count, other.m_pilot_count);
+        std::swap(m_free_count, other.m_free_count);
+    }
+
+    // Helper
+private:
+    static constexpr size_type header_size = 48;
+    static constexpr size_type partition_keys = 100000;
+    static constexpr unsigned max_attempts = 8;
+    static constexpr std::uint32_t max_pilot = 0xffff;
+
+    static const char* magic() noexcept
+    {
+        return "CMP1";
+    }
+
+    // Result of building one partition.
+    struct partition_build
+    {
+        std::vector<std::uint16_t>  pilots;
+        std::vector<std::uint32_t>  free;
+        std::uint32_t               table_size;
+        bool                        duplicate;
+        bool                        failed;
+    };
+
+    static std::uint64_t padded(std::uint64_t bytes) noexcept
+    {
+        return (bytes + 7) & ~std::uint64_t{7};
+    }
+
+    static std::uint64_t mul_high(std::uint64_t a, std::uint64_t b) noexcept
+    {
+        detail::hash_mul128(a, b);
+        return b;
+    }
+
+    static size_type partition_of(std::uint64_t h, size_type count) noexcept
+    {
+        return static_cast<size_type>(mul_high(h, count));
+    }
+
+    // Skewed bucket choice: 60% of the keys share 30% of the buckets. Those dense buckets are
+    // placed first while the table is still empty, which keeps the pilots small.
+    static std::uint32_t bucket_of(std::uint64_t h, std::uint32_t bucket_count) noexcept
+    {
+        const std::uint64_t b = detail::hash_mix(h, 0x9e3779b97f4a7c15ull);
+        const std::uint32_t dense = static_cast<std::uint32_t>(bucket_count * std::uint64_t{3} / 10);
+        const std::uint64_t x = b >> 32;
+        if(dense != 0 && static_cast<std::uint32_t>(b) < 0x9999999au) {
+            return static_cast<std::uint32_t>((x * dense) >> 32);
+        }
+        return dense + static_cast<std::uint32_t>((x * (bucket_count - dense)) >> 32);
+    }
+
+    static std::uint64_t position_hash(std::uint64_t h) noexcept
+    {
+        return detail::hash_mix(h, 0xc2b2ae3d27d4eb4full);
+    }
+
+    static std::uint64_t position(std::uint64_t h2, std::uint64_t pilot, std::uint32_t table_size) noexcept
+    {
+        return mul_high(h2 ^ detail::hash_mix(pilot + 1, 0x165667b19e3779f9ull), table_size);
+    }
+
+    void build(span<const string_view> keys, thread_pool *pool, std::uint64_t seed)
+    {
+        if(keys.size() > 0xffffffffu) {
+            throw std::length_error("mphf: too many keys");
+        }
+        const size_type n = keys.size();
+        const size_type partition_count = (n + partition_keys - 1) / partition_keys;
+        std::vector<std::uint64_t> hashes(n);
+        std::vector<std::uint64_t> grouped(n);
+        bool duplicate = false;
+        for(unsigned attempt = 0; attempt < max_attempts; ++attempt) {
+            const std::uint64_t s = seed + attempt * 0x9e3779b97f4a7c15ull;
+            detail::for_range(pool, n, [&](size_type begin, size_type end) {
+                for(size_type i = begin; i < end; ++i) {
+                    hashes[i] = detail::hash_key(keys[i], s);
+                }
+            });
+
+            // Group the hashes by partition.
+            std::vector<std::uint64_t> offsets(partition_count + 1, 0);
+            for(const std::uint64_t h : hashes) {
+                ++offsets[partition_of(h, partition_count) + 1];
+            }
+            for(size_type p = 0; p < partition_count; ++p) {
+                offsets[p + 1] += offsets[p];
+            }
+            std::vector<std::uint64_t> fill(offsets.begin(), offsets.end() - (partition_count != 0 ? 1 : 0));
+            for(const std::uint64_t h : hashes) {
+                grouped[fill[partition_of(h, partition_count)]++] = h;
+            }
+
+            std::vector<partition_build> parts(partition_count);
+            detail::for_range(pool, partition_count, [&](size_type begin, size_type end) {
+                for(size_type p = begin; p < end; ++p) {
+                    build_partition(&grouped[offsets[p]], static_cast<size_type>(offsets[p + 1] - offsets[p]), parts[p]);
+                }
+            });
+
+            bool collision = false;
+            bool failed = false;
+            for(const auto &part : parts) {
+                collision = collision || part.duplicate;
+                failed = failed || part.failed || part.duplicate;
+            }
+            // Equal hashes under two different seeds are equal keys.
+            if(collision && duplicate) {
+                throw std::invalid_argument("mphf: duplicate keys");
+            }
+            duplicate = collision;
+            if(failed) {
+                continue;
+            }
+
+            m_seed = s;
+            m_key_count = n;
+            for(size_type p = 0; p < partition_count; ++p) {
+                detail::mphf_partition info;
+                info.key_offset = offsets[p];
+                info.pilot_offset = m_pilot_storage.size();
+                info.free_offset = m_free_storage.size();
+                info.size = static_cast<std::uint32_t>(offsets[p + 1] - offsets[p]);
+                info.table_size = parts[p].table_size;
+                info.bucket_count = static_cast<std::uint32_t>(parts[p].pilots.size());
+                info.reserved = 0;
+                m_partition_storage.push_back(info);
+                m_pilot_storage.insert(m_pilot_storage.end(), parts[p].pilots.begin(), parts[p].pilots.end());
+                m_free_storage.insert(m_free_storage.end(), parts[p].free.begin(), parts[p].free.end());
+            }
+            sync();
+            return;
+        }
+        throw std::runtime_error("mphf: construction failed");
+    }
+
+    static void build_partition(std::uint64_t *hashes, size_type n, partition_build &out)
+    {
+        out.duplicate = false;
+        out.failed = false;
+        out.table_size = static_cast<std::uint32_t>(n + (n + 98) / 99);
+        if(n == 0) {
+            return;
+        }
+        std::sort(hashes, hashes + n);
+        for(size_type i = 1; i < n; ++i) {
+            if(hashes[i] == hashes[i - 1]) {
+                out.duplicate = true;
+                return;
+            }
+        }
+
+        // c * n / log2(n) buckets with c = 5.
+        unsigned log2 = 1;
+        while(log2 < 63 && (size_type{1} << (log2 + 1)) <= n) {
+            ++log2;
+        }
+        const std::uint32_t bucket_count = static_cast<std::uint32_t>((5 * n + log2 - 1) / log2);
+
+        // Keys sorted by bucket, buckets by decreasing size.
+        std::vector<std::uint32_t> bucket_start(bucket_count + 1, 0);
+        std::vector<std::uint32_t> buckets(n);
+        for(size_type i = 0; i < n; ++i) {
+            buckets[i] = bucket_of(hashes[i], bucket_count);
+            ++bucket_start[buckets[i] + 1];
+        }
+        std::uint32_t largest = 0;
+        for(std::uint32_t b = 0; b < bucket_count; ++b) {
+            largest = bucket_start[b + 1] > largest ? bucket_start[b + 1] : largest;
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        std::vector<std::uint64_t> by_bucket(n);
+        {
+            std::vector<std::uint32_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+            for(size_type i = 0; i < n; ++i) {
+                by_bucket[fill[buckets[i]]++] = position_hash(hashes[i]);
+            }
+        }
+        std::vector<std::uint32_t> size_start(largest + 2, 0);
+        for(std::uint32_t b = 0; b < bucket_count; ++b) {
+            ++size_start[largest - (bucket_start[b + 1] - bucket_start[b]) + 1];
+        }
+        for(std::uint32_t s = 0; s <= largest; ++s) {
+            size_start[s + 1] += size_start[s];
+        }
+        std::vector<std::uint32_t> order(bucket_count);
+        for(std::uint32_t b = 0; b < bucket_count; ++b) {
+            order[size_start[largest - (bucket_start[b + 1] - bucket_start[b])]++] = b;
+        }
+
+        const std::uint32_t table_size = out.table_size;
+        std::vector<std::uint64_t> taken((table_size + 63) / 64, 0);
+        std::vector<std::uint64_t> slots;
+        slots.reserve(largest);
+        out.pilots.assign(bucket_count, 0);
+        for(const std::uint32_t b : order) {
+            if(bucket_start[b + 1] == bucket_start[b]) {
+                break;
+            }
+            std::uint32_t pilot = 0;
+            for(;; ++pilot) {
+                if(pilot > max_pilot) {
+                    out.failed = true;
+                    return;
+                }
+                slots.clear();
+                bool fits = true;
+                for(std::uint32_t k = bucket_start[b]; k < bucket_start[b + 1] && fits; ++k) {
+                    const std::uint64_t slot = position(by_bucket[k], pilot, table_size);
+                    fits = (taken[slot / 64] >> (slot % 64) & 1u) == 0
+                        && std::find(slots.begin(), slots.end(), slot) == slots.end();
+                    slots.push_back(slot);
+                }
+                if(fits) {
+                    break;
+                }
+            }
+            for(const std::uint64_t slot : slots) {
+                taken[slot / 64] |= std::uint64_t{1} << (slot % 64);
+            }
+            out.pilots[b] = static_cast<std::uint16_t>(pilot);
+        }
+
+        // Every taken slot past n moves to a free slot below n.
+        out.free.assign(table_size - n, 0);
+        std::uint32_t next = 0;
+        for(std::uint32_t slot = static_cast<std::uint32_t>(n); slot < table_size; ++slot) {
+            if(taken[slot / 64] >> (slot % 64) & 1u) {
+                while(taken[next / 64] >> (next % 64) & 1u) {
+                    ++next;
+                }
+                out.free[slot - n] = next++;
+            }
+        }
+    }
+
+    void copy_from(const mphf &other)
+    {
+        m_seed = other.m_seed;
+        m_key_count = other.m_key_count;
+        m_partition_storage.assign(other.m_partitions, other.m_partitions + other.m_partition_count);
+        m_pilot_storage.assign(other.m_pilots, other.m_pilots + other.m_pilot_count);
+        m_free_storage.assign(other.m_free, other.m_free + other.m_free_count);
+        sync();
+    }
+
+    template<typename T>
+    static unsigned char* write_array(unsigned char *p, const T *data, size_type bytes) noexcept
+    {
+        if(bytes != 0) {
+            std::memcpy(p, data, bytes);
+        }
+        return p + padded(bytes);
+    }
+
+    // Points the accessors at the owned storage.
+    void sync() noexcept
+    {
+        m_partitions = m_partition_storage.data();
+        m_pilots = m_pilot_storage.data();
+        m_free = m_free_storage.data();
+        m_partition_count = m_partition_storage.size();
+        m_pilot_count = m_pilot_storage.size();
+        m_free_count = m_free_storage.size();
+    }
+
+    // Private Member
+private:
+    std::uint64_t                           m_seed;
+    size_type                               m_key_count;
+    std::vector<detail::mphf_partition>     m_partition_storage;
+    std::vector<std::uint16_t>              m_pilot_storage;
+    std::vector<std::uint32_t>              m_free_storage;
+    const detail::mphf_partition           *m_partitions;
+    const std::uint16_t                    *m_pilots;
+    const std::uint32_t                    *m_free;
+    size_type                               m_partition_count;
+    size_type                               m_pilot_count;
+    size_type                               m_free_count;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_MPHF_HPP
@@ -0,0 +1,222 @@
+#ifndef CPPBP_MULTI_SEARCHER_HPP
+#define CPPBP_MULTI_SEARCHER_HPP
+
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <algorithm>    // std::sort
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument, std::length_error
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+constexpr std::size_t   multi_searcher_alphabet = 256;
+constexpr std::uint32_t multi_searcher_none     = std::numeric_limits<std::uint32_t>::max();
+
+} // namespace detail
+
+// Aho-Corasick searcher for a set of byte patterns. Finds every occurrence of every pattern,
+// overlapping ones included, in a single pass over the haystack.
+//
+// The automaton is a full DFA with 256 transitions per state, so each input byte costs one table
+// lookup no matter how many patterns there are. Memory is 1 KiB per state, and there is at most
+// one state per pattern byte. The patterns are not kept; only their lengths are.
+class multi_searcher final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+    using state_type    = std::uint32_t;
+
+    struct match
+    {
+        size_type position;
+        size_type pattern;
+
+        friend bool operator==(const match &lhs, const match &rhs) noexcept
+        {
+            return lhs.position == rhs.position && lhs.pattern == rhs.pattern;
+        }
+
+        friend bool operator!=(const match &lhs, const match &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const match &lhs, const match &rhs) noexcept
+        {
+            return lhs.position != rhs.position ? lhs.position < rhs.position : lhs.pattern < rhs.pattern;
+        }
+    };
+
+    // Construction
+public:
+    // Pattern i is reported as match::pattern == i. Duplicates are reported once per copy.
+    // Throws std::invalid_argument for an empty pattern.
+    explicit multi_searcher(const std::vector<string_view> &patterns)
+        : m_next(detail::multi_searcher_alphabet, 0)
+        , m_report(1, 0)
+        , m_dict(1, 0)
+        , m_first(1, detail::multi_searcher_none)
+        , m_same(patterns.size(), detail::multi_searcher_none)
+        , m_lengths(patterns.size())
+        , m_max_length{0}
+    {
+        size_type total = 0;
+        for(const auto pattern : patterns) {
+            if(pattern.empty()) {
+                throw std::invalid_argument("multi_searcher: patterns must not be empty");
+            }
+            total += pattern.size();
+        }
+        if(total >= std::numeric_limits<state_type>::max() || patterns.size() >= detail::multi_searcher_none) {
+            throw std::length_error("multi_searcher: too many pattern bytes");
+        }
+        for(size_type i = 0; i < patterns.size(); ++i) {
+            insert(patterns[i], static_cast<state_type>(i));
+        }
+        link();
+    }
+
+    // Observers
+public:
+    size_type pattern_count() const noexcept
+    {
+        return m_lengths.size();
+    }
+
+    size_type pattern_length(size_type pattern) const noexcept
+    {
+        return m_lengths[pattern];
+    }
+
+    size_type max_pattern_length() const noexcept
+    {
+        return m_max_length;
+    }
+
+    size_type state_count() const noexcept
+    {
+        return m_first.size();
+    }
+
+    // Searching
+public:
+    // Calls f(match) for every occurrence, ordered by the end of the match.
+    template<typename Function>
+    void for_each_match(string_view haystack, Function f) const
+    {
+        scan(start(), haystack, [&](size_type end, size_type pattern) {
+            f(match{end - m_lengths[pattern], pattern});
+        });
+    }
+
+    // Every occurrence, ordered by position and then pattern.
+    std::vector<match> find_all(string_view haystack) const
+    {
+        std::vector<match> result;
+        for_each_match(haystack, [&](match m) { result.push_back(m); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Automaton
+public:
+    // State before any input.
+    state_type start() const noexcept
+    {
+        return 0;
+    }
+
+    // Feeds chunk to the automaton in state and returns the new state. For every pattern ending
+    // in the chunk, calls f(end, pattern) with the offset one past its last byte in the chunk; it
+    // may have started in an earlier chunk.
+    template<typename Function>
+    state_type scan(state_type state, string_view chunk, Function f) const
+    {
+        const unsigned char *p = reinterpret_cast<const unsigned char*>(chunk.data());
+        for(size_type i = 0; i < chunk.size(); ++i) {
+            state = m_next[static_cast<size_type>(state) * detail::multi_searcher_alphabet + p[i]];
+            for(state_type t = m_report[state]; t != 0; t = m_dict[t]) {
+                for(state_type pattern = m_first[t]; pattern != detail::multi_searcher_none; pattern = m_same[pattern]) {
+                    f(i + 1, static_cast<size_type>(pattern));
+                }
+            }
+        }
+        return state;
+    }
+
+    // Helper
+private:
+    // Adds the trie path of pattern; missing edges stay 0 until link().
+    void insert(string_view pattern, state_type id)
+    {
+        size_type state = 0;
+        for(const char c : pattern) {
+            const size_type edge = state * detail::multi_searcher_alphabet + static_cast<unsigned char>(c);
+            if(m_next[edge] == 0) {
+                m_next[edge] = static_cast<state_type>(m_first.size());
+                m_next.resize(m_next.size() + detail::multi_searcher_alphabet, 0);
+                m_report.push_back(0);
+                m_dict.push_back(0);
+                m_first.push_back(detail::multi_searcher_none);
+            }
+            state = m_next[edge];
+        }
+        // Keep duplicates in id order.
+        state_type *slot = &m_first[state];
+        while(*slot != detail::multi_searcher_none) {
+            slot = &m_same[*slot];
+        }
+        *slot = id;
+        m_lengths[id] = pattern.size();
+        m_max_length = pattern.size() > m_max_length ? pattern.size() : m_max_length;
+    }
+
+    // Breadth first over the trie: fills the missing edges from the failure state, whose row is
+    // already complete, and links every state to the longest proper suffix with a pattern.
+    void link()
+    {
+        std::vector<state_type> fail(m_first.size(), 0);
+        std::vector<state_type> queue;
+        queue.reserve(m_first.size());
+        for(size_type c = 0; c < detail::multi_searcher_alphabet; ++c) {
+            if(m_next[c] != 0) {
+                queue.push_back(m_next[c]);
+            }
+        }
+        for(size_type head = 0; head < queue.size(); ++head) {
+            const state_type s = queue[head];
+            m_dict[s] = m_report[fail[s]];
+            m_report[s] = m_first[s] != detail::multi_searcher_none ? s : m_dict[s];
+            for(size_type c = 0; c < detail::multi_searcher_alphabet; ++c) {
+                state_type &edge = m_next[static_cast<size_type>(s) * detail::multi_searcher_alphabet + c];
+                const state_type via_fail = m_next[static_cast<size_type>(fail[s]) * detail::multi_searcher_alphabet + c];
+                if(edge != 0) {
+                    fail[edge] = via_fail;
+                    queue.push_back(edge);
+                } else {
+                    edge = via_fail;
+                }
+            }
+        }
+    }
+
+    // Private Member
+private:
+    std::vector<state_type> m_next;     // state * 256 + byte -> state
+    std::vector<state_type> m_report;   // first state on the suffix chain with a pattern, or 0
+    std::vector<state_type> m_dict;     // m_report of the failure state
+    std::vector<state_type> m_first;    // first pattern ending at the state
+    std::vector<state_type> m_same;     // next pattern equal to this one
+    std::vector<size_type>  m_lengths;
+    size_type               m_max_length;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_MULTI_SEARCHER_HPP
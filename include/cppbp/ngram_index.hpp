@@ -0,0 +1,391 @@
+#ifndef CPPBP_NGRAM_INDEX_HPP
+#define CPPBP_NGRAM_INDEX_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::popcount
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/key_arena.hpp>      // cppbp::detail::key_arena
+#include <cppbp/string_search.hpp>  // cppbp::searcher
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <algorithm>        // std::sort, std::unique
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint32_t
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <unordered_map>    // std::unordered_map
+#include <utility>          // std::pair
+#include <vector>           // std::vector
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_cmpgt_epi32, _mm_movemask_ps, _mm256_cmpgt_epi32, ...
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// Number of values in p[0, n) that are less than x.
+inline std::size_t count_less(const std::uint32_t *p, std::size_t n, std::uint32_t x) noexcept
+{
+    std::size_t result = 0;
+    std::size_t i = 0;
+    // There is no unsigned compare; flipping the sign bit keeps the order for a signed one.
+#if defined(__AVX2__)
+    const __m256i bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256i key = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(x)), bias);
+    for(; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), bias);
+        result += static_cast<std::size_t>(popcount(static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(key, v))))));
+    }
+#elif defined(CPPBP_HAS_SSE2)
+    const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i key = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(x)), bias);
+    for(; i + 4 <= n; i += 4) {
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), bias);
+        result += static_cast<std::size_t>(popcount(static_cast<unsigned>(
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(key, v))))));
+    }
+#endif
+    for(; i < n; ++i) {
+        result += p[i] < x ? 1 : 0;
+    }
+    return result;
+}
+
+// Increasing document ids in blocks of 128: the first id of every block is stored as is, the
+// others as variable length deltas. The block heads allow galloping to the block of an id
+// without decoding the ones before it.
+class posting_list final
+{
+public:
+    static constexpr std::size_t block_size = 128;
+
+    posting_list() noexcept
+        : m_last{0}
+        , m_size{0}
+    { }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    std::size_t block_count() const noexcept
+    {
+        return m_first.size();
+    }
+
+    const std::uint32_t* block_heads() const noexcept
+    {
+        return m_first.data();
+    }
+
+    // id must be greater than every id added before.
+    void push_back(std::uint32_t id)
+    {
+        if(m_size % block_size == 0) {
+            m_first.push_back(id);
+            m_offset.push_back(static_cast<std::uint32_t>(m_bytes.size()));
+        } else {
+            std::uint32_t delta = id - m_last;
+            while(delta >= 0x80) {
+                m_bytes.push_back(static_cast<unsigned char>(delta | 0x80));
+                delta >>= 7;
+            }
+            m_bytes.push_back(static_cast<unsigned char>(delta));
+        }
+        m_last = id;
+        ++m_size;
+    }
+
+    // Writes the ids of block b to out, which holds block_size values, and returns their count.
+    std::size_t decode(std::size_t b, std::uint32_t *out) const noexcept
+    {
+        const std::size_t count = m_size - b * block_size < block_size ? m_size - b * block_size : block_size;
+        const unsigned char *p = m_bytes.data() + m_offset[b];
+        std::uint32_t id = m_first[b];
+        out[0] = id;
+        for(std::size_t i = 1; i < count; ++i) {
+            std::uint32_t delta = 0;
+            unsigned shift = 0;
+            for(;;) {
+                const unsigned char byte = *p++;
+                delta |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+                if(byte < 0x80) {
+                    break;
+                }
+                shift += 7;
+            }
+            id += delta;
+            out[i] = id;
+        }
+        return count;
+    }
+
+    std::vector<std::uint32_t> decode_all() const
+    {
+        std::vector<std::uint32_t> result(m_first.size() * block_size);
+        std::size_t size = 0;
+        for(std::size_t b = 0; b < m_first.size(); ++b) {
+            size += decode(b, result.data() + size);
+        }
+        result.resize(size);
+        return result;
+    }
+
+    std::size_t memory_usage() const noexcept
+    {
+        return (m_first.capacity() + m_offset.capacity()) * sizeof(std::uint32_t) + m_bytes.capacity();
+    }
+
+private:
+    std::vector<std::uint32_t>  m_first;
+    std::vector<std::uint32_t>  m_offset;
+    std::vector<unsigned char>  m_bytes;
+    std::uint32_t               m_last;
+    std::size_t                 m_size;
+};
+
+} // namespace detail
+
+// Inverted index of the 3-grams of many short documents, for substring search.
+//
+// Every document gets an increasing id and is listed in the compressed posting list of each of
+// its distinct 3-grams. A search intersects the lists of the pattern's 3-grams, starting from the
+// shortest: each candidate gallops over the block heads of the next list and is then looked up in
+// one decoded block with SIMD compares. The surviving candidates are verified with a searcher, so
+// results are exact. Patterns shorter than three bytes scan all documents.
+//
+// Removed documents stay in the posting lists until compact(), which runs on its own once they
+// outnumber the live ones.
+class ngram_index final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+    using document_id   = std::uint32_t;
+
+    struct memory_stats
+    {
+        size_type   postings;   // posting lists and their table
+        size_type   documents;  // document texts and the id table
+    };
+
+    // Construction and Assignment
+public:
+    ngram_index() noexcept
+        : m_live{0}
+        , m_stale{0}
+    { }
+
+    // Capacity
+public:
+    // Number of documents that have not been removed.
+    size_type size() const noexcept
+    {
+        return m_live;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_live == 0;
+    }
+
+    memory_stats memory_usage() const noexcept
+    {
+        memory_stats result;
+        result.postings = m_lists.bucket_count() * sizeof(void*)
+            + m_lists.size() * (sizeof(std::pair<const std::uint32_t, detail::posting_list>) + 2 * sizeof(void*));
+        for(const auto &entry : m_lists) {
+            result.postings += entry.second.memory_usage();
+        }
+        result.documents = m_documents.capacity() * sizeof(const char*) + m_arena.allocated();
+        return result;
+    }
+
+    // Lookup
+public:
+    bool has_document(document_id id) const noexcept
+    {
+        return id < m_documents.size() && m_documents[id] != nullptr;
+    }
+
+    // Throws std::out_of_range if there is no such document.
+    string_view document(document_id id) const
+    {
+        if(!has_document(id)) {
+            throw std::out_of_range("ngram_index::document: unknown document");
+        }
+        return detail::key_arena::view_of(m_documents[id]);
+    }
+
+    // Ids of the documents containing pattern, in increasing order.
+    std::vector<document_id> search(string_view pattern) const
+    {
+        std::vector<document_id> result;
+        const searcher verify{pattern};
+        if(pattern.size() < gram_size) {
+            for(document_id id = 0; id < m_documents.size(); ++id) {
+                if(m_documents[id] && verify.search(detail::key_arena::view_of(m_documents[id])) != searcher::npos) {
+                    result.push_back(id);
+                }
+            }
+            return result;
+        }
+
+        std::vector<const detail::posting_list*> lists;
+        for(const std::uint32_t gram : grams_of(pattern)) {
+            const auto it = m_lists.find(gram);
+            if(it == m_lists.end()) {
+                return result;
+            }
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const detail::posting_list *a, const detail::posting_list *b) {
+            return a->size() < b->size();
+        });
+
+        std::vector<document_id> candidates = lists[0]->decode_all();
+        for(size_type l = 1; l < lists.size() && !candidates.empty(); ++l) {
+            intersect(candidates, *lists[l]);
+        }
+        for(const document_id id : candidates) {
+            if(m_documents[id] && verify.search(detail::key_arena::view_of(m_documents[id])) != searcher::npos) {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+    // Modifiers
+public:
+    // Indexes a copy of text and returns its id.
+    document_id add(string_view text)
+    {
+        if(m_documents.size() >= 0xffffffffu) {
+            throw std::length_error("ngram_index::add: out of document ids");
+        }
+        const document_id id = static_cast<document_id>(m_documents.size());
+        m_documents.push_back(m_arena.store(text));
+        for(const std::uint32_t gram : grams_of(text)) {
+            m_lists[gram].push_back(id);
+        }
+        ++m_live;
+        return id;
+    }
+
+    // Returns false if there is no such document.
+    bool remove(document_id id)
+    {
+        if(!has_document(id)) {
+            return false;
+        }
+        m_arena.release(m_documents[id]);
+        m_documents[id] = nullptr;
+        --m_live;
+        ++m_stale;
+        if(m_stale > compact_threshold && m_stale > m_live) {
+            compact();
+        }
+        return true;
+    }
+
+    // Drops removed documents from the posting lists.
+    void compact()
+    {
+        for(auto it = m_lists.begin(); it != m_lists.end();) {
+            detail::posting_list compacted;
+            for(const document_id id : it->second.decode_all()) {
+                if(m_documents[id]) {
+                    compacted.push_back(id);
+                }
+            }
+            if(compacted.size() == 0) {
+                it = m_lists.erase(it);
+            } else {
+                it->second = std::move(compacted);
+                ++it;
+            }
+        }
+        m_stale = 0;
+    }
+
+    // Helper
+private:
+    static constexpr size_type gram_size = 3;
+    static constexpr size_type compact_threshold = 4096;
+
+    // Distinct 3-grams of text as 24 bit keys.
+    static std::vector<std::uint32_t> grams_of(string_view text)
+    {
+        std::vector<std::uint32_t> grams;
+        if(text.size() < gram_size) {
+            return grams;
+        }
+        grams.reserve(text.size() - 2);
+        const unsigned char *p = reinterpret_cast<const unsigned char*>(text.data());
+        std::uint32_t gram = (static_cast<std::uint32_t>(p[0]) << 8) | p[1];
+        for(size_type i = 2; i < text.size(); ++i) {
+            gram = ((gram << 8) | p[i]) & 0xffffff;
+            grams.push_back(gram);
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+
+    // Keeps the candidates that are also in list.
+    static void intersect(std::vector<document_id> &candidates, const detail::posting_list &list)
+    {
+        const std::uint32_t *heads = list.block_heads();
+        const size_type blocks = list.block_count();
+        std::uint32_t decoded[detail::posting_list::block_size];
+        size_type decoded_block = blocks;
+        size_type length = 0;
+        size_type pos = 0;
+        size_type block = 0;
+        size_type kept = 0;
+        for(const document_id id : candidates) {
+            if(heads[block] > id) {
+                continue;
+            }
+            // Gallop to the last block whose head is not greater than id.
+            size_type step = 1;
+            while(block + step < blocks && heads[block + step] <= id) {
+                block += step;
+                step *= 2;
+            }
+            size_type last = block + step < blocks ? block + step : blocks;
+            while(last - block > 1) {
+                const size_type mid = block + (last - block) / 2;
+                if(heads[mid] <= id) {
+                    block = mid;
+                } else {
+                    last = mid;
+                }
+            }
+            if(block != decoded_block) {
+                length = list.decode(block, decoded);
+                decoded_block = block;
+                pos = 0;
+            }
+            pos += detail::count_less(decoded + pos, length - pos, id);
+            if(pos < length && decoded[pos] == id) {
+                candidates[kept++] = id;
+            }
+        }
+        candidates.resize(kept);
+    }
+
+    // Private Member
+private:
+    detail::key_arena                                       m_arena;
+    std::vector<const char*>                                m_documents;
+    std::unordered_map<std::uint32_t, detail::posting_list> m_lists;
+    size_type                                               m_live;
+    size_type                                               m_stale;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_NGRAM_INDEX_HPP
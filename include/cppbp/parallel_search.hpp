@@ -0,0 +1,124 @@
+#ifndef CPPBP_PARALLEL_SEARCH_HPP
+#define CPPBP_PARALLEL_SEARCH_HPP
+
+#include <cppbp/multi_searcher.hpp> // cppbp::multi_searcher
+#include <cppbp/string_search.hpp>  // cppbp::searcher, cppbp::search_mode
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+#include <cppbp/thread_pool.hpp>    // cppbp::thread_pool
+
+#include <algorithm>    // std::sort
+#include <cstddef>      // std::size_t
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Bytes of haystack searched by one task.
+constexpr std::size_t parallel_search_chunk = std::size_t{1} << 20;
+
+// Splits haystack into chunks and calls search(begin, end, matches) on the pool for every chunk,
+// a few chunks per thread at a time, so memory for the matches stays bounded. Each chunk is
+// searched a little past its end, but only matches starting in [begin, end) are kept, so a match
+// across a boundary is found exactly once. emit(match) then runs on the calling thread, in order.
+template<typename Match, typename Search, typename Emit>
+void parallel_chunks(std::size_t size, thread_pool &pool, Search search, Emit emit)
+{
+    const std::size_t chunk_count = (size + parallel_search_chunk - 1) / parallel_search_chunk;
+    const std::size_t wave = pool.size() * 4;
+    std::vector<std::vector<Match>> results(chunk_count < wave ? chunk_count : wave);
+    for(std::size_t first = 0; first < chunk_count; first += wave) {
+        const std::size_t count = chunk_count - first < wave ? chunk_count - first : wave;
+        pool.parallel_for(count, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t j = begin; j < end; ++j) {
+                const std::size_t chunk_begin = (first + j) * parallel_search_chunk;
+                const std::size_t chunk_end = size - chunk_begin < parallel_search_chunk ? size : chunk_begin + parallel_search_chunk;
+                results[j].clear();
+                search(chunk_begin, chunk_end, results[j]);
+            }
+        });
+        for(std::size_t j = 0; j < count; ++j) {
+            for(const Match &m : results[j]) {
+                emit(m);
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+// Calls f(position) on the calling thread for every occurrence of needle in haystack, in
+// increasing order, while the pool searches chunks of the haystack in parallel. The chunks
+// overlap by needle.size() - 1 bytes. Non-overlapping matches are chosen left to right from all
+// matches after the parallel part, which gives the same result as find_all().
+template<typename Function>
+void parallel_for_each_match(string_view haystack, string_view needle, thread_pool &pool, Function f,
+                             search_mode mode = search_mode::non_overlapping)
+{
+    const std::size_t m = needle.size();
+    if(m == 0) {
+        for(std::size_t pos = 0; pos <= haystack.size(); ++pos) {
+            f(pos);
+        }
+        return;
+    }
+    const searcher search{needle};
+    std::size_t allowed = 0;
+    detail::parallel_chunks<std::size_t>(haystack.size(), pool,
+        [&](std::size_t begin, std::size_t end, std::vector<std::size_t> &matches) {
+            const std::size_t stop = haystack.size() - end < m - 1 ? haystack.size() : end + m - 1;
+            const string_view part = haystack.substr(begin, stop - begin);
+            for(std::size_t pos = search.search(part, 0); pos != searcher::npos && begin + pos < end;
+                pos = search.search(part, pos + 1)) {
+                matches.push_back(begin + pos);
+            }
+        },
+        [&](std::size_t pos) {
+            if(mode == search_mode::overlapping || pos >= allowed) {
+                f(pos);
+                allowed = pos + m;
+            }
+        });
+}
+
+// Every occurrence of needle in haystack, in increasing order.
+inline std::vector<std::size_t> parallel_find_all(string_view haystack, string_view needle, thread_pool &pool,
+                                                  search_mode mode = search_mode::non_overlapping)
+{
+    std::vector<std::size_t> result;
+    parallel_for_each_match(haystack, needle, pool, [&](std::size_t pos) { result.push_back(pos); }, mode);
+    return result;
+}
+
+// Calls f(match) on the calling thread for every occurrence of every pattern, ordered by
+// position and then pattern. The chunks overlap by max_pattern_length() - 1 bytes.
+template<typename Function>
+void parallel_for_each_match(string_view haystack, const multi_searcher &searcher, thread_pool &pool, Function f)
+{
+    using match = multi_searcher::match;
+    const std::size_t overlap = searcher.max_pattern_length() > 0 ? searcher.max_pattern_length() - 1 : 0;
+    detail::parallel_chunks<match>(haystack.size(), pool,
+        [&](std::size_t begin, std::size_t end, std::vector<match> &matches) {
+            const std::size_t stop = haystack.size() - end < overlap ? haystack.size() : end + overlap;
+            searcher.for_each_match(haystack.substr(begin, stop - begin), [&](match m) {
+                if(begin + m.position < end) {
+                    matches.push_back(match{begin + m.position, m.pattern});
+                }
+            });
+            std::sort(matches.begin(), matches.end());
+        },
+        [&](const match &m) { f(m); });
+}
+
+// Every occurrence of every pattern, ordered by position and then pattern.
+inline std::vector<multi_searcher::match> parallel_find_all(string_view haystack, const multi_searcher &searcher,
+                                                            thread_pool &pool)
+{
+    std::vector<multi_searcher::match> result;
+    parallel_for_each_match(haystack, searcher, pool, [&](const multi_searcher::match &m) { result.push_back(m); });
+    return result;
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_PARALLEL_SEARCH_HPP
@@ -0,0 +1,527 @@
+#ifndef CPPBP_RANDOM_HPP
+#define CPPBP_RANDOM_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::rotl
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/hash.hpp>           // cppbp::detail::hash_mix, cppbp::detail::hash_mul128
+#include <cppbp/span.hpp>           // cppbp::span
+
+#include <array>        // std::array
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument
+#include <type_traits>  // std::integral_constant, std::is_integral, std::make_unsigned
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_slli_epi64, _mm_add_epi64, _mm256_xor_si256, ...
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+constexpr std::uint64_t default_random_seed = 0x853c49e6748fea9bull;
+
+// SplitMix64, which turns one seed word into as many well mixed state words as needed.
+inline std::uint64_t splitmix64(std::uint64_t &state) noexcept
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+} // namespace detail
+
+// Engines
+//
+// All engines satisfy UniformRandomBitGenerator, so they work with the <random> distributions
+// and std::shuffle as well as with the functions further down. Their state is a few words and
+// a step costs a handful of instructions, against 2.5 KB of state for std::mt19937_64.
+
+// xoshiro256** by Blackman and Vigna: 256 bits of state, period 2^256 - 1. jump() advances it by
+// 2^128 steps, which splits one seed into non-overlapping streams for parallel use.
+class xoshiro256ss final
+{
+    // Types
+public:
+    using result_type = std::uint64_t;
+    using state_type  = std::array<std::uint64_t, 4>;
+
+    // Construction
+public:
+    explicit xoshiro256ss(std::uint64_t seed = detail::default_random_seed) noexcept
+    {
+        this->seed(seed);
+    }
+
+    // Restores a state returned by state(). Throws std::invalid_argument for the all zero state,
+    // which the generator never leaves.
+    explicit xoshiro256ss(const state_type &state)
+        : m_state(state)
+    {
+        if((state[0] | state[1] | state[2] | state[3]) == 0) {
+            throw std::invalid_argument("xoshiro256ss: state must not be all zero");
+        }
+    }
+
+    void seed(std::uint64_t seed) noexcept
+    {
+        for(auto &word : m_state) {
+            word = detail::splitmix64(seed);
+        }
+    }
+
+    // Observers
+public:
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    const state_type& state() const noexcept
+    {
+        return m_state;
+    }
+
+    // Generation
+public:
+    result_type operator()() noexcept
+    {
+        std::uint64_t *s = m_state.data();
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void discard(unsigned long long count) noexcept
+    {
+        for(; count > 0; --count) {
+            (*this)();
+        }
+    }
+
+    void jump() noexcept
+    {
+        static const std::uint64_t polynomial[] = {
+            0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+        };
+        state_type jumped{};
+        for(const std::uint64_t word : polynomial) {
+            for(int bit = 0; bit < 64; ++bit) {
+                if(word & (std::uint64_t{1} << bit)) {
+                    for(std::size_t i = 0; i < jumped.size(); ++i) {
+                        jumped[i] ^= m_state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        m_state = jumped;
+    }
+
+    friend bool operator==(const xoshiro256ss &lhs, const xoshiro256ss &rhs) noexcept
+    {
+        return lhs.m_state == rhs.m_state;
+    }
+
+    friend bool operator!=(const xoshiro256ss &lhs, const xoshiro256ss &rhs) noexcept
+    {
+        return lhs.m_state != rhs.m_state;
+    }
+
+    // Private Member
+private:
+    state_type  m_state;
+};
+
+// wyrand by Wang Yi: a 64 bit counter pushed through the multiply-xor mix of the string hash.
+// The fastest engine here, with period 2^64; every seed is valid.
+class wyrand final
+{
+    // Types
+public:
+    using result_type = std::uint64_t;
+
+    // Construction
+public:
+    explicit wyrand(std::uint64_t seed = detail::default_random_seed) noexcept
+        : m_state{seed}
+    { }
+
+    void seed(std::uint64_t seed) noexcept
+    {
+        m_state = seed;
+    }
+
+    // Observers
+public:
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    std::uint64_t state() const noexcept
+    {
+        return m_state;
+    }
+
+    // Generation
+public:
+    result_type operator()() noexcept
+    {
+        m_state += detail::hash_secret0;
+        return detail::hash_mix(m_state, m_state ^ detail::hash_secret1);
+    }
+
+    void discard(unsigned long long count) noexcept
+    {
+        m_state += detail::hash_secret0 * count;
+    }
+
+    friend bool operator==(const wyrand &lhs, const wyrand &rhs) noexcept
+    {
+        return lhs.m_state == rhs.m_state;
+    }
+
+    friend bool operator!=(const wyrand &lhs, const wyrand &rhs) noexcept
+    {
+        return lhs.m_state != rhs.m_state;
+    }
+
+    // Private Member
+private:
+    std::uint64_t   m_state;
+};
+
+// PCG32 (PCG-XSH-RR) by O'Neill: a 64 bit LCG with a permuted 32 bit output. The stream
+// selects one of 2^63 distinct sequences for the same seed.
+class pcg32 final
+{
+    // Types
+public:
+    using result_type = std::uint32_t;
+
+    // Construction
+public:
+    explicit pcg32(std::uint64_t seed = detail::default_random_seed, std::uint64_t stream = 0xda3e39cb94b95bdbull) noexcept
+    {
+        this->seed(seed, stream);
+    }
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0xda3e39cb94b95bdbull) noexcept
+    {
+        m_state = 0;
+        m_increment = (stream << 1) | 1;
+        (*this)();
+        m_state += seed;
+        (*this)();
+    }
+
+    // Observers
+public:
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    // Generation
+public:
+    result_type operator()() noexcept
+    {
+        const std::uint64_t old = m_state;
+        m_state = old * 6364136223846793005ull + m_increment;
+        const std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        return rotr(xorshifted, static_cast<int>(old >> 59));
+    }
+
+    void discard(unsigned long long count) noexcept
+    {
+        for(; count > 0; --count) {
+            (*this)();
+        }
+    }
+
+    friend bool operator==(const pcg32 &lhs, const pcg32 &rhs) noexcept
+    {
+        return lhs.m_state == rhs.m_state && lhs.m_increment == rhs.m_increment;
+    }
+
+    friend bool operator!=(const pcg32 &lhs, const pcg32 &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    // Private Member
+private:
+    std::uint64_t   m_state;
+    std::uint64_t   m_increment;
+};
+
+// Four xoshiro256** streams stepped side by side, for filling large buffers. Stream k is the
+// seeded generator jumped k times. The outputs are interleaved stream by stream, and the
+// sequence is the same with AVX2, SSE2 or neither.
+class xoshiro256ss_x4 final
+{
+    // Types
+public:
+    using result_type = std::uint64_t;
+
+    // Construction
+public:
+    explicit xoshiro256ss_x4(std::uint64_t seed = detail::default_random_seed) noexcept
+    {
+        xoshiro256ss stream{seed};
+        for(std::size_t lane = 0; lane < 4; ++lane) {
+            for(std::size_t word = 0; word < 4; ++word) {
+                m_state[word][lane] = stream.state()[word];
+            }
+            stream.jump();
+        }
+    }
+
+    // Generation
+public:
+    // Fills out with the next out.size() outputs. A size that is not a multiple of four drops
+    // the unused outputs of the last step.
+    void fill(span<std::uint64_t> out) noexcept
+    {
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        fill_avx2(out, i);
+#elif defined(CPPBP_HAS_SSE2)
+        fill_sse2(out, i);
+#endif
+        for(; i < out.size(); i += 4) {
+            std::uint64_t block[4];
+            step(block);
+            for(std::size_t lane = 0; lane < 4 && i + lane < out.size(); ++lane) {
+                out[i + lane] = block[lane];
+            }
+        }
+    }
+
+    // Helper
+private:
+    void step(std::uint64_t *result) noexcept
+    {
+        std::uint64_t (&s)[4][4] = m_state;
+        for(std::size_t lane = 0; lane < 4; ++lane) {
+            result[lane] = rotl(s[1][lane] * 5, 7) * 9;
+            const std::uint64_t t = s[1][lane] << 17;
+            s[2][lane] ^= s[0][lane];
+            s[3][lane] ^= s[1][lane];
+            s[1][lane] ^= s[2][lane];
+            s[0][lane] ^= s[3][lane];
+            s[2][lane] ^= t;
+            s[3][lane] = rotl(s[3][lane], 45);
+        }
+    }
+
+    // There is no 64 bit vector multiply below AVX-512, but * 5 and * 9 are a shift and an add.
+#if defined(__AVX2__)
+    void fill_avx2(span<std::uint64_t> out, std::size_t &i) noexcept
+    {
+        __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_state[0]));
+        __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_state[1]));
+        __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_state[2]));
+        __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_state[3]));
+        for(; i + 4 <= out.size(); i += 4) {
+            const __m256i x5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+            const __m256i r = _mm256_or_si256(_mm256_slli_epi64(x5, 7), _mm256_srli_epi64(x5, 57));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + i), _mm256_add_epi64(_mm256_slli_epi64(r, 3), r));
+            const __m256i t = _mm256_slli_epi64(s1, 17);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_state[0]), s0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_state[1]), s1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_state[2]), s2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_state[3]), s3);
+    }
+#elif defined(CPPBP_HAS_SSE2)
+    // Lanes 0 and 1 in the first register of each pair, lanes 2 and 3 in the second.
+    void fill_sse2(span<std::uint64_t> out, std::size_t &i) noexcept
+    {
+        __m128i s[4][2];
+        for(std::size_t word = 0; word < 4; ++word) {
+            for(std::size_t half = 0; half < 2; ++half) {
+                s[word][half] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_state[word] + 2 * half));
+            }
+        }
+        for(; i + 4 <= out.size(); i += 4) {
+            for(std::size_t half = 0; half < 2; ++half) {
+                const __m128i x5 = _mm_add_epi64(_mm_slli_epi64(s[1][half], 2), s[1][half]);
+                const __m128i r = _mm_or_si128(_mm_slli_epi64(x5, 7), _mm_srli_epi64(x5, 57));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i + 2 * half), _mm_add_epi64(_mm_slli_epi64(r, 3), r));
+                const __m128i t = _mm_slli_epi64(s[1][half], 17);
+                s[2][half] = _mm_xor_si128(s[2][half], s[0][half]);
+                s[3][half] = _mm_xor_si128(s[3][half], s[1][half]);
+                s[1][half] = _mm_xor_si128(s[1][half], s[2][half]);
+                s[0][half] = _mm_xor_si128(s[0][half], s[3][half]);
+                s[2][half] = _mm_xor_si128(s[2][half], t);
+                s[3][half] = _mm_or_si128(_mm_slli_epi64(s[3][half], 45), _mm_srli_epi64(s[3][half], 19));
+            }
+        }
+        for(std::size_t word = 0; word < 4; ++word) {
+            for(std::size_t half = 0; half < 2; ++half) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(m_state[word] + 2 * half), s[word][half]);
+            }
+        }
+    }
+#endif
+
+    // Private Member
+private:
+    std::uint64_t   m_state[4][4];  // [word][stream]
+};
+
+// Distributions
+
+namespace detail {
+
+template<typename Generator>
+using random_bits = std::integral_constant<int,
+    Generator::min() == 0 && Generator::max() == std::numeric_limits<std::uint64_t>::max() ? 64
+  : Generator::min() == 0 && Generator::max() == std::numeric_limits<std::uint32_t>::max() ? 32 : 0>;
+
+template<typename Generator>
+std::uint64_t random64(Generator &g, std::integral_constant<int, 64>)
+{
+    return static_cast<std::uint64_t>(g());
+}
+
+template<typename Generator>
+std::uint64_t random64(Generator &g, std::integral_constant<int, 32>)
+{
+    const std::uint64_t high = static_cast<std::uint32_t>(g());
+    return (high << 32) | static_cast<std::uint32_t>(g());
+}
+
+template<typename Generator>
+std::uint64_t uniform_below(Generator &g, std::uint64_t bound, std::integral_constant<int, 64>)
+{
+    std::uint64_t low = g();
+    std::uint64_t high = bound;
+    hash_mul128(low, high);
+    if(low < bound) {
+        const std::uint64_t threshold = (0 - bound) % bound;
+        while(low < threshold) {
+            low = g();
+            high = bound;
+            hash_mul128(low, high);
+        }
+    }
+    return high;
+}
+
+// A 32 bit generator takes two calls per 64 bit word; bounds that fit in 32 bits need one.
+template<typename Generator>
+std::uint64_t uniform_below(Generator &g, std::uint64_t bound, std::integral_constant<int, 32>)
+{
+    if(bound > std::numeric_limits<std::uint32_t>::max()) {
+        std::uint64_t low = random64(g, std::integral_constant<int, 32>{});
+        std::uint64_t high = bound;
+        hash_mul128(low, high);
+        if(low < bound) {
+            const std::uint64_t threshold = (0 - bound) % bound;
+            while(low < threshold) {
+                low = random64(g, std::integral_constant<int, 32>{});
+                high = bound;
+                hash_mul128(low, high);
+            }
+        }
+        return high;
+    }
+    const std::uint32_t bound32 = static_cast<std::uint32_t>(bound);
+    std::uint64_t product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(g())) * bound32;
+    if(static_cast<std::uint32_t>(product) < bound32) {
+        const std::uint32_t threshold = (0 - bound32) % bound32;
+        while(static_cast<std::uint32_t>(product) < threshold) {
+            product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(g())) * bound32;
+        }
+    }
+    return product >> 32;
+}
+
+} // namespace detail
+
+// 64 random bits from any generator whose results cover the full 32 or 64 bit range.
+template<typename Generator>
+std::uint64_t random64(Generator &g)
+{
+    static_assert(detail::random_bits<Generator>::value != 0,
+                  "random64: the generator must produce full 32 or 64 bit words");
+    return detail::random64(g, detail::random_bits<Generator>{});
+}
+
+// A uniformly distributed integer in [0, bound), for bound > 0.
+//
+// Lemire's nearly divisionless method: the top half of random * bound is the result, and only
+// when the low half falls into the biased sliver below bound does it compute the exact rejection
+// threshold with a division. For bounds far below 2^64 that almost never happens, so the common
+// path is one multiplication. Recent libstdc++ uses the same method in
+// std::uniform_int_distribution; older standard libraries, and MSVC, divide on every call.
+template<typename Generator>
+std::uint64_t uniform_below(Generator &g, std::uint64_t bound)
+{
+    static_assert(detail::random_bits<Generator>::value != 0,
+                  "uniform_below: the generator must produce full 32 or 64 bit words");
+    return detail::uniform_below(g, bound, detail::random_bits<Generator>{});
+}
+
+// A uniformly distributed integer in [low, high].
+template<typename T, typename Generator>
+T uniform_int(Generator &g, T low, T high)
+{
+    static_assert(std::is_integral<T>::value, "uniform_int: T must be an integer type");
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    const std::uint64_t range = static_cast<unsigned_type>(static_cast<unsigned_type>(high) - static_cast<unsigned_type>(low));
+    const std::uint64_t offset = range == std::numeric_limits<std::uint64_t>::max() ? random64(g)
+                                                                                     : uniform_below(g, range + 1);
+    return static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(low) + offset));
+}
+
+// A uniformly distributed double in [0, 1), with all 53 bits of the mantissa random.
+template<typename Generator>
+double uniform_double(Generator &g)
+{
+    return static_cast<double>(random64(g) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// A uniformly distributed float in [0, 1), with all 24 bits of the mantissa random.
+template<typename Generator>
+float uniform_float(Generator &g)
+{
+    return static_cast<float>(random64(g) >> 40) * (1.0f / 16777216.0f);
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_RANDOM_HPP
@@ -0,0 +1,761 @@
+#ifndef CPPBP_RING_BUFFER_HPP
+#define CPPBP_RING_BUFFER_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_ceil
+#include <cppbp/cache_padded.hpp>   // cppbp::detail::cache_padded
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <atomic>       // std::atomic, std::memory_order, std::atomic_thread_fence
+#include <climits>      // INT_MAX
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <cstring>      // std::memcpy
+#include <memory>       // std::unique_ptr
+#include <new>          // placement new
+#include <stdexcept>    // std::invalid_argument, std::length_error
+#include <thread>       // std::this_thread::yield
+#include <type_traits>  // std::aligned_storage
+#include <utility>      // std::forward, std::move
+
+#if defined(__linux__)
+#include <linux/futex.h>    // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h>    // SYS_futex
+#include <time.h>           // ::timespec
+#include <unistd.h>         // ::syscall
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// Sleeps while *word == expected, for at most a millisecond.
+inline void futex_wait(std::atomic<std::uint32_t> *word, std::uint32_t expected) noexcept
+{
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+                  "futex requires a plain 32 bit atomic word");
+#if defined(__linux__)
+    ::timespec timeout{};
+    timeout.tv_nsec = 1000000;
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected,
+              &timeout, nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+inline void futex_wake_all(std::atomic<std::uint32_t> *word) noexcept
+{
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE_PRIVATE, INT_MAX,
+              nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+// Event count: lets a thread sleep until a condition it checked may have changed.
+//
+// notify_all() is a fence and a load unless somebody actually sleeps. notify_if_waiting() is only
+// the load: without the fence it can miss a thread registering at the same moment, which then
+// sleeps until futex_wait() times out. The rings use it for the non-blocking operations, so that
+// only blocking calls and batches pay for the fence.
+class event_count final
+{
+public:
+    event_count() noexcept
+        : m_epoch{0}
+        , m_waiters{0}
+    { }
+
+    // Waits until condition() is true.
+    template<typename Condition>
+    void wait_until(Condition condition) noexcept
+    {
+        while(!condition()) {
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+            if(!condition()) {
+                futex_wait(&m_epoch, epoch);
+            }
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void notify_all() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        notify_if_waiting();
+    }
+
+    void notify_if_waiting() noexcept
+    {
+        if(m_waiters.load(std::memory_order_relaxed) != 0) {
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            futex_wake_all(&m_epoch);
+        }
+    }
+
+private:
+    std::atomic<std::uint32_t> m_epoch;
+    std::atomic<std::uint32_t> m_waiters;
+};
+
+inline std::size_t ring_capacity(std::size_t capacity)
+{
+    if(capacity == 0) {
+        throw std::invalid_argument("ring buffer capacity must not be zero");
+    }
+    return bit_ceil(capacity);
+}
+
+} // namespace detail
+
+// Single producer, single consumer bounded queue. The capacity is rounded up to a power of two.
+// Each side keeps a cached copy of the other side's index and only reloads it when the ring looks
+// full (producer) or empty (consumer).
+template<typename T>
+class spsc_ring final
+{
+    // Types
+public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+    // Construction and Assignment
+public:
+    explicit spsc_ring(size_type capacity)
+        : m_capacity{detail::ring_capacity(capacity)}
+        , m_mask{m_capacity - 1}
+        , m_slots{new storage_type[m_capacity]}
+    {
+        m_head.value.store(0, std::memory_order_relaxed);
+        m_tail.value.store(0, std::memory_order_relaxed);
+        m_cached_head.value = 0;
+        m_cached_tail.value = 0;
+    }
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    ~spsc_ring()
+    {
+        const size_type tail = m_tail.value.load(std::memory_order_acquire);
+        for(size_type i = m_head.value.load(std::memory_order_relaxed); i != tail; ++i) {
+            slot(i)->~T();
+        }
+    }
+
+    // Capacity
+public:
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    // Approximate when called concurrently with push or pop.
+    size_type size() const noexcept
+    {
+        return m_tail.value.load(std::memory_order_acquire) - m_head.value.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Producer
+public:
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        if(!emplace(std::forward<Args>(args)...)) {
+            return false;
+        }
+        m_not_empty.notify_if_waiting();
+        return true;
+    }
+
+    bool try_push(const T &value)
+    {
+        return try_emplace(value);
+    }
+
+    bool try_push(T &&value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    // Pushes as many of the n values as fit and publishes them at once. Returns the number pushed.
+    size_type try_push_batch(const T *values, size_type n)
+    {
+        const size_type tail = m_tail.value.load(std::memory_order_relaxed);
+        size_type free = m_capacity - (tail - m_cached_head.value);
+        if(free < n) {
+            m_cached_head.value = m_head.value.load(std::memory_order_acquire);
+            free = m_capacity - (tail - m_cached_head.value);
+        }
+        const size_type count = n < free ? n : free;
+        for(size_type i = 0; i < count; ++i) {
+            new (slot(tail + i)) T(values[i]);
+        }
+        if(count > 0) {
+            m_tail.value.store(tail + count, std::memory_order_release);
+            m_not_empty.notify_all();
+        }
+        return count;
+    }
+
+    // Blocks while the ring is full.
+    void push(const T &value)
+    {
+        while(!emplace(value)) {
+            m_not_full.wait_until([this]() { return !full(); });
+        }
+        m_not_empty.notify_all();
+    }
+
+    void push(T &&value)
+    {
+        while(!emplace(std::move(value))) {
+            m_not_full.wait_until([this]() { return !full(); });
+        }
+        m_not_empty.notify_all();
+    }
+
+    // Consumer
+public:
+    bool try_pop(T &out)
+    {
+        if(!take(out)) {
+            return false;
+        }
+        m_not_full.notify_if_waiting();
+        return true;
+    }
+
+    // Pops up to n values at once. Returns the number popped.
+    size_type try_pop_batch(T *out, size_type n)
+    {
+        const size_type head = m_head.value.load(std::memory_order_relaxed);
+        size_type available = m_cached_tail.value - head;
+        if(available < n) {
+            m_cached_tail.value = m_tail.value.load(std::memory_order_acquire);
+            available = m_cached_tail.value - head;
+        }
+        const size_type count = n < available ? n : available;
+        for(size_type i = 0; i < count; ++i) {
+            T *value = slot(head + i);
+            out[i] = std::move(*value);
+            value->~T();
+        }
+        if(count > 0) {
+            m_head.value.store(head + count, std::memory_order_release);
+            m_not_full.notify_all();
+        }
+        return count;
+    }
+
+    // Blocks while the ring is empty.
+    void pop(T &out)
+    {
+        while(!take(out)) {
+            m_not_empty.wait_until([this]() { return !empty(); });
+        }
+        m_not_full.notify_all();
+    }
+
+    // Helper
+private:
+    using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    // Push and pop without notifying the other side.
+    template<typename... Args>
+    bool emplace(Args&&... args)
+    {
+        const size_type tail = m_tail.value.load(std::memory_order_relaxed);
+        if(tail - m_cached_head.value == m_capacity) {
+            m_cached_head.value = m_head.value.load(std::memory_order_acquire);
+            if(tail - m_cached_head.value == m_capacity) {
+                return false;
+            }
+        }
+        new (slot(tail)) T(std::forward<Args>(args)...);
+        m_tail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool take(T &out)
+    {
+        const size_type head = m_head.value.load(std::memory_order_relaxed);
+        if(head == m_cached_tail.value) {
+            m_cached_tail.value = m_tail.value.load(std::memory_order_acquire);
+            if(head == m_cached_tail.value) {
+                return false;
+            }
+        }
+        T *value = slot(head);
+        out = std::move(*value);
+        value->~T();
+        m_head.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    T* slot(size_type index) noexcept
+    {
+        return reinterpret_cast<T*>(&m_slots[index & m_mask]);
+    }
+
+    bool full() const noexcept
+    {
+        return size() >= m_capacity;
+    }
+
+    // Private Member
+private:
+    const size_type                                 m_capacity;
+    const size_type                                 m_mask;
+    std::unique_ptr<storage_type[]>                 m_slots;
+
+    detail::cache_padded<std::atomic<size_type>>    m_head;
+    detail::cache_padded<size_type>                 m_cached_tail;  // consumer only
+    detail::cache_padded<std::atomic<size_type>>    m_tail;
+    detail::cache_padded<size_type>                 m_cached_head;  // producer only
+
+    detail::event_count                             m_not_empty;
+    detail::event_count                             m_not_full;
+};
+
+// Multi producer, multi consumer bounded queue after Dmitry Vyukov: every slot carries a sequence
+// number that tells producers and consumers whether it is their turn, so each operation is a single
+// CAS on the shared position plus uncontended slot accesses.
+template<typename T>
+class mpmc_ring final
+{
+    // Types
+public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+    // Construction and Assignment
+public:
+    explicit mpmc_ring(size_type capacity)
+        : m_capacity{detail::ring_capacity(capacity)}
+        , m_mask{m_capacity - 1}
+        , m_cells{new cell[m_capacity]}
+    {
+        for(size_type i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_enqueue_pos.value.store(0, std::memory_order_relaxed);
+        m_dequeue_pos.value.store(0, std::memory_order_relaxed);
+    }
+
+    mpmc_ring(const mpmc_ring&) = delete;
+    mpmc_ring& operator=(const mpmc_ring&) = delete;
+
+    ~mpmc_ring()
+    {
+        const size_type tail = m_enqueue_pos.value.load(std::memory_order_acquire);
+        for(size_type i = m_dequeue_pos.value.load(std::memory_order_relaxed); i != tail; ++i) {
+            reinterpret_cast<T*>(&m_cells[i & m_mask].storage)->~T();
+        }
+    }
+
+    // Capacity
+public:
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    // Approximate when called concurrently with push or pop.
+    size_type size() const noexcept
+    {
+        const size_type head = m_dequeue_pos.value.load(std::memory_order_acquire);
+        const size_type tail = m_enqueue_pos.value.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Producers
+public:
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        if(!emplace(std::forward<Args>(args)...)) {
+            return false;
+        }
+        m_not_empty.notify_if_waiting();
+        return true;
+    }
+
+    bool try_push(const T &value)
+    {
+        return try_emplace(value);
+    }
+
+    bool try_push(T &&value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    // Claims the free cells ahead of the enqueue position, up to n, with one CAS and fills them.
+    // Returns the number pushed.
+    size_type try_push_batch(const T *values, size_type n)
+    {
+        size_type pos;
+        const size_type count = claim(m_enqueue_pos.value, 0, n, pos);
+        for(size_type i = 0; i < count; ++i) {
+            cell &c = m_cells[(pos + i) & m_mask];
+            new (&c.storage) T(values[i]);
+            c.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        if(count > 0) {
+            m_not_empty.notify_all();
+        }
+        return count;
+    }
+
+    // Blocks while the ring is full.
+    void push(const T &value)
+    {
+        while(!emplace(value)) {
+            m_not_full.wait_until([this]() { return size() < m_capacity; });
+        }
+        m_not_empty.notify_all();
+    }
+
+    void push(T &&value)
+    {
+        while(!emplace(std::move(value))) {
+            m_not_full.wait_until([this]() { return size() < m_capacity; });
+        }
+        m_not_empty.notify_all();
+    }
+
+    // Consumers
+public:
+    bool try_pop(T &out)
+    {
+        if(!take(out)) {
+            return false;
+        }
+        m_not_full.notify_if_waiting();
+        return true;
+    }
+
+    // Claims the filled cells ahead of the dequeue position, up to n, with one CAS and drains them.
+    // Returns the number popped.
+    size_type try_pop_batch(T *out, size_type n)
+    {
+        size_type pos;
+        const size_type count = claim(m_dequeue_pos.value, 1, n, pos);
+        for(size_type i = 0; i < count; ++i) {
+            cell &c = m_cells[(pos + i) & m_mask];
+            T *value = reinterpret_cast<T*>(&c.storage);
+            out[i] = std::move(*value);
+            value->~T();
+            c.sequence.store(pos + i + m_capacity, std::memory_order_release);
+        }
+        if(count > 0) {
+            m_not_full.notify_all();
+        }
+        return count;
+    }
+
+    // Blocks while the ring is empty.
+    void pop(T &out)
+    {
+        while(!take(out)) {
+            m_not_empty.wait_until([this]() { return !empty(); });
+        }
+        m_not_full.notify_all();
+    }
+
+    // Helper
+private:
+    struct cell
+    {
+        std::atomic<size_type>                                  sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    // Advances position over the run of up to n cells whose sequence is their position plus
+    // offset (0: free for a producer, 1: filled for a consumer). Returns the length of the run,
+    // which starts at pos; zero if the first cell is not ready.
+    size_type claim(std::atomic<size_type> &position, size_type offset, size_type n, size_type &pos) noexcept
+    {
+        pos = position.load(std::memory_order_relaxed);
+        for(;;) {
+            size_type count = 0;
+            while(count < n) {
+                const size_type sequence = m_cells[(pos + count) & m_mask].sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + count + offset));
+                if(diff != 0) {
+                    if(count == 0 && diff > 0) {
+                        count = npos;   // pos is stale
+                    }
+                    break;
+                }
+                ++count;
+            }
+            if(count == npos) {
+                pos = position.load(std::memory_order_relaxed);
+            } else if(count == 0
+                      || position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                return count;
+            }
+        }
+    }
+
+    // Push and pop without notifying the other side.
+    template<typename... Args>
+    bool emplace(Args&&... args)
+    {
+        size_type pos;
+        if(claim(m_enqueue_pos.value, 0, 1, pos) == 0) {
+            return false;
+        }
+        cell &c = m_cells[pos & m_mask];
+        new (&c.storage) T(std::forward<Args>(args)...);
+        c.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool take(T &out)
+    {
+        size_type pos;
+        if(claim(m_dequeue_pos.value, 1, 1, pos) == 0) {
+            return false;
+        }
+        cell &c = m_cells[pos & m_mask];
+        T *value = reinterpret_cast<T*>(&c.storage);
+        out = std::move(*value);
+        value->~T();
+        c.sequence.store(pos + m_capacity, std::memory_order_release);
+        return true;
+    }
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Private Member
+private:
+    const size_type                                 m_capacity;
+    const size_type                                 m_mask;
+    std::unique_ptr<cell[]>                         m_cells;
+
+    detail::cache_padded<std::atomic<size_type>>    m_enqueue_pos;
+    detail::cache_padded<std::atomic<size_type>>    m_dequeue_pos;
+
+    detail::event_count                             m_not_empty;
+    detail::event_count                             m_not_full;
+};
+
+// Single producer, single consumer ring of variable-length byte records. Records are stored inline
+// (length header plus payload, 8 byte aligned) and never split across the end of the buffer, so the
+// consumer receives each record as a string_view into the ring. The view stays valid until pop().
+class spsc_byte_ring final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    // Construction and Assignment
+public:
+    explicit spsc_byte_ring(size_type capacity)
+        : m_capacity{detail::ring_capacity(capacity < 16 ? 16 : capacity)}
+        , m_mask{m_capacity - 1}
+        , m_buffer{new std::uint64_t[m_capacity / sizeof(std::uint64_t)]}
+        , m_front_size{0}
+    {
+        m_head.value.store(0, std::memory_order_relaxed);
+        m_tail.value.store(0, std::memory_order_relaxed);
+        m_cached_head.value = 0;
+        m_cached_tail.value = 0;
+    }
+
+    spsc_byte_ring(const spsc_byte_ring&) = delete;
+    spsc_byte_ring& operator=(const spsc_byte_ring&) = delete;
+
+    // Capacity
+public:
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    // Largest record that can ever be pushed. Limiting records to half the ring guarantees that a
+    // record which has to skip the end of the buffer still fits into an empty ring.
+    size_type max_record_size() const noexcept
+    {
+        return m_capacity / 2 - header_size;
+    }
+
+    // Approximate number of bytes in use (headers and padding included).
+    size_type bytes_used() const noexcept
+    {
+        return m_tail.value.load(std::memory_order_acquire) - m_head.value.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept
+    {
+        return bytes_used() == 0;
+    }
+
+    // Producer
+public:
+    // Copies record into the ring. Returns false if there is not enough space right now.
+    bool try_push(string_view record)
+    {
+        if(!write(record)) {
+            return false;
+        }
+        m_not_empty.notify_if_waiting();
+        return true;
+    }
+
+    // Blocks until there is space for record.
+    void push(string_view record)
+    {
+        while(!write(record)) {
+            const size_type tail = m_tail.value.load(std::memory_order_relaxed);
+            const size_type total = footprint(tail, record.size());
+            m_not_full.wait_until([this, tail, total]() {
+                return tail + total - m_head.value.load(std::memory_order_acquire) <= m_capacity;
+            });
+        }
+        m_not_empty.notify_all();
+    }
+
+    // Consumer
+public:
+    // Returns the oldest record without removing it.
+    bool try_front(string_view &out)
+    {
+        size_type head = m_head.value.load(std::memory_order_relaxed);
+        if(head == m_cached_tail.value) {
+            m_cached_tail.value = m_tail.value.load(std::memory_order_acquire);
+            if(head == m_cached_tail.value) {
+                return false;
+            }
+        }
+        size_type offset = head & m_mask;
+        std::uint32_t size = read_header(offset);
+        if(size == wrap_marker) {
+            offset = 0;
+            size = read_header(offset);
+            m_front_size = m_capacity - (head & m_mask) + record_size(size);
+        } else {
+            m_front_size = record_size(size);
+        }
+        out = string_view{bytes() + offset + header_size, size};
+        return true;
+    }
+
+    // Blocks until a record is available.
+    void front(string_view &out)
+    {
+        while(!try_front(out)) {
+            m_not_empty.wait_until([this]() { return !empty(); });
+        }
+    }
+
+    // Releases the record returned by the last try_front().
+    void pop() noexcept
+    {
+        const size_type head = m_head.value.load(std::memory_order_relaxed);
+        m_head.value.store(head + m_front_size, std::memory_order_release);
+        m_front_size = 0;
+        m_not_full.notify_if_waiting();
+    }
+
+    // Helper
+private:
+    static constexpr size_type header_size = sizeof(std::uint32_t);
+    static constexpr std::uint32_t wrap_marker = 0xffffffffu;
+
+    static size_type record_size(size_type payload) noexcept
+    {
+        return (header_size + payload + 7) & ~size_type{7};
+    }
+
+    // Bytes a record written at tail occupies, including the skipped end of the buffer.
+    size_type footprint(size_type tail, size_type payload) const noexcept
+    {
+        const size_type need = record_size(payload);
+        const size_type to_end = m_capacity - (tail & m_mask);
+        return need > to_end ? to_end + need : need;
+    }
+
+    // try_push() without notifying the consumer.
+    bool write(string_view record)
+    {
+        if(record.size() > max_record_size()) {
+            throw std::length_error("spsc_byte_ring::try_push: record larger than the ring");
+        }
+        const size_type tail = m_tail.value.load(std::memory_order_relaxed);
+        const size_type need = record_size(record.size());
+        const size_type offset = tail & m_mask;
+        const size_type to_end = m_capacity - offset;
+        const size_type total = footprint(tail, record.size());
+
+        if(tail + total - m_cached_head.value > m_capacity) {
+            m_cached_head.value = m_head.value.load(std::memory_order_acquire);
+            if(tail + total - m_cached_head.value > m_capacity) {
+                return false;
+            }
+        }
+
+        size_type position = offset;
+        if(need > to_end) {
+            write_header(position, wrap_marker);
+            position = 0;
+        }
+        write_header(position, static_cast<std::uint32_t>(record.size()));
+        std::memcpy(bytes() + position + header_size, record.data(), record.size());
+        m_tail.value.store(tail + total, std::memory_order_release);
+        return true;
+    }
+
+    char* bytes() noexcept
+    {
+        return reinterpret_cast<char*>(m_buffer.get());
+    }
+
+    void write_header(size_type offset, std::uint32_t size) noexcept
+    {
+        std::memcpy(bytes() + offset, &size, sizeof(size));
+    }
+
+    std::uint32_t read_header(size_type offset) noexcept
+    {
+        std::uint32_t size;
+        std::memcpy(&size, bytes() + offset, sizeof(size));
+        return size;
+    }
+
+    // Private Member
+private:
+    const size_type                                 m_capacity;
+    const size_type                                 m_mask;
+    std::unique_ptr<std::uint64_t[]>                m_buffer;
+    size_type                                       m_front_size;   // consumer only
+
+    detail::cache_padded<std::atomic<size_type>>    m_head;
+    detail::cache_padded<size_type>                 m_cached_tail;  // consumer only
+    detail::cache_padded<std::atomic<size_type>>    m_tail;
+    detail::cache_padded<size_type>                 m_cached_head;  // producer only
+
+    detail::event_count                             m_not_empty;
+    detail::event_count                             m_not_full;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_RING_BUFFER_HPP
@@ -0,0 +1,287 @@
+#ifndef CPPBP_SHARED_STRING_HPP
+#define CPPBP_SHARED_STRING_HPP
+
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::hash, cppbp::detail::hash_key
+
+#include <atomic>       // std::atomic, std::memory_order_*
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::memcpy
+#include <new>          // operator new, operator delete
+#include <ostream>      // std::ostream
+#include <stdexcept>    // std::length_error
+#include <utility>      // std::swap
+
+namespace cppbp {
+
+namespace detail {
+
+// Allocated in front of the characters of a shared_string.
+struct shared_string_header
+{
+    std::atomic<std::size_t>    refs;
+    std::size_t                 size;
+    std::uint64_t               hash;
+    bool                        local;
+};
+
+} // namespace detail
+
+// Immutable, reference counted string in a single allocation: the reference count, the length,
+// the hash and the characters followed by a terminating null. Copies share the allocation and
+// cost one increment, so handing a payload to another thread does not copy the bytes. The hash
+// is computed once on construction and kept in the header.
+//
+// A string created with refcount::local counts its references with plain loads and stores. It
+// and all its copies must stay on one thread; in exchange a copy costs no locked instruction.
+class shared_string final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+    using value_type    = char;
+
+    enum class refcount
+    {
+        atomic,
+        local
+    };
+
+    // Construction and Assignment
+public:
+    shared_string() noexcept = default;
+
+    // Copies the characters of value into a new allocation. Throws std::length_error if the
+    // allocation size would overflow.
+    explicit shared_string(string_view value, refcount mode = refcount::atomic)
+    {
+        if(value.empty()) {
+            return;
+        }
+        if(value.size() > static_cast<size_type>(-1) - sizeof(detail::shared_string_header) - 1) {
+            throw std::length_error("shared_string: string too long");
+        }
+        void *memory = ::operator new(sizeof(detail::shared_string_header) + value.size() + 1);
+        m_header = ::new(memory) detail::shared_string_header;
+        m_header->refs.store(1, std::memory_order_relaxed);
+        m_header->size = value.size();
+        m_header->hash = detail::hash_key(value);
+        m_header->local = mode == refcount::local;
+        char *chars = characters(m_header);
+        std::memcpy(chars, value.data(), value.size());
+        chars[value.size()] = '\0';
+    }
+
+    shared_string(const shared_string &other) noexcept
+        : m_header{other.m_header}
+    {
+        retain();
+    }
+
+    shared_string(shared_string &&other) noexcept
+        : m_header{other.m_header}
+    {
+        other.m_header = nullptr;
+    }
+
+    shared_string& operator=(shared_string other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~shared_string()
+    {
+        release();
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_header ? m_header->size : 0;
+    }
+
+    size_type length() const noexcept
+    {
+        return size();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_header == nullptr;
+    }
+
+    // Element access
+public:
+    const char* data() const noexcept
+    {
+        return m_header ? characters(m_header) : "";
+    }
+
+    // data() is always null terminated.
+    const char* c_str() const noexcept
+    {
+        return data();
+    }
+
+    char operator[](size_type i) const noexcept
+    {
+        return data()[i];
+    }
+
+    string_view view() const noexcept
+    {
+        return string_view{data(), size()};
+    }
+
+    operator string_view() const noexcept
+    {
+        return view();
+    }
+
+    // Observers
+public:
+    // detail::hash_key(view()) without touching the characters.
+    std::uint64_t hash() const noexcept
+    {
+        return m_header ? m_header->hash : detail::hash_key(string_view{});
+    }
+
+    // Number of shared_strings sharing the allocation; 0 for the empty string.
+    size_type use_count() const noexcept
+    {
+        return m_header ? m_header->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    bool is_local() const noexcept
+    {
+        return m_header && m_header->local;
+    }
+
+    // Comparison
+public:
+    int compare(string_view other) const noexcept
+    {
+        return view().compare(other);
+    }
+
+    // Equal hashes are checked before the characters, and a shared allocation needs neither.
+    bool equals(const shared_string &other) const noexcept
+    {
+        if(m_header == other.m_header) {
+            return true;
+        }
+        return hash() == other.hash() && view() == other.view();
+    }
+
+    // Modifiers
+public:
+    void clear() noexcept
+    {
+        release();
+        m_header = nullptr;
+    }
+
+    void swap(shared_string &other) noexcept
+    {
+        std::swap(m_header, other.m_header);
+    }
+
+    // Helper
+private:
+    static char* characters(detail::shared_string_header *header) noexcept
+    {
+        return reinterpret_cast<char*>(header + 1);
+    }
+
+    void retain() const noexcept
+    {
+        if(!m_header) {
+            return;
+        }
+        if(m_header->local) {
+            m_header->refs.store(m_header->refs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else {
+            m_header->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void release() noexcept
+    {
+        if(!m_header) {
+            return;
+        }
+        if(m_header->local) {
+            const size_type refs = m_header->refs.load(std::memory_order_relaxed) - 1;
+            m_header->refs.store(refs, std::memory_order_relaxed);
+            if(refs != 0) {
+                return;
+            }
+        } else if(m_header->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        m_header->~shared_string_header();
+        ::operator delete(m_header);
+    }
+
+    // Private Member
+private:
+    detail::shared_string_header *m_header = nullptr;
+};
+
+inline void swap(shared_string &lhs, shared_string &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+// Comparison functions
+
+inline bool operator==(const shared_string &lhs, const shared_string &rhs) noexcept
+{
+    return lhs.equals(rhs);
+}
+
+inline bool operator!=(const shared_string &lhs, const shared_string &rhs) noexcept
+{
+    return !lhs.equals(rhs);
+}
+
+inline bool operator<(const shared_string &lhs, const shared_string &rhs) noexcept
+{
+    return lhs.compare(rhs.view()) < 0;
+}
+
+inline bool operator==(const shared_string &lhs, string_view rhs) noexcept
+{
+    return lhs.view() == rhs;
+}
+
+inline bool operator!=(const shared_string &lhs, string_view rhs) noexcept
+{
+    return lhs.view() != rhs;
+}
+
+// Inserters
+
+inline std::ostream& operator<<(std::ostream &os, const shared_string &str)
+{
+    return os << str.view();
+}
+
+// Hash support
+
+// Returns the cached hash; equal to hash<string_view> of the characters.
+template<>
+struct hash<shared_string>
+{
+public:
+    std::size_t operator()(const shared_string &str) const noexcept
+    {
+        return static_cast<std::size_t>(str.hash());
+    }
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_SHARED_STRING_HPP
@@ -0,0 +1,742 @@
+#ifndef CPPBP_SIMD_ALGO_HPP
+#define CPPBP_SIMD_ALGO_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::countr_zero, cppbp::countr_one, cppbp::bit_width
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/span.hpp>           // cppbp::span
+
+#include <algorithm>    // std::find, std::count, std::min_element, std::mismatch, ...
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::memcmp
+#include <iterator>     // std::iterator_traits
+#include <memory>       // std::addressof
+#include <type_traits>  // std::integral_constant, std::is_integral, std::is_same, ...
+#include <utility>      // std::pair, std::declval
+#include <vector>       // std::vector
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_cmpeq_epi8, _mm_cmpgt_epi32, _mm256_cmpeq_epi64, ...
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// Element types the kernels handle: integers, whose == and < agree with their bit patterns once
+// the sign is accounted for. bool and floating point (NaN, -0.0) go through std.
+template<typename T>
+struct is_simd_algo_value
+    : std::integral_constant<bool,
+        std::is_integral<T>::value && !std::is_same<T, bool>::value
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>
+{ };
+
+template<typename Iterator>
+using iterator_reference_t = typename std::remove_reference<decltype(*std::declval<Iterator&>())>::type;
+
+template<typename Iterator>
+using iterator_element_t = typename std::remove_cv<iterator_reference_t<Iterator>>::type;
+
+// Iterators known to point into contiguous memory: pointers and std::vector iterators. C++11 has
+// no way to ask an arbitrary iterator, so everything else is treated as non-contiguous.
+template<typename Iterator, typename T = iterator_element_t<Iterator>,
+         bool = is_simd_algo_value<T>::value && !std::is_volatile<iterator_reference_t<Iterator>>::value>
+struct is_simd_algo_iterator : std::false_type { };
+
+template<typename Iterator, typename T>
+struct is_simd_algo_iterator<Iterator, T, true>
+    : std::integral_constant<bool,
+        std::is_pointer<Iterator>::value
+        || std::is_same<Iterator, typename std::vector<T>::iterator>::value
+        || std::is_same<Iterator, typename std::vector<T>::const_iterator>::value>
+{ };
+
+template<typename Iterator, typename Value>
+using simd_algo_search_tag = std::integral_constant<bool,
+    is_simd_algo_iterator<Iterator>::value && std::is_integral<Value>::value && !std::is_same<Value, bool>::value>;
+
+template<typename Iterator1, typename Iterator2>
+using simd_algo_compare_tag = std::integral_constant<bool,
+    is_simd_algo_iterator<Iterator1>::value && is_simd_algo_iterator<Iterator2>::value
+    && std::is_same<iterator_element_t<Iterator1>, iterator_element_t<Iterator2>>::value>;
+
+// std::lexicographical_compare is already a memcmp call for unsigned bytes, and memcmp is faster.
+template<typename Iterator1, typename Iterator2>
+using simd_algo_order_tag = std::integral_constant<bool,
+    simd_algo_compare_tag<Iterator1, Iterator2>::value
+    && !(sizeof(iterator_element_t<Iterator1>) == 1 && std::is_unsigned<iterator_element_t<Iterator1>>::value)>;
+
+template<typename Iterator>
+const iterator_element_t<Iterator>* simd_algo_pointer(Iterator it) noexcept
+{
+    return std::addressof(*it);
+}
+
+// Whether some T compares equal to value, the way std::find compares them. Values that do not
+// survive the round trip through T cannot match any element.
+template<typename T, typename Value>
+bool simd_algo_representable(const Value &value) noexcept
+{
+    return static_cast<Value>(static_cast<T>(value)) == value;
+}
+
+// Registers
+
+#if defined(CPPBP_HAS_SSE2)
+
+struct simd128_base
+{
+    using reg = __m128i;
+    static constexpr std::size_t width = 16;
+    static constexpr unsigned all_lanes = 0xffffu;
+
+    static reg load(const void *p) noexcept
+    {
+        return _mm_loadu_si128(static_cast<const __m128i*>(p));
+    }
+
+    static void store(void *p, reg v) noexcept
+    {
+        _mm_storeu_si128(static_cast<__m128i*>(p), v);
+    }
+
+    // One bit per byte.
+    static unsigned mask(reg v) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_epi8(v));
+    }
+
+    static reg bit_xor(reg a, reg b) noexcept
+    {
+        return _mm_xor_si128(a, b);
+    }
+
+    // m ? a : b, lane by lane.
+    static reg select(reg m, reg a, reg b) noexcept
+    {
+        return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+    }
+};
+
+// Lane width specific operations; gt is the signed comparison, sub wraps around.
+template<std::size_t Size>
+struct simd128;
+
+template<>
+struct simd128<1> : simd128_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm_set1_epi8(static_cast<char>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm_cmpeq_epi8(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm_cmpgt_epi8(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm_sub_epi8(a, b); }
+};
+
+template<>
+struct simd128<2> : simd128_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm_set1_epi16(static_cast<short>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm_cmpeq_epi16(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm_cmpgt_epi16(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm_sub_epi16(a, b); }
+};
+
+template<>
+struct simd128<4> : simd128_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm_set1_epi32(static_cast<int>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm_cmpeq_epi32(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm_cmpgt_epi32(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm_sub_epi32(a, b); }
+};
+
+// SSE2 has no 64 bit comparisons; they are assembled from the 32 bit halves.
+template<>
+struct simd128<8> : simd128_base
+{
+    static reg set1(std::uint64_t v) noexcept
+    {
+        return _mm_set1_epi64x(static_cast<long long>(v));
+    }
+
+    static reg eq(reg a, reg b) noexcept
+    {
+        const __m128i halves = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    // With equal high halves, b - a is negative exactly when a > b and its high half is all ones.
+    static reg gt(reg a, reg b) noexcept
+    {
+        const __m128i high = _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_sub_epi64(b, a)),
+                                          _mm_cmpgt_epi32(a, b));
+        return _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 1, 1));
+    }
+
+    static reg sub(reg a, reg b) noexcept
+    {
+        return _mm_sub_epi64(a, b);
+    }
+};
+
+#endif
+
+#if defined(__AVX2__)
+
+struct simd256_base
+{
+    using reg = __m256i;
+    static constexpr std::size_t width = 32;
+    static constexpr unsigned all_lanes = 0xffffffffu;
+
+    static reg load(const void *p) noexcept
+    {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+    }
+
+    static void store(void *p, reg v) noexcept
+    {
+        _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+    }
+
+    static unsigned mask(reg v) noexcept
+    {
+        return static_cast<unsigned>(_mm256_movemask_epi8(v));
+    }
+
+    static reg bit_xor(reg a, reg b) noexcept
+    {
+        return _mm256_xor_si256(a, b);
+    }
+
+    static reg select(reg m, reg a, reg b) noexcept
+    {
+        return _mm256_blendv_epi8(b, a, m);
+    }
+};
+
+template<std::size_t Size>
+struct simd256;
+
+template<>
+struct simd256<1> : simd256_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm256_cmpgt_epi8(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_epi8(a, b); }
+};
+
+template<>
+struct simd256<2> : simd256_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm256_set1_epi16(static_cast<short>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm256_cmpeq_epi16(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm256_cmpgt_epi16(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_epi16(a, b); }
+};
+
+template<>
+struct simd256<4> : simd256_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm256_set1_epi32(static_cast<int>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm256_cmpeq_epi32(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm256_cmpgt_epi32(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_epi32(a, b); }
+};
+
+template<>
+struct simd256<8> : simd256_base
+{
+    static reg set1(std::uint64_t v) noexcept { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+    static reg eq(reg a, reg b) noexcept { return _mm256_cmpeq_epi64(a, b); }
+    static reg gt(reg a, reg b) noexcept { return _mm256_cmpgt_epi64(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_epi64(a, b); }
+};
+
+#endif
+
+// Block kernels. Each one works through whole registers starting at i, leaving i at the first
+// element it did not look at, or at the element it was looking for.
+
+template<typename Lanes, typename T>
+bool find_blocks(const T *p, std::size_t n, std::size_t &i, T value) noexcept
+{
+    constexpr std::size_t lanes = Lanes::width / sizeof(T);
+    const typename Lanes::reg needle = Lanes::set1(static_cast<std::uint64_t>(value));
+    for(; i + lanes <= n; i += lanes) {
+        const unsigned mask = Lanes::mask(Lanes::eq(Lanes::load(p + i), needle));
+        if(mask != 0) {
+            i += static_cast<std::size_t>(countr_zero(mask)) / sizeof(T);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Works backwards from the end i of the part still to be searched.
+template<typename Lanes, typename T>
+bool find_last_blocks(const T *p, std::size_t &i, T value) noexcept
+{
+    constexpr std::size_t lanes = Lanes::width / sizeof(T);
+    const typename Lanes::reg needle = Lanes::set1(static_cast<std::uint64_t>(value));
+    for(; i >= lanes; i -= lanes) {
+        const unsigned mask = Lanes::mask(Lanes::eq(Lanes::load(p + i - lanes), needle));
+        if(mask != 0) {
+            i = i - lanes + static_cast<std::size_t>(bit_width(mask) - 1) / sizeof(T);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every lane counts its matches by subtracting the all ones comparison results, and is added to
+// the total before it could wrap around.
+template<typename Lanes, typename T>
+std::size_t count_blocks(const T *p, std::size_t n, std::size_t &i, T value) noexcept
+{
+    using counter = typename std::make_unsigned<T>::type;
+    constexpr std::size_t lanes = Lanes::width / sizeof(T);
+    constexpr std::size_t batch = sizeof(T) == 1 ? 255 : 65535;
+    const typename Lanes::reg needle = Lanes::set1(static_cast<std::uint64_t>(value));
+    std::size_t result = 0;
+    while(i + lanes <= n) {
+        const std::size_t end = n - i > batch * lanes ? i + batch * lanes : n;
+        typename Lanes::reg counts = Lanes::set1(0);
+        for(; i + lanes <= end; i += lanes) {
+            counts = Lanes::sub(counts, Lanes::eq(Lanes::load(p + i), needle));
+        }
+        counter values[lanes];
+        Lanes::store(values, counts);
+        for(const counter c : values) {
+            result += c;
+        }
+    }
+    return result;
+}
+
+// Folds the smallest and largest values into lo and hi. Unsigned values are compared with their
+// sign bit flipped, which maps their order onto the signed order gt implements.
+template<typename Lanes, typename T>
+void minmax_blocks(const T *p, std::size_t n, std::size_t &i, T &lo, T &hi) noexcept
+{
+    constexpr std::size_t lanes = Lanes::width / sizeof(T);
+    if(n - i < lanes) {
+        return;
+    }
+    const typename Lanes::reg bias = Lanes::set1(std::is_signed<T>::value ? 0 : std::uint64_t{1} << (8 * sizeof(T) - 1));
+    typename Lanes::reg vmin = Lanes::bit_xor(Lanes::load(p + i), bias);
+    typename Lanes::reg vmax = vmin;
+    for(i += lanes; i + lanes <= n; i += lanes) {
+        const typename Lanes::reg v = Lanes::bit_xor(Lanes::load(p + i), bias);
+        vmin = Lanes::select(Lanes::gt(vmin, v), v, vmin);
+        vmax = Lanes::select(Lanes::gt(v, vmax), v, vmax);
+    }
+
+    T values[2][lanes];
+    Lanes::store(values[0], Lanes::bit_xor(vmin, bias));
+    Lanes::store(values[1], Lanes::bit_xor(vmax, bias));
+    for(std::size_t k = 0; k < lanes; ++k) {
+        lo = values[0][k] < lo ? values[0][k] : lo;
+        hi = hi < values[1][k] ? values[1][k] : hi;
+    }
+}
+
+template<typename Lanes>
+bool mismatch_blocks(const unsigned char *a, const unsigned char *b, std::size_t n, std::size_t &i) noexcept
+{
+    constexpr std::size_t lanes = Lanes::width;
+    for(; i + lanes <= n; i += lanes) {
+        const unsigned mask = Lanes::mask(Lanes::eq(Lanes::load(a + i), Lanes::load(b + i)));
+        if(mask != Lanes::all_lanes) {
+            i += static_cast<std::size_t>(countr_one(mask));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whole range kernels: AVX2 registers where available, then SSE2, then a scalar tail.
+
+template<typename T>
+std::size_t find_value(const T *p, std::size_t n, T value) noexcept
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    if(find_blocks<simd256<sizeof(T)>>(p, n, i, value)) {
+        return i;
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    if(find_blocks<simd128<sizeof(T)>>(p, n, i, value)) {
+        return i;
+    }
+#endif
+    for(; i < n && p[i] != value; ++i) { }
+    return i;
+}
+
+// Index of the last element equal to value, n if there is none.
+template<typename T>
+std::size_t find_last_value(const T *p, std::size_t n, T value) noexcept
+{
+    std::size_t i = n;
+#if defined(__AVX2__)
+    if(find_last_blocks<simd256<sizeof(T)>>(p, i, value)) {
+        return i;
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    if(find_last_blocks<simd128<sizeof(T)>>(p, i, value)) {
+        return i;
+    }
+#endif
+    while(i > 0) {
+        if(p[--i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template<typename T>
+std::size_t count_value(const T *p, std::size_t n, T value) noexcept
+{
+    std::size_t result = 0;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    result += count_blocks<simd256<sizeof(T)>>(p, n, i, value);
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    result += count_blocks<simd128<sizeof(T)>>(p, n, i, value);
+#endif
+    for(; i < n; ++i) {
+        result += (p[i] == value);
+    }
+    return result;
+}
+
+// Smallest and largest of the n > 0 values at p.
+template<typename T>
+std::pair<T, T> minmax_value(const T *p, std::size_t n) noexcept
+{
+    T lo = p[0];
+    T hi = p[0];
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    minmax_blocks<simd256<sizeof(T)>>(p, n, i, lo, hi);
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    minmax_blocks<simd128<sizeof(T)>>(p, n, i, lo, hi);
+#endif
+    for(; i < n; ++i) {
+        lo = p[i] < lo ? p[i] : lo;
+        hi = hi < p[i] ? p[i] : hi;
+    }
+    return {lo, hi};
+}
+
+// Index of the first byte where a and b differ, n if they are equal.
+inline std::size_t mismatch_bytes(const unsigned char *a, const unsigned char *b, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    if(mismatch_blocks<simd256<1>>(a, b, n, i)) {
+        return i;
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    if(mismatch_blocks<simd128<1>>(a, b, n, i)) {
+        return i;
+    }
+#endif
+    for(; i < n && a[i] == b[i]; ++i) { }
+    return i;
+}
+
+// Integers are equal exactly when their bytes are, so the first differing element is the one
+// holding the first differing byte.
+template<typename T>
+std::size_t mismatch_values(const T *a, const T *b, std::size_t n) noexcept
+{
+    return mismatch_bytes(reinterpret_cast<const unsigned char*>(a), reinterpret_cast<const unsigned char*>(b),
+                          n * sizeof(T)) / sizeof(T);
+}
+
+// Dispatch. The std::true_type overloads run the kernels above on contiguous integer ranges.
+
+template<typename Iterator, typename Value>
+Iterator find(Iterator first, Iterator last, const Value &value, std::false_type)
+{
+    return std::find(first, last, value);
+}
+
+template<typename Iterator, typename Value>
+Iterator find(Iterator first, Iterator last, const Value &value, std::true_type)
+{
+    using T = iterator_element_t<Iterator>;
+    if(first == last || !simd_algo_representable<T>(value)) {
+        return last;
+    }
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    return first + static_cast<std::ptrdiff_t>(find_value(simd_algo_pointer(first), n, static_cast<T>(value)));
+}
+
+template<typename Iterator, typename Value>
+typename std::iterator_traits<Iterator>::difference_type
+count(Iterator first, Iterator last, const Value &value, std::false_type)
+{
+    return std::count(first, last, value);
+}
+
+template<typename Iterator, typename Value>
+typename std::iterator_traits<Iterator>::difference_type
+count(Iterator first, Iterator last, const Value &value, std::true_type)
+{
+    using T = iterator_element_t<Iterator>;
+    if(first == last || !simd_algo_representable<T>(value)) {
+        return 0;
+    }
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    return static_cast<typename std::iterator_traits<Iterator>::difference_type>(
+        count_value(simd_algo_pointer(first), n, static_cast<T>(value)));
+}
+
+// min_element and max_element find the extreme value first and then its first occurrence: two
+// vectorized passes beat one scalar pass that tracks the index.
+template<typename Iterator>
+std::pair<Iterator, Iterator> minmax_element(Iterator first, Iterator last, std::false_type)
+{
+    return std::minmax_element(first, last);
+}
+
+template<typename Iterator>
+std::pair<Iterator, Iterator> minmax_element(Iterator first, Iterator last, std::true_type)
+{
+    if(first == last) {
+        return {last, last};
+    }
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const auto *p = simd_algo_pointer(first);
+    const auto values = minmax_value(p, n);
+    // Like std::minmax_element: the first smallest and the last largest element.
+    return {first + static_cast<std::ptrdiff_t>(find_value(p, n, values.first)),
+            first + static_cast<std::ptrdiff_t>(find_last_value(p, n, values.second))};
+}
+
+template<typename Iterator>
+Iterator min_element(Iterator first, Iterator last, std::false_type)
+{
+    return std::min_element(first, last);
+}
+
+template<typename Iterator>
+Iterator min_element(Iterator first, Iterator last, std::true_type)
+{
+    if(first == last) {
+        return last;
+    }
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const auto *p = simd_algo_pointer(first);
+    return first + static_cast<std::ptrdiff_t>(find_value(p, n, minmax_value(p, n).first));
+}
+
+template<typename Iterator>
+Iterator max_element(Iterator first, Iterator last, std::false_type)
+{
+    return std::max_element(first, last);
+}
+
+template<typename Iterator>
+Iterator max_element(Iterator first, Iterator last, std::true_type)
+{
+    if(first == last) {
+        return last;
+    }
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const auto *p = simd_algo_pointer(first);
+    return first + static_cast<std::ptrdiff_t>(find_value(p, n, minmax_value(p, n).second));
+}
+
+// The four iterator forms of std::mismatch and std::equal are C++14.
+template<typename Iterator1, typename Iterator2>
+std::pair<Iterator1, Iterator2> mismatch(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2,
+                                         std::false_type)
+{
+    for(; first1 != last1 && first2 != last2 && *first1 == *first2; ++first1, ++first2) { }
+    return {first1, first2};
+}
+
+template<typename Iterator1, typename Iterator2>
+std::pair<Iterator1, Iterator2> mismatch(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2,
+                                         std::true_type)
+{
+    const std::size_t n = std::min(static_cast<std::size_t>(last1 - first1), static_cast<std::size_t>(last2 - first2));
+    if(n == 0) {
+        return {first1, first2};
+    }
+    const std::size_t k = mismatch_values(simd_algo_pointer(first1), simd_algo_pointer(first2), n);
+    return {first1 + static_cast<std::ptrdiff_t>(k), first2 + static_cast<std::ptrdiff_t>(k)};
+}
+
+template<typename Iterator1, typename Iterator2>
+bool lexicographical_compare(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2,
+                             std::false_type)
+{
+    return std::lexicographical_compare(first1, last1, first2, last2);
+}
+
+template<typename Iterator1, typename Iterator2>
+bool lexicographical_compare(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2,
+                             std::true_type)
+{
+    const auto m = detail::mismatch(first1, last1, first2, last2, std::true_type{});
+    if(m.first != last1 && m.second != last2) {
+        return *m.first < *m.second;
+    }
+    return m.first == last1 && m.second != last2;
+}
+
+} // namespace detail
+
+// Vectorized versions of the <algorithm> functions that search and compare arrays of integers.
+//
+// Each function has the signature and result of its std counterpart, plus an overload taking
+// spans. Ranges of integers (not bool) behind pointers or std::vector iterators run through SSE2
+// or AVX2 kernels; anything else, floating point included, is passed on to std.
+namespace simd_algo {
+
+// Searching
+
+template<typename InputIterator, typename Value>
+InputIterator find(InputIterator first, InputIterator last, const Value &value)
+{
+    return detail::find(first, last, value, detail::simd_algo_search_tag<InputIterator, Value>{});
+}
+
+template<typename T, std::size_t Extent, typename Value>
+typename span<T, Extent>::iterator find(span<T, Extent> range, const Value &value)
+{
+    return simd_algo::find(range.begin(), range.end(), value);
+}
+
+template<typename InputIterator, typename Value>
+typename std::iterator_traits<InputIterator>::difference_type
+count(InputIterator first, InputIterator last, const Value &value)
+{
+    return detail::count(first, last, value, detail::simd_algo_search_tag<InputIterator, Value>{});
+}
+
+template<typename T, std::size_t Extent, typename Value>
+std::size_t count(span<T, Extent> range, const Value &value)
+{
+    return static_cast<std::size_t>(count(range.begin(), range.end(), value));
+}
+
+// Minimum and maximum
+
+template<typename ForwardIterator>
+ForwardIterator min_element(ForwardIterator first, ForwardIterator last)
+{
+    return detail::min_element(first, last, detail::is_simd_algo_iterator<ForwardIterator>{});
+}
+
+template<typename T, std::size_t Extent>
+typename span<T, Extent>::iterator min_element(span<T, Extent> range)
+{
+    return simd_algo::min_element(range.begin(), range.end());
+}
+
+template<typename ForwardIterator>
+ForwardIterator max_element(ForwardIterator first, ForwardIterator last)
+{
+    return detail::max_element(first, last, detail::is_simd_algo_iterator<ForwardIterator>{});
+}
+
+template<typename T, std::size_t Extent>
+typename span<T, Extent>::iterator max_element(span<T, Extent> range)
+{
+    return simd_algo::max_element(range.begin(), range.end());
+}
+
+template<typename ForwardIterator>
+std::pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator first, ForwardIterator last)
+{
+    return detail::minmax_element(first, last, detail::is_simd_algo_iterator<ForwardIterator>{});
+}
+
+template<typename T, std::size_t Extent>
+std::pair<typename span<T, Extent>::iterator, typename span<T, Extent>::iterator>
+minmax_element(span<T, Extent> range)
+{
+    return simd_algo::minmax_element(range.begin(), range.end());
+}
+
+// Comparison
+
+template<typename InputIterator1, typename InputIterator2>
+std::pair<InputIterator1, InputIterator2>
+mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
+{
+    return detail::mismatch(first1, last1, first2, last2,
+                            detail::simd_algo_compare_tag<InputIterator1, InputIterator2>{});
+}
+
+// The second range is at least as long as the first.
+template<typename InputIterator1, typename InputIterator2>
+std::pair<InputIterator1, InputIterator2>
+mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    return detail::simd_algo_compare_tag<InputIterator1, InputIterator2>::value
+         ? simd_algo::mismatch(first1, last1, first2, std::next(first2, std::distance(first1, last1)))
+         : std::mismatch(first1, last1, first2);
+}
+
+template<typename T, std::size_t Extent1, typename U, std::size_t Extent2>
+std::pair<typename span<T, Extent1>::iterator, typename span<U, Extent2>::iterator>
+mismatch(span<T, Extent1> a, span<U, Extent2> b)
+{
+    return simd_algo::mismatch(a.begin(), a.end(), b.begin(), b.end());
+}
+
+// std::equal already turns into memcmp for integers, which the C library vectorizes; ranges of
+// different lengths are rejected before touching the elements.
+template<typename InputIterator1, typename InputIterator2>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    return std::equal(first1, last1, first2);
+}
+
+template<typename InputIterator1, typename InputIterator2>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
+{
+    if(detail::simd_algo_compare_tag<InputIterator1, InputIterator2>::value) {
+        return std::distance(first1, last1) == std::distance(first2, last2) && std::equal(first1, last1, first2);
+    }
+    return simd_algo::mismatch(first1, last1, first2, last2) == std::make_pair(last1, last2);
+}
+
+template<typename T, std::size_t Extent1, typename U, std::size_t Extent2>
+bool equal(span<T, Extent1> a, span<U, Extent2> b)
+{
+    return simd_algo::equal(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template<typename InputIterator1, typename InputIterator2>
+bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
+{
+    return detail::lexicographical_compare(first1, last1, first2, last2,
+                                           detail::simd_algo_order_tag<InputIterator1, InputIterator2>{});
+}
+
+template<typename T, std::size_t Extent1, typename U, std::size_t Extent2>
+bool lexicographical_compare(span<T, Extent1> a, span<U, Extent2> b)
+{
+    return simd_algo::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+} // namespace simd_algo
+
+} // namespace cppbp
+
+#endif // CPPBP_SIMD_ALGO_HPP
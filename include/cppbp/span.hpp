@@ -0,0 +1,358 @@
+#ifndef CPPBP_SPAN_HPP
+#define CPPBP_SPAN_HPP
+
+#include <cppbp/config.hpp>     // CPPBP_CONSTEXPR14
+
+#include <array>        // std::array
+#include <cassert>      // assert
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::memcpy
+#include <iterator>     // std::reverse_iterator
+#include <type_traits>  // std::remove_cv, std::enable_if, std::is_convertible
+#include <utility>      // std::declval
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+constexpr std::size_t dynamic_extent = static_cast<std::size_t>(-1);
+
+template<typename T, std::size_t Extent = dynamic_extent>
+class span;
+
+namespace detail {
+
+template<typename T>
+struct is_span : std::false_type { };
+
+template<typename T, std::size_t Extent>
+struct is_span<span<T, Extent>> : std::true_type { };
+
+template<typename T>
+struct is_std_array : std::false_type { };
+
+template<typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type { };
+
+template<typename... >
+struct void_type
+{
+    using type = void;
+};
+
+// Contiguous containers: anything with data() and size() whose elements convert to ElementType
+// through a qualification conversion.
+template<typename Container, typename ElementType, typename = void>
+struct is_span_compatible_container : std::false_type { };
+
+template<typename Container, typename ElementType>
+struct is_span_compatible_container<Container, ElementType,
+    typename void_type<decltype(std::declval<Container&>().data()),
+                       decltype(std::declval<Container&>().size())>::type>
+    : std::integral_constant<bool,
+        !is_span<typename std::remove_cv<Container>::type>::value
+        && !is_std_array<typename std::remove_cv<Container>::type>::value
+        && !std::is_array<Container>::value
+        && std::is_convertible<typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type(*)[],
+                               ElementType(*)[]>::value>
+{ };
+
+// Static extent spans still store their size; Extent is only used for checking.
+template<std::size_t Extent, std::size_t Offset, std::size_t Count>
+struct subspan_extent
+    : std::integral_constant<std::size_t,
+        Count != dynamic_extent ? Count : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent)>
+{ };
+
+} // namespace detail
+
+template<typename T, std::size_t Extent>
+class span final
+{
+    // Types
+public:
+    using element_type              = T;
+    using value_type                = typename std::remove_cv<T>::type;
+    using size_type                 = std::size_t;
+    using difference_type           = std::ptrdiff_t;
+    using pointer                   = T*;
+    using const_pointer             = const T*;
+    using reference                 = T&;
+    using const_reference           = const T&;
+    using iterator                  = pointer;
+    using reverse_iterator          = std::reverse_iterator<iterator>;
+
+    static constexpr size_type extent = Extent;
+
+    // Construction and Assignment                                                 [span.cons]
+public:
+    template<std::size_t E = Extent,
+             typename std::enable_if<E == 0 || E == dynamic_extent, int>::type = 0>
+    constexpr span() noexcept
+        : m_data{nullptr}
+        , m_size{0}
+    { }
+
+    // A static extent span taking its size at run time is explicit, as in C++20.
+    template<std::size_t E = Extent,
+             typename std::enable_if<E == dynamic_extent, int>::type = 0>
+    constexpr span(pointer first, size_type count)
+        : m_data{first}
+        , m_size{count}
+    { }
+
+    template<std::size_t E = Extent,
+             typename std::enable_if<E != dynamic_extent, int>::type = 0>
+    constexpr explicit span(pointer first, size_type count)
+        : m_data{first}
+        , m_size{count}
+    { }
+
+    template<typename It,
+             typename std::enable_if<std::is_convertible<It, pointer>::value
+                                     && std::is_pointer<It>::value && Extent == dynamic_extent, int>::type = 0>
+    constexpr span(It first, It last)
+        : m_data{first}
+        , m_size{static_cast<size_type>(last - first)}
+    { }
+
+    template<typename It,
+             typename std::enable_if<std::is_convertible<It, pointer>::value
+                                     && std::is_pointer<It>::value && Extent != dynamic_extent, int>::type = 0>
+    constexpr explicit span(It first, It last)
+        : m_data{first}
+        , m_size{static_cast<size_type>(last - first)}
+    { }
+
+    template<std::size_t N,
+             typename std::enable_if<Extent == dynamic_extent || Extent == N, int>::type = 0>
+    constexpr span(element_type (&arr)[N]) noexcept
+        : m_data{arr}
+        , m_size{N}
+    { }
+
+    template<typename U, std::size_t N,
+             typename std::enable_if<(Extent == dynamic_extent || Extent == N)
+                                     && std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+    constexpr span(std::array<U, N> &arr) noexcept
+        : m_data{arr.data()}
+        , m_size{N}
+    { }
+
+    template<typename U, std::size_t N,
+             typename std::enable_if<(Extent == dynamic_extent || Extent == N)
+                                     && std::is_convertible<const U(*)[], T(*)[]>::value, int>::type = 0>
+    constexpr span(const std::array<U, N> &arr) noexcept
+        : m_data{arr.data()}
+        , m_size{N}
+    { }
+
+    template<typename Container,
+             typename std::enable_if<detail::is_span_compatible_container<Container, T>::value
+                                     && Extent == dynamic_extent, int>::type = 0>
+    constexpr span(Container &container)
+        : m_data{container.data()}
+        , m_size{static_cast<size_type>(container.size())}
+    { }
+
+    template<typename Container,
+             typename std::enable_if<detail::is_span_compatible_container<Container, T>::value
+                                     && Extent != dynamic_extent, int>::type = 0>
+    constexpr explicit span(Container &container)
+        : m_data{container.data()}
+        , m_size{static_cast<size_type>(container.size())}
+    { }
+
+    template<typename Container,
+             typename std::enable_if<detail::is_span_compatible_container<const Container, T>::value
+                                     && Extent == dynamic_extent, int>::type = 0>
+    constexpr span(const Container &container)
+        : m_data{container.data()}
+        , m_size{static_cast<size_type>(container.size())}
+    { }
+
+    template<typename Container,
+             typename std::enable_if<detail::is_span_compatible_container<const Container, T>::value
+                                     && Extent != dynamic_extent, int>::type = 0>
+    constexpr explicit span(const Container &container)
+        : m_data{container.data()}
+        , m_size{static_cast<size_type>(container.size())}
+    { }
+
+    // Narrowing a dynamic extent span to a static one is explicit.
+    template<typename U, std::size_t N,
+             typename std::enable_if<(Extent == dynamic_extent || Extent == N)
+                                     && std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+    constexpr span(const span<U, N> &other) noexcept
+        : m_data{other.data()}
+        , m_size{other.size()}
+    { }
+
+    template<typename U, std::size_t N,
+             typename std::enable_if<Extent != dynamic_extent && N == dynamic_extent
+                                     && std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+    constexpr explicit span(const span<U, N> &other) noexcept
+        : m_data{other.data()}
+        , m_size{other.size()}
+    { }
+
+    constexpr span(const span &other) noexcept = default;
+    CPPBP_CONSTEXPR14 span& operator=(const span &other) noexcept = default;
+
+    // Subviews                                                                    [span.sub]
+public:
+    template<std::size_t Count>
+    CPPBP_CONSTEXPR14 span<T, Count> first() const
+    {
+        assert(Count <= m_size);
+        return span<T, Count>{m_data, Count};
+    }
+
+    template<std::size_t Count>
+    CPPBP_CONSTEXPR14 span<T, Count> last() const
+    {
+        assert(Count <= m_size);
+        return span<T, Count>{m_data + (m_size - Count), Count};
+    }
+
+    template<std::size_t Offset, std::size_t Count = dynamic_extent>
+    CPPBP_CONSTEXPR14 span<T, detail::subspan_extent<Extent, Offset, Count>::value> subspan() const
+    {
+        assert(Offset <= m_size && (Count == dynamic_extent || Count <= m_size - Offset));
+        return span<T, detail::subspan_extent<Extent, Offset, Count>::value>{
+            m_data + Offset, Count == dynamic_extent ? m_size - Offset : Count};
+    }
+
+    CPPBP_CONSTEXPR14 span<T, dynamic_extent> first(size_type count) const
+    {
+        assert(count <= m_size);
+        return span<T, dynamic_extent>{m_data, count};
+    }
+
+    CPPBP_CONSTEXPR14 span<T, dynamic_extent> last(size_type count) const
+    {
+        assert(count <= m_size);
+        return span<T, dynamic_extent>{m_data + (m_size - count), count};
+    }
+
+    CPPBP_CONSTEXPR14 span<T, dynamic_extent> subspan(size_type offset, size_type count = dynamic_extent) const
+    {
+        assert(offset <= m_size && (count == dynamic_extent || count <= m_size - offset));
+        return span<T, dynamic_extent>{m_data + offset, count == dynamic_extent ? m_size - offset : count};
+    }
+
+    // Observers                                                                   [span.obs]
+public:
+    constexpr size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr size_type size_bytes() const noexcept
+    {
+        return m_size * sizeof(element_type);
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    // Element access                                                             [span.elem]
+public:
+    CPPBP_CONSTEXPR14 reference operator[](size_type idx) const
+    {
+        assert(idx < m_size);
+        return m_data[idx];
+    }
+
+    CPPBP_CONSTEXPR14 reference front() const
+    {
+        assert(m_size > 0);
+        return m_data[0];
+    }
+
+    CPPBP_CONSTEXPR14 reference back() const
+    {
+        assert(m_size > 0);
+        return m_data[m_size - 1];
+    }
+
+    constexpr pointer data() const noexcept
+    {
+        return m_data;
+    }
+
+    // Iterator support                                                        [span.iterators]
+public:
+    constexpr iterator begin() const noexcept
+    {
+        return m_data;
+    }
+
+    constexpr iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    constexpr reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator{end()};
+    }
+
+    constexpr reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator{begin()};
+    }
+
+    // Private Member
+private:
+    pointer     m_data;
+    size_type   m_size;
+};
+
+// Static member initialization
+
+template<typename T, std::size_t Extent>
+constexpr typename span<T, Extent>::size_type span<T, Extent>::extent;
+
+// Views of object representation                                         [span.objectrep]
+
+// std::byte is not available before C++17; bytes are viewed as unsigned char.
+
+template<typename T, std::size_t Extent>
+span<const unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>
+as_bytes(span<T, Extent> s) noexcept
+{
+    return span<const unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>{
+        reinterpret_cast<const unsigned char*>(s.data()), s.size_bytes()};
+}
+
+template<typename T, std::size_t Extent,
+         typename std::enable_if<!std::is_const<T>::value, int>::type = 0>
+span<unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>
+as_writable_bytes(span<T, Extent> s) noexcept
+{
+    return span<unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>{
+        reinterpret_cast<unsigned char*>(s.data()), s.size_bytes()};
+}
+
+namespace detail {
+
+// Returns read(copy) for an 8 byte aligned copy of bytes. Used by the deserialize() functions,
+// which borrow the copy and must return a deep copy of the result before the copy is freed.
+template<typename Read>
+auto read_aligned(span<const unsigned char> bytes, Read read) -> decltype(read(bytes))
+{
+    std::vector<std::uint64_t> aligned((bytes.size() + 7) / 8);
+    if(!bytes.empty()) {
+        std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    }
+    return read(span<const unsigned char>{reinterpret_cast<const unsigned char*>(aligned.data()), bytes.size()});
+}
+
+} // namespace detail
+
+} // namespace cppbp
+
+#endif // CPPBP_SPAN_HPP
@@ -0,0 +1,207 @@
+#ifndef CPPBP_STREAM_SEARCHER_HPP
+#define CPPBP_STREAM_SEARCHER_HPP
+
+#include <cppbp/multi_searcher.hpp> // cppbp::multi_searcher
+#include <cppbp/string_search.hpp>  // cppbp::searcher, cppbp::search_mode
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <cstddef>      // std::size_t
+#include <stdexcept>    // std::invalid_argument
+#include <string>       // std::string
+#include <utility>      // std::swap
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+// Finds a needle in a stream that arrives in chunks, including occurrences that straddle two or
+// more chunks. Positions are reported in stream coordinates, as if all chunks had been
+// concatenated.
+//
+// Between chunks only the last needle.size() - 1 bytes of the stream are kept. A new chunk is
+// searched in place with a Boyer-Moore-Horspool searcher; only the boundary, those kept bytes
+// followed by the first needle.size() - 1 bytes of the chunk, is copied to a small window and
+// searched there for matches that start before the chunk.
+class stream_searcher final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    // Construction and Assignment
+public:
+    // Copies needle. Throws std::invalid_argument if it is empty.
+    explicit stream_searcher(string_view needle, search_mode mode = search_mode::non_overlapping)
+        : m_needle(needle.begin(), needle.end())
+        , m_searcher{string_view{m_needle.data(), m_needle.size()}}
+        , m_mode{mode}
+        , m_consumed{0}
+        , m_allowed{0}
+    {
+        if(needle.empty()) {
+            throw std::invalid_argument("stream_searcher: needle must not be empty");
+        }
+        m_tail.reserve(needle.size() - 1);
+        m_window.reserve(2 * (needle.size() - 1));
+    }
+
+    stream_searcher(const stream_searcher &other)
+        : m_needle{other.m_needle}
+        , m_searcher{string_view{m_needle.data(), m_needle.size()}}
+        , m_mode{other.m_mode}
+        , m_tail{other.m_tail}
+        , m_consumed{other.m_consumed}
+        , m_allowed{other.m_allowed}
+    { }
+
+    stream_searcher& operator=(const stream_searcher &other)
+    {
+        stream_searcher copy{other};
+        swap(copy);
+        return *this;
+    }
+
+    // Observers
+public:
+    string_view needle() const noexcept
+    {
+        return string_view{m_needle.data(), m_needle.size()};
+    }
+
+    // Bytes fed so far.
+    size_type consumed() const noexcept
+    {
+        return m_consumed;
+    }
+
+    // Modifiers
+public:
+    // Searches the next chunk of the stream and calls f(position) for every match that ends in
+    // it, in increasing order.
+    template<typename Function>
+    void feed(string_view chunk, Function f)
+    {
+        const size_type keep = m_needle.size() - 1;
+        if(!m_tail.empty() && !chunk.empty()) {
+            m_window.assign(m_tail);
+            m_window.append(chunk.data(), chunk.size() < keep ? chunk.size() : keep);
+            const string_view window{m_window.data(), m_window.size()};
+            const size_type base = m_consumed - m_tail.size();
+            for(size_type pos = m_searcher.search(window, 0); pos != searcher::npos && pos < m_tail.size();
+                pos = m_searcher.search(window, pos + 1)) {
+                report(base + pos, f);
+            }
+        }
+        const size_type start = m_mode == search_mode::non_overlapping && m_allowed > m_consumed
+                              ? m_allowed - m_consumed : 0;
+        for(size_type pos = m_searcher.search(chunk, start); pos != searcher::npos;
+            pos = m_searcher.search(chunk, pos + 1)) {
+            report(m_consumed + pos, f);
+        }
+
+        if(chunk.size() >= keep) {
+            m_tail.assign(chunk.data() + chunk.size() - keep, keep);
+        } else {
+            const size_type drop = m_tail.size() + chunk.size() > keep ? m_tail.size() + chunk.size() - keep : 0;
+            m_tail.erase(0, drop);
+            m_tail.append(chunk.data(), chunk.size());
+        }
+        m_consumed += chunk.size();
+    }
+
+    // Starts a new stream.
+    void reset() noexcept
+    {
+        m_tail.clear();
+        m_consumed = 0;
+        m_allowed = 0;
+    }
+
+    void swap(stream_searcher &other) noexcept
+    {
+        // Vectors keep their buffers when swapped, so the searchers stay valid.
+        m_needle.swap(other.m_needle);
+        std::swap(m_searcher, other.m_searcher);
+        std::swap(m_mode, other.m_mode);
+        m_tail.swap(other.m_tail);
+        m_window.swap(other.m_window);
+        std::swap(m_consumed, other.m_consumed);
+        std::swap(m_allowed, other.m_allowed);
+    }
+
+    // Helper
+private:
+    template<typename Function>
+    void report(size_type position, Function &f)
+    {
+        if(m_mode == search_mode::overlapping || position >= m_allowed) {
+            f(position);
+            m_allowed = position + m_needle.size();
+        }
+    }
+
+    // Private Member
+private:
+    std::vector<char>   m_needle;
+    searcher            m_searcher;
+    search_mode         m_mode;
+    std::string         m_tail;     // last needle.size() - 1 bytes of the stream
+    std::string         m_window;   // m_tail followed by the start of the chunk
+    size_type           m_consumed;
+    size_type           m_allowed;  // first position a non-overlapping match may start at
+};
+
+// Streaming form of a multi_searcher. The state between chunks is the automaton state alone, as
+// the automaton already remembers the longest pattern prefix the stream ends with.
+class multi_stream_searcher final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+    using match     = multi_searcher::match;
+
+    // Construction
+public:
+    // searcher must outlive this object.
+    explicit multi_stream_searcher(const multi_searcher &searcher) noexcept
+        : m_searcher{&searcher}
+        , m_state{searcher.start()}
+        , m_consumed{0}
+    { }
+
+    // Observers
+public:
+    size_type consumed() const noexcept
+    {
+        return m_consumed;
+    }
+
+    // Modifiers
+public:
+    // Searches the next chunk and calls f(match) for every occurrence that ends in it, ordered
+    // by the end of the match.
+    template<typename Function>
+    void feed(string_view chunk, Function f)
+    {
+        const multi_searcher &searcher = *m_searcher;
+        m_state = searcher.scan(m_state, chunk, [&](size_type end, size_type pattern) {
+            f(match{m_consumed + end - searcher.pattern_length(pattern), pattern});
+        });
+        m_consumed += chunk.size();
+    }
+
+    void reset() noexcept
+    {
+        m_state = m_searcher->start();
+        m_consumed = 0;
+    }
+
+    // Private Member
+private:
+    const multi_searcher       *m_searcher;
+    multi_searcher::state_type  m_state;
+    size_type                   m_consumed;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_STREAM_SEARCHER_HPP
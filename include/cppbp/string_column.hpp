@@ -0,0 +1,398 @@
+#ifndef CPPBP_STRING_COLUMN_HPP
+#define CPPBP_STRING_COLUMN_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::countr_zero
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/hash_batch.hpp>     // cppbp::hash_batch
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::detail::hash_key
+
+#include <algorithm>    // std::upper_bound
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::int32_t, std::int64_t, std::uint64_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::out_of_range
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_cmpeq_epi8, _mm256_mask_i64gather_epi64, _mm256_cmpgt_epi64, ...
+#endif
+
+namespace cppbp {
+
+namespace detail {
+
+// Calls f(i) for every occurrence of needle (size m >= 1) at p[i], in increasing order.
+// Positions whose first and last byte match the needle's are found with SIMD compares; only
+// those are compared in full.
+template<typename Function>
+void for_each_occurrence(const char *p, std::size_t n, string_view needle, Function f)
+{
+    const std::size_t m = needle.size();
+    if(m > n) {
+        return;
+    }
+    const std::size_t last = n - m;     // last possible start
+    std::size_t i = 0;
+    const auto verify = [&](std::size_t pos) {
+        if(m <= 2 || std::memcmp(p + pos + 1, needle.data() + 1, m - 2) == 0) {
+            f(pos);
+        }
+    };
+#if defined(__AVX2__)
+    const __m256i first32 = _mm256_set1_epi8(needle[0]);
+    const __m256i last32 = _mm256_set1_epi8(needle[m - 1]);
+    for(; i + 32 <= last + 1; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + m - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, first32), _mm256_cmpeq_epi8(b, last32))));
+        for(; mask != 0; mask &= mask - 1) {
+            verify(i + static_cast<std::size_t>(countr_zero(mask)));
+        }
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    const __m128i first16 = _mm_set1_epi8(needle[0]);
+    const __m128i last16 = _mm_set1_epi8(needle[m - 1]);
+    for(; i + 16 <= last + 1; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + m - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first16), _mm_cmpeq_epi8(b, last16))));
+        for(; mask != 0; mask &= mask - 1) {
+            verify(i + static_cast<std::size_t>(countr_zero(mask)));
+        }
+    }
+#endif
+    for(; i <= last; ++i) {
+        if(p[i] == needle[0] && p[i + m - 1] == needle[m - 1]) {
+            verify(i);
+        }
+    }
+}
+
+#if defined(__AVX2__)
+// Four consecutive offsets widened to 64 bit lanes.
+inline __m256i load_offsets(const std::int32_t *p) noexcept
+{
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+inline __m256i load_offsets(const std::int64_t *p) noexcept
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+#endif
+
+} // namespace detail
+
+// Row numbers of the set bits of a mask returned by the string_column kernels.
+inline std::vector<std::size_t> mask_to_selection(span<const std::uint64_t> mask)
+{
+    std::vector<std::size_t> result;
+    for(std::size_t w = 0; w < mask.size(); ++w) {
+        for(std::uint64_t bits = mask[w]; bits != 0; bits &= bits - 1) {
+            result.push_back(w * 64 + static_cast<std::size_t>(countr_zero(bits)));
+        }
+    }
+    return result;
+}
+
+// Column of strings in one contiguous buffer, addressed by an array of size() + 1 offsets.
+//
+// The layout is Arrow's (utf8 with signed 32 bit, large_utf8 with signed 64 bit offsets): string i is
+// data()[offsets()[i], offsets()[i + 1]). Compared to a vector of string_views this needs 4 or 8
+// bytes per string instead of 16 plus an allocation, and scanning the column reads memory in
+// order. The kernels evaluate a predicate over every row and return a bitmask with bit i % 64 of
+// word i / 64 set for the matching rows.
+template<typename Offset>
+class basic_string_column final
+{
+    // Types
+public:
+    using size_type     = std::size_t;
+    using offset_type   = Offset;
+    using mask_type     = std::vector<std::uint64_t>;
+
+    // Construction and Assignment
+public:
+    basic_string_column()
+        : m_offsets(1, 0)
+    { }
+
+    // Takes Arrow style buffers. Throws std::invalid_argument unless offsets is non-empty,
+    // non-negative, non-decreasing and ends within data.
+    basic_string_column(std::vector<Offset> offsets, std::vector<char> data)
+        : m_offsets(std::move(offsets))
+        , m_data(std::move(data))
+    {
+        if(m_offsets.empty()) {
+            throw std::invalid_argument("string_column: offsets must not be empty");
+        }
+        if(m_offsets.front() < 0) {
+            throw std::invalid_argument("string_column: offsets must not be negative");
+        }
+        for(size_type i = 1; i < m_offsets.size(); ++i) {
+            if(m_offsets[i] < m_offsets[i - 1]) {
+                throw std::invalid_argument("string_column: offsets must not decrease");
+            }
+        }
+        if(static_cast<size_type>(m_offsets.back()) > m_data.size()) {
+            throw std::invalid_argument("string_column: offsets point past the data");
+        }
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_offsets.size() - 1;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_offsets.size() == 1;
+    }
+
+    // Bytes of string data.
+    size_type data_size() const noexcept
+    {
+        return static_cast<size_type>(m_offsets.back() - m_offsets.front());
+    }
+
+    void reserve(size_type rows, size_type bytes)
+    {
+        m_offsets.reserve(rows + 1);
+        m_data.reserve(bytes);
+    }
+
+    // Element access
+public:
+    string_view operator[](size_type i) const noexcept
+    {
+        return string_view{m_data.data() + m_offsets[i], static_cast<size_type>(m_offsets[i + 1] - m_offsets[i])};
+    }
+
+    string_view at(size_type i) const
+    {
+        if(i >= size()) {
+            throw std::out_of_range("string_column::at: index out of range");
+        }
+        return (*this)[i];
+    }
+
+    span<const Offset> offsets() const noexcept
+    {
+        return span<const Offset>{m_offsets.data(), m_offsets.size()};
+    }
+
+    span<const char> data() const noexcept
+    {
+        return span<const char>{m_data.data(), m_data.size()};
+    }
+
+    // Modifiers
+public:
+    // Throws std::length_error if the data would end past the largest offset, which is INT32_MAX
+    // for a string_column.
+    void push_back(string_view value)
+    {
+        if(value.size() > static_cast<size_type>(std::numeric_limits<Offset>::max() - m_offsets.back())) {
+            throw std::length_error("string_column::push_back: data exceeds the offset range");
+        }
+        // Imported data may extend past the last string.
+        m_data.resize(static_cast<size_type>(m_offsets.back()));
+        m_data.insert(m_data.end(), value.begin(), value.end());
+        m_offsets.push_back(static_cast<Offset>(m_offsets.back() + value.size()));
+    }
+
+    void clear() noexcept
+    {
+        m_offsets.assign(1, 0);
+        m_data.clear();
+    }
+
+    // Kernels
+public:
+    mask_type equals(string_view value) const
+    {
+        return prefix_mask(value, true);
+    }
+
+    mask_type starts_with(string_view prefix) const
+    {
+        return prefix_mask(prefix, false);
+    }
+
+    // Searches the whole data buffer once instead of every row on its own; a match is kept when
+    // it does not cross the end of its row, and later matches in the same row are skipped.
+    mask_type contains(string_view needle) const
+    {
+        if(needle.empty()) {
+            return mask_of([](size_type) { return true; });
+        }
+        mask_type mask((size() + 63) / 64, 0);
+        const size_type first = static_cast<size_type>(m_offsets.front());
+        size_type r = 0;
+        size_type skip = first;     // matches before this lie in a row that already matched
+        detail::for_each_occurrence(m_data.data() + first, static_cast<size_type>(m_offsets.back()) - first, needle,
+                                    [&](size_type at) {
+            const size_type pos = first + at;
+            if(pos < skip) {
+                return;
+            }
+            // Row holding pos: the last one starting at or before it.
+            r = static_cast<size_type>(std::upper_bound(m_offsets.begin() + r + 1, m_offsets.end(),
+                                                        static_cast<Offset>(pos)) - m_offsets.begin()) - 1;
+            if(pos + needle.size() <= static_cast<size_type>(m_offsets[r + 1])) {
+                mask[r / 64] |= std::uint64_t{1} << (r % 64);
+                skip = static_cast<size_type>(m_offsets[r + 1]);
+            }
+        });
+        return mask;
+    }
+
+    // Element i is detail::hash_key((*this)[i], seed).
+    std::vector<std::uint64_t> hash_all(std::uint64_t seed = detail::default_hash_seed) const
+    {
+        std::vector<std::uint64_t> hashes(size());
+        string_view views[batch_size];
+        for(size_type i = 0; i < hashes.size(); i += batch_size) {
+            const size_type n = hashes.size() - i < batch_size ? hashes.size() - i : batch_size;
+            for(size_type j = 0; j < n; ++j) {
+                views[j] = (*this)[i + j];
+            }
+            hash_batch(span<const string_view>{views, n}, span<std::uint64_t>{hashes.data() + i, n}, seed);
+        }
+        return hashes;
+    }
+
+    // Helper
+private:
+    static constexpr size_type batch_size = 64;
+
+    const char* row(size_type i) const noexcept
+    {
+        return m_data.data() + m_offsets[i];
+    }
+
+    size_type length(size_type i) const noexcept
+    {
+        return static_cast<size_type>(m_offsets[i + 1] - m_offsets[i]);
+    }
+
+    template<typename Predicate>
+    mask_type mask_of(Predicate predicate) const
+    {
+        const size_type n = size();
+        mask_type mask((n + 63) / 64, 0);
+        for(size_type w = 0; w < mask.size(); ++w) {
+            const size_type end = n - w * 64 < 64 ? n - w * 64 : 64;
+            std::uint64_t bits = 0;
+            for(size_type j = 0; j < end; ++j) {
+                bits |= static_cast<std::uint64_t>(predicate(w * 64 + j) ? 1u : 0u) << j;
+            }
+            mask[w] = bits;
+        }
+        return mask;
+    }
+
+    // equals() and starts_with(). The length comes from the offsets and the first up to 8 bytes
+    // from one masked 64 bit load per row, four rows per step with AVX2; only rows that pass both
+    // compare the rest of a longer value with memcmp. Rows too close to the end of the buffer for
+    // the load compare with memcmp.
+    mask_type prefix_mask(string_view value, bool exact) const
+    {
+        const size_type k = value.size();
+        const size_type head = k < 8 ? k : 8;
+        // Built bytewise so that the first head bytes are kept whatever the byte order.
+        unsigned char bytes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        unsigned char ones[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        for(size_type j = 0; j < head; ++j) {
+            bytes[j] = static_cast<unsigned char>(value[j]);
+            ones[j] = 0xff;
+        }
+        std::uint64_t expected;
+        std::uint64_t keep;
+        std::memcpy(&expected, bytes, 8);
+        std::memcpy(&keep, ones, 8);
+        // Rows starting before this can be loaded with 8 bytes.
+        const size_type loadable = m_data.size() < 8 ? 0 : m_data.size() - 7;
+        const auto tail_matches = [&](size_type i) {
+            return k <= 8 || std::memcmp(row(i) + 8, value.data() + 8, k - 8) == 0;
+        };
+        const auto matches = [&](size_type i) {
+            const size_type len = length(i);
+            if(exact ? len != k : len < k) {
+                return false;
+            }
+            if(k == 0) {
+                return true;
+            }
+            const size_type start = static_cast<size_type>(m_offsets[i]);
+            if(start >= loadable) {
+                return std::memcmp(row(i), value.data(), k) == 0;
+            }
+            std::uint64_t word;
+            std::memcpy(&word, m_data.data() + start, 8);
+            return (word & keep) == expected && tail_matches(i);
+        };
+
+        const size_type n = size();
+        mask_type mask((n + 63) / 64, 0);
+        size_type i = 0;
+#if defined(__AVX2__)
+        if(k != 0) {
+            const __m256i length_bound = _mm256_set1_epi64x(static_cast<long long>(exact ? k : k - 1));
+            const __m256i load_bound = _mm256_set1_epi64x(static_cast<long long>(loadable));
+            const __m256i keep4 = _mm256_set1_epi64x(static_cast<long long>(keep));
+            const __m256i expected4 = _mm256_set1_epi64x(static_cast<long long>(expected));
+            const long long *base = reinterpret_cast<const long long*>(m_data.data());
+            for(; i + 4 <= n; i += 4) {
+                const __m256i starts = detail::load_offsets(m_offsets.data() + i);
+                const __m256i lengths = _mm256_sub_epi64(detail::load_offsets(m_offsets.data() + i + 1), starts);
+                const __m256i fits = exact ? _mm256_cmpeq_epi64(lengths, length_bound)
+                                           : _mm256_cmpgt_epi64(lengths, length_bound);
+                if(_mm256_testz_si256(fits, fits)) {
+                    continue;   // no row has a fitting length, which is the common case for equals()
+                }
+                const __m256i load = _mm256_and_si256(fits, _mm256_cmpgt_epi64(load_bound, starts));
+                const __m256i words = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(), base, starts, load, 1);
+                const __m256i hit = _mm256_and_si256(load, _mm256_cmpeq_epi64(_mm256_and_si256(words, keep4), expected4));
+                unsigned hits = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(hit)));
+                unsigned rest = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_andnot_si256(load, fits))));
+                // Up to 8 bytes the loaded word was the whole value.
+                std::uint64_t bits = k <= 8 ? hits : 0;
+                for(hits = k <= 8 ? 0 : hits; hits != 0; hits &= hits - 1) {
+                    const unsigned j = static_cast<unsigned>(countr_zero(hits));
+                    bits |= static_cast<std::uint64_t>(tail_matches(i + j) ? 1u : 0u) << j;
+                }
+                for(; rest != 0; rest &= rest - 1) {
+                    const unsigned j = static_cast<unsigned>(countr_zero(rest));
+                    bits |= static_cast<std::uint64_t>(std::memcmp(row(i + j), value.data(), k) == 0 ? 1u : 0u) << j;
+                }
+                mask[i / 64] |= bits << (i % 64);
+            }
+        }
+#endif
+        for(; i < n; ++i) {
+            mask[i / 64] |= static_cast<std::uint64_t>(matches(i) ? 1u : 0u) << (i % 64);
+        }
+        return mask;
+    }
+
+    // Private Member
+private:
+    std::vector<Offset> m_offsets;
+    std::vector<char>   m_data;
+};
+
+using string_column         = basic_string_column<std::int32_t>;
+using large_string_column   = basic_string_column<std::int64_t>;
+
+} // namespace cppbp
+
+#endif // CPPBP_STRING_COLUMN_HPP
@@ -0,0 +1,432 @@
+#ifndef CPPBP_STRING_DICTIONARY_HPP
+#define CPPBP_STRING_DICTIONARY_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::bit_ceil
+#include <cppbp/cstring_view.hpp>   // cppbp::cstring_view
+#include <cppbp/mapped_file.hpp>    // cppbp::mapped_file
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view, cppbp::detail::hash_key
+
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstdio>       // std::FILE, std::fopen, std::fwrite, std::fclose, std::rename
+#include <cstring>      // std::memcpy, std::memcmp
+#include <stdexcept>    // std::invalid_argument, std::length_error, std::out_of_range, std::runtime_error
+#include <string>       // std::string
+#include <system_error> // std::system_error, std::system_category
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Layout of a serialized string dictionary. All offsets are relative to the start of the buffer,
+// so the file can be mapped at any address. Integers use the byte order of the writer, which the
+// endian marker records.
+//
+//   header    80 bytes, see below
+//   offsets   (count + 1) x u64, key i is blob[offsets[i], offsets[i + 1])
+//   values    count x value_size bytes, in key order
+//   blob      the concatenated key bytes
+//   index     slots x u64, (upper 32 hash bits << 32) | (ordinal + 1), 0 marks an empty slot
+struct string_dictionary_layout
+{
+    static constexpr std::size_t header_size = 80;
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::uint32_t endian_marker = 0x01020304u;
+
+    static constexpr std::size_t magic_at = 0;
+    static constexpr std::size_t version_at = 4;
+    static constexpr std::size_t value_size_at = 8;
+    static constexpr std::size_t endian_at = 12;
+    static constexpr std::size_t count_at = 16;
+    static constexpr std::size_t seed_at = 24;
+    static constexpr std::size_t offsets_at = 32;
+    static constexpr std::size_t values_at = 40;
+    static constexpr std::size_t blob_at = 48;
+    static constexpr std::size_t blob_size_at = 56;
+    static constexpr std::size_t index_at = 64;
+    static constexpr std::size_t slots_at = 72;
+
+    static const char* magic() noexcept
+    {
+        return "CSD1";
+    }
+
+    static std::size_t align8(std::size_t n) noexcept
+    {
+        return (n + 7) & ~std::size_t{7};
+    }
+};
+
+template<typename T>
+T load_as(const unsigned char *p) noexcept
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void store_as(unsigned char *p, T value) noexcept
+{
+    std::memcpy(p, &value, sizeof(T));
+}
+
+} // namespace detail
+
+// Collects keys with fixed size values and writes them as one position independent buffer that
+// string_dictionary reads without deserialization. Ordinals follow the order of add().
+class string_dictionary_builder final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    // Construction and Assignment
+public:
+    explicit string_dictionary_builder(size_type value_size, std::uint64_t seed = detail::default_hash_seed)
+        : m_value_size{value_size}
+        , m_seed{seed}
+        , m_offsets(1, 0)
+    { }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_offsets.size() - 1;
+    }
+
+    size_type value_size() const noexcept
+    {
+        return m_value_size;
+    }
+
+    // The index stores entry i + 1 in 32 bits, with 0 for an empty slot, and a dictionary of
+    // 0xffffffff entries is not accepted by string_dictionary.
+    static constexpr size_type max_size() noexcept
+    {
+        return 0xfffffffe;
+    }
+
+    // Modifiers
+public:
+    // Copies value_size() bytes from value. Throws std::length_error once max_size() keys were added.
+    void add(string_view key, const void *value)
+    {
+        if(size() >= max_size()) {
+            throw std::length_error("string_dictionary_builder::add: too many keys");
+        }
+        m_blob.append(key.data(), key.size());
+        m_offsets.push_back(m_blob.size());
+        const unsigned char *bytes = static_cast<const unsigned char*>(value);
+        m_values.insert(m_values.end(), bytes, bytes + m_value_size);
+    }
+
+    template<typename T>
+    void add(string_view key, const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "values are stored as raw bytes");
+        if(sizeof(T) != m_value_size) {
+            throw std::invalid_argument("string_dictionary_builder::add: value size mismatch");
+        }
+        add(key, static_cast<const void*>(&value));
+    }
+
+    // Serializes the dictionary. Throws std::invalid_argument if a key was added twice.
+    std::vector<unsigned char> build() const
+    {
+        using layout = detail::string_dictionary_layout;
+        const size_type count = size();
+        const size_type slots = bit_ceil(count * 2 < 2 ? size_type{2} : count * 2);
+
+        const size_type offsets_at = layout::header_size;
+        const size_type values_at = layout::align8(offsets_at + (count + 1) * 8);
+        const size_type blob_at = layout::align8(values_at + m_values.size());
+        const size_type index_at = layout::align8(blob_at + m_blob.size());
+        const size_type total = index_at + slots * 8;
+
+        std::vector<unsigned char> out(total, 0);
+        unsigned char *p = out.data();
+        std::memcpy(p + layout::magic_at, layout::magic(), 4);
+        detail::store_as<std::uint32_t>(p + layout::version_at, layout::version);
+        detail::store_as<std::uint32_t>(p + layout::value_size_at, static_cast<std::uint32_t>(m_value_size));
+        detail::store_as<std::uint32_t>(p + layout::endian_at, layout::endian_marker);
+        detail::store_as<std::uint64_t>(p + layout::count_at, count);
+        detail::store_as<std::uint64_t>(p + layout::seed_at, m_seed);
+        detail::store_as<std::uint64_t>(p + layout::offsets_at, offsets_at);
+        detail::store_as<std::uint64_t>(p + layout::values_at, values_at);
+        detail::store_as<std::uint64_t>(p + layout::blob_at, blob_at);
+        detail::store_as<std::uint64_t>(p + layout::blob_size_at, m_blob.size());
+        detail::store_as<std::uint64_t>(p + layout::index_at, index_at);
+        detail::store_as<std::uint64_t>(p + layout::slots_at, slots);
+
+        for(size_type i = 0; i <= count; ++i) {
+            detail::store_as<std::uint64_t>(p + offsets_at + i * 8, m_offsets[i]);
+        }
+        if(!m_values.empty()) {
+            std::memcpy(p + values_at, m_values.data(), m_values.size());
+        }
+        std::memcpy(p + blob_at, m_blob.data(), m_blob.size());
+
+        for(size_type i = 0; i < count; ++i) {
+            const string_view key = key_at(i);
+            const std::uint64_t h = detail::hash_key(key, m_seed);
+            size_type slot = static_cast<size_type>(h) & (slots - 1);
+            for(;;) {
+                unsigned char *entry = p + index_at + slot * 8;
+                const std::uint64_t current = detail::load_as<std::uint64_t>(entry);
+                if(current == 0) {
+                    detail::store_as<std::uint64_t>(entry, ((h >> 32) << 32) | (i + 1));
+                    break;
+                }
+                if((current >> 32) == (h >> 32) && key_at(static_cast<size_type>(current & 0xffffffffu) - 1) == key) {
+                    throw std::invalid_argument("string_dictionary_builder::build: duplicate key");
+                }
+                slot = (slot + 1) & (slots - 1);
+            }
+        }
+        return out;
+    }
+
+    // Writes the dictionary to path. The data goes to a temporary file that is renamed over
+    // path, so readers never map a partially written dictionary.
+    void write(const std::string &path) const
+    {
+        const std::vector<unsigned char> bytes = build();
+        const std::string tmp = path + ".tmp";
+        std::FILE *file = std::fopen(tmp.c_str(), "wb");
+        if(!file) {
+            throw std::system_error(errno, std::system_category(), "string_dictionary_builder: cannot create " + tmp);
+        }
+        const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        const int error = errno;
+        if(std::fclose(file) != 0 || !written) {
+            std::remove(tmp.c_str());
+            throw std::system_error(written ? errno : error, std::system_category(),
+                                    "string_dictionary_builder: cannot write " + tmp);
+        }
+        if(std::rename(tmp.c_str(), path.c_str()) != 0) {
+            const int rename_error = errno;
+            std::remove(tmp.c_str());
+            throw std::system_error(rename_error, std::system_category(), "string_dictionary_builder: cannot rename to " + path);
+        }
+    }
+
+    // Helper
+private:
+    string_view key_at(size_type i) const noexcept
+    {
+        return string_view{m_blob.data() + m_offsets[i], static_cast<size_type>(m_offsets[i + 1] - m_offsets[i])};
+    }
+
+    // Private Member
+private:
+    size_type                   m_value_size;
+    std::uint64_t               m_seed;
+    std::string                 m_blob;
+    std::vector<std::uint64_t>  m_offsets;
+    std::vector<unsigned char>  m_values;
+};
+
+// Read only view of a buffer written by string_dictionary_builder.
+//
+// Opening validates the header and section bounds only; keys, values and the hash index are read
+// in place, so opening a memory mapped dictionary costs no more than faulting in the pages that
+// lookups touch.
+class string_dictionary final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Construction and Assignment
+public:
+    // Reads the dictionary in bytes, which must outlive it.
+    explicit string_dictionary(span<const unsigned char> bytes)
+    {
+        attach(bytes);
+    }
+
+    // Maps the dictionary stored at path.
+    static string_dictionary open(cstring_view path)
+    {
+        mapped_file file{path};
+        file.advise(mapped_file::access_pattern::random);
+        string_dictionary result{file.bytes()};
+        result.m_file = std::move(file);
+        return result;
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_count;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_count == 0;
+    }
+
+    size_type value_size() const noexcept
+    {
+        return m_value_size;
+    }
+
+    // Lookup
+public:
+    // Ordinal of key, or npos.
+    size_type find(string_view key) const
+    {
+        const std::uint64_t h = detail::hash_key(key, m_seed);
+        size_type slot = static_cast<size_type>(h) & (m_slots - 1);
+        for(size_type probe = 0; probe < m_slots; ++probe) {
+            const std::uint64_t entry = detail::load_as<std::uint64_t>(m_index + slot * 8);
+            if(entry == 0) {
+                return npos;
+            }
+            if((entry >> 32) == (h >> 32)) {
+                const size_type ordinal = static_cast<size_type>(entry & 0xffffffffu) - 1;
+                if(ordinal < m_count && key_at(ordinal) == key) {
+                    return ordinal;
+                }
+            }
+            slot = (slot + 1) & (m_slots - 1);
+        }
+        return npos;
+    }
+
+    bool contains(string_view key) const
+    {
+        return find(key) != npos;
+    }
+
+    string_view key(size_type ordinal) const
+    {
+        check(ordinal);
+        return key_at(ordinal);
+    }
+
+    span<const unsigned char> value(size_type ordinal) const
+    {
+        check(ordinal);
+        return span<const unsigned char>{m_values + ordinal * m_value_size, m_value_size};
+    }
+
+    template<typename T>
+    T value_as(size_type ordinal) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "values are stored as raw bytes");
+        check_value_type(sizeof(T));
+        check(ordinal);
+        return detail::load_as<T>(m_values + ordinal * m_value_size);
+    }
+
+    // Copies the value of key to out. Returns false if key is not present.
+    template<typename T>
+    bool get(string_view key, T &out) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "values are stored as raw bytes");
+        check_value_type(sizeof(T));
+        const size_type ordinal = find(key);
+        if(ordinal == npos) {
+            return false;
+        }
+        out = detail::load_as<T>(m_values + ordinal * m_value_size);
+        return true;
+    }
+
+    // Helper
+private:
+    void attach(span<const unsigned char> bytes)
+    {
+        using layout = detail::string_dictionary_layout;
+        const unsigned char *p = bytes.data();
+        const size_type size = bytes.size();
+        if(size < layout::header_size || std::memcmp(p + layout::magic_at, layout::magic(), 4) != 0) {
+            throw std::invalid_argument("string_dictionary: not a string dictionary");
+        }
+        if(detail::load_as<std::uint32_t>(p + layout::endian_at) != layout::endian_marker
+           || detail::load_as<std::uint32_t>(p + layout::version_at) != layout::version) {
+            throw std::invalid_argument("string_dictionary: unsupported version or byte order");
+        }
+
+        const std::uint64_t count = detail::load_as<std::uint64_t>(p + layout::count_at);
+        const std::uint64_t value_size = detail::load_as<std::uint32_t>(p + layout::value_size_at);
+        const std::uint64_t offsets_at = detail::load_as<std::uint64_t>(p + layout::offsets_at);
+        const std::uint64_t values_at = detail::load_as<std::uint64_t>(p + layout::values_at);
+        const std::uint64_t blob_at = detail::load_as<std::uint64_t>(p + layout::blob_at);
+        const std::uint64_t blob_size = detail::load_as<std::uint64_t>(p + layout::blob_size_at);
+        const std::uint64_t index_at = detail::load_as<std::uint64_t>(p + layout::index_at);
+        const std::uint64_t slots = detail::load_as<std::uint64_t>(p + layout::slots_at);
+
+        const auto fits = [size](std::uint64_t at, std::uint64_t length) {
+            return at <= size && length <= size - at;
+        };
+        if(count >= 0xffffffffu || slots == 0 || (slots & (slots - 1)) != 0 || slots <= count
+           || !fits(offsets_at, (count + 1) * 8) || !fits(values_at, count * value_size)
+           || !fits(blob_at, blob_size) || index_at > size || slots > (size - index_at) / 8) {
+            throw std::invalid_argument("string_dictionary: corrupt or truncated buffer");
+        }
+
+        m_count = static_cast<size_type>(count);
+        m_value_size = static_cast<size_type>(value_size);
+        m_seed = detail::load_as<std::uint64_t>(p + layout::seed_at);
+        m_offsets = p + offsets_at;
+        m_values = p + values_at;
+        m_blob = reinterpret_cast<const char*>(p + blob_at);
+        m_blob_size = static_cast<size_type>(blob_size);
+        m_index = p + index_at;
+        m_slots = static_cast<size_type>(slots);
+    }
+
+    void check(size_type ordinal) const
+    {
+        if(ordinal >= m_count) {
+            throw std::out_of_range("string_dictionary: ordinal out of range");
+        }
+    }
+
+    void check_value_type(size_type size) const
+    {
+        if(size != m_value_size) {
+            throw std::invalid_argument("string_dictionary: value size mismatch");
+        }
+    }
+
+    // Offsets are checked when they are used, so opening stays independent of the key count.
+    string_view key_at(size_type ordinal) const
+    {
+        const std::uint64_t begin = detail::load_as<std::uint64_t>(m_offsets + ordinal * 8);
+        const std::uint64_t end = detail::load_as<std::uint64_t>(m_offsets + ordinal * 8 + 8);
+        if(begin > end || end > m_blob_size) {
+            throw std::runtime_error("string_dictionary: corrupt key offsets");
+        }
+        return string_view{m_blob + begin, static_cast<size_type>(end - begin)};
+    }
+
+    // Private Member
+private:
+    size_type               m_count;
+    size_type               m_value_size;
+    std::uint64_t           m_seed;
+    const unsigned char    *m_offsets;
+    const unsigned char    *m_values;
+    const char             *m_blob;
+    size_type               m_blob_size;
+    const unsigned char    *m_index;
+    size_type               m_slots;
+    mapped_file             m_file;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_STRING_DICTIONARY_HPP
@@ -0,0 +1,355 @@
+#ifndef CPPBP_STRING_SEARCH_HPP
+#define CPPBP_STRING_SEARCH_HPP
+
+#include <cppbp/bit.hpp>            // cppbp::popcount, cppbp::countr_zero
+#include <cppbp/config.hpp>         // CPPBP_HAS_SSE2
+#include <cppbp/string_view.hpp>    // cppbp::basic_string_view
+
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <iterator>     // std::forward_iterator_tag
+#include <string>       // std::char_traits
+#include <type_traits>  // std::integral_constant, std::is_same
+
+#if defined(CPPBP_HAS_SSE2)
+#include <immintrin.h>  // _mm_cmpeq_epi8, _mm_movemask_epi8, _mm256_cmpeq_epi8, ...
+#endif
+
+namespace cppbp {
+
+enum class search_mode
+{
+    non_overlapping,
+    overlapping
+};
+
+namespace detail {
+
+// Character types that are bytes and compared by value can use memchr-like SIMD kernels.
+template<typename CharT, typename Traits>
+using is_byte_char = std::integral_constant<bool,
+    sizeof(CharT) == 1 && std::is_same<Traits, std::char_traits<CharT>>::value>;
+
+inline std::size_t count_byte(const unsigned char *p, std::size_t n, unsigned char ch) noexcept
+{
+    std::size_t result = 0;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i needle32 = _mm256_set1_epi8(static_cast<char>(ch));
+    for(; i + 32 <= n; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle32)));
+        result += static_cast<std::size_t>(popcount(mask));
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    const __m128i needle16 = _mm_set1_epi8(static_cast<char>(ch));
+    for(; i + 16 <= n; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle16)));
+        result += static_cast<std::size_t>(popcount(mask));
+    }
+#endif
+    for(; i < n; ++i) {
+        result += (p[i] == ch);
+    }
+    return result;
+}
+
+// Calls f(i) for every i with p[i] == ch, in increasing order.
+template<typename Function>
+void for_each_byte(const unsigned char *p, std::size_t n, unsigned char ch, Function f)
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i needle32 = _mm256_set1_epi8(static_cast<char>(ch));
+    for(; i + 32 <= n; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle32)));
+        for(; mask != 0; mask &= mask - 1) {
+            f(i + static_cast<std::size_t>(countr_zero(mask)));
+        }
+    }
+#endif
+#if defined(CPPBP_HAS_SSE2)
+    const __m128i needle16 = _mm_set1_epi8(static_cast<char>(ch));
+    for(; i + 16 <= n; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle16)));
+        for(; mask != 0; mask &= mask - 1) {
+            f(i + static_cast<std::size_t>(countr_zero(mask)));
+        }
+    }
+#endif
+    for(; i < n; ++i) {
+        if(p[i] == ch) {
+            f(i);
+        }
+    }
+}
+
+template<typename CharT, typename Traits>
+std::size_t count_char(const CharT *p, std::size_t n, CharT ch, std::true_type) noexcept
+{
+    return count_byte(reinterpret_cast<const unsigned char*>(p), n, static_cast<unsigned char>(ch));
+}
+
+template<typename CharT, typename Traits>
+std::size_t count_char(const CharT *p, std::size_t n, CharT ch, std::false_type) noexcept
+{
+    std::size_t result = 0;
+    for(std::size_t i = 0; i < n; ++i) {
+        result += Traits::eq(p[i], ch);
+    }
+    return result;
+}
+
+} // namespace detail
+
+// Searcher
+
+// Boyer-Moore-Horspool searcher. Building the shift table is the expensive part of a substring
+// search, so a searcher is meant to be constructed once and reused for every search of the same
+// needle. The needle is not copied and must outlive the searcher.
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_searcher final
+{
+    // Types
+public:
+    using view_type     = basic_string_view<CharT, Traits>;
+    using size_type     = typename view_type::size_type;
+
+    static constexpr size_type npos = view_type::npos;
+
+    // Construction
+public:
+    explicit basic_searcher(view_type needle) noexcept
+        : m_needle{needle}
+    {
+        for(auto &shift : m_shift) {
+            shift = m_needle.size();
+        }
+        // Table is keyed by the low byte of the character; collisions keep the smallest shift,
+        // which is always safe.
+        for(size_type i = 0; i + 1 < m_needle.size(); ++i) {
+            m_shift[key(m_needle[i])] = m_needle.size() - 1 - i;
+        }
+    }
+
+    // Observers
+public:
+    view_type needle() const noexcept
+    {
+        return m_needle;
+    }
+
+    // Searching
+public:
+    size_type search(view_type haystack, size_type pos = 0) const noexcept
+    {
+        const size_type m = m_needle.size();
+        const size_type n = haystack.size();
+        if(pos > n || m > n - pos) {
+            return npos;
+        }
+        if(m == 0) {
+            return pos;
+        }
+
+        const CharT *h = haystack.data();
+        const CharT *p = m_needle.data();
+        const CharT last = p[m - 1];
+
+        if(m == 1) {
+            const CharT *hit = Traits::find(h + pos, n - pos, last);
+            return hit ? static_cast<size_type>(hit - h) : npos;
+        }
+
+        while(pos <= n - m) {
+            const CharT c = h[pos + m - 1];
+            if(Traits::eq(c, last) && Traits::compare(h + pos, p, m - 1) == 0) {
+                return pos;
+            }
+            pos += m_shift[key(c)];
+        }
+        return npos;
+    }
+
+    // Helper
+private:
+    static unsigned char key(CharT c) noexcept
+    {
+        return static_cast<unsigned char>(Traits::to_int_type(c));
+    }
+
+    // Private Member
+private:
+    view_type   m_needle;
+    size_type   m_shift[256];
+};
+
+template<typename CharT, typename Traits>
+constexpr typename basic_searcher<CharT, Traits>::size_type basic_searcher<CharT, Traits>::npos;
+
+// Lazy range of match positions
+
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_match_range final
+{
+    // Types
+public:
+    using searcher_type = basic_searcher<CharT, Traits>;
+    using view_type     = typename searcher_type::view_type;
+    using size_type     = typename searcher_type::size_type;
+
+    class iterator final
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = size_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const size_type*;
+        using reference         = const size_type&;
+
+        iterator() noexcept
+            : m_range{nullptr}
+            , m_pos{searcher_type::npos}
+        { }
+
+        reference operator*() const noexcept
+        {
+            return m_pos;
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &m_pos;
+        }
+
+        iterator& operator++() noexcept
+        {
+            m_pos = m_range->next(m_pos);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator tmp{*this};
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const iterator &lhs, const iterator &rhs) noexcept
+        {
+            return lhs.m_pos == rhs.m_pos;
+        }
+
+        friend bool operator!=(const iterator &lhs, const iterator &rhs) noexcept
+        {
+            return lhs.m_pos != rhs.m_pos;
+        }
+
+    private:
+        friend class basic_match_range;
+
+        iterator(const basic_match_range *range, size_type pos) noexcept
+            : m_range{range}
+            , m_pos{pos}
+        { }
+
+        const basic_match_range *m_range;
+        size_type                m_pos;
+    };
+
+    using const_iterator = iterator;
+
+    // Construction
+public:
+    basic_match_range(view_type haystack, view_type needle,
+                      search_mode mode = search_mode::non_overlapping) noexcept
+        : m_haystack{haystack}
+        , m_searcher{needle}
+        , m_mode{mode}
+    { }
+
+    // Iterators
+public:
+    iterator begin() const noexcept
+    {
+        return iterator{this, m_searcher.search(m_haystack, 0)};
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator{this, searcher_type::npos};
+    }
+
+    // Helper
+private:
+    size_type next(size_type pos) const noexcept
+    {
+        const size_type needle_size = m_searcher.needle().size();
+        // An empty needle matches at every position; always advance to guarantee progress.
+        const size_type step = (m_mode == search_mode::overlapping || needle_size == 0) ? 1 : needle_size;
+        return m_searcher.search(m_haystack, pos + step);
+    }
+
+    // Private Member
+private:
+    view_type       m_haystack;
+    searcher_type   m_searcher;
+    search_mode     m_mode;
+};
+
+// Type aliases
+
+using searcher      = basic_searcher<char>;
+using match_range   = basic_match_range<char>;
+
+// Counting and enumerating occurrences
+
+template<typename CharT, typename Traits>
+std::size_t count(basic_string_view<CharT, Traits> str, cppbp::type_identity_t<CharT> ch) noexcept
+{
+    return detail::count_char<CharT, Traits>(str.data(), str.size(), ch,
+                                             detail::is_byte_char<CharT, Traits>{});
+}
+
+template<typename CharT, typename Traits>
+std::size_t count(basic_string_view<CharT, Traits> str,
+                  const basic_searcher<CharT, Traits> &searcher,
+                  search_mode mode = search_mode::non_overlapping) noexcept
+{
+    const std::size_t needle_size = searcher.needle().size();
+    const std::size_t step = (mode == search_mode::overlapping || needle_size == 0) ? 1 : needle_size;
+
+    std::size_t result = 0;
+    std::size_t pos = searcher.search(str, 0);
+    while(pos != basic_searcher<CharT, Traits>::npos) {
+        ++result;
+        pos = searcher.search(str, pos + step);
+    }
+    return result;
+}
+
+template<typename CharT, typename Traits>
+std::size_t count(basic_string_view<CharT, Traits> str,
+                  cppbp::type_identity_t<basic_string_view<CharT, Traits>> needle,
+                  search_mode mode = search_mode::non_overlapping) noexcept
+{
+    if(needle.size() == 1) {
+        return count(str, needle[0]);
+    }
+    return count(str, basic_searcher<CharT, Traits>{needle}, mode);
+}
+
+template<typename CharT, typename Traits>
+basic_match_range<CharT, Traits> find_all(basic_string_view<CharT, Traits> str,
+                                          cppbp::type_identity_t<basic_string_view<CharT, Traits>> needle,
+                                          search_mode mode = search_mode::non_overlapping) noexcept
+{
+    return basic_match_range<CharT, Traits>{str, needle, mode};
+}
+
+} // namespace cppbp
+
+#endif // CPPBP_STRING_SEARCH_HPP
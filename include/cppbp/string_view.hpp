@@ -1,8 +1,11 @@
 #ifndef CPPBP_STRING_VIEW_HPP
 #define CPPBP_STRING_VIEW_HPP
 
+#include <cppbp/config.hpp>         // CPPBP_CONSTEXPR14
+#include <cppbp/hash.hpp>           // cppbp::hash_bytes
 #include <cppbp/type_traits.hpp>    // cppbp::type_identity_t
 
+#include <algorithm>    // std::min
 #include <memory>       // std::addressof
 #include <cassert>      // assert
 #include <cstddef>      // std::size_t, std::ptrdiff_t
@@ -45,7 +48,7 @@ public:
     { }
 
     constexpr basic_string_view(const basic_string_view &other) noexcept = default;
-    constexpr basic_string_view& operator=(const basic_string_view &view) noexcept = default;
+    CPPBP_CONSTEXPR14 basic_string_view& operator=(const basic_string_view &view) noexcept = default;
 
     constexpr basic_string_view(const_pointer str)
         : m_str{str}
@@ -126,13 +129,13 @@ public:
 
     // Element Access                                                           [string.view.access]
 public:
-    constexpr const_reference operator[](size_type pos) const noexcept
+    CPPBP_CONSTEXPR14 const_reference operator[](size_type pos) const noexcept
     {
         assert(pos < m_size);
         return m_str[pos];
     }
 
-    constexpr const_reference at(size_type pos) const
+    CPPBP_CONSTEXPR14 const_reference at(size_type pos) const
     {
         if(pos >= m_size) {
             throw std::out_of_range("basic_string_view::at: position out of range");
@@ -140,18 +143,20 @@ public:
         return m_str[pos];
     }
 
-    constexpr const_reference front() const noexcept
+    CPPBP_CONSTEXPR14 const_reference front() const noexcept
     {
         assert(m_size > 0);
         return *m_str;
     }
 
-    constexpr const_reference back() const noexcept
+    CPPBP_CONSTEXPR14 const_reference back() const noexcept
     {
         assert(m_size > 0);
-        return *m_str[m_size - 1];
+        return m_str[m_size - 1];
     }
 
+    // Same as data(): a view is not null terminated in general. Use basic_cstring_view or
+    // with_cstr() to pass it to a C API.
     constexpr const_pointer c_str() const noexcept
     {
         return m_str;
@@ -164,20 +169,20 @@ public:
 
     // Modifiers                                                             [string.view.modifiers]
 public:
-    constexpr void remove_prefix(size_type n)
+    CPPBP_CONSTEXPR14 void remove_prefix(size_type n)
     {
         assert(n <= m_size);
         m_str += n;
         m_size -= n;
     }
 
-    constexpr void remove_suffix(size_type n)
+    CPPBP_CONSTEXPR14 void remove_suffix(size_type n)
     {
         assert(n <= m_size);
         m_size -= n;
     }
 
-    constexpr void swap(basic_string_view& v) noexcept
+    CPPBP_CONSTEXPR14 void swap(basic_string_view& v) noexcept
     {
         // std::swap is not constexpr before C++20
         const basic_string_view tmp{*this};
@@ -187,7 +192,7 @@ public:
 
     // String operations                                                           [string.view.ops]
 public:
-    constexpr size_type copy(pointer dst, size_type n, size_type pos = 0) const
+    CPPBP_CONSTEXPR14 size_type copy(pointer dst, size_type n, size_type pos = 0) const
     {
         if(pos > m_size) {
             throw std::out_of_range("basic_string_view::copy: position out of range");
@@ -200,16 +205,16 @@ public:
         return rlen;
     }
 
-    constexpr basic_string_view substr(size_type pos = 0, size_type n = npos) const
+    CPPBP_CONSTEXPR14 basic_string_view substr(size_type pos = 0, size_type n = npos) const
     {
         if(pos > m_size) {
-            throw std::out_of_range("basic_string_view::copy: position out of range");
+            throw std::out_of_range("basic_string_view::substr: position out of range");
         }
         const size_type rlen = std::min(m_size - pos, n);
         return basic_string_view{m_str + pos, rlen};
     }
 
-    constexpr int compare(basic_string_view str) const noexcept
+    CPPBP_CONSTEXPR14 int compare(basic_string_view str) const noexcept
     {
         const size_type rlen = std::min(m_size, str.m_size);
         // Check: compare is not constexpr in C++11 !!!
@@ -299,7 +304,7 @@ public:
 
     // Searching                                                                  [string.view.find]
 public:
-    constexpr size_type find(basic_string_view str, size_type pos = 0) const noexcept
+    CPPBP_CONSTEXPR14 size_type find(basic_string_view str, size_type pos = 0) const noexcept
     {
         if(pos > m_size) {
             return npos;
@@ -313,7 +318,7 @@ public:
 
         for(auto i = 0u; i <= increments; ++i) {
             const auto j = i + offset;
-            if(substr(j, str.m_size) == v) {
+            if(substr(j, str.m_size) == str) {
                 return j;
             }
         }
@@ -336,7 +341,7 @@ public:
         return find(basic_string_view(s), pos);
     }
 
-    constexpr size_type rfind(basic_string_view str, size_type pos = npos) const noexcept
+    CPPBP_CONSTEXPR14 size_type rfind(basic_string_view str, size_type pos = npos) const noexcept
     {
         if(empty()) {
             return str.empty() ? 0u : npos;
@@ -344,13 +349,13 @@ public:
         if(str.empty()) {
             return std::min(m_size - 1, pos);
         }
-        if(str.m_size() > m_size) {
+        if(str.m_size > m_size) {
             return npos;
         }
 
         auto i = std::min(pos, (m_size - str.m_size));
         while(i != npos) {
-            if(substr(i, str.m_size) == v) {
+            if(substr(i, str.m_size) == str) {
                 return i;
             }
             --i;
@@ -374,7 +379,7 @@ public:
         return rfind(basic_string_view(s), pos);
     }
 
-    constexpr size_type find_first_of(basic_string_view str, size_type pos = 0) const noexcept
+    CPPBP_CONSTEXPR14 size_type find_first_of(basic_string_view str, size_type pos = 0) const noexcept
     {
         for(auto i = pos; i < m_size; ++i) {
             if(is_one_of(m_str[i], str)) {
@@ -399,7 +404,7 @@ public:
         return find_first_of(basic_string_view(s), pos);
     }
 
-    constexpr size_type find_last_of(basic_string_view str, size_type pos = npos) const noexcept
+    CPPBP_CONSTEXPR14 size_type find_last_of(basic_string_view str, size_type pos = npos) const noexcept
     {
         if(empty()) {
             return npos;
@@ -407,7 +412,7 @@ public:
 
         const auto last_index = std::min(m_size - 1, pos);
         for(auto i = 0u; i <= last_index; ++i) {
-            const auto j = last_index - 1;
+            const auto j = last_index - i;
             if(is_one_of(m_str[j], str)) {
                 return j;
             }
@@ -430,7 +435,7 @@ public:
         return find_last_of(basic_string_view(s), pos);
     }
 
-    constexpr size_type find_first_not_of(basic_string_view str, size_type pos = 0) const noexcept
+    CPPBP_CONSTEXPR14 size_type find_first_not_of(basic_string_view str, size_type pos = 0) const noexcept
     {
         for(auto i = pos; i < m_size; ++i) {
             if(!is_one_of(m_str[i], str)) {
@@ -455,7 +460,7 @@ public:
         return find_first_not_of(basic_string_view(s), pos);
     }
 
-    constexpr size_type find_last_not_of(basic_string_view str, size_type pos = npos) const noexcept
+    CPPBP_CONSTEXPR14 size_type find_last_not_of(basic_string_view str, size_type pos = npos) const noexcept
     {
         if(empty()) {
             return npos;
@@ -463,7 +468,7 @@ public:
 
         const auto last_index = std::min(m_size - 1, pos);
         for(auto i = 0u; i <= last_index; ++i) {
-            const auto j = last_index - 1;
+            const auto j = last_index - i;
             if(!is_one_of(m_str[j], str)) {
                 return j;
             }
@@ -563,21 +568,21 @@ template<typename CharT, typename Traits>
 constexpr bool operator<(basic_string_view<CharT, Traits> lhs,
                           basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) < 0;
+    return lhs.compare(rhs) < 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator<(cppbp::type_identity_t<basic_string_view<CharT, Traits>> lhs,
                           basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) < 0;
+    return lhs.compare(rhs) < 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator<(basic_string_view<CharT, Traits> lhs,
                           cppbp::type_identity_t<basic_string_view<CharT, Traits>> rhs) noexcept
 {
-    return x.compare(y) < 0;
+    return lhs.compare(rhs) < 0;
 }
 
 // operator>
@@ -586,21 +591,21 @@ template<typename CharT, typename Traits>
 constexpr bool operator>(basic_string_view<CharT, Traits> lhs,
                           basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) > 0;
+    return lhs.compare(rhs) > 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator>(cppbp::type_identity_t<basic_string_view<CharT, Traits>> lhs,
                           basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) > 0;
+    return lhs.compare(rhs) > 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator>(basic_string_view<CharT, Traits> lhs,
                           cppbp::type_identity_t<basic_string_view<CharT, Traits>> rhs) noexcept
 {
-    return x.compare(y) > 0;
+    return lhs.compare(rhs) > 0;
 }
 
 // operator<=
@@ -609,21 +614,21 @@ template<typename CharT, typename Traits>
 constexpr bool operator<=(basic_string_view<CharT, Traits> lhs,
     basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) <= 0;
+    return lhs.compare(rhs) <= 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator<=(cppbp::type_identity_t<basic_string_view<CharT, Traits>> lhs,
     basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) <= 0;
+    return lhs.compare(rhs) <= 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator<=(basic_string_view<CharT, Traits> lhs,
     cppbp::type_identity_t<basic_string_view<CharT, Traits>> rhs) noexcept
 {
-    return x.compare(y) <= 0;
+    return lhs.compare(rhs) <= 0;
 }
 
 // operator>=
@@ -632,21 +637,21 @@ template<typename CharT, typename Traits>
 constexpr bool operator>=(basic_string_view<CharT, Traits> lhs,
                           basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) >= 0;
+    return lhs.compare(rhs) >= 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator>=(cppbp::type_identity_t<basic_string_view<CharT, Traits>> lhs,
                           basic_string_view<CharT, Traits> rhs) noexcept
 {
-    return x.compare(y) >= 0;
+    return lhs.compare(rhs) >= 0;
 }
 
 template<typename CharT, typename Traits>
 constexpr bool operator>=(basic_string_view<CharT, Traits> lhs,
                           cppbp::type_identity_t<basic_string_view<CharT, Traits>> rhs) noexcept
 {
-    return x.compare(y) >= 0;
+    return lhs.compare(rhs) >= 0;
 }
 
 // Inserters and extractors                                                         [string.view.io]
@@ -667,6 +672,9 @@ using wstring_view      = basic_string_view<wchar_t>;
 
 // Hash support                                                                   [string.view.hash]
 
+// Hashes the characters in place (no temporary std::basic_string); the values differ from
+// std::hash of the corresponding std::basic_string.
+
 template<typename T>
 struct hash;
 
@@ -676,7 +684,7 @@ struct hash<string_view>
 public:
     std::size_t operator()(string_view str) const noexcept
     {
-        return std::hash<std::string>()(std::string(str.data(), str.size()));
+        return static_cast<std::size_t>(hash_bytes(str.data(), str.size() * sizeof(char)));
     }
 };
 
@@ -686,7 +694,7 @@ struct hash<wstring_view>
 public:
     std::size_t operator()(wstring_view str) const noexcept
     {
-        return std::hash<std::wstring>()(std::wstring(str.data(), str.size()));
+        return static_cast<std::size_t>(hash_bytes(str.data(), str.size() * sizeof(wchar_t)));
     }
 };
 
@@ -696,7 +704,7 @@ struct hash<u16string_view>
 public:
     std::size_t operator()(u16string_view str) const noexcept
     {
-        return std::hash<std::u16string>()(std::u16string(str.data(), str.size()));
+        return static_cast<std::size_t>(hash_bytes(str.data(), str.size() * sizeof(char16_t)));
     }
 };
 
@@ -706,10 +714,21 @@ struct hash<u32string_view>
 public:
     std::size_t operator()(u32string_view str) const noexcept
     {
-        return std::hash<std::u32string>()(std::u32string(str.data(), str.size()));
+        return static_cast<std::size_t>(hash_bytes(str.data(), str.size() * sizeof(char32_t)));
     }
 };
 
+namespace detail {
+
+// Full 64 bit hash of the characters, for data structures that derive several indices from it.
+template<typename CharT, typename Traits>
+std::uint64_t hash_key(basic_string_view<CharT, Traits> key, std::uint64_t seed = default_hash_seed) noexcept
+{
+    return hash_bytes(key.data(), key.size() * sizeof(CharT), seed);
+}
+
+} // namespace detail
+
 // Suffix for basic_string_view literals                                      [string.view.literals]
 
 inline namespace literals {
@@ -0,0 +1,436 @@
+#ifndef CPPBP_SUCCINCT_TRIE_HPP
+#define CPPBP_SUCCINCT_TRIE_HPP
+
+#include <cppbp/bit_vector.hpp>     // cppbp::bit_vector
+#include <cppbp/span.hpp>           // cppbp::span
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <stdexcept>    // std::invalid_argument, std::length_error
+#include <string>       // std::string
+#include <type_traits>  // std::is_same, std::true_type, std::false_type
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+// Immutable set of strings stored as a LOUDS encoded trie (the sparse layout of FST/SuRF).
+//
+// Edges are listed in breadth first order, each node's edges sorted by label. Per edge the trie
+// keeps its label byte and three bits: whether the edge starts a node (louds), leads to a child
+// node (has_child) and ends a key (terminal). The child of edge p is node rank1(has_child, p + 1)
+// whose edges start at select1(louds, node). That is 11 bits per edge plus the rank and select
+// samples, independent of pointer size.
+class succinct_trie final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Construction and Assignment
+public:
+    succinct_trie()
+        : m_key_count{0}
+        , m_has_empty{false}
+        , m_labels{nullptr}
+        , m_edge_count{0}
+    {
+        finish();
+    }
+
+    // Builds the trie from keys in strictly increasing (byte wise) order.
+    explicit succinct_trie(span<const string_view> keys)
+        : succinct_trie{}
+    {
+        build(keys);
+    }
+
+    succinct_trie(const succinct_trie &other)
+        : m_key_count{other.m_key_count}
+        , m_has_empty{other.m_has_empty}
+        , m_label_storage(other.m_labels, other.m_labels + other.m_edge_count)
+        , m_labels{m_label_storage.data()}
+        , m_edge_count{other.m_edge_count}
+        , m_louds{other.m_louds}
+        , m_has_child{other.m_has_child}
+        , m_terminal{other.m_terminal}
+    { }
+
+    succinct_trie(succinct_trie &&other) noexcept
+        : m_key_count{other.m_key_count}
+        , m_has_empty{other.m_has_empty}
+        , m_label_storage(std::move(other.m_label_storage))
+        , m_labels{other.m_labels}
+        , m_edge_count{other.m_edge_count}
+        , m_louds(std::move(other.m_louds))
+        , m_has_child(std::move(other.m_has_child))
+        , m_terminal(std::move(other.m_terminal))
+    { }
+
+    succinct_trie& operator=(succinct_trie other) noexcept
+    {
+        m_key_count = other.m_key_count;
+        m_has_empty = other.m_has_empty;
+        m_label_storage.swap(other.m_label_storage);
+        m_labels = other.m_labels;
+        m_edge_count = other.m_edge_count;
+        m_louds.swap(other.m_louds);
+        m_has_child.swap(other.m_has_child);
+        m_terminal.swap(other.m_terminal);
+        return *this;
+    }
+
+    // Walks the labels and bit vectors inside a serialize() buffer without copying them, e.g. from
+    // a memory mapped file kept open for as long as the trie; the buffer must be 8 byte aligned.
+    static succinct_trie borrow(span<const unsigned char> bytes)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % 8 != 0) {
+            throw std::invalid_argument("succinct_trie::borrow: buffer is not 8 byte aligned");
+        }
+        if(bytes.size() < header_size || std::memcmp(bytes.data(), magic(), 4) != 0) {
+            throw std::invalid_argument("succinct_trie: not a serialized trie");
+        }
+        std::uint64_t header[header_size / 8];
+        std::memcpy(header, bytes.data(), header_size);
+        const std::uint64_t edges = header[1];
+        const std::uint64_t sizes[3] = {header[3], header[4], header[5]};
+        const std::uint64_t labels_size = (edges + 7) & ~std::uint64_t{7};
+        std::uint64_t total = header_size + labels_size;
+        for(const std::uint64_t size : sizes) {
+            if(size % 8 != 0 || size > bytes.size()) {
+                throw std::invalid_argument("succinct_trie: corrupt buffer");
+            }
+            total += size;
+        }
+        if(edges > bytes.size() || total > bytes.size()) {
+            throw std::invalid_argument("succinct_trie: truncated buffer");
+        }
+
+        succinct_trie result;
+        result.m_key_count = static_cast<size_type>(header[2] >> 1);
+        result.m_has_empty = (header[2] & 1u) != 0;
+        result.m_label_storage.clear();
+        result.m_labels = bytes.data() + header_size;
+        result.m_edge_count = static_cast<size_type>(edges);
+        const unsigned char *p = bytes.data() + header_size + labels_size;
+        result.m_louds = bit_vector::borrow(span<const unsigned char>{p, static_cast<size_type>(sizes[0])});
+        p += sizes[0];
+        result.m_has_child = bit_vector::borrow(span<const unsigned char>{p, static_cast<size_type>(sizes[1])});
+        p += sizes[1];
+        result.m_terminal = bit_vector::borrow(span<const unsigned char>{p, static_cast<size_type>(sizes[2])});
+        if(result.m_louds.size() != edges || result.m_has_child.size() != edges || result.m_terminal.size() != edges) {
+            throw std::invalid_argument("succinct_trie: corrupt buffer");
+        }
+        return result;
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_key_count;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_key_count == 0;
+    }
+
+    size_type edge_count() const noexcept
+    {
+        return m_edge_count;
+    }
+
+    // Lookup
+public:
+    bool contains(string_view key) const noexcept
+    {
+        if(key.empty()) {
+            return m_has_empty;
+        }
+        size_type edge = npos;
+        return walk(key, edge) == key.size() && m_terminal[edge];
+    }
+
+    // Length of the longest key that is a prefix of text, or npos if there is none.
+    size_type longest_prefix(string_view text) const noexcept
+    {
+        size_type result = npos;
+        if(m_has_empty) {
+            result = 0;
+        }
+        if(m_edge_count == 0) {
+            return result;
+        }
+        size_type begin = 0;
+        for(size_type depth = 0; depth < text.size(); ++depth) {
+            const size_type edge = find_label(begin, static_cast<unsigned char>(text[depth]));
+            if(edge == npos) {
+                break;
+            }
+            if(m_terminal[edge]) {
+                result = depth + 1;
+            }
+            if(!m_has_child[edge]) {
+                break;
+            }
+            begin = child_begin(edge);
+        }
+        return result;
+    }
+
+    // Calls f(string_view key) for every key starting with prefix, in increasing order. The view
+    // is only valid during the call. If f returns bool, the walk stops as soon as it returns false.
+    template<typename Function>
+    void for_each_with_prefix(string_view prefix, Function f) const
+    {
+        std::string buffer(prefix.data(), prefix.size());
+        if(prefix.empty()) {
+            if(m_has_empty && !visit(f, string_view{})) {
+                return;
+            }
+            if(m_edge_count != 0) {
+                enumerate(0, buffer, f);
+            }
+            return;
+        }
+        size_type edge = npos;
+        if(walk(prefix, edge) != prefix.size()) {
+            return;
+        }
+        if(m_terminal[edge] && !visit(f, string_view{buffer.data(), buffer.size()})) {
+            return;
+        }
+        if(m_has_child[edge]) {
+            enumerate(child_begin(edge), buffer, f);
+        }
+    }
+
+    // Up to limit keys starting with prefix; the walk ends at the limit.
+    std::vector<std::string> keys_with_prefix(string_view prefix, size_type limit = npos) const
+    {
+        std::vector<std::string> result;
+        if(limit == 0) {
+            return result;
+        }
+        for_each_with_prefix(prefix, [&](string_view key) {
+            result.emplace_back(key.data(), key.size());
+            return result.size() < limit;
+        });
+        return result;
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const
+    {
+        return header_size + ((m_edge_count + 7) & ~size_type{7})
+            + m_louds.serialized_size() + m_has_child.serialized_size() + m_terminal.serialized_size();
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> out(serialized_size(), 0);
+        const std::uint64_t header[header_size / 8] = {
+            0, m_edge_count, (static_cast<std::uint64_t>(m_key_count) << 1) | (m_has_empty ? 1u : 0u),
+            m_louds.serialized_size(), m_has_child.serialized_size(), m_terminal.serialized_size()
+        };
+        unsigned char *p = out.data();
+        std::memcpy(p, header, header_size);
+        std::memcpy(p, magic(), 4);
+        p += header_size;
+        if(m_edge_count != 0) {
+            std::memcpy(p, m_labels, m_edge_count);
+        }
+        p += (m_edge_count + 7) & ~size_type{7};
+        m_louds.serialize(span<unsigned char>{p, m_louds.serialized_size()});
+        p += m_louds.serialized_size();
+        m_has_child.serialize(span<unsigned char>{p, m_has_child.serialized_size()});
+        p += m_has_child.serialized_size();
+        m_terminal.serialize(span<unsigned char>{p, m_terminal.serialized_size()});
+        return out;
+    }
+
+    // Helper
+private:
+    static constexpr size_type header_size = 48;
+
+    static const char* magic() noexcept
+    {
+        return "CST1";
+    }
+
+    void build(span<const string_view> keys)
+    {
+        for(size_type i = 1; i < keys.size(); ++i) {
+            if(!(keys[i - 1] < keys[i])) {
+                throw std::invalid_argument("succinct_trie: keys must be sorted and unique");
+            }
+        }
+
+        // Keys still longer than the current depth, with the length of their common prefix with
+        // the previous such key.
+        struct active_key
+        {
+            size_type index;
+            size_type lcp;
+        };
+        std::vector<active_key> active;
+        active.reserve(keys.size());
+        for(size_type i = 0; i < keys.size(); ++i) {
+            if(keys[i].empty()) {
+                m_has_empty = true;
+                continue;
+            }
+            size_type lcp = 0;
+            if(!active.empty()) {
+                const string_view prev = keys[active.back().index];
+                while(lcp < prev.size() && lcp < keys[i].size() && prev[lcp] == keys[i][lcp]) {
+                    ++lcp;
+                }
+            }
+            active.push_back(active_key{i, lcp});
+        }
+        m_key_count = keys.size();
+
+        for(size_type depth = 0; !active.empty(); ++depth) {
+            std::vector<active_key> next;
+            size_type carried = npos;
+            for(size_type i = 0; i < active.size(); ++i) {
+                const string_view key = keys[active[i].index];
+                const bool first = i == 0;
+                if(first || active[i].lcp < depth + 1) {
+                    m_label_storage.push_back(static_cast<unsigned char>(key[depth]));
+                    m_louds.push_back(first || active[i].lcp < depth);
+                    m_has_child.push_back(false);
+                    m_terminal.push_back(false);
+                }
+                const size_type edge = m_label_storage.size() - 1;
+                if(key.size() == depth + 1) {
+                    m_terminal.set(edge);
+                    // Keys that end here leave; their successor inherits the smaller lcp.
+                    carried = carried < active[i].lcp ? carried : active[i].lcp;
+                } else {
+                    m_has_child.set(edge);
+                    const size_type lcp = carried < active[i].lcp ? carried : active[i].lcp;
+                    next.push_back(active_key{active[i].index, next.empty() ? 0 : lcp});
+                    carried = npos;
+                }
+            }
+            active.swap(next);
+        }
+        finish();
+    }
+
+    void finish()
+    {
+        m_labels = m_label_storage.data();
+        m_edge_count = m_label_storage.size();
+        m_louds.build_index();
+        m_has_child.build_index();
+        m_terminal.build_index();
+    }
+
+    size_type node_end(size_type begin) const noexcept
+    {
+        const size_type next = m_louds.select1(m_louds.rank1(begin + 1));
+        return next == bit_vector::npos ? m_edge_count : next;
+    }
+
+    size_type child_begin(size_type edge) const noexcept
+    {
+        return m_louds.select1(m_has_child.rank1(edge + 1));
+    }
+
+    // Edge with label c in the node whose edges start at begin, or npos.
+    size_type find_label(size_type begin, unsigned char c) const noexcept
+    {
+        const size_type end = node_end(begin);
+        for(size_type edge = begin; edge < end; ++edge) {
+            if(m_labels[edge] >= c) {
+                return m_labels[edge] == c ? edge : npos;
+            }
+        }
+        return npos;
+    }
+
+    // Follows key from the root; returns the number of characters matched and the last edge.
+    size_type walk(string_view key, size_type &edge) const noexcept
+    {
+        if(m_edge_count == 0) {
+            return 0;
+        }
+        size_type begin = 0;
+        for(size_type depth = 0; depth < key.size(); ++depth) {
+            const size_type found = find_label(begin, static_cast<unsigned char>(key[depth]));
+            if(found == npos) {
+                return depth;
+            }
+            edge = found;
+            if(depth + 1 == key.size()) {
+                return key.size();
+            }
+            if(!m_has_child[found]) {
+                return depth + 1;
+            }
+            begin = child_begin(found);
+        }
+        return key.size();
+    }
+
+    // Calls f and tells whether to go on: its result if it returns bool, true otherwise.
+    template<typename Function>
+    static bool visit(Function &f, string_view key)
+    {
+        return visit(f, key, std::is_same<decltype(f(key)), bool>{});
+    }
+
+    template<typename Function>
+    static bool visit(Function &f, string_view key, std::true_type)
+    {
+        return f(key);
+    }
+
+    template<typename Function>
+    static bool visit(Function &f, string_view key, std::false_type)
+    {
+        f(key);
+        return true;
+    }
+
+    // Returns false once f asked to stop.
+    template<typename Function>
+    bool enumerate(size_type begin, std::string &buffer, Function &f) const
+    {
+        const size_type end = node_end(begin);
+        for(size_type edge = begin; edge < end; ++edge) {
+            buffer.push_back(static_cast<char>(m_labels[edge]));
+            if(m_terminal[edge] && !visit(f, string_view{buffer.data(), buffer.size()})) {
+                return false;
+            }
+            if(m_has_child[edge] && !enumerate(child_begin(edge), buffer, f)) {
+                return false;
+            }
+            buffer.pop_back();
+        }
+        return true;
+    }
+
+    // Private Member
+private:
+    size_type                   m_key_count;
+    bool                        m_has_empty;
+    std::vector<unsigned char>  m_label_storage;
+    const unsigned char        *m_labels;
+    size_type                   m_edge_count;
+    bit_vector                  m_louds;
+    bit_vector                  m_has_child;
+    bit_vector                  m_terminal;
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_SUCCINCT_TRIE_HPP
@@ -0,0 +1,611 @@
+#ifndef CPPBP_TEXT_INDEX_HPP
+#define CPPBP_TEXT_INDEX_HPP
+
+#include <cppbp/bit_vector.hpp>     // cppbp::bit_vector
+#include <cppbp/span.hpp>           // cppbp::span, cppbp::detail::read_aligned
+#include <cppbp/string_view.hpp>    // cppbp::string_view
+#include <cppbp/thread_pool.hpp>    // cppbp::thread_pool, cppbp::detail::for_range
+
+#include <algorithm>    // std::fill, std::copy, std::sort, std::lexicographical_compare
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::invalid_argument
+#include <utility>      // std::swap
+#include <vector>       // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Suffix array of s[0, n) by induced sorting (SA-IS), with an implicit sentinel after the last
+// symbol. Symbols are in [0, upper]; Index must hold n + 1.
+//
+// Besides sa this needs n bits for the suffix types and one bucket per symbol: the sorted LMS
+// substrings, their names and the reduced string all live in sa, and the recursion sorts the
+// reduced string in the front of sa while reading it from the back.
+template<typename Index, typename Symbol>
+void suffix_array(const Symbol *s, Index n, Index upper, Index *sa)
+{
+    const Index empty = std::numeric_limits<Index>::max();
+    if(n < 8) {
+        for(Index i = 0; i < n; ++i) {
+            sa[i] = i;
+        }
+        std::sort(sa, sa + n, [&](Index a, Index b) {
+            return std::lexicographical_compare(s + a, s + n, s + b, s + n);
+        });
+        return;
+    }
+
+    // ls[i]: suffix i is smaller than suffix i + 1 (S type).
+    std::vector<bool> ls(n, false);
+    for(Index i = n - 1; i-- > 0;) {
+        ls[i] = s[i] == s[i + 1] ? ls[i + 1] : s[i] < s[i + 1];
+    }
+    const auto is_lms = [&](Index i) {
+        return i > 0 && ls[i] && !ls[i - 1];
+    };
+
+    // Bucket heads or tails of every symbol, recounted from s each time instead of keeping both.
+    std::vector<Index> bucket(upper + 1);
+    const auto buckets = [&](bool tails) {
+        std::fill(bucket.begin(), bucket.end(), 0);
+        for(Index i = 0; i < n; ++i) {
+            ++bucket[s[i]];
+        }
+        Index sum = 0;
+        for(Index &b : bucket) {
+            sum += b;
+            b = tails ? sum : sum - b;
+        }
+    };
+    // Sorts all suffixes from the LMS suffixes at the tails of their buckets.
+    const auto induce = [&] {
+        buckets(false);
+        sa[bucket[s[n - 1]]++] = n - 1;
+        for(Index i = 0; i < n; ++i) {
+            const Index v = sa[i];
+            if(v != empty && v >= 1 && !ls[v - 1]) {
+                sa[bucket[s[v - 1]]++] = v - 1;
+            }
+        }
+        buckets(true);
+        for(Index i = n; i-- > 0;) {
+            const Index v = sa[i];
+            if(v != empty && v >= 1 && ls[v - 1]) {
+                sa[--bucket[s[v - 1]]] = v - 1;
+            }
+        }
+    };
+
+    // Sort the LMS substrings.
+    std::fill(sa, sa + n, empty);
+    buckets(true);
+    for(Index i = 1; i < n; ++i) {
+        if(is_lms(i)) {
+            sa[--bucket[s[i]]] = i;
+        }
+    }
+    induce();
+
+    // Move them to the front in sorted order. They are at least two apart, so there are at most
+    // n / 2 of them.
+    Index m = 0;
+    for(Index i = 0; i < n; ++i) {
+        if(is_lms(sa[i])) {
+            sa[m++] = sa[i];
+        }
+    }
+    if(m == 0) {
+        return;     // the induced pass from the last suffix alone sorted everything
+    }
+
+    // Name them, storing the name of the substring at p in sa[m + p / 2]. Equal substrings have
+    // equal symbols and types up to the next LMS position; the sentinel differs from everything.
+    std::fill(sa + m, sa + n, empty);
+    Index names = 0;
+    Index previous = empty;
+    for(Index i = 0; i < m; ++i) {
+        const Index p = sa[i];
+        bool differ = previous == empty;
+        for(Index d = 0; !differ; ++d) {
+            if(p + d == n || previous + d == n || s[p + d] != s[previous + d] || ls[p + d] != ls[previous + d]) {
+                differ = true;
+            } else if(d > 0 && is_lms(p + d)) {
+                break;
+            }
+        }
+        if(differ) {
+            ++names;
+            previous = p;
+        }
+        sa[m + p / 2] = names - 1;
+    }
+
+    // The reduced string, the names in text order, goes to the back of sa and is sorted into
+    // the front.
+    Index *const reduced = sa + n - m;
+    for(Index i = n, j = n; i-- > m;) {
+        if(sa[i] != empty) {
+            sa[--j] = sa[i];
+        }
+    }
+    if(names < m) {
+        suffix_array<Index, Index>(reduced, m, names - 1, sa);
+    } else {
+        for(Index i = 0; i < m; ++i) {
+            sa[reduced[i]] = i;
+        }
+    }
+
+    // Map back to text positions, then place the LMS suffixes at their bucket tails in the
+    // sorted order and induce the rest. Going from the back, no entry overwrites one still to go.
+    for(Index i = 1, j = 0; i < n; ++i) {
+        if(is_lms(i)) {
+            reduced[j++] = i;
+        }
+    }
+    for(Index i = 0; i < m; ++i) {
+        sa[i] = reduced[sa[i]];
+    }
+    std::fill(sa + m, sa + n, empty);
+    buckets(true);
+    for(Index i = m; i-- > 0;) {
+        const Index p = sa[i];
+        sa[i] = empty;
+        sa[--bucket[s[p]]] = p;
+    }
+    induce();
+}
+
+} // namespace detail
+
+// Full text index (FM-index) over a byte string.
+//
+// Built from the suffix array (SA-IS, linear time), the index keeps the Burrows-Wheeler transform
+// of the text in a wavelet matrix of eight rank/select bit vectors, plus the suffix array entries
+// of every sample_rate-th text position. count() and contains() take O(m) rank queries for a
+// pattern of length m, independent of the text size; locate() then needs at most sample_rate
+// steps per occurrence. The transform takes about 1.3 bytes per text byte and the samples
+// 8 / sample_rate more: a rate of 1 keeps the whole suffix array, larger rates trade locate
+// speed for space. The text itself is not needed after construction, which takes about 5 bytes
+// per text byte besides the text, 9 from 4 GiB on, mostly for the suffix array.
+class text_index final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Construction and Assignment
+public:
+    text_index()
+        : m_text_size{0}
+        , m_sample_rate{1}
+        , m_primary{0}
+        , m_samples{nullptr}
+        , m_sample_count{0}
+    {
+        build(string_view{}, nullptr);
+    }
+
+    explicit text_index(string_view text, size_type sample_rate = 32)
+        : text_index{}
+    {
+        set_sample_rate(sample_rate);
+        build(text, nullptr);
+    }
+
+    // Computes the transform, the samples and the wavelet levels on the threads of pool. The
+    // suffix array itself is built sequentially and takes about two thirds of the time.
+    text_index(string_view text, size_type sample_rate, thread_pool &pool)
+        : text_index{}
+    {
+        set_sample_rate(sample_rate);
+        build(text, &pool);
+    }
+
+    text_index(const text_index &other)
+        : m_text_size{other.m_text_size}
+        , m_sample_rate{other.m_sample_rate}
+        , m_primary{other.m_primary}
+        , m_sampled{other.m_sampled}
+        , m_sample_storage(other.m_samples, other.m_samples + other.m_sample_count)
+        , m_samples{m_sample_storage.data()}
+        , m_sample_count{other.m_sample_count}
+    {
+        for(size_type l = 0; l < levels; ++l) {
+            m_levels[l] = other.m_levels[l];
+        }
+        finish();
+    }
+
+    text_index(text_index &&other) noexcept
+        : text_index{}
+    {
+        swap(other);
+    }
+
+    text_index& operator=(text_index other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    // Queries the wavelet levels and samples where serialize() wrote them; only the per symbol
+    // tables are computed. bytes must be 8 byte aligned and outlive the index.
+    static text_index borrow(span<const unsigned char> bytes)
+    {
+        if(reinterpret_cast<std::uintptr_t>(bytes.data()) % 8 != 0) {
+            throw std::invalid_argument("text_index::borrow: buffer is not 8 byte aligned");
+        }
+        if(bytes.size() < header_size || std::memcmp(bytes.data(), magic(), 4) != 0) {
+            throw std::invalid_argument("text_index: not a serialized index");
+        }
+        std::uint64_t header[header_size / 8];
+        std::memcpy(header, bytes.data(), header_size);
+
+        text_index result;
+        result.m_text_size = static_cast<size_type>(header[1]);
+        result.m_sample_rate = static_cast<size_type>(header[2]);
+        result.m_primary = static_cast<size_type>(header[3]);
+        result.m_sample_count = static_cast<size_type>(header[4]);
+        const unsigned char *p = bytes.data() + header_size;
+        const unsigned char *end = bytes.data() + bytes.size();
+        for(size_type l = 0; l <= levels; ++l) {
+            const std::uint64_t size = header[5 + l];
+            if(size % 8 != 0 || size > static_cast<std::uint64_t>(end - p)) {
+                throw std::invalid_argument("text_index: truncated buffer");
+            }
+            bit_vector bits = bit_vector::borrow(span<const unsigned char>{p, static_cast<size_type>(size)});
+            if(bits.size() != result.m_text_size + 1) {
+                throw std::invalid_argument("text_index: corrupt buffer");
+            }
+            (l < levels ? result.m_levels[l] : result.m_sampled) = std::move(bits);
+            p += size;
+        }
+        if(result.m_sample_count != result.m_sampled.count_ones() || result.m_sample_rate == 0
+           || result.m_primary > result.m_text_size
+           || result.m_sample_count > static_cast<size_type>(end - p) / 8) {
+            throw std::invalid_argument("text_index: corrupt buffer");
+        }
+        result.m_sample_storage.clear();
+        result.m_samples = reinterpret_cast<const std::uint64_t*>(p);
+        result.finish();
+        return result;
+    }
+
+    // Copies an index out of a buffer written by serialize().
+    static text_index deserialize(span<const unsigned char> bytes)
+    {
+        return detail::read_aligned(bytes, [](span<const unsigned char> copy) {
+            const text_index borrowed = borrow(copy);
+            return text_index{borrowed};
+        });
+    }
+
+    // Capacity
+public:
+    // Length of the indexed text.
+    size_type size() const noexcept
+    {
+        return m_text_size;
+    }
+
+    size_type sample_rate() const noexcept
+    {
+        return m_sample_rate;
+    }
+
+    // Lookup
+public:
+    // Number of occurrences of pattern; an empty pattern occurs at all size() + 1 positions.
+    size_type count(string_view pattern) const noexcept
+    {
+        size_type first = 0;
+        size_type last = 0;
+        search(pattern, first, last);
+        return last - first;
+    }
+
+    bool contains(string_view pattern) const noexcept
+    {
+        return count(pattern) != 0;
+    }
+
+    // Start positions of the occurrences of pattern in increasing order.
+    std::vector<size_type> locate(string_view pattern) const
+    {
+        size_type first = 0;
+        size_type last = 0;
+        search(pattern, first, last);
+        std::vector<size_type> result;
+        result.reserve(last - first);
+        for(size_type row = first; row < last; ++row) {
+            result.push_back(position(row));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // First occurrence of pattern, or npos.
+    size_type find(string_view pattern) const noexcept
+    {
+        size_type first = 0;
+        size_type last = 0;
+        search(pattern, first, last);
+        size_type result = npos;
+        for(size_type row = first; row < last; ++row) {
+            const size_type p = position(row);
+            result = p < result ? p : result;
+        }
+        return result;
+    }
+
+    // Serialization
+public:
+    size_type serialized_size() const
+    {
+        size_type result = header_size + m_sampled.serialized_size() + m_sample_count * 8;
+        for(const auto &level : m_levels) {
+            result += level.serialized_size();
+        }
+        return result;
+    }
+
+    std::vector<unsigned char> serialize() const
+    {
+        std::vector<unsigned char> out(serialized_size(), 0);
+        std::uint64_t header[header_size / 8] = {0, m_text_size, m_sample_rate, m_primary, m_sample_count};
+        for(size_type l = 0; l < levels; ++l) {
+            header[5 + l] = m_levels[l].serialized_size();
+        }
+        header[5 + levels] = m_sampled.serialized_size();
+        unsigned char *p = out.data();
+        std::memcpy(p, header, header_size);
+        std::memcpy(p, magic(), 4);
+        p += header_size;
+        for(size_type l = 0; l <= levels; ++l) {
+            const bit_vector &bits = l < levels ? m_levels[l] : m_sampled;
+            bits.serialize(span<unsigned char>{p, bits.serialized_size()});
+            p += bits.serialized_size();
+        }
+        if(m_sample_count != 0) {
+            std::memcpy(p, m_samples, m_sample_count * 8);
+        }
+        return out;
+    }
+
+    void swap(text_index &other) noexcept
+    {
+        std::swap(m_text_size, other.m_text_size);
+        std::swap(m_sample_rate, other.m_sample_rate);
+        std::swap(m_primary, other.m_primary);
+        for(size_type l = 0; l < levels; ++l) {
+            m_levels[l].swap(other.m_levels[l]);
+            std::swap(m_zeros[l], other.m_zeros[l]);
+        }
+        m_sampled.swap(other.m_sampled);
+        m_sample_storage.swap(other.m_sample_storage);
+        std::swap(m_samples, other.m_samples);
+        std::swap(m_sample_count, other.m_sample_count);
+        for(size_type c = 0; c < alphabet; ++c) {
+            std::swap(m_first_row[c], other.m_first_row[c]);
+            std::swap(m_level_start[c], other.m_level_start[c]);
+        }
+    }
+
+    // Helper
+private:
+    static constexpr size_type levels = 8;
+    static constexpr size_type alphabet = 256;
+    static constexpr size_type header_size = 8 * (6 + levels);
+
+    static const char* magic() noexcept
+    {
+        return "CTI1";
+    }
+
+    void set_sample_rate(size_type sample_rate)
+    {
+        if(sample_rate == 0) {
+            throw std::invalid_argument("text_index: sample rate must not be zero");
+        }
+        m_sample_rate = sample_rate;
+    }
+
+    void build(string_view text, thread_pool *pool)
+    {
+        if(text.size() < 0xfffffffeu) {
+            build<std::uint32_t>(text, pool);
+        } else {
+            build<std::uint64_t>(text, pool);
+        }
+    }
+
+    template<typename Index>
+    void build(string_view text, thread_pool *pool)
+    {
+        const size_type n = text.size();
+        const unsigned char *s = reinterpret_cast<const unsigned char*>(text.data());
+        std::vector<Index> sa(n);
+        if(n != 0) {
+            detail::suffix_array<Index, unsigned char>(s, static_cast<Index>(n), 255, sa.data());
+        }
+
+        // Row 0 is the empty suffix; row r + 1 is suffix sa[r]. The sentinel is stored as 0 and
+        // corrected for by the row it sits in. Tasks take whole words of m_sampled so that no two
+        // of them set bits in the same word.
+        const size_type rows = n + 1;
+        const auto suffix = [&](size_type r) {
+            return r == 0 ? n : static_cast<size_type>(sa[r - 1]);
+        };
+        std::vector<unsigned char> bwt(rows);
+        m_sampled = bit_vector(rows);
+        m_primary = 0;
+        detail::for_range(pool, (rows + 63) / 64, [&](size_type begin, size_type end) {
+            for(size_type r = begin * 64; r < end * 64 && r < rows; ++r) {
+                const size_type p = suffix(r);
+                bwt[r] = p == 0 ? 0 : s[p - 1];
+                if(p == 0) {
+                    m_primary = r;
+                }
+                if(p % m_sample_rate == 0) {
+                    m_sampled.set(r);
+                }
+            }
+        });
+        m_sampled.build_index();
+        // Every sample_rate-th position of [0, n] is sampled, in row order.
+        m_sample_storage.assign(n / m_sample_rate + 1, 0);
+        detail::for_range(pool, (rows + 63) / 64, [&](size_type begin, size_type end) {
+            size_type next = m_sampled.rank1(begin * 64);
+            for(size_type r = begin * 64; r < end * 64 && r < rows; ++r) {
+                if(m_sampled[r]) {
+                    m_sample_storage[next++] = suffix(r);
+                }
+            }
+        });
+        m_samples = m_sample_storage.data();
+        m_sample_count = m_sample_storage.size();
+        sa.clear();
+        sa.shrink_to_fit();
+
+        // The levels of the wavelet matrix do not depend on each other; build one per task.
+        detail::for_range(pool, levels, [&](size_type begin, size_type end) {
+            for(size_type l = begin; l < end; ++l) {
+                m_levels[l] = wavelet_level(bwt, l);
+            }
+        });
+        m_text_size = n;
+        finish();
+    }
+
+    // Level l of the wavelet matrix holds bit 7 - l of every symbol, in the order left by stable
+    // partitions on bits 7 down to 8 - l. That is a stable sort on those bits read in reverse,
+    // so a counting sort finds each symbol's place without building the levels above.
+    static bit_vector wavelet_level(const std::vector<unsigned char> &bwt, size_type l)
+    {
+        size_type key[alphabet];
+        for(size_type c = 0; c < alphabet; ++c) {
+            size_type reversed = 0;
+            for(size_type b = 0; b < l; ++b) {
+                reversed |= ((c >> (7 - b)) & 1u) << b;
+            }
+            key[c] = reversed;
+        }
+        size_type start[alphabet] = {};
+        for(const unsigned char c : bwt) {
+            ++start[key[c]];
+        }
+        size_type sum = 0;
+        for(size_type k = 0; k < (size_type{1} << l); ++k) {
+            const size_type count = start[k];
+            start[k] = sum;
+            sum += count;
+        }
+        bit_vector bits(bwt.size());
+        for(const unsigned char c : bwt) {
+            const size_type row = start[key[c]]++;
+            if((c >> (7 - l)) & 1u) {
+                bits.set(row);
+            }
+        }
+        bits.build_index();
+        return bits;
+    }
+
+    // Derives the per symbol tables from the wavelet matrix.
+    void finish() noexcept
+    {
+        for(size_type l = 0; l < levels; ++l) {
+            m_zeros[l] = m_levels[l].empty() ? 0 : m_levels[l].rank0(m_levels[l].size());
+        }
+        const size_type rows = m_text_size + 1;
+        size_type before = 1;
+        for(size_type c = 0; c < alphabet; ++c) {
+            m_level_start[c] = m_levels[0].empty() ? 0 : descend(static_cast<unsigned char>(c), 0);
+            m_first_row[c] = before;
+            before += rank(static_cast<unsigned char>(c), rows);
+        }
+    }
+
+    // Position of element i of symbol c after the last wavelet level.
+    size_type descend(unsigned char c, size_type i) const noexcept
+    {
+        for(size_type l = 0; l < levels; ++l) {
+            if((c >> (7 - l)) & 1u) {
+                i = m_zeros[l] + m_levels[l].rank1(i);
+            } else {
+                i = m_levels[l].rank0(i);
+            }
+        }
+        return i;
+    }
+
+    // Occurrences of text symbol c in the transform rows [0, i).
+    size_type rank(unsigned char c, size_type i) const noexcept
+    {
+        size_type result = descend(c, i) - m_level_start[c];
+        if(c == 0 && m_primary < i) {
+            --result;
+        }
+        return result;
+    }
+
+    // Rows [first, last) of the suffixes starting with pattern.
+    void search(string_view pattern, size_type &first, size_type &last) const noexcept
+    {
+        first = 0;
+        last = m_text_size + 1;
+        for(size_type i = pattern.size(); i-- > 0 && first < last;) {
+            const unsigned char c = static_cast<unsigned char>(pattern[i]);
+            first = m_first_row[c] + rank(c, first);
+            last = m_first_row[c] + rank(c, last);
+        }
+    }
+
+    // Text position of the suffix in row, found by walking back to a sampled row.
+    size_type position(size_type row) const noexcept
+    {
+        size_type steps = 0;
+        while(!m_sampled[row]) {
+            // Read the symbol of row while descending; its final position is its rank.
+            size_type i = row;
+            unsigned c = 0;
+            for(size_type l = 0; l < levels; ++l) {
+                const bool bit = m_levels[l][i];
+                c = (c << 1) | (bit ? 1u : 0u);
+                i = bit ? m_zeros[l] + m_levels[l].rank1(i) : m_levels[l].rank0(i);
+            }
+            size_type r = i - m_level_start[c];
+            if(c == 0 && m_primary < row) {
+                --r;
+            }
+            row = m_first_row[c] + r;
+            ++steps;
+        }
+        return static_cast<size_type>(m_samples[m_sampled.rank1(row)]) + steps;
+    }
+
+    // Private Member
+private:
+    size_type                   m_text_size;
+    size_type                   m_sample_rate;
+    size_type                   m_primary;
+    bit_vector                  m_levels[levels];
+    size_type                   m_zeros[levels];
+    bit_vector                  m_sampled;
+    std::vector<std::uint64_t>  m_sample_storage;
+    const std::uint64_t        *m_samples;
+    size_type                   m_sample_count;
+    size_type                   m_first_row[alphabet];
+    size_type                   m_level_start[alphabet];
+};
+
+} // namespace cppbp
+
+#endif // CPPBP_TEXT_INDEX_HPP
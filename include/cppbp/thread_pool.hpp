@@ -0,0 +1,208 @@
+#ifndef CPPBP_THREAD_POOL_HPP
+#define CPPBP_THREAD_POOL_HPP
+
+#include <atomic>               // std::atomic
+#include <condition_variable>   // std::condition_variable
+#include <cstddef>              // std::size_t
+#include <deque>                // std::deque
+#include <exception>            // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <functional>           // std::function
+#include <future>               // std::future, std::packaged_task
+#include <memory>               // std::make_shared
+#include <mutex>                // std::mutex, std::unique_lock, std::lock_guard
+#include <thread>               // std::thread
+#include <utility>              // std::declval, std::move
+#include <vector>               // std::vector
+
+namespace cppbp {
+
+namespace detail {
+
+// Result of calling a Function with Args; std::result_of is deprecated in C++17 and gone in C++20,
+// and std::invoke_result is not available in C++11.
+template<typename Function, typename... Args>
+struct call_result
+{
+    using type = decltype(std::declval<Function>()(std::declval<Args>()...));
+};
+
+} // namespace detail
+
+// Fixed set of worker threads running tasks from a shared queue.
+//
+// The destructor finishes the queued tasks before joining. parallel_for() splits an index range
+// into chunks that the workers and the calling thread take in turn; it must not be called from a
+// task of the same pool.
+class thread_pool final
+{
+    // Types
+public:
+    using size_type = std::size_t;
+
+    // Construction and Assignment
+public:
+    // Zero threads uses one per hardware thread.
+    explicit thread_pool(size_type threads = 0)
+        : m_stopping{false}
+    {
+        if(threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        if(threads == 0) {
+            threads = 1;
+        }
+        m_workers.reserve(threads);
+        try {
+            for(size_type i = 0; i < threads; ++i) {
+                m_workers.emplace_back([this] { run(); });
+            }
+        } catch(...) {
+            stop();
+            throw;
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        stop();
+    }
+
+    // Capacity
+public:
+    size_type size() const noexcept
+    {
+        return m_workers.size();
+    }
+
+    // Modifiers
+public:
+    // Queues f and returns a future for its result or exception.
+    template<typename Function>
+    std::future<typename detail::call_result<Function>::type> submit(Function f)
+    {
+        using result_type = typename detail::call_result<Function>::type;
+        // std::function needs a copyable target.
+        const auto task = std::make_shared<std::packaged_task<result_type()>>(std::move(f));
+        std::future<result_type> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_tasks.emplace_back([task] { (*task)(); });
+        }
+        m_ready.notify_one();
+        return result;
+    }
+
+    // Calls f(begin, end) on disjoint chunks covering [0, count) and waits for all of them. The
+    // first exception thrown by f is rethrown once every chunk has finished.
+    template<typename Function>
+    void parallel_for(size_type count, Function f)
+    {
+        if(count == 0) {
+            return;
+        }
+        const size_type chunks = size() * 4;
+        const size_type chunk = count / chunks > 0 ? count / chunks : 1;
+        std::atomic<size_type> next{0};
+        const auto work = [&] {
+            for(;;) {
+                const size_type begin = next.fetch_add(chunk);
+                if(begin >= count) {
+                    return;
+                }
+                f(begin, count - begin < chunk ? count : begin + chunk);
+            }
+        };
+
+        std::vector<std::future<void>> helpers;
+        const size_type helper_count = (count + chunk - 1) / chunk - 1 < size() ? (count + chunk - 1) / chunk - 1 : size();
+        helpers.reserve(helper_count);
+        std::exception_ptr error;
+        try {
+            for(size_type i = 0; i < helper_count; ++i) {
+                helpers.push_back(submit(work));
+            }
+            work();
+        } catch(...) {
+            error = std::current_exception();
+            // Let the helpers drain the remaining chunks; they reference this frame.
+        }
+        for(auto &helper : helpers) {
+            helper.wait();
+        }
+        for(auto &helper : helpers) {
+            if(!error) {
+                try {
+                    helper.get();
+                } catch(...) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if(error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Helper
+private:
+    void run()
+    {
+        for(;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_ready.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if(m_tasks.empty()) {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stopping = true;
+        }
+        m_ready.notify_all();
+        for(auto &worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    // Private Member
+private:
+    std::mutex                          m_mutex;
+    std::condition_variable             m_ready;
+    std::deque<std::function<void()>>   m_tasks;
+    bool                                m_stopping;
+    std::vector<std::thread>            m_workers;
+};
+
+namespace detail {
+
+// Runs f(begin, end) over [0, count) with pool->parallel_for(), or as one call on the calling
+// thread when pool is null, for algorithms that take an optional pool.
+template<typename Function>
+void for_range(thread_pool *pool, std::size_t count, Function f)
+{
+    if(pool) {
+        pool->parallel_for(count, f);
+    } else if(count != 0) {
+        f(0, count);
+    }
+}
+
+} // namespace detail
+
+} // namespace cppbp
+
+#endif // CPPBP_THREAD_POOL_HPP
@@ -0,0 +1,138 @@
+#include <cppbp/bit_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Checks rank and select of bits against the plain vector they were built from.
+void expect_rank_select(const cppbp::bit_vector &bits, const std::vector<bool> &expected)
+{
+    const std::size_t npos = cppbp::bit_vector::npos;
+    std::size_t ones = 0;
+    std::vector<std::size_t> one_positions;
+    std::vector<std::size_t> zero_positions;
+    for(std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(bits[i], expected[i]);
+        ASSERT_EQ(bits.rank1(i), ones);
+        if(expected[i]) {
+            ++ones;
+            one_positions.push_back(i);
+        } else {
+            zero_positions.push_back(i);
+        }
+    }
+    EXPECT_EQ(bits.rank1(expected.size()), ones);
+    EXPECT_EQ(bits.count_ones(), ones);
+    for(std::size_t k = 0; k < one_positions.size(); ++k) {
+        ASSERT_EQ(bits.select1(k), one_positions[k]);
+    }
+    for(std::size_t k = 0; k < zero_positions.size(); ++k) {
+        ASSERT_EQ(bits.select0(k), zero_positions[k]);
+    }
+    EXPECT_EQ(bits.select1(one_positions.size()), npos);
+    EXPECT_EQ(bits.select0(zero_positions.size()), npos);
+}
+
+} // namespace
+
+TEST(bit_vector_test, empty)
+{
+    cppbp::bit_vector bits;
+    bits.build_index();
+    EXPECT_TRUE(bits.empty());
+    EXPECT_EQ(bits.rank1(0), 0u);
+    expect_rank_select(bits, {});
+}
+
+TEST(bit_vector_test, rank_select_random_densities)
+{
+    std::mt19937_64 random{42};
+    for(const double density : {0.001, 0.05, 0.5, 0.95, 0.999}) {
+        std::bernoulli_distribution bit{density};
+        std::vector<bool> expected;
+        cppbp::bit_vector bits;
+        for(std::size_t i = 0; i < 20000 + static_cast<std::size_t>(density * 1000); ++i) {
+            expected.push_back(bit(random));
+            bits.push_back(expected.back());
+        }
+        bits.build_index();
+        expect_rank_select(bits, expected);
+    }
+}
+
+TEST(bit_vector_test, filled_and_set)
+{
+    cppbp::bit_vector bits{1000, true};
+    std::vector<bool> expected(1000, true);
+    for(std::size_t i = 0; i < 1000; i += 7) {
+        bits.set(i, false);
+        expected[i] = false;
+    }
+    EXPECT_THROW(bits.set(1000), std::out_of_range);
+    EXPECT_THROW(bits.count_ones(), std::logic_error);
+    bits.build_index();
+    expect_rank_select(bits, expected);
+}
+
+TEST(bit_vector_test, serialize_and_borrow)
+{
+    std::mt19937_64 random{7};
+    std::vector<bool> expected;
+    cppbp::bit_vector bits;
+    for(std::size_t i = 0; i < 5000; ++i) {
+        expected.push_back(random() % 3 == 0);
+        bits.push_back(expected.back());
+    }
+    bits.build_index();
+
+    const std::vector<unsigned char> bytes = bits.serialize();
+    EXPECT_EQ(bytes.size(), bits.serialized_size());
+
+    const cppbp::bit_vector copy = cppbp::bit_vector::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    expect_rank_select(copy, expected);
+
+    cppbp::bit_vector borrowed = cppbp::bit_vector::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    expect_rank_select(borrowed, expected);
+    EXPECT_THROW(borrowed.push_back(true), std::logic_error);
+    EXPECT_THROW(cppbp::bit_vector::borrow(cppbp::span<const unsigned char>{bytes.data() + 1, bytes.size() - 8}),
+                 std::invalid_argument);
+    EXPECT_THROW(cppbp::bit_vector::borrow(cppbp::span<const unsigned char>{bytes.data(), 40}), std::invalid_argument);
+    EXPECT_THROW(cppbp::bit_vector::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size() - 8}),
+                 std::invalid_argument);
+
+    // Sample counts and the total number of ones must agree with the header.
+    const auto patched = [&](std::size_t field, std::uint64_t value) {
+        std::vector<unsigned char> result = bytes;
+        std::memcpy(result.data() + field * 8, &value, 8);
+        return result;
+    };
+    for(const auto &corrupt : {patched(1, 1), patched(4, 0), patched(5, 1), patched(0, ~std::uint64_t{0})}) {
+        EXPECT_THROW(cppbp::bit_vector::borrow(cppbp::span<const unsigned char>{corrupt.data(), corrupt.size()}),
+                     std::invalid_argument);
+    }
+
+    // The samples are used as indices, so they must be ordered block numbers.
+    const std::size_t rank_field = 6 + (5000 + 63) / 64;
+    const std::size_t select1_field = rank_field + ((5000 + 63) / 64 + 7) / 8 + 1;
+    std::uint64_t select1_count;
+    std::memcpy(&select1_count, bytes.data() + 32, 8);
+    const std::size_t select0_field = select1_field + static_cast<std::size_t>(select1_count);
+    for(const auto &corrupt : {patched(rank_field + 3, 0), patched(rank_field + 1, 600), patched(select1_field + 1, 1000),
+                               patched(select1_field + 2, 0), patched(select0_field + 3, ~std::uint64_t{0})}) {
+        EXPECT_THROW(cppbp::bit_vector::borrow(cppbp::span<const unsigned char>{corrupt.data(), corrupt.size()}),
+                     std::invalid_argument);
+    }
+
+    // A copy of a borrowed vector owns its bits.
+    cppbp::bit_vector owned = borrowed;
+    owned.push_back(true);
+    owned.build_index();
+    expected.push_back(true);
+    expect_rank_select(owned, expected);
+}
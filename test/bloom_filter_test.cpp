@@ -0,0 +1,83 @@
+#include <cppbp/bloom_filter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(bloom_filter_test, sizing)
+{
+    EXPECT_EQ(cppbp::bloom_filter::optimal_bits(1000, 0.01), 9586u);
+    EXPECT_EQ(cppbp::bloom_filter::optimal_hashes(9586, 1000), 7);
+    EXPECT_THROW(cppbp::bloom_filter::optimal_bits(1000, 0.0), std::invalid_argument);
+    EXPECT_THROW(cppbp::bloom_filter(0, 3), std::invalid_argument);
+    EXPECT_THROW(cppbp::bloom_filter(512, 17), std::invalid_argument);
+
+    // The classic 19 blocks give the blocked filter a false positive rate above 1%.
+    EXPECT_GT(cppbp::bloom_filter::blocked_false_positive_rate(19 * 512, 7, 1000), 0.01);
+    const auto filter = cppbp::bloom_filter::for_false_positive_rate(1000, 0.01);
+    EXPECT_EQ(filter.bit_count(), 20u * 512u);
+    EXPECT_EQ(filter.hash_count(), 7);
+    EXPECT_LE(cppbp::bloom_filter::blocked_false_positive_rate(filter.bit_count(), 7, 1000), 0.01);
+}
+
+TEST(bloom_filter_test, no_false_negatives_and_bounded_false_positives)
+{
+    constexpr int keys = 20000;
+    auto filter = cppbp::bloom_filter::for_false_positive_rate(keys, 0.01);
+    for(int i = 0; i < keys; ++i) {
+        const std::string key = "present/" + std::to_string(i);
+        filter.insert(cppbp::string_view{key.data(), key.size()});
+    }
+    for(int i = 0; i < keys; ++i) {
+        const std::string key = "present/" + std::to_string(i);
+        ASSERT_TRUE(filter.contains(cppbp::string_view{key.data(), key.size()}));
+    }
+    constexpr int queries = 100000;
+    int false_positives = 0;
+    for(int i = 0; i < queries; ++i) {
+        const std::string key = "absent/" + std::to_string(i);
+        false_positives += filter.contains(cppbp::string_view{key.data(), key.size()});
+    }
+    // 1000 expected; the bound is over three standard deviations away.
+    EXPECT_LT(false_positives, queries * 115 / 10000);
+
+    filter.insert(u"wide"sv);
+    EXPECT_TRUE(filter.contains(u"wide"sv));
+}
+
+TEST(bloom_filter_test, serialization)
+{
+    cppbp::bloom_filter filter{4096, 5, 1234};
+    filter.insert("alpha"sv);
+    filter.insert("beta"sv);
+
+    const std::vector<unsigned char> bytes = filter.serialize();
+    EXPECT_EQ(bytes.size(), filter.serialized_size());
+
+    const auto copy = cppbp::bloom_filter::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    EXPECT_FALSE(copy.borrowed());
+    EXPECT_EQ(copy.hash_count(), 5);
+    EXPECT_TRUE(copy.contains("alpha"sv));
+    EXPECT_TRUE(copy.contains("beta"sv));
+    EXPECT_EQ(copy.hash("alpha"sv), filter.hash("alpha"sv));
+
+    std::vector<std::uint64_t> aligned(bytes.size() / 8 + 1);
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    auto view = cppbp::bloom_filter::borrow(cppbp::span<const unsigned char>{
+        reinterpret_cast<const unsigned char*>(aligned.data()), bytes.size()});
+    EXPECT_TRUE(view.borrowed());
+    EXPECT_TRUE(view.contains("alpha"sv));
+    EXPECT_THROW(view.insert("gamma"sv), std::logic_error);
+
+    EXPECT_THROW(cppbp::bloom_filter::deserialize(cppbp::span<const unsigned char>{bytes.data(), 40}),
+                 std::invalid_argument);
+    std::vector<unsigned char> broken = bytes;
+    broken[0] = 'X';
+    EXPECT_THROW(cppbp::bloom_filter::deserialize(cppbp::span<const unsigned char>{broken.data(), broken.size()}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,149 @@
+#include <cppbp/concurrent_string_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(concurrent_string_map_test, insert_find_erase)
+{
+    cppbp::concurrent_string_map<int> map{4};
+    EXPECT_EQ(map.shard_count(), 4u);
+    EXPECT_TRUE(map.empty());
+
+    EXPECT_TRUE(map.insert("alpha"sv, 1));
+    EXPECT_FALSE(map.insert("alpha"sv, 2));
+    EXPECT_TRUE(map.insert(""sv, 3));
+
+    int value = 0;
+    EXPECT_TRUE(map.find("alpha"sv, value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(map.find(""sv, value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(map.find("beta"sv, value));
+
+    EXPECT_FALSE(map.insert_or_assign("alpha"sv, 5));
+    EXPECT_TRUE(map.find("alpha"sv, value));
+    EXPECT_EQ(value, 5);
+
+    EXPECT_TRUE(map.update("alpha"sv, [](int &v) { v *= 2; }));
+    EXPECT_FALSE(map.update("beta"sv, [](int &v) { v = 0; }));
+    EXPECT_TRUE(map.find("alpha"sv, value));
+    EXPECT_EQ(value, 10);
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.erase("alpha"sv));
+    EXPECT_FALSE(map.erase("alpha"sv));
+    EXPECT_FALSE(map.contains("alpha"sv));
+    EXPECT_TRUE(map.contains(""sv));
+    EXPECT_EQ(map.size(), 1u);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(""sv));
+}
+
+TEST(concurrent_string_map_test, growth_and_churn)
+{
+    cppbp::concurrent_string_map<long> map{2};
+    for(long i = 0; i < 5000; ++i) {
+        map.insert(cppbp::string_view{std::to_string(i).c_str()}, i);
+    }
+    EXPECT_EQ(map.size(), 5000u);
+    for(long i = 0; i < 5000; i += 2) {
+        EXPECT_TRUE(map.erase(cppbp::string_view{std::to_string(i).c_str()}));
+    }
+    // Reuses tombstones and recycled key blocks.
+    for(int round = 0; round < 10; ++round) {
+        for(long i = 0; i < 500; ++i) {
+            const std::string key = "churn" + std::to_string(i);
+            map.insert(cppbp::string_view{key.data(), key.size()}, i);
+            map.erase(cppbp::string_view{key.data(), key.size()});
+        }
+    }
+    EXPECT_EQ(map.size(), 2500u);
+
+    long sum = 0;
+    std::size_t visited = 0;
+    map.for_each([&](cppbp::string_view key, long value) {
+        EXPECT_EQ(std::to_string(value), std::string(key.data(), key.size()));
+        sum += value;
+        ++visited;
+    });
+    EXPECT_EQ(visited, 2500u);
+    EXPECT_EQ(sum, 2500L * 2500L);
+}
+
+TEST(concurrent_string_map_test, non_trivial_values)
+{
+    cppbp::concurrent_string_map<std::string> map;
+    for(int i = 0; i < 200; ++i) {
+        const std::string key = "key" + std::to_string(i);
+        map.insert(cppbp::string_view{key.data(), key.size()}, std::string(100, static_cast<char>('a' + i % 26)));
+    }
+    std::string value;
+    EXPECT_TRUE(map.find("key27"sv, value));
+    EXPECT_EQ(value, std::string(100, 'b'));
+    EXPECT_TRUE(map.update("key27"sv, [](std::string &v) { v = "changed"; }));
+    EXPECT_TRUE(map.find("key27"sv, value));
+    EXPECT_EQ(value, "changed");
+    EXPECT_TRUE(map.erase("key0"sv));
+    EXPECT_EQ(map.size(), 199u);
+}
+
+TEST(concurrent_string_map_test, concurrent_readers_and_writers)
+{
+    constexpr int writers = 4;
+    constexpr int readers = 4;
+    constexpr int keys_per_writer = 2000;
+    cppbp::concurrent_string_map<int> map{8};
+
+    std::vector<std::string> keys;
+    for(int i = 0; i < writers * keys_per_writer; ++i) {
+        keys.push_back("metric." + std::to_string(i));
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for(int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w]() {
+            for(int round = 1; round <= 3; ++round) {
+                for(int i = w * keys_per_writer; i < (w + 1) * keys_per_writer; ++i) {
+                    map.insert_or_assign(cppbp::string_view{keys[i].data(), keys[i].size()}, i * 4 + round);
+                }
+            }
+        });
+    }
+    for(int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r]() {
+            int value;
+            std::size_t i = static_cast<std::size_t>(r);
+            while(!done.load()) {
+                const std::string &key = keys[i % keys.size()];
+                if(map.find(cppbp::string_view{key.data(), key.size()}, value) && value / 4 != static_cast<int>(i % keys.size())) {
+                    ++wrong;
+                }
+                i += 7;
+            }
+        });
+    }
+    for(int w = 0; w < writers; ++w) {
+        threads[static_cast<std::size_t>(w)].join();
+    }
+    done = true;
+    for(std::size_t t = writers; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    EXPECT_EQ(wrong.load(), 0);
+    EXPECT_EQ(map.size(), keys.size());
+    int value = 0;
+    EXPECT_TRUE(map.find("metric.4321"sv, value));
+    EXPECT_EQ(value, 4321 * 4 + 3);
+}
@@ -0,0 +1,175 @@
+#include <cppbp/cord.hpp>
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+cppbp::cord make_cord(const std::vector<std::string> &pieces)
+{
+    cppbp::cord result;
+    for(const auto &piece : pieces) {
+        result.append(cppbp::string_view{piece.data(), piece.size()});
+    }
+    return result;
+}
+
+cppbp::cord make_cord(std::initializer_list<const char*> literals)
+{
+    cppbp::cord result;
+    for(auto literal : literals) {
+        result.append(cppbp::string_view{literal});
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(cord_test, construction)
+{
+    cppbp::cord empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_TRUE(empty.chunks().begin() == empty.chunks().end());
+
+    cppbp::cord borrowed{"hello"sv};
+    EXPECT_EQ(borrowed.size(), 5u);
+    EXPECT_EQ(borrowed.to_string(), "hello");
+
+    cppbp::cord owned{std::string("world")};
+    EXPECT_EQ(owned.to_string(), "world");
+    EXPECT_EQ(owned[4], 'd');
+    EXPECT_THROW(owned.at(5), std::out_of_range);
+}
+
+TEST(cord_test, concatenation_keeps_chunks)
+{
+    const std::vector<std::string> pieces = {"HTTP/1.1 200 OK\r\n", "Content-Length: 5\r\n", "\r\n", "hello"};
+    const auto cord = make_cord(pieces);
+
+    std::size_t index = 0;
+    for(auto chunk : cord.chunks()) {
+        ASSERT_LT(index, pieces.size());
+        EXPECT_EQ(chunk.data(), pieces[index].data());
+        EXPECT_EQ(chunk.size(), pieces[index].size());
+        ++index;
+    }
+    EXPECT_EQ(index, pieces.size());
+    EXPECT_EQ(cord.to_string(), pieces[0] + pieces[1] + pieces[2] + pieces[3]);
+}
+
+TEST(cord_test, many_appends_stay_consistent)
+{
+    std::string expected;
+    std::vector<std::string> pieces;
+    for(int i = 0; i < 2000; ++i) {
+        pieces.push_back(std::to_string(i) + ",");
+    }
+    cppbp::cord cord;
+    for(const auto &piece : pieces) {
+        expected += piece;
+        cord.append(cppbp::string_view{piece.data(), piece.size()});
+    }
+    // Prepending exercises the left side of the tree.
+    cppbp::cord front;
+    for(auto it = pieces.rbegin(); it != pieces.rend(); ++it) {
+        front.prepend(cppbp::cord{cppbp::string_view{it->data(), it->size()}});
+    }
+
+    EXPECT_EQ(cord.to_string(), expected);
+    EXPECT_EQ(front.to_string(), expected);
+    EXPECT_EQ(cord.compare(front), 0);
+    for(std::size_t i = 0; i < expected.size(); i += 97) {
+        EXPECT_EQ(cord[i], expected[i]);
+    }
+}
+
+TEST(cord_test, substr)
+{
+    const std::vector<std::string> pieces = {"abc", "defg", "h", "ijklmn", "op"};
+    const auto cord = make_cord(pieces);
+    const std::string flat = cord.to_string();
+
+    for(std::size_t pos = 0; pos <= flat.size(); ++pos) {
+        for(std::size_t n = 0; pos + n <= flat.size() + 1; ++n) {
+            EXPECT_EQ(cord.substr(pos, n).to_string(), flat.substr(pos, n));
+        }
+    }
+    EXPECT_THROW(cord.substr(flat.size() + 1), std::out_of_range);
+
+    char buffer[8] = {};
+    EXPECT_EQ(cord.copy(buffer, 6, 2), 6u);
+    EXPECT_EQ(std::string(buffer, 6), "cdefgh");
+}
+
+TEST(cord_test, find_across_chunks)
+{
+    const std::vector<std::string> pieces = {"xxab", "c", "dxx", "abcd", "ab", "cdxabc"};
+    const auto cord = make_cord(pieces);
+    const std::string flat = cord.to_string();
+
+    const char *needles[] = {"abcd", "ab", "cdx", "xabc", "x", "dxxa", "zz", "abcdxxabcdab", ""};
+    for(auto needle : needles) {
+        for(std::size_t pos = 0; pos <= flat.size() + 1; ++pos) {
+            const auto expected = flat.find(needle, pos);
+            EXPECT_EQ(cord.find(needle, pos), expected == std::string::npos ? cppbp::cord::npos : expected)
+                << needle << " " << pos;
+        }
+    }
+    EXPECT_TRUE(cord.contains("cdxabc"));
+    EXPECT_EQ(cord.find('d', 4), 5u);
+}
+
+TEST(cord_test, compare)
+{
+    const auto a = make_cord({"ab", "cd", "ef"});
+    const auto b = make_cord({"a", "bcde", "f"});
+    const auto c = make_cord({"abc", "dx"});
+
+    EXPECT_EQ(a, b);
+    EXPECT_TRUE(a == "abcdef"sv);
+    EXPECT_TRUE(a != "abcdeg"sv);
+    EXPECT_LT(a.compare(c), 0);
+    EXPECT_GT(c.compare(a), 0);
+    EXPECT_LT(a.compare("abcdefg"sv), 0);
+    EXPECT_GT(a.compare("abcde"sv), 0);
+    EXPECT_EQ(cppbp::cord{}.compare(""sv), 0);
+    EXPECT_TRUE(a.starts_with("abcd"sv));
+    EXPECT_FALSE(a.starts_with("abd"sv));
+    EXPECT_EQ((a + c).to_string(), "abcdefabcdx");
+}
+
+TEST(cord_test, shared_subtrees)
+{
+    cppbp::cord a{"ab"sv};
+    a.append(a);
+    EXPECT_EQ(a.size(), 4u);
+    EXPECT_EQ(a.to_string(), "abab");
+    EXPECT_EQ(std::distance(a.chunks().begin(), a.chunks().end()), 2);
+    EXPECT_FALSE(a.chunks().begin() == std::next(a.chunks().begin()));
+
+    const auto b = make_cord({"x", "yz", "w"});
+    auto c = b + b;
+    c = c + c;
+    const std::string flat = "xyzwxyzwxyzwxyzw";
+    EXPECT_EQ(c.to_string(), flat);
+    EXPECT_EQ(c.find("wx"sv, 4), 7u);
+    EXPECT_EQ(c.find("zwxy"sv, 8), 10u);
+    EXPECT_EQ(c.compare(cppbp::string_view{flat.data(), flat.size()}), 0);
+    EXPECT_LT(c.compare("xyzwxyzwxyzwxyzx"sv), 0);
+
+    char buffer[16];
+    EXPECT_EQ(c.copy(buffer, sizeof(buffer)), 16u);
+    EXPECT_EQ(std::string(buffer, 16), flat);
+
+    std::ostringstream os;
+    os << c;
+    EXPECT_EQ(os.str(), flat);
+}
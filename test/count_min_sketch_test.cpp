@@ -0,0 +1,84 @@
+#include <cppbp/count_min_sketch.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(count_min_sketch_test, estimates)
+{
+    auto sketch = cppbp::count_min_sketch::for_error(0.001, 0.01);
+    EXPECT_EQ(sketch.width(), 4096u);
+    EXPECT_EQ(sketch.depth(), 5u);
+    EXPECT_THROW(cppbp::count_min_sketch::for_error(0.0, 0.1), std::invalid_argument);
+
+    for(int i = 0; i < 1000; ++i) {
+        const std::string key = "/page/" + std::to_string(i);
+        sketch.add(cppbp::string_view{key.data(), key.size()}, static_cast<std::uint32_t>(i % 10 + 1));
+    }
+    sketch.add("/index"sv, 5000);
+    EXPECT_EQ(sketch.total(), 5500u + 5000u);
+
+    EXPECT_GE(sketch.estimate("/index"sv), 5000u);
+    EXPECT_LE(sketch.estimate("/index"sv), 5000u + 11u);
+    for(int i = 0; i < 1000; ++i) {
+        const std::string key = "/page/" + std::to_string(i);
+        EXPECT_GE(sketch.estimate(cppbp::string_view{key.data(), key.size()}), static_cast<std::uint32_t>(i % 10 + 1));
+    }
+    EXPECT_LE(sketch.estimate("/never"sv), 11u);
+
+    const std::vector<cppbp::string_view> batch = {"/index"sv, "/index"sv, "/about"sv};
+    sketch.add_batch(cppbp::span<const cppbp::string_view>{batch.data(), batch.size()});
+    EXPECT_GE(sketch.estimate("/index"sv), 5002u);
+
+    cppbp::count_min_sketch other{4096, 5};
+    other.add("/about"sv, 10);
+    sketch.merge(other);
+    EXPECT_GE(sketch.estimate("/about"sv), 11u);
+    EXPECT_THROW(sketch.merge(cppbp::count_min_sketch{1024, 5}), std::invalid_argument);
+
+    sketch.clear();
+    EXPECT_EQ(sketch.estimate("/index"sv), 0u);
+}
+
+TEST(count_min_sketch_test, saturation)
+{
+    cppbp::count_min_sketch sketch{16, 2};
+    sketch.add("x"sv, 0xfffffff0u);
+    sketch.add("x"sv, 0x100u);
+    EXPECT_EQ(sketch.estimate("x"sv), 0xffffffffu);
+}
+
+TEST(count_min_sketch_test, heavy_hitters)
+{
+    cppbp::heavy_hitters hitters{3, 2048, 4};
+    std::vector<std::string> stream;
+    for(int i = 0; i < 2000; ++i) {
+        stream.push_back("/rare/" + std::to_string(i));
+        if(i % 2 == 0) {
+            stream.push_back("/hot");
+        }
+        if(i % 4 == 0) {
+            stream.push_back("/warm");
+        }
+        if(i % 10 == 0) {
+            stream.push_back("/mild");
+        }
+    }
+    std::vector<cppbp::string_view> views;
+    for(const auto &s : stream) {
+        views.emplace_back(s.data(), s.size());
+    }
+    hitters.add_batch(cppbp::span<const cppbp::string_view>{views.data(), views.size()});
+    hitters.add("/mild"sv, 3);
+
+    const auto top = hitters.top();
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].first, "/hot");
+    EXPECT_GE(top[0].second, 1000u);
+    EXPECT_EQ(top[1].first, "/warm");
+    EXPECT_EQ(top[2].first, "/mild");
+    EXPECT_GE(top[2].second, 203u);
+}
@@ -0,0 +1,89 @@
+#include <cppbp/cstring_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace cppbp::literals;
+
+TEST(cstring_view_test, construction)
+{
+    constexpr cppbp::cstring_view empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_STREQ(empty.c_str(), "");
+
+    const cppbp::cstring_view literal = "literal";
+    EXPECT_EQ(literal.size(), 7u);
+    EXPECT_EQ(literal[7], '\0');
+
+    const std::string str = "from std::string";
+    const cppbp::cstring_view from_string = str;
+    EXPECT_EQ(from_string.c_str(), str.c_str());
+    EXPECT_EQ(from_string.size(), str.size());
+
+    const char buffer[] = "abc\0def";
+    const cppbp::cstring_view counted{buffer, 3};
+    EXPECT_EQ(counted.view(), "abc"sv);
+    EXPECT_THROW(counted.at(3), std::out_of_range);
+}
+
+TEST(cstring_view_test, converts_to_string_view)
+{
+    const cppbp::cstring_view str = "hello world";
+    const cppbp::string_view view = str;
+    EXPECT_EQ(view.data(), str.data());
+    EXPECT_EQ(view, "hello world"sv);
+    EXPECT_EQ(view.substr(6), "world"sv);
+}
+
+TEST(cstring_view_test, suffixes_stay_terminated)
+{
+    cppbp::cstring_view str = "prefix/name";
+    EXPECT_STREQ(str.substr(7).c_str(), "name");
+    EXPECT_THROW(str.substr(12), std::out_of_range);
+    str.remove_prefix(7);
+    EXPECT_STREQ(str.c_str(), "name");
+    EXPECT_EQ(str.size(), 4u);
+}
+
+TEST(cstring_view_test, comparison)
+{
+    const std::string a = "apple";
+    const cppbp::cstring_view view = a;
+    EXPECT_TRUE(view == "apple");
+    EXPECT_TRUE("apple" == view);
+    EXPECT_TRUE(view != "apples");
+    EXPECT_TRUE(view < "banana");
+    EXPECT_TRUE(view == "apple"sv);
+
+    std::ostringstream os;
+    os << view;
+    EXPECT_EQ(os.str(), "apple");
+}
+
+TEST(cstring_view_test, with_cstr)
+{
+    const std::string text = "PATH=/usr/bin";
+    const cppbp::string_view key = cppbp::string_view{text.data(), text.size()}.substr(0, 4);
+    const std::size_t length = cppbp::with_cstr(key, [](cppbp::cstring_view str) {
+        return std::strlen(str.c_str());
+    });
+    EXPECT_EQ(length, 4u);
+
+    // Longer than the stack buffer.
+    const std::string long_text(1000, 'x');
+    const cppbp::string_view long_view = cppbp::string_view{long_text.data(), 999};
+    EXPECT_EQ(cppbp::with_cstr(long_view, [](cppbp::cstring_view str) { return std::strlen(str.c_str()); }), 999u);
+
+    // An empty default view has no data pointer.
+    EXPECT_EQ(cppbp::with_cstr(cppbp::string_view{}, [](cppbp::cstring_view str) { return std::strlen(str.c_str()); }), 0u);
+
+    // Terminated input is passed through.
+    const cppbp::cstring_view terminated = text;
+    cppbp::with_cstr(terminated, [&](cppbp::cstring_view str) {
+        EXPECT_EQ(str.c_str(), text.c_str());
+    });
+}
@@ -0,0 +1,101 @@
+#include <cppbp/cuckoo_filter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(cuckoo_filter_test, insert_contains_erase)
+{
+    cppbp::cuckoo_filter filter{1000};
+    EXPECT_EQ(filter.bucket_count(), 512u);
+    EXPECT_TRUE(filter.empty());
+
+    EXPECT_TRUE(filter.insert("alpha"sv));
+    EXPECT_TRUE(filter.insert("beta"sv));
+    EXPECT_TRUE(filter.contains("alpha"sv));
+    EXPECT_EQ(filter.size(), 2u);
+
+    EXPECT_TRUE(filter.erase("alpha"sv));
+    EXPECT_FALSE(filter.contains("alpha"sv));
+    EXPECT_FALSE(filter.erase("alpha"sv));
+    EXPECT_TRUE(filter.contains("beta"sv));
+    EXPECT_EQ(filter.size(), 1u);
+}
+
+TEST(cuckoo_filter_test, high_load)
+{
+    constexpr int keys = 30000;
+    cppbp::cuckoo_filter filter{keys};
+    int inserted = 0;
+    for(int i = 0; i < keys; ++i) {
+        const std::string key = "key:" + std::to_string(i);
+        inserted += filter.insert(cppbp::string_view{key.data(), key.size()});
+    }
+    EXPECT_EQ(inserted, keys);
+    EXPECT_GT(filter.load_factor(), 0.45);
+
+    for(int i = 0; i < keys; ++i) {
+        const std::string key = "key:" + std::to_string(i);
+        ASSERT_TRUE(filter.contains(cppbp::string_view{key.data(), key.size()}));
+    }
+    int false_positives = 0;
+    for(int i = 0; i < keys; ++i) {
+        const std::string key = "missing:" + std::to_string(i);
+        false_positives += filter.contains(cppbp::string_view{key.data(), key.size()});
+    }
+    EXPECT_LT(false_positives, 20);
+
+    for(int i = 0; i < keys; i += 2) {
+        const std::string key = "key:" + std::to_string(i);
+        EXPECT_TRUE(filter.erase(cppbp::string_view{key.data(), key.size()}));
+    }
+    for(int i = 1; i < keys; i += 2) {
+        const std::string key = "key:" + std::to_string(i);
+        ASSERT_TRUE(filter.contains(cppbp::string_view{key.data(), key.size()}));
+    }
+    EXPECT_EQ(filter.size(), static_cast<std::size_t>(keys / 2));
+}
+
+TEST(cuckoo_filter_test, full_filter)
+{
+    cppbp::cuckoo_filter filter{8};
+    int inserted = 0;
+    for(int i = 0; i < 100; ++i) {
+        const std::string key = std::to_string(i);
+        inserted += filter.insert(cppbp::string_view{key.data(), key.size()});
+    }
+    EXPECT_LT(inserted, 100);
+    EXPECT_GE(static_cast<std::size_t>(inserted), filter.capacity());
+    for(int i = 0; i < inserted; ++i) {
+        const std::string key = std::to_string(i);
+        EXPECT_TRUE(filter.contains(cppbp::string_view{key.data(), key.size()}));
+    }
+}
+
+TEST(cuckoo_filter_test, serialization)
+{
+    cppbp::cuckoo_filter filter{100, 99};
+    filter.insert("alpha"sv);
+    filter.insert("beta"sv);
+
+    const std::vector<unsigned char> bytes = filter.serialize();
+    const auto copy = cppbp::cuckoo_filter::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT_TRUE(copy.contains("alpha"sv));
+    EXPECT_FALSE(copy.contains("gamma"sv));
+
+    std::vector<std::uint64_t> aligned(bytes.size() / 8 + 1);
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    auto view = cppbp::cuckoo_filter::borrow(cppbp::span<const unsigned char>{
+        reinterpret_cast<const unsigned char*>(aligned.data()), bytes.size()});
+    EXPECT_TRUE(view.contains("beta"sv));
+    EXPECT_THROW(view.erase("beta"sv), std::logic_error);
+
+    EXPECT_THROW(cppbp::cuckoo_filter::deserialize(cppbp::span<const unsigned char>{bytes.data(), 20}),
+                 std::invalid_argument);
+}
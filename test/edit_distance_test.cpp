@@ -0,0 +1,120 @@
+#include <cppbp/edit_distance.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+std::size_t reference_distance(const std::string &a, const std::string &b)
+{
+    std::vector<std::size_t> row(b.size() + 1);
+    for(std::size_t j = 0; j <= b.size(); ++j) {
+        row[j] = j;
+    }
+    for(std::size_t i = 1; i <= a.size(); ++i) {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+        for(std::size_t j = 1; j <= b.size(); ++j) {
+            const std::size_t up = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+            diagonal = up;
+        }
+    }
+    return row[b.size()];
+}
+
+std::string random_string(std::mt19937 &rng, std::size_t size, char alphabet)
+{
+    std::uniform_int_distribution<int> dist(0, alphabet - 1);
+    std::string result(size, 'a');
+    for(auto &c : result) {
+        c = static_cast<char>('a' + dist(rng));
+    }
+    return result;
+}
+
+cppbp::string_view view(const std::string &str)
+{
+    return cppbp::string_view{str.data(), str.size()};
+}
+
+} // namespace
+
+TEST(edit_distance_test, small)
+{
+    EXPECT_EQ(cppbp::edit_distance(""sv, ""), 0u);
+    EXPECT_EQ(cppbp::edit_distance("abc"sv, ""), 3u);
+    EXPECT_EQ(cppbp::edit_distance(""sv, "abc"), 3u);
+    EXPECT_EQ(cppbp::edit_distance("kitten"sv, "sitting"), 3u);
+    EXPECT_EQ(cppbp::edit_distance("flaw"sv, "lawn"), 2u);
+    EXPECT_EQ(cppbp::edit_distance("same"sv, "same"), 0u);
+    EXPECT_EQ(cppbp::edit_distance(U"straße"sv, U"strasse"), 2u);
+}
+
+TEST(edit_distance_test, bound)
+{
+    EXPECT_EQ(cppbp::edit_distance("kitten"sv, "sitting", 3), 3u);
+    EXPECT_EQ(cppbp::edit_distance("kitten"sv, "sitting", 2), 3u);
+    EXPECT_EQ(cppbp::edit_distance("kitten"sv, "sitting", 0), 1u);
+    EXPECT_EQ(cppbp::edit_distance("a"sv, "abcdefgh", 3), 4u);
+}
+
+TEST(edit_distance_test, matches_reference)
+{
+    std::mt19937 rng{42};
+    const std::size_t sizes[] = {1, 5, 63, 64, 65, 130, 300, 700};
+    for(auto size_a : sizes) {
+        for(auto size_b : sizes) {
+            const auto a = random_string(rng, size_a, 4);
+            const auto b = random_string(rng, size_b, 4);
+            const auto expected = reference_distance(a, b);
+            EXPECT_EQ(cppbp::edit_distance(view(a), view(b)), expected) << size_a << " " << size_b;
+            EXPECT_EQ(cppbp::edit_distance(view(a), view(b), expected), expected);
+            if(expected > 0) {
+                EXPECT_EQ(cppbp::edit_distance(view(a), view(b), expected - 1), expected);
+            }
+        }
+    }
+}
+
+TEST(edit_distance_test, fuzzy_find)
+{
+    auto match = cppbp::fuzzy_find("the quick brown fox"sv, "quikc", 2);
+    EXPECT_EQ(match.position, 4u);
+    EXPECT_EQ(match.length, 4u);
+    EXPECT_EQ(match.distance, 1u);
+
+    match = cppbp::fuzzy_find("the quick brown fox"sv, "brwn", 1);
+    EXPECT_EQ(match.position, 10u);
+    EXPECT_EQ(match.length, 5u);
+    EXPECT_EQ(match.distance, 1u);
+
+    match = cppbp::fuzzy_find("the quick brown fox"sv, "zebra", 1);
+    EXPECT_EQ(match.position, cppbp::string_view::npos);
+
+    match = cppbp::fuzzy_find("abc"sv, "xy", 2);
+    EXPECT_EQ(match.position, 0u);
+    EXPECT_EQ(match.length, 0u);
+}
+
+TEST(edit_distance_test, fuzzy_find_long_pattern)
+{
+    std::mt19937 rng{7};
+    const auto pattern = random_string(rng, 150, 26);
+    auto corrupted = pattern;
+    corrupted[10] = '#';
+    corrupted.erase(70, 1);
+    const auto text = random_string(rng, 500, 26) + corrupted + random_string(rng, 100, 26);
+
+    const auto match = cppbp::fuzzy_find(view(text), view(pattern), 3);
+    EXPECT_EQ(match.position, 500u);
+    EXPECT_EQ(match.length, corrupted.size());
+    EXPECT_EQ(match.distance, 2u);
+    EXPECT_EQ(reference_distance(text.substr(match.position, match.length), pattern), match.distance);
+}
@@ -0,0 +1,111 @@
+#include <cppbp/enum_names.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace cppbp::literals;
+
+namespace enum_names_test {
+
+enum class color { red, green = 5, blue = -3 };
+
+enum plain { first, second, third };
+
+enum class byte : std::uint8_t { low = 1, high = 120 };
+
+enum class wide { small = 1, large = 1000 };
+
+// Registered; the values are far outside of any range worth scanning, and ok has an alias.
+enum class status : std::int32_t { ok = 200, success = 200, not_found = 404, teapot = 418, negative = -100000 };
+CPPBP_ENUM_NAMES(status, status::ok, status::success , status :: not_found, status::teapot, status::negative)
+
+enum unscoped_registered { alpha = 1 << 20, beta = 7 };
+CPPBP_ENUM_NAMES(unscoped_registered, alpha, beta)
+
+enum class big { v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16, v17, v18, v19, v20, v21, v22, v23, v24, v25, v26, v27, v28, v29, v30, v31, v32, v33, v34, v35, v36, v37, v38, v39, v40, v41, v42, v43, v44, v45, v46, v47, v48, v49, v50, v51, v52, v53, v54, v55, v56, v57, v58, v59, v60, v61, v62, v63, v64, v65, v66, v67, v68, v69, v70, v71, v72, v73, v74, v75, v76, v77, v78, v79, v80, v81, v82, v83, v84, v85, v86, v87, v88, v89, v90, v91, v92, v93, v94, v95, v96, v97, v98, v99 };
+
+} // namespace enum_names_test
+
+namespace cppbp {
+
+// No fixed underlying type: its values are 0 to 3 only, and the scan must stay within them.
+template<>
+struct enum_range<enum_names_test::plain>
+{
+    static constexpr int min = 0;
+    static constexpr int max = 3;
+};
+
+template<>
+struct enum_range<enum_names_test::wide>
+{
+    static constexpr int min = 0;
+    static constexpr int max = 1000;
+};
+
+} // namespace cppbp
+
+using namespace enum_names_test;
+
+TEST(enum_names_test, reflected_names)
+{
+    EXPECT_EQ(cppbp::enum_name(color::red), "red"sv);
+    EXPECT_EQ(cppbp::enum_name(color::green), "green"sv);
+    EXPECT_EQ(cppbp::enum_name(color::blue), "blue"sv);
+    EXPECT_TRUE(cppbp::enum_name(static_cast<color>(1)).empty());
+    EXPECT_TRUE(cppbp::enum_name(static_cast<color>(1000)).empty());
+    EXPECT_EQ(cppbp::enum_name(second), "second"sv);
+    EXPECT_EQ(cppbp::enum_name(byte::high), "high"sv);
+    EXPECT_EQ(cppbp::enum_name(wide::large), "large"sv);
+
+    EXPECT_EQ(cppbp::enum_from_name<color>("green"sv), color::green);
+    EXPECT_EQ(cppbp::enum_from_name<plain>("third"sv), third);
+    EXPECT_THROW(cppbp::enum_from_name<color>("purple"sv), std::invalid_argument);
+    EXPECT_THROW(cppbp::enum_from_name<color>("gree"sv), std::invalid_argument);
+    EXPECT_THROW(cppbp::enum_from_name<color>(""sv), std::invalid_argument);
+
+    color c = color::red;
+    EXPECT_FALSE(cppbp::enum_from_name("Red"sv, c));
+    EXPECT_EQ(c, color::red);
+    EXPECT_TRUE(cppbp::enum_from_name("blue"sv, c));
+    EXPECT_EQ(c, color::blue);
+}
+
+TEST(enum_names_test, values_and_names)
+{
+    const auto values = cppbp::enum_values<color>();
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_EQ(values[0], color::blue);
+    EXPECT_EQ(values[1], color::red);
+    EXPECT_EQ(values[2], color::green);
+    const auto names = cppbp::enum_names<color>();
+    ASSERT_EQ(names.size(), 3u);
+    EXPECT_EQ(names[0], "blue"sv);
+
+    ASSERT_EQ(cppbp::enum_values<big>().size(), 100u);
+    for(std::size_t i = 0; i < 100; ++i) {
+        const std::string name = "v" + std::to_string(i);
+        const big value = static_cast<big>(i);
+        EXPECT_EQ(cppbp::enum_name(value), cppbp::string_view(name.data(), name.size()));
+        EXPECT_EQ(cppbp::enum_from_name<big>(cppbp::string_view(name.data(), name.size())), value);
+    }
+}
+
+TEST(enum_names_test, registered_names)
+{
+    EXPECT_EQ(cppbp::enum_name(status::not_found), "not_found"sv);
+    EXPECT_EQ(cppbp::enum_name(status::negative), "negative"sv);
+    // The first name of a value wins; both names are found.
+    EXPECT_EQ(cppbp::enum_name(status::success), "ok"sv);
+    EXPECT_EQ(cppbp::enum_from_name<status>("success"sv), status::ok);
+    EXPECT_EQ(cppbp::enum_from_name<status>("teapot"sv), status::teapot);
+    EXPECT_TRUE(cppbp::enum_name(static_cast<status>(500)).empty());
+    EXPECT_THROW(cppbp::enum_from_name<status>("status::ok"sv), std::invalid_argument);
+    EXPECT_EQ(cppbp::enum_values<status>().size(), 5u);
+
+    EXPECT_EQ(cppbp::enum_name(alpha), "alpha"sv);
+    EXPECT_EQ(cppbp::enum_from_name<unscoped_registered>("beta"sv), beta);
+}
@@ -0,0 +1,52 @@
+#include <cppbp/hash_batch.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(hash_batch_test, matches_scalar_hash)
+{
+    std::mt19937_64 random{21};
+    std::string bytes(300, '\0');
+    for(auto &c : bytes) {
+        c = static_cast<char>(random());
+    }
+    // Every length from 0 to 200 at varying offsets, so every code path of the hash is covered.
+    std::vector<cppbp::string_view> keys;
+    for(std::size_t len = 0; len <= 200; ++len) {
+        keys.emplace_back(bytes.data() + len % 37, len);
+    }
+    for(const std::uint64_t seed : {cppbp::detail::default_hash_seed, std::uint64_t{0}, std::uint64_t{12345}}) {
+        std::vector<std::uint64_t> out(keys.size());
+        cppbp::hash_batch(cppbp::span<const cppbp::string_view>{keys.data(), keys.size()},
+                          cppbp::span<std::uint64_t>{out.data(), out.size()}, seed);
+        for(std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(out[i], cppbp::hash_bytes(keys[i].data(), keys[i].size(), seed)) << i;
+        }
+    }
+}
+
+TEST(hash_batch_test, partial_groups)
+{
+    const std::vector<cppbp::string_view> keys = {"a", "bb", "ccc", "a much longer key of more than 16 bytes", "", "x"};
+    for(std::size_t n = 0; n <= keys.size(); ++n) {
+        std::vector<std::uint64_t> out(n + 1, 7);
+        cppbp::hash_batch(cppbp::span<const cppbp::string_view>{keys.data(), n}, cppbp::span<std::uint64_t>{out.data(), out.size()});
+        for(std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(out[i], cppbp::hash<cppbp::string_view>{}(keys[i]));
+        }
+        EXPECT_EQ(out[n], 7u);
+    }
+}
+
+TEST(hash_batch_test, rejects_short_output)
+{
+    const std::vector<cppbp::string_view> keys = {"a", "b"};
+    std::uint64_t out[1];
+    EXPECT_THROW(cppbp::hash_batch(cppbp::span<const cppbp::string_view>{keys.data(), keys.size()},
+                                   cppbp::span<std::uint64_t>{out, 1}), std::length_error);
+}
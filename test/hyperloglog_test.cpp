@@ -0,0 +1,117 @@
+#include <cppbp/hyperloglog.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+std::vector<std::string> make_keys(int first, int count)
+{
+    std::vector<std::string> keys;
+    for(int i = first; i < first + count; ++i) {
+        keys.push_back("user-" + std::to_string(i));
+    }
+    return keys;
+}
+
+std::vector<cppbp::string_view> views_of(const std::vector<std::string> &keys)
+{
+    std::vector<cppbp::string_view> views;
+    for(const auto &key : keys) {
+        views.emplace_back(key.data(), key.size());
+    }
+    return views;
+}
+
+double relative_error(double estimate, double exact)
+{
+    return std::fabs(estimate - exact) / exact;
+}
+
+} // namespace
+
+TEST(hyperloglog_test, small_cardinalities_are_sparse)
+{
+    EXPECT_THROW(cppbp::hyperloglog{3}, std::invalid_argument);
+
+    cppbp::hyperloglog hll;
+    EXPECT_EQ(hll.estimate(), 0.0);
+    hll.add("a"sv);
+    hll.add("b"sv);
+    hll.add("a"sv);
+    EXPECT_NEAR(hll.estimate(), 2.0, 0.01);
+    EXPECT_TRUE(hll.is_sparse());
+
+    const auto keys = make_keys(0, 1000);
+    const auto views = views_of(keys);
+    hll.add_batch(cppbp::span<const cppbp::string_view>{views.data(), views.size()});
+    EXPECT_TRUE(hll.is_sparse());
+    EXPECT_LT(relative_error(hll.estimate(), 1002.0), 0.02);
+
+    // Pending entries count as if they were compacted; a merge compacts them.
+    cppbp::hyperloglog pending;
+    for(const auto &key : make_keys(0, 300)) {
+        pending.add(cppbp::string_view{key.data(), key.size()});
+        pending.add(cppbp::string_view{key.data(), key.size()});
+    }
+    cppbp::hyperloglog compacted;
+    compacted.merge(pending);
+    EXPECT_DOUBLE_EQ(pending.estimate(), compacted.estimate());
+}
+
+TEST(hyperloglog_test, large_cardinalities)
+{
+    cppbp::hyperloglog hll{12};
+    const auto keys = make_keys(0, 200000);
+    for(const auto &key : keys) {
+        hll.add(cppbp::string_view{key.data(), key.size()});
+        hll.add(cppbp::string_view{key.data(), key.size()});
+    }
+    EXPECT_FALSE(hll.is_sparse());
+    EXPECT_EQ(hll.memory_usage(), 4096u);
+    // 1.04 / sqrt(4096) is about 1.6%; allow three standard errors.
+    EXPECT_LT(relative_error(hll.estimate(), 200000.0), 0.05);
+}
+
+TEST(hyperloglog_test, merge)
+{
+    const auto first = make_keys(0, 60000);
+    const auto second = make_keys(40000, 60000);
+    const auto few = make_keys(0, 50);
+
+    cppbp::hyperloglog a{12};
+    cppbp::hyperloglog b{12};
+    cppbp::hyperloglog sparse{12};
+    for(const auto &key : first) {
+        a.add(cppbp::string_view{key.data(), key.size()});
+    }
+    for(const auto &key : second) {
+        b.add(cppbp::string_view{key.data(), key.size()});
+    }
+    for(const auto &key : few) {
+        sparse.add(cppbp::string_view{key.data(), key.size()});
+    }
+
+    const double before = a.estimate();
+    a.merge(sparse);
+    EXPECT_EQ(a.estimate(), before);
+    a.merge(b);
+    EXPECT_LT(relative_error(a.estimate(), 100000.0), 0.05);
+
+    cppbp::hyperloglog c{12};
+    c.merge(sparse);
+    EXPECT_TRUE(c.is_sparse());
+    EXPECT_NEAR(c.estimate(), sparse.estimate(), 1e-9);
+    c.merge(c);
+
+    EXPECT_THROW(a.merge(cppbp::hyperloglog{13}), std::invalid_argument);
+
+    a.clear();
+    EXPECT_TRUE(a.is_sparse());
+    EXPECT_EQ(a.estimate(), 0.0);
+}
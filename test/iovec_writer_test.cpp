@@ -0,0 +1,137 @@
+#include <cppbp/iovec_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace cppbp::literals;
+
+namespace {
+
+// Temporary file that is read back after writing.
+class temporary_file
+{
+public:
+    temporary_file()
+        : m_file{std::tmpfile()}
+    { }
+
+    ~temporary_file()
+    {
+        std::fclose(m_file);
+    }
+
+    int fd() const
+    {
+        return fileno(m_file);
+    }
+
+    std::string contents() const
+    {
+        std::string result;
+        char buffer[4096];
+        ::lseek(fd(), 0, SEEK_SET);
+        ssize_t n;
+        while((n = ::read(fd(), buffer, sizeof(buffer))) > 0) {
+            result.append(buffer, static_cast<std::size_t>(n));
+        }
+        return result;
+    }
+
+private:
+    std::FILE *m_file;
+};
+
+} // namespace
+
+TEST(iovec_writer_test, coalesces_small_pieces)
+{
+    temporary_file file;
+    cppbp::iovec_writer writer{file.fd()};
+
+    const std::string body(1000, 'x');
+    writer << "HTTP/1.1 200 OK\r\n"sv << "Content-Length: 1000\r\n"sv << "\r\n"sv;
+    EXPECT_EQ(writer.piece_count(), 1u);
+    writer.write(cppbp::span<const char>{body});
+    EXPECT_EQ(writer.piece_count(), 2u);
+    writer.write("\n");
+    EXPECT_EQ(writer.piece_count(), 3u);
+    EXPECT_EQ(writer.pending(), 41u + 1000u + 1u);
+
+    writer.flush();
+    EXPECT_EQ(writer.pending(), 0u);
+    EXPECT_EQ(writer.piece_count(), 0u);
+    EXPECT_EQ(file.contents(), "HTTP/1.1 200 OK\r\nContent-Length: 1000\r\n\r\n" + body + "\n");
+}
+
+TEST(iovec_writer_test, adjacent_pieces_share_an_entry)
+{
+    temporary_file file;
+    cppbp::iovec_writer writer{file.fd(), 0};
+
+    const std::string text = "abcdefghij";
+    writer.write(cppbp::string_view{text.data(), 4});
+    writer.write(cppbp::string_view{text.data() + 4, 6});
+    EXPECT_EQ(writer.piece_count(), 1u);
+    writer.flush();
+    EXPECT_EQ(file.contents(), text);
+}
+
+TEST(iovec_writer_test, more_pieces_than_iov_max)
+{
+    temporary_file file;
+    cppbp::iovec_writer writer{file.fd(), 0};
+
+    std::vector<std::string> pieces;
+    std::string expected;
+    for(int i = 0; i < 5000; ++i) {
+        pieces.push_back(std::to_string(i) + ";");
+        expected += pieces.back();
+    }
+    for(const auto &piece : pieces) {
+        writer.write(cppbp::span<const char>{piece});
+    }
+    EXPECT_EQ(writer.piece_count(), pieces.size());
+    writer.flush();
+    EXPECT_EQ(file.contents(), expected);
+}
+
+TEST(iovec_writer_test, full_buffer_flushes)
+{
+    temporary_file file;
+    cppbp::iovec_writer writer{file.fd()};
+
+    std::string expected;
+    for(int i = 0; i < 1000; ++i) {
+        const std::string piece = "line " + std::to_string(i) + "\n";
+        writer.write(cppbp::string_view{piece.data(), piece.size()});
+        expected += piece;
+    }
+    writer.flush();
+    EXPECT_EQ(file.contents(), expected);
+}
+
+TEST(iovec_writer_test, writes_cord_chunks)
+{
+    temporary_file file;
+    cppbp::iovec_writer writer{file.fd(), 0};
+
+    cppbp::cord response{"head|"sv};
+    response.append("body|"sv).append(std::string("tail"));
+    writer.write(response);
+    EXPECT_EQ(writer.piece_count(), 3u);
+    writer.flush();
+    EXPECT_EQ(file.contents(), "head|body|tail");
+}
+
+TEST(iovec_writer_test, write_error_throws)
+{
+    cppbp::iovec_writer writer{-1};
+    writer << "data"sv;
+    EXPECT_THROW(writer.flush(), std::system_error);
+    EXPECT_EQ(writer.pending(), 4u);
+}
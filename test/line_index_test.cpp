@@ -0,0 +1,140 @@
+#include <cppbp/line_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+std::vector<std::string> split_lines(const std::string &text)
+{
+    std::vector<std::string> lines;
+    std::size_t begin = 0;
+    while(begin < text.size()) {
+        std::size_t end = text.find('\n', begin);
+        if(end == std::string::npos) {
+            end = text.size();
+        }
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return lines;
+}
+
+void expect_lines(const cppbp::line_index &index, const std::string &text)
+{
+    const std::vector<std::string> expected = split_lines(text);
+    ASSERT_EQ(index.size(), expected.size());
+    for(std::size_t n = 0; n < expected.size(); ++n) {
+        const cppbp::string_view line = index.line(n);
+        ASSERT_EQ(std::string(line.data(), line.size()), expected[n]) << n;
+    }
+}
+
+std::string random_text(std::size_t size, std::size_t average_line, std::uint32_t seed)
+{
+    std::mt19937 random{seed};
+    std::string text(size, 'x');
+    for(auto &c : text) {
+        c = random() % average_line == 0 ? '\n' : static_cast<char>('a' + random() % 26);
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(line_index_test, small_texts)
+{
+    EXPECT_EQ(cppbp::line_index{}.size(), 0u);
+    EXPECT_EQ(cppbp::line_index{""sv}.size(), 0u);
+    for(const char *text : {"a", "\n", "a\nb", "a\nb\n", "\n\n\n", "first line\n\nthird\n"}) {
+        expect_lines(cppbp::line_index{cppbp::string_view{text}}, text);
+    }
+
+    const cppbp::line_index index{"ab\ncd\n\nef"sv};
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_EQ(index.line(3), "ef"sv);
+    EXPECT_EQ(index.line_start(1), 3u);
+    EXPECT_EQ(index.line_start(4), 9u);
+    EXPECT_EQ(index.newline(2), 6u);
+    EXPECT_THROW(index.at(4), std::out_of_range);
+}
+
+TEST(line_index_test, line_number)
+{
+    const std::string text = random_text(5000, 7, 1);
+    const cppbp::line_index index{cppbp::string_view{text.data(), text.size()}};
+    std::size_t line = 0;
+    for(std::size_t offset = 0; offset < text.size(); ++offset) {
+        ASSERT_EQ(index.line_number(offset), line) << offset;
+        if(text[offset] == '\n') {
+            ++line;
+        }
+    }
+    EXPECT_EQ(index.line_number(text.size()), line);
+}
+
+TEST(line_index_test, line_lengths)
+{
+    // Short lines give no low bits, long lines many.
+    for(const std::size_t average : {1u, 2u, 30u, 1000u, 100000u}) {
+        const std::string text = random_text(300000, average, static_cast<std::uint32_t>(average));
+        expect_lines(cppbp::line_index{cppbp::string_view{text.data(), text.size()}}, text);
+    }
+}
+
+TEST(line_index_test, parallel_build)
+{
+    // Chunks share the words at their ends with the neighbours, whether the lines are short
+    // (no low bits, dense high bits) or longer than a chunk (chunks without newlines).
+    cppbp::thread_pool pool{3};
+    for(const std::size_t average : {1u, 50u, 3000000u}) {
+        const std::string text = random_text(3 * cppbp::detail::line_index_chunk + 777, average, 9);
+        const cppbp::string_view view{text.data(), text.size()};
+        const cppbp::line_index sequential{view};
+        const cppbp::line_index parallel{view, pool};
+        EXPECT_EQ(parallel.size(), sequential.size());
+        EXPECT_EQ(parallel.serialize(), sequential.serialize());
+        expect_lines(parallel, text);
+    }
+}
+
+TEST(line_index_test, serialization)
+{
+    const std::string text = random_text(20000, 40, 4);
+    const cppbp::string_view view{text.data(), text.size()};
+    const cppbp::line_index index{view};
+    const std::vector<unsigned char> bytes = index.serialize();
+    EXPECT_EQ(bytes.size(), index.serialized_size());
+
+    std::vector<std::uint64_t> aligned((bytes.size() + 7) / 8);
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    const cppbp::line_index borrowed = cppbp::line_index::borrow(
+        cppbp::span<const unsigned char>{reinterpret_cast<const unsigned char*>(aligned.data()), bytes.size()}, view);
+    expect_lines(borrowed, text);
+
+    const cppbp::line_index copy = cppbp::line_index::deserialize(
+        cppbp::span<const unsigned char>{bytes.data(), bytes.size()}, view);
+    expect_lines(copy, text);
+
+    EXPECT_THROW(cppbp::line_index::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size()},
+                                                view.substr(1)), std::invalid_argument);
+    EXPECT_THROW(cppbp::line_index::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size() - 8},
+                                                view), std::invalid_argument);
+    std::vector<unsigned char> corrupt = bytes;
+    corrupt[0] = 'X';
+    EXPECT_THROW(cppbp::line_index::deserialize(cppbp::span<const unsigned char>{corrupt.data(), corrupt.size()},
+                                                view), std::invalid_argument);
+
+    const cppbp::line_index empty;
+    const std::vector<unsigned char> empty_bytes = empty.serialize();
+    EXPECT_EQ(cppbp::line_index::deserialize(cppbp::span<const unsigned char>{empty_bytes.data(), empty_bytes.size()},
+                                             cppbp::string_view{}).size(), 0u);
+}
@@ -0,0 +1,127 @@
+#include <cppbp/line_reader.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace cppbp::literals;
+
+namespace {
+
+// Hands out text at most chunk bytes per call.
+cppbp::line_reader::read_function chunked(const std::string &text, std::size_t chunk)
+{
+    std::size_t pos = 0;
+    return [=](char *data, std::size_t size) mutable {
+        const std::size_t n = std::min(std::min(size, chunk), text.size() - pos);
+        std::memcpy(data, text.data() + pos, n);
+        pos += n;
+        return n;
+    };
+}
+
+std::vector<std::string> read_all(cppbp::line_reader &reader)
+{
+    std::vector<std::string> lines;
+    reader.for_each([&](cppbp::string_view line) {
+        lines.emplace_back(line.data(), line.size());
+    });
+    return lines;
+}
+
+} // namespace
+
+TEST(line_reader_test, splits_lines)
+{
+    cppbp::line_reader reader{chunked("first\n\nthird\nlast without newline", 1000)};
+    cppbp::string_view line;
+    ASSERT_TRUE(reader.next(line));
+    EXPECT_EQ(line, "first"sv);
+    ASSERT_TRUE(reader.next(line));
+    EXPECT_EQ(line, ""sv);
+    ASSERT_TRUE(reader.next(line));
+    EXPECT_EQ(line, "third"sv);
+    ASSERT_TRUE(reader.next(line));
+    EXPECT_EQ(line, "last without newline"sv);
+    EXPECT_FALSE(reader.next(line));
+    EXPECT_FALSE(reader.next(line));
+    EXPECT_EQ(reader.line_count(), 4u);
+}
+
+TEST(line_reader_test, empty_input)
+{
+    cppbp::line_reader reader{chunked("", 10)};
+    cppbp::string_view line;
+    EXPECT_FALSE(reader.next(line));
+
+    cppbp::line_reader newline_only{chunked("\n", 10)};
+    EXPECT_EQ(read_all(newline_only), std::vector<std::string>{""});
+}
+
+TEST(line_reader_test, lines_spanning_refills)
+{
+    std::string text;
+    std::vector<std::string> expected;
+    for(int i = 0; i < 500; ++i) {
+        expected.push_back(std::string(static_cast<std::size_t>(i % 37), static_cast<char>('a' + i % 26)));
+        text += expected.back() + "\n";
+    }
+    // Small buffers force compaction and growth; small reads split lines everywhere.
+    for(const std::size_t buffer : {1u, 7u, 64u, 4096u}) {
+        for(const std::size_t chunk : {1u, 3u, 100u}) {
+            cppbp::line_reader reader{chunked(text, chunk), buffer};
+            EXPECT_EQ(read_all(reader), expected) << buffer << " " << chunk;
+        }
+    }
+}
+
+TEST(line_reader_test, max_line)
+{
+    cppbp::line_reader fits{chunked("12345\n123\n", 2), 4, 5};
+    EXPECT_EQ(read_all(fits), (std::vector<std::string>{"12345", "123"}));
+
+    cppbp::line_reader too_long{chunked("123\n123456\n", 2), 4, 5};
+    cppbp::string_view line;
+    ASSERT_TRUE(too_long.next(line));
+    EXPECT_THROW(too_long.next(line), std::length_error);
+
+    cppbp::line_reader last_too_long{chunked("123456", 100), 100, 5};
+    EXPECT_THROW(last_too_long.next(line), std::length_error);
+
+    const std::string long_line(1000, 'x');
+    cppbp::line_reader unlimited{chunked(long_line + "\nend", 7), 4, std::numeric_limits<std::size_t>::max()};
+    EXPECT_EQ(read_all(unlimited), (std::vector<std::string>{long_line, "end"}));
+
+    EXPECT_THROW(cppbp::line_reader(chunked("", 1), 0), std::invalid_argument);
+}
+
+TEST(line_reader_test, reads_pipe)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    std::thread writer{[&] {
+        for(int i = 0; i < 10000; ++i) {
+            const std::string line = "line " + std::to_string(i) + "\n";
+            ASSERT_EQ(::write(fds[1], line.data(), line.size()), static_cast<::ssize_t>(line.size()));
+        }
+        ::close(fds[1]);
+    }};
+
+    cppbp::line_reader reader{fds[0], 1000};
+    int count = 0;
+    reader.for_each([&](cppbp::string_view line) {
+        EXPECT_EQ(std::string(line.data(), line.size()), "line " + std::to_string(count));
+        ++count;
+    });
+    writer.join();
+    ::close(fds[0]);
+    EXPECT_EQ(count, 10000);
+}
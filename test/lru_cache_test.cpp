@@ -0,0 +1,144 @@
+#include <cppbp/lru_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(lru_cache_test, evicts_least_recently_used)
+{
+    cppbp::lru_cache<int> cache{3};
+    EXPECT_THROW(cppbp::lru_cache<int>{0}, std::invalid_argument);
+
+    cache.put("a"sv, 1);
+    cache.put("b"sv, 2);
+    cache.put("c"sv, 3);
+
+    int value = 0;
+    EXPECT_TRUE(cache.get("a"sv, value));
+    EXPECT_EQ(value, 1);
+
+    cache.put("d"sv, 4);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_FALSE(cache.contains("b"sv));
+    EXPECT_TRUE(cache.contains("a"sv));
+
+    cache.put("c"sv, 30);
+    cache.put("e"sv, 5);
+    EXPECT_FALSE(cache.contains("a"sv));
+    EXPECT_TRUE(cache.get("c"sv, value));
+    EXPECT_EQ(value, 30);
+
+    EXPECT_TRUE(cache.erase("c"sv));
+    EXPECT_FALSE(cache.erase("c"sv));
+    EXPECT_EQ(cache.size(), 2u);
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    cache.put("f"sv, 6);
+    EXPECT_TRUE(cache.get("f"sv, value));
+}
+
+TEST(lru_cache_test, byte_capacity)
+{
+    cppbp::lru_cache<std::string> cache{100, 64};
+    cache.put("one"sv, "x", 20);
+    cache.put("two"sv, "y", 20);
+    EXPECT_EQ(cache.bytes(), 46u);
+
+    cache.put("three"sv, "z", 20);
+    EXPECT_FALSE(cache.contains("one"sv));
+    EXPECT_EQ(cache.bytes(), 48u);
+
+    // Larger than the whole cache: not stored, and an older value of the key is dropped.
+    cache.put("two"sv, "huge", 100);
+    EXPECT_FALSE(cache.contains("two"sv));
+    EXPECT_EQ(cache.size(), 1u);
+
+    std::string seen;
+    EXPECT_TRUE(cache.visit("three"sv, [&](const std::string &v) { seen = v; }));
+    EXPECT_EQ(seen, "z");
+}
+
+TEST(lru_cache_test, releases_values)
+{
+    auto tracked = std::make_shared<int>(7);
+    {
+        cppbp::lru_cache<std::shared_ptr<int>> cache{2};
+        cache.put("a"sv, tracked);
+        cache.put("b"sv, tracked);
+        cache.put("c"sv, tracked);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(lru_cache_test, clock_second_chance)
+{
+    cppbp::clock_cache<int> cache{3};
+    cache.put("a"sv, 1);
+    cache.put("b"sv, 2);
+    cache.put("c"sv, 3);
+
+    int value = 0;
+    EXPECT_TRUE(cache.get("a"sv, value));
+    cache.put("d"sv, 4);
+    EXPECT_TRUE(cache.contains("a"sv));
+    EXPECT_FALSE(cache.contains("b"sv));
+    EXPECT_TRUE(cache.contains("d"sv));
+
+    for(int i = 0; i < 1000; ++i) {
+        const std::string key = std::to_string(i);
+        cache.put(cppbp::string_view{key.data(), key.size()}, i);
+        EXPECT_LE(cache.size(), 3u);
+    }
+    EXPECT_TRUE(cache.get("999"sv, value));
+    EXPECT_EQ(value, 999);
+}
+
+TEST(lru_cache_test, sharded_concurrent)
+{
+    cppbp::concurrent_lru_cache<int> lru{1024, 0, 8};
+    cppbp::concurrent_clock_cache<int> clock{1024, 0, 8};
+    EXPECT_EQ(lru.shard_count(), 8u);
+
+    std::vector<std::string> keys;
+    for(int i = 0; i < 4096; ++i) {
+        keys.push_back("/api/v1/items/" + std::to_string(i));
+    }
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for(int round = 0; round < 5; ++round) {
+                for(std::size_t i = static_cast<std::size_t>(t); i < keys.size(); i += 3) {
+                    const cppbp::string_view key{keys[i].data(), keys[i].size()};
+                    int value;
+                    if(!lru.get(key, value)) {
+                        lru.put(key, static_cast<int>(i));
+                    } else {
+                        EXPECT_EQ(value, static_cast<int>(i));
+                    }
+                    if(!clock.get(key, value)) {
+                        clock.put(key, static_cast<int>(i));
+                    }
+                }
+            }
+        });
+    }
+    for(auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(lru.size(), 1024u);
+    EXPECT_LE(clock.size(), 1024u);
+    EXPECT_GT(lru.size(), 0u);
+
+    lru.put("/x"sv, 1);
+    EXPECT_TRUE(lru.erase("/x"sv));
+    lru.clear();
+    EXPECT_EQ(lru.size(), 0u);
+}
@@ -0,0 +1,122 @@
+#include <cppbp/mphf.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+std::vector<std::string> make_keys(std::size_t count)
+{
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        keys.push_back("key-" + std::to_string(i * 7919));
+    }
+    return keys;
+}
+
+std::vector<cppbp::string_view> views_of(const std::vector<std::string> &keys)
+{
+    std::vector<cppbp::string_view> views;
+    for(const auto &key : keys) {
+        views.emplace_back(key.data(), key.size());
+    }
+    return views;
+}
+
+// Every key maps to its own index in [0, n).
+void expect_minimal_perfect(const cppbp::mphf &f, const std::vector<cppbp::string_view> &keys)
+{
+    ASSERT_EQ(f.size(), keys.size());
+    std::vector<bool> seen(keys.size(), false);
+    for(const auto key : keys) {
+        const std::size_t index = f(key);
+        ASSERT_LT(index, keys.size());
+        ASSERT_FALSE(seen[index]);
+        seen[index] = true;
+    }
+}
+
+} // namespace
+
+TEST(mphf_test, small_sets)
+{
+    const cppbp::mphf empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty("x"sv), 0u);
+
+    for(const std::size_t n : {std::size_t{1}, std::size_t{2}, std::size_t{3}, std::size_t{100}}) {
+        const std::vector<std::string> keys = make_keys(n);
+        const std::vector<cppbp::string_view> views = views_of(keys);
+        const cppbp::mphf f{cppbp::span<const cppbp::string_view>{views.data(), views.size()}};
+        expect_minimal_perfect(f, views);
+    }
+}
+
+TEST(mphf_test, parallel_build_matches_sequential)
+{
+    const std::vector<std::string> keys = make_keys(250000);
+    const std::vector<cppbp::string_view> views = views_of(keys);
+    const cppbp::span<const cppbp::string_view> span{views.data(), views.size()};
+
+    cppbp::thread_pool pool{3};
+    const cppbp::mphf parallel{span, pool};
+    const cppbp::mphf sequential{span};
+    expect_minimal_perfect(parallel, views);
+    EXPECT_LT(parallel.bits_per_key(), 8.0);
+    for(const auto key : views) {
+        ASSERT_EQ(parallel(key), sequential(key));
+    }
+}
+
+TEST(mphf_test, rejects_duplicates)
+{
+    const std::vector<cppbp::string_view> views = {"a"sv, "b"sv, "a"sv};
+    EXPECT_THROW(cppbp::mphf{cppbp::span<const cppbp::string_view>(views.data(), views.size())}, std::invalid_argument);
+}
+
+TEST(mphf_test, serialize_and_borrow)
+{
+    const std::vector<std::string> keys = make_keys(5000);
+    const std::vector<cppbp::string_view> views = views_of(keys);
+    const cppbp::mphf f{cppbp::span<const cppbp::string_view>{views.data(), views.size()}, 42};
+    const std::vector<unsigned char> bytes = f.serialize();
+    EXPECT_EQ(bytes.size(), f.serialized_size());
+
+    const cppbp::mphf borrowed = cppbp::mphf::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    const cppbp::mphf copy = cppbp::mphf::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    for(const auto key : views) {
+        ASSERT_EQ(borrowed(key), f(key));
+        ASSERT_EQ(copy(key), f(key));
+    }
+
+    EXPECT_THROW(cppbp::mphf::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size() - 8}), std::invalid_argument);
+    std::vector<unsigned char> corrupt = bytes;
+    corrupt[1] = 'X';
+    EXPECT_THROW(cppbp::mphf::borrow(cppbp::span<const unsigned char>{corrupt.data(), corrupt.size()}), std::invalid_argument);
+
+    // One partition after the header: an offset that wraps the bounds check, and a remapped slot
+    // outside of the partition's keys.
+    std::uint64_t pilots;
+    std::uint64_t free;
+    std::memcpy(&pilots, bytes.data() + 32, 8);
+    std::memcpy(&free, bytes.data() + 40, 8);
+    ASSERT_GT(free, 0u);
+    const auto patched = [&](std::size_t offset, std::uint64_t value, std::size_t size) {
+        std::vector<unsigned char> result = bytes;
+        std::memcpy(result.data() + offset, &value, size);
+        return result;
+    };
+    const std::size_t free_offset = 48 + 40 + static_cast<std::size_t>((pilots * 2 + 7) / 8 * 8);
+    for(const auto &bad : {patched(56, ~std::uint64_t{0}, 8), patched(64, ~std::uint64_t{0}, 8),
+                           patched(free_offset + 4 * static_cast<std::size_t>(free - 1), 5000, 4)}) {
+        EXPECT_THROW(cppbp::mphf::borrow(cppbp::span<const unsigned char>{bad.data(), bad.size()}), std::invalid_argument);
+    }
+}
@@ -0,0 +1,113 @@
+#include <cppbp/multi_searcher.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+using match = cppbp::multi_searcher::match;
+
+// Every occurrence by trying each pattern at each position.
+std::vector<match> naive_find_all(const std::string &text, const std::vector<std::string> &patterns)
+{
+    std::vector<match> result;
+    for(std::size_t pos = 0; pos < text.size(); ++pos) {
+        for(std::size_t p = 0; p < patterns.size(); ++p) {
+            if(text.compare(pos, patterns[p].size(), patterns[p]) == 0) {
+                result.push_back(match{pos, p});
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<cppbp::string_view> views(const std::vector<std::string> &strings)
+{
+    std::vector<cppbp::string_view> result;
+    for(const auto &s : strings) {
+        result.emplace_back(s.data(), s.size());
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(multi_searcher_test, classic_example)
+{
+    const cppbp::multi_searcher searcher{{"he"sv, "she"sv, "his"sv, "hers"sv}};
+    EXPECT_EQ(searcher.pattern_count(), 4u);
+    EXPECT_EQ(searcher.max_pattern_length(), 4u);
+    EXPECT_EQ(searcher.pattern_length(1), 3u);
+    std::vector<match> found;
+    searcher.for_each_match("ushers"sv, [&](match m) { found.push_back(m); });
+    // Ordered by end: "she" and "he" end together, the longer first.
+    EXPECT_EQ(found, (std::vector<match>{{1, 1}, {2, 0}, {2, 3}}));
+    EXPECT_EQ(searcher.find_all("ushers"sv), (std::vector<match>{{1, 1}, {2, 0}, {2, 3}}));
+    EXPECT_TRUE(searcher.find_all("xyz"sv).empty());
+    EXPECT_TRUE(searcher.find_all(""sv).empty());
+}
+
+TEST(multi_searcher_test, duplicates_and_nested_patterns)
+{
+    const cppbp::multi_searcher searcher{{"a"sv, "aa"sv, "a"sv, "aaa"sv}};
+    EXPECT_EQ(searcher.find_all("aaa"sv),
+              (std::vector<match>{{0, 0}, {0, 1}, {0, 2}, {0, 3}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 2}}));
+}
+
+TEST(multi_searcher_test, matches_naive_search)
+{
+    std::mt19937 random{3};
+    for(int round = 0; round < 20; ++round) {
+        std::vector<std::string> patterns;
+        for(int p = 0; p < 1 + round; ++p) {
+            std::string pattern;
+            const int length = 1 + static_cast<int>(random() % 5);
+            for(int i = 0; i < length; ++i) {
+                pattern += static_cast<char>('a' + random() % 3);
+            }
+            patterns.push_back(pattern);
+        }
+        std::string text;
+        for(int i = 0; i < 2000; ++i) {
+            text += static_cast<char>('a' + random() % 3);
+        }
+        const cppbp::multi_searcher searcher{views(patterns)};
+        EXPECT_EQ(searcher.find_all(cppbp::string_view{text.data(), text.size()}), naive_find_all(text, patterns));
+    }
+}
+
+TEST(multi_searcher_test, scan_across_chunks)
+{
+    const cppbp::multi_searcher searcher{{"needle"sv, "ee"sv}};
+    const std::string text = "hayneedlehayneedle";
+    std::vector<std::size_t> ends;
+    auto state = searcher.start();
+    std::size_t offset = 0;
+    for(const std::size_t split : {5u, 6u, 13u, 18u}) {
+        const cppbp::string_view chunk{text.data() + offset, split - offset};
+        state = searcher.scan(state, chunk, [&](std::size_t end, std::size_t) { ends.push_back(offset + end); });
+        offset = split;
+    }
+    EXPECT_EQ(ends, (std::vector<std::size_t>{6, 9, 15, 18}));
+}
+
+TEST(multi_searcher_test, binary_patterns)
+{
+    const std::string zero("\0\xff", 2);
+    const cppbp::multi_searcher searcher{{cppbp::string_view{zero.data(), zero.size()}}};
+    const std::string text("a\0\xff\0\xff", 5);
+    EXPECT_EQ(searcher.find_all(cppbp::string_view{text.data(), text.size()}), (std::vector<match>{{1, 0}, {3, 0}}));
+}
+
+TEST(multi_searcher_test, rejects_empty_patterns)
+{
+    EXPECT_THROW(cppbp::multi_searcher({"a"sv, ""sv}), std::invalid_argument);
+    const cppbp::multi_searcher none{{}};
+    EXPECT_TRUE(none.find_all("abc"sv).empty());
+}
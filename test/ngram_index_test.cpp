@@ -0,0 +1,120 @@
+#include <cppbp/ngram_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+using ids = std::vector<cppbp::ngram_index::document_id>;
+
+TEST(ngram_index_test, count_less)
+{
+    std::vector<std::uint32_t> values;
+    for(std::uint32_t i = 0; i < 37; ++i) {
+        values.push_back(i * 3 + (i > 30 ? 0x80000000u : 0));
+    }
+    for(const std::uint32_t x : {0u, 1u, 3u, 50u, 90u, 0x80000000u, 0x80000060u, 0xffffffffu}) {
+        std::size_t expected = 0;
+        for(const std::uint32_t v : values) {
+            expected += v < x ? 1 : 0;
+        }
+        EXPECT_EQ(cppbp::detail::count_less(values.data(), values.size(), x), expected) << x;
+    }
+}
+
+TEST(ngram_index_test, posting_list_round_trip)
+{
+    cppbp::detail::posting_list list;
+    std::vector<std::uint32_t> expected;
+    std::uint32_t id = 5;
+    for(int i = 0; i < 1000; ++i) {
+        id += 1 + (i % 7 == 0 ? 100000 : i % 3);
+        list.push_back(id);
+        expected.push_back(id);
+    }
+    EXPECT_EQ(list.size(), expected.size());
+    EXPECT_EQ(list.block_count(), 8u);
+    EXPECT_EQ(list.decode_all(), expected);
+}
+
+TEST(ngram_index_test, search)
+{
+    cppbp::ngram_index index;
+    const auto phone = index.add("Acme Smart Phone X200"sv);
+    const auto case_ = index.add("Phone case for X200"sv);
+    const auto lamp = index.add("Desk lamp"sv);
+    const auto empty = index.add(""sv);
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_TRUE(index.document(lamp) == "Desk lamp"sv);
+
+    EXPECT_EQ(index.search("X200"sv), (ids{phone, case_}));
+    EXPECT_EQ(index.search("Phone"sv), (ids{phone, case_}));
+    EXPECT_EQ(index.search("hone X"sv), (ids{phone}));
+    EXPECT_EQ(index.search("lamp"sv), (ids{lamp}));
+    EXPECT_TRUE(index.search("Tablet"sv).empty());
+    // 3-grams all present, but not as one substring.
+    EXPECT_TRUE(index.search("X200 Phone"sv).empty());
+    EXPECT_EQ(index.search("e"sv), (ids{phone, case_, lamp}));
+    EXPECT_EQ(index.search(""sv), (ids{phone, case_, lamp, empty}));
+}
+
+TEST(ngram_index_test, remove_and_compact)
+{
+    cppbp::ngram_index index;
+    const auto a = index.add("red apple"sv);
+    const auto b = index.add("green apple"sv);
+    EXPECT_TRUE(index.remove(a));
+    EXPECT_FALSE(index.remove(a));
+    EXPECT_FALSE(index.remove(42));
+    EXPECT_FALSE(index.has_document(a));
+    EXPECT_THROW(index.document(a), std::out_of_range);
+    EXPECT_EQ(index.search("apple"sv), (ids{b}));
+    EXPECT_TRUE(index.search("red"sv).empty());
+
+    const std::size_t before = index.memory_usage().postings;
+    index.compact();
+    EXPECT_LT(index.memory_usage().postings, before);
+    EXPECT_EQ(index.search("apple"sv), (ids{b}));
+    const auto c = index.add("apple pie"sv);
+    EXPECT_EQ(index.search("apple"sv), (ids{b, c}));
+}
+
+TEST(ngram_index_test, random_documents_match_naive_search)
+{
+    std::mt19937_64 random{9};
+    cppbp::ngram_index index;
+    std::vector<std::string> documents;
+    for(int i = 0; i < 3000; ++i) {
+        std::string text(5 + random() % 40, '\0');
+        for(auto &c : text) {
+            c = static_cast<char>('a' + random() % 5);
+        }
+        index.add(cppbp::string_view{text.data(), text.size()});
+        documents.push_back(text);
+    }
+    for(int i = 0; i < 3000; i += 2) {
+        index.remove(static_cast<cppbp::ngram_index::document_id>(i));
+        documents[i].clear();
+    }
+    EXPECT_EQ(index.size(), 1500u);
+    EXPECT_GT(index.memory_usage().documents, 0u);
+
+    for(int q = 0; q < 200; ++q) {
+        std::string pattern(1 + random() % 7, '\0');
+        for(auto &c : pattern) {
+            c = static_cast<char>('a' + random() % 5);
+        }
+        ids expected;
+        for(std::size_t d = 1; d < documents.size(); d += 2) {
+            if(documents[d].find(pattern) != std::string::npos) {
+                expected.push_back(static_cast<cppbp::ngram_index::document_id>(d));
+            }
+        }
+        ASSERT_EQ(index.search(cppbp::string_view{pattern.data(), pattern.size()}), expected) << pattern;
+    }
+}
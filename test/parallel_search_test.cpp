@@ -0,0 +1,91 @@
+#include <cppbp/parallel_search.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+constexpr std::size_t chunk = cppbp::detail::parallel_search_chunk;
+
+std::vector<std::size_t> sequential_find_all(cppbp::string_view haystack, cppbp::string_view needle,
+                                             cppbp::search_mode mode)
+{
+    std::vector<std::size_t> result;
+    for(const std::size_t pos : cppbp::find_all(haystack, needle, mode)) {
+        result.push_back(pos);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(parallel_search_test, matches_at_chunk_boundaries)
+{
+    cppbp::thread_pool pool{3};
+    const cppbp::string_view needle = "needle"sv;
+    // Copies ending at, straddling and starting at every chunk boundary.
+    for(const int offset : {-6, -5, -3, -1, 0, 1}) {
+        std::string text(3 * chunk + 100, 'x');
+        for(std::size_t c = 1; c <= 3; ++c) {
+            text.replace(static_cast<std::size_t>(static_cast<int>(c * chunk) + offset), needle.size(),
+                         needle.data(), needle.size());
+        }
+        const cppbp::string_view haystack{text.data(), text.size()};
+        const auto found = cppbp::parallel_find_all(haystack, needle, pool);
+        EXPECT_EQ(found.size(), 3u) << offset;
+        EXPECT_EQ(found, sequential_find_all(haystack, needle, cppbp::search_mode::non_overlapping)) << offset;
+    }
+}
+
+TEST(parallel_search_test, overlapping_and_non_overlapping)
+{
+    cppbp::thread_pool pool{4};
+    std::mt19937 random{5};
+    std::string text(2 * chunk + 12345, 'a');
+    for(auto &c : text) {
+        c = static_cast<char>('a' + random() % 2);
+    }
+    const cppbp::string_view haystack{text.data(), text.size()};
+    for(const cppbp::string_view needle : {"a"sv, "abab"sv, "aaaaaaa"sv, "babbab"sv}) {
+        for(const auto mode : {cppbp::search_mode::overlapping, cppbp::search_mode::non_overlapping}) {
+            EXPECT_EQ(cppbp::parallel_find_all(haystack, needle, pool, mode), sequential_find_all(haystack, needle, mode));
+        }
+    }
+}
+
+TEST(parallel_search_test, small_and_empty_inputs)
+{
+    cppbp::thread_pool pool{2};
+    EXPECT_TRUE(cppbp::parallel_find_all(""sv, "a"sv, pool).empty());
+    EXPECT_EQ(cppbp::parallel_find_all("abcabc"sv, "bc"sv, pool), (std::vector<std::size_t>{1, 4}));
+    EXPECT_EQ(cppbp::parallel_find_all("ab"sv, ""sv, pool), (std::vector<std::size_t>{0, 1, 2}));
+    EXPECT_TRUE(cppbp::parallel_find_all("ab"sv, "abc"sv, pool).empty());
+}
+
+TEST(parallel_search_test, multi_pattern)
+{
+    cppbp::thread_pool pool{3};
+    std::mt19937 random{8};
+    std::string text(2 * chunk + 999, 'a');
+    for(auto &c : text) {
+        c = static_cast<char>('a' + random() % 3);
+    }
+    const cppbp::string_view haystack{text.data(), text.size()};
+    const cppbp::multi_searcher searcher{{"abc"sv, "ca"sv, "bbbbbb"sv, "c"sv}};
+    const auto found = cppbp::parallel_find_all(haystack, searcher, pool);
+    EXPECT_EQ(found, searcher.find_all(haystack));
+
+    std::size_t streamed = 0;
+    cppbp::parallel_for_each_match(haystack, searcher, pool, [&](const cppbp::multi_searcher::match &m) {
+        ASSERT_LT(streamed, found.size());
+        EXPECT_EQ(m, found[streamed]);
+        ++streamed;
+    });
+    EXPECT_EQ(streamed, found.size());
+}
@@ -0,0 +1,168 @@
+#include <cppbp/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Chi-squared statistic of draws from uniform_below(g, bound) over its bound buckets.
+template<typename Generator>
+double chi_squared(Generator &g, std::uint64_t bound, std::size_t draws)
+{
+    std::vector<std::size_t> buckets(static_cast<std::size_t>(bound));
+    for(std::size_t i = 0; i < draws; ++i) {
+        ++buckets[static_cast<std::size_t>(cppbp::uniform_below(g, bound))];
+    }
+    const double expected = static_cast<double>(draws) / static_cast<double>(bound);
+    double result = 0;
+    for(const std::size_t count : buckets) {
+        const double d = static_cast<double>(count) - expected;
+        result += d * d / expected;
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(random_test, reference_sequences)
+{
+    // Published first outputs of xoshiro256** from the state {1, 2, 3, 4}.
+    cppbp::xoshiro256ss xoshiro{cppbp::xoshiro256ss::state_type{{1, 2, 3, 4}}};
+    EXPECT_EQ(xoshiro(), 11520u);
+    EXPECT_EQ(xoshiro(), 0u);
+    EXPECT_EQ(xoshiro(), 1509978240u);
+    EXPECT_EQ(xoshiro(), 1215971899390074240u);
+
+    // pcg32-demo, seed 42 and stream 54.
+    cppbp::pcg32 pcg{42, 54};
+    for(const std::uint32_t expected : {0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u, 0xbfa4784bu, 0xcbed606eu}) {
+        EXPECT_EQ(pcg(), expected);
+    }
+
+    EXPECT_THROW(cppbp::xoshiro256ss{cppbp::xoshiro256ss::state_type{}}, std::invalid_argument);
+}
+
+TEST(random_test, seeding_and_discard)
+{
+    cppbp::xoshiro256ss a{7};
+    cppbp::xoshiro256ss b{7};
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, cppbp::xoshiro256ss{8});
+    a.discard(5);
+    for(int i = 0; i < 5; ++i) {
+        b();
+    }
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a(), b());
+    EXPECT_EQ(cppbp::xoshiro256ss{a.state()}, a);
+
+    cppbp::wyrand c{3};
+    cppbp::wyrand d{3};
+    c.discard(1000);
+    for(int i = 0; i < 1000; ++i) {
+        d();
+    }
+    EXPECT_EQ(c, d);
+
+    cppbp::pcg32 e{1, 2};
+    cppbp::pcg32 f{1, 3};
+    EXPECT_NE(e, f);
+    EXPECT_NE(e(), f());
+}
+
+TEST(random_test, works_with_std)
+{
+    cppbp::wyrand g{11};
+    std::uniform_int_distribution<int> dice{1, 6};
+    for(int i = 0; i < 100; ++i) {
+        const int roll = dice(g);
+        EXPECT_GE(roll, 1);
+        EXPECT_LE(roll, 6);
+    }
+    std::vector<int> values(50);
+    std::iota(values.begin(), values.end(), 0);
+    cppbp::pcg32 h{5};
+    std::shuffle(values.begin(), values.end(), h);
+    EXPECT_FALSE(std::is_sorted(values.begin(), values.end()));
+
+    std::mt19937 mt{1};
+    EXPECT_LT(cppbp::uniform_below(mt, 10), 10u);
+}
+
+TEST(random_test, uniform_below)
+{
+    // 99.9 % quantile of chi-squared with bound - 1 degrees of freedom: 9 -> 27.9, 99 -> 148.2.
+    cppbp::xoshiro256ss x{1};
+    EXPECT_LT(chi_squared(x, 10, 100000), 27.9);
+    EXPECT_LT(chi_squared(x, 100, 100000), 148.2);
+    cppbp::pcg32 p{2};
+    EXPECT_LT(chi_squared(p, 10, 100000), 27.9);
+    EXPECT_LT(chi_squared(p, 100, 100000), 148.2);
+    cppbp::wyrand w{3};
+    EXPECT_LT(chi_squared(w, 100, 100000), 148.2);
+
+    // A bound just above 2^63 rejects almost half of the raw words; results stay below it.
+    const std::uint64_t big = (std::uint64_t{1} << 63) + 12345;
+    for(int i = 0; i < 1000; ++i) {
+        EXPECT_LT(cppbp::uniform_below(x, big), big);
+        EXPECT_LT(cppbp::uniform_below(p, big), big);
+    }
+    EXPECT_EQ(cppbp::uniform_below(x, 1), 0u);
+}
+
+TEST(random_test, uniform_int_and_real)
+{
+    cppbp::xoshiro256ss g{4};
+    bool seen_low = false;
+    bool seen_high = false;
+    for(int i = 0; i < 10000; ++i) {
+        const int v = cppbp::uniform_int(g, -3, 3);
+        ASSERT_GE(v, -3);
+        ASSERT_LE(v, 3);
+        seen_low |= v == -3;
+        seen_high |= v == 3;
+
+        const std::int8_t b = cppbp::uniform_int<std::int8_t>(g, -128, 127);
+        ASSERT_GE(b, -128);
+
+        const double d = cppbp::uniform_double(g);
+        ASSERT_GE(d, 0.0);
+        ASSERT_LT(d, 1.0);
+        const float f = cppbp::uniform_float(g);
+        ASSERT_GE(f, 0.0f);
+        ASSERT_LT(f, 1.0f);
+    }
+    EXPECT_TRUE(seen_low);
+    EXPECT_TRUE(seen_high);
+    cppbp::uniform_int(g, std::uint64_t{0}, ~std::uint64_t{0});
+}
+
+TEST(random_test, bulk_fill_matches_streams)
+{
+    std::vector<cppbp::xoshiro256ss> streams{cppbp::xoshiro256ss{9}};
+    while(streams.size() < 4) {
+        streams.push_back(streams.back());
+        streams.back().jump();
+    }
+
+    cppbp::xoshiro256ss_x4 bulk{9};
+    std::vector<std::uint64_t> out(1001);
+    bulk.fill(cppbp::span<std::uint64_t>{out.data(), 400});
+    bulk.fill(cppbp::span<std::uint64_t>{out.data() + 400, 601});
+    for(std::size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(out[i], streams[i % 4]()) << i;
+    }
+    EXPECT_EQ(out[1000], streams[0]());
+
+    // The rest of the last step is dropped.
+    std::vector<std::uint64_t> next(4);
+    bulk.fill(cppbp::span<std::uint64_t>{next.data(), next.size()});
+    streams[1]();
+    EXPECT_EQ(next[1], streams[1]());
+}
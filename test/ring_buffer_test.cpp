@@ -0,0 +1,246 @@
+#include <cppbp/ring_buffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(ring_buffer_test, spsc_single_thread)
+{
+    cppbp::spsc_ring<int> ring{3};
+    EXPECT_EQ(ring.capacity(), 4u);
+    EXPECT_TRUE(ring.empty());
+
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+    EXPECT_EQ(ring.size(), 4u);
+
+    int value = -1;
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+
+    int batch[8] = {};
+    EXPECT_EQ(ring.try_pop_batch(batch, 8), 3u);
+    EXPECT_EQ(batch[2], 3);
+    EXPECT_FALSE(ring.try_pop(value));
+
+    const int values[] = {10, 11, 12, 13, 14, 15};
+    EXPECT_EQ(ring.try_push_batch(values, 6), 4u);
+    EXPECT_EQ(ring.try_pop_batch(batch, 2), 2u);
+    EXPECT_EQ(batch[1], 11);
+}
+
+TEST(ring_buffer_test, spsc_destroys_remaining_elements)
+{
+    auto tracked = std::make_shared<int>(1);
+    {
+        cppbp::spsc_ring<std::shared_ptr<int>> ring{8};
+        ring.try_push(tracked);
+        ring.try_push(tracked);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(ring_buffer_test, spsc_two_threads)
+{
+    constexpr int count = 200000;
+    cppbp::spsc_ring<cppbp::string_view> ring{64};
+    const char *text = "0123456789";
+
+    std::thread producer([&]() {
+        for(int i = 0; i < count; ++i) {
+            ring.push(cppbp::string_view{text, static_cast<std::size_t>(i % 10)});
+        }
+    });
+
+    bool in_order = true;
+    for(int i = 0; i < count; ++i) {
+        cppbp::string_view record;
+        ring.pop(record);
+        in_order = in_order && record.size() == static_cast<std::size_t>(i % 10);
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ring_buffer_test, mpmc_many_threads)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr long per_producer = 50000;
+    cppbp::mpmc_ring<long> ring{128};
+
+    std::atomic<long> sum{0};
+    std::atomic<long> received{0};
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ring]() {
+            for(long i = 1; i <= per_producer; ++i) {
+                ring.push(i);
+            }
+        });
+    }
+    for(int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            long local = 0;
+            long values[16];
+            while(received.load() < producers * per_producer) {
+                const auto n = ring.try_pop_batch(values, 16);
+                for(std::size_t i = 0; i < n; ++i) {
+                    local += values[i];
+                }
+                received += static_cast<long>(n);
+                if(n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            sum += local;
+        });
+    }
+    for(auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(sum.load(), producers * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ring_buffer_test, mpmc_blocking_pop)
+{
+    cppbp::mpmc_ring<std::string> ring{2};
+    std::string result;
+    std::thread consumer([&]() {
+        ring.pop(result);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring.push(std::string("wake up"));
+    consumer.join();
+    EXPECT_EQ(result, "wake up");
+}
+
+TEST(ring_buffer_test, mpmc_batches)
+{
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    constexpr long per_producer = 30000;
+    cppbp::mpmc_ring<long> ring{64};
+
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    std::atomic<long> received{0};
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ring, p]() {
+            long values[7];
+            for(long next = 0; next < per_producer;) {
+                const long n = per_producer - next < 7 ? per_producer - next : 7;
+                for(long i = 0; i < n; ++i) {
+                    values[i] = p * per_producer + next + i;
+                }
+                const auto pushed = ring.try_push_batch(values, static_cast<std::size_t>(n));
+                next += static_cast<long>(pushed);
+                if(pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            long values[5];
+            while(received.load() < producers * per_producer) {
+                const auto n = ring.try_pop_batch(values, 5);
+                for(std::size_t i = 0; i < n; ++i) {
+                    ++seen[static_cast<std::size_t>(values[i])];
+                }
+                received += static_cast<long>(n);
+                if(n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(auto &thread : threads) {
+        thread.join();
+    }
+    for(const auto &count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ring_buffer_test, blocking_pop_wakes_on_try_push)
+{
+    // try_push() does not fence before looking for sleepers; a missed one wakes on its timeout.
+    cppbp::spsc_ring<int> ring{4};
+    for(int round = 0; round < 200; ++round) {
+        int result = 0;
+        std::thread consumer([&]() {
+            ring.pop(result);
+        });
+        while(!ring.try_push(round + 1)) {
+        }
+        consumer.join();
+        EXPECT_EQ(result, round + 1);
+    }
+}
+
+TEST(ring_buffer_test, byte_ring_records)
+{
+    cppbp::spsc_byte_ring ring{64};
+    EXPECT_EQ(ring.max_record_size(), 28u);
+    EXPECT_THROW(ring.try_push(cppbp::string_view{"this record is far too long to fit"}), std::length_error);
+
+    cppbp::string_view record;
+    EXPECT_FALSE(ring.try_front(record));
+
+    // Forces records to skip the end of the buffer repeatedly.
+    for(int round = 0; round < 20; ++round) {
+        const std::string first(static_cast<std::size_t>(round % 7 + 5), static_cast<char>('a' + round % 26));
+        const std::string second(static_cast<std::size_t>(round % 11 + 1), 'z');
+        ASSERT_TRUE(ring.try_push(cppbp::string_view{first.data(), first.size()}));
+        ASSERT_TRUE(ring.try_push(cppbp::string_view{second.data(), second.size()}));
+
+        ASSERT_TRUE(ring.try_front(record));
+        EXPECT_EQ(std::string(record.data(), record.size()), first);
+        ring.pop();
+        ASSERT_TRUE(ring.try_front(record));
+        EXPECT_EQ(std::string(record.data(), record.size()), second);
+        ring.pop();
+    }
+    EXPECT_TRUE(ring.empty());
+    EXPECT_TRUE(ring.try_push(""sv));
+    ASSERT_TRUE(ring.try_front(record));
+    EXPECT_TRUE(record.empty());
+}
+
+TEST(ring_buffer_test, byte_ring_two_threads)
+{
+    constexpr int count = 100000;
+    cppbp::spsc_byte_ring ring{1024};
+
+    std::thread producer([&]() {
+        std::string record;
+        for(int i = 0; i < count; ++i) {
+            record = std::to_string(i);
+            ring.push(cppbp::string_view{record.data(), record.size()});
+        }
+    });
+
+    bool in_order = true;
+    for(int i = 0; i < count; ++i) {
+        cppbp::string_view record;
+        ring.front(record);
+        in_order = in_order && std::string(record.data(), record.size()) == std::to_string(i);
+        ring.pop();
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+}
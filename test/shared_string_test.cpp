@@ -0,0 +1,113 @@
+#include <cppbp/shared_string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(shared_string_test, construction)
+{
+    cppbp::shared_string empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.use_count(), 0u);
+    EXPECT_STREQ(empty.c_str(), "");
+    EXPECT_TRUE(cppbp::shared_string{""sv}.empty());
+
+    std::string source = "payload";
+    cppbp::shared_string str{cppbp::string_view{source.data(), source.size()}};
+    source[0] = 'X';
+    EXPECT_EQ(str, "payload"sv);
+    EXPECT_EQ(str.size(), 7u);
+    EXPECT_EQ(str[3], 'l');
+    EXPECT_STREQ(str.c_str(), "payload");
+    EXPECT_EQ(str.use_count(), 1u);
+    EXPECT_FALSE(str.is_local());
+}
+
+TEST(shared_string_test, copies_share_the_allocation)
+{
+    cppbp::shared_string a{"shared bytes"sv};
+    cppbp::shared_string b = a;
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_EQ(a.use_count(), 2u);
+
+    cppbp::shared_string c = std::move(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(c.data(), a.data());
+    EXPECT_EQ(a.use_count(), 2u);
+
+    c.clear();
+    EXPECT_EQ(a.use_count(), 1u);
+
+    cppbp::shared_string d{"other"sv};
+    d = a;
+    EXPECT_EQ(d, a);
+    EXPECT_EQ(a.use_count(), 2u);
+    d = d;
+    EXPECT_EQ(a.use_count(), 2u);
+}
+
+TEST(shared_string_test, converts_to_string_view)
+{
+    const cppbp::shared_string str{"view me"sv};
+    const cppbp::string_view view = str;
+    EXPECT_EQ(view.data(), str.data());
+    EXPECT_EQ(view.size(), str.size());
+    EXPECT_EQ(str.compare("view"sv), 1);
+}
+
+TEST(shared_string_test, cached_hash)
+{
+    const cppbp::shared_string str{"hash me once"sv};
+    EXPECT_EQ(str.hash(), cppbp::detail::hash_key("hash me once"sv));
+    EXPECT_EQ(cppbp::hash<cppbp::shared_string>{}(str), cppbp::hash<cppbp::string_view>{}("hash me once"sv));
+    EXPECT_EQ(cppbp::shared_string{}.hash(), cppbp::detail::hash_key(cppbp::string_view{}));
+}
+
+TEST(shared_string_test, comparison)
+{
+    const cppbp::shared_string a{"apple"sv};
+    const cppbp::shared_string b{"apple"sv};
+    const cppbp::shared_string c{"banana"sv};
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    EXPECT_TRUE(a < c);
+    EXPECT_FALSE(c < a);
+    EXPECT_TRUE(a != "apples"sv);
+}
+
+TEST(shared_string_test, local_mode)
+{
+    cppbp::shared_string a{"local"sv, cppbp::shared_string::refcount::local};
+    EXPECT_TRUE(a.is_local());
+    {
+        std::vector<cppbp::shared_string> copies(10, a);
+        EXPECT_EQ(a.use_count(), 11u);
+    }
+    EXPECT_EQ(a.use_count(), 1u);
+    EXPECT_EQ(a, "local"sv);
+}
+
+TEST(shared_string_test, handoff_between_threads)
+{
+    const cppbp::shared_string original{"payload passed to workers"sv};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([original] {
+            for(int i = 0; i < 10000; ++i) {
+                cppbp::shared_string copy = original;
+                EXPECT_EQ(copy.size(), 25u);
+            }
+        });
+    }
+    for(auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(original.use_count(), 1u);
+}
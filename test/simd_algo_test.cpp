@@ -0,0 +1,127 @@
+#include <cppbp/simd_algo.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Values from a small range so that searches hit and extremes repeat, plus the type's limits.
+template<typename T>
+std::vector<T> random_values(std::size_t size, std::mt19937_64 &random)
+{
+    std::vector<T> values(size);
+    for(auto &v : values) {
+        switch(random() % 8) {
+        case 0:  v = std::numeric_limits<T>::min(); break;
+        case 1:  v = std::numeric_limits<T>::max(); break;
+        default: v = static_cast<T>(static_cast<int>(random() % 16) - 8); break;
+        }
+    }
+    return values;
+}
+
+template<typename T>
+void expect_like_std()
+{
+    std::mt19937_64 random{sizeof(T) * 2 + std::numeric_limits<T>::is_signed};
+    for(std::size_t size = 0; size < 150; ++size) {
+        const std::vector<T> values = random_values<T>(size, random);
+        const T *first = values.data();
+        const T *last = values.data() + values.size();
+        for(const int value : {-8, -1, 0, 7, 100}) {
+            const T needle = static_cast<T>(value);
+            ASSERT_EQ(cppbp::simd_algo::find(first, last, needle), std::find(first, last, needle)) << size;
+            ASSERT_EQ(cppbp::simd_algo::count(first, last, needle), std::count(first, last, needle)) << size;
+        }
+        ASSERT_EQ(cppbp::simd_algo::min_element(first, last), std::min_element(first, last)) << size;
+        ASSERT_EQ(cppbp::simd_algo::max_element(first, last), std::max_element(first, last)) << size;
+        ASSERT_EQ(cppbp::simd_algo::minmax_element(first, last), std::minmax_element(first, last)) << size;
+
+        std::vector<T> other = values;
+        ASSERT_TRUE(cppbp::simd_algo::equal(first, last, other.cbegin(), other.cend()));
+        ASSERT_FALSE(cppbp::simd_algo::lexicographical_compare(first, last, other.cbegin(), other.cend()));
+        if(size > 0) {
+            const std::size_t k = random() % size;
+            other[k] = static_cast<T>(~other[k]);
+            ASSERT_EQ(cppbp::simd_algo::mismatch(first, last, other.data()).first - first, static_cast<std::ptrdiff_t>(k));
+            ASSERT_FALSE(cppbp::simd_algo::equal(first, last, other.data()));
+            ASSERT_EQ(cppbp::simd_algo::lexicographical_compare(first, last, other.data(), other.data() + size),
+                      std::lexicographical_compare(first, last, other.data(), other.data() + size)) << size;
+            ASSERT_EQ(cppbp::simd_algo::lexicographical_compare(other.data(), other.data() + size, first, last),
+                      std::lexicographical_compare(other.data(), other.data() + size, first, last)) << size;
+            other.pop_back();
+            ASSERT_EQ(cppbp::simd_algo::lexicographical_compare(first, last, other.cbegin(), other.cend()),
+                      std::lexicographical_compare(first, last, other.cbegin(), other.cend())) << size;
+            ASSERT_FALSE(cppbp::simd_algo::equal(first, last, other.cbegin(), other.cend()));
+        }
+    }
+}
+
+} // namespace
+
+TEST(simd_algo_test, integer_types)
+{
+    expect_like_std<std::int8_t>();
+    expect_like_std<std::uint8_t>();
+    expect_like_std<std::int16_t>();
+    expect_like_std<std::uint16_t>();
+    expect_like_std<std::int32_t>();
+    expect_like_std<std::uint32_t>();
+    expect_like_std<std::int64_t>();
+    expect_like_std<std::uint64_t>();
+    expect_like_std<char>();
+}
+
+TEST(simd_algo_test, values_of_other_types)
+{
+    const std::vector<std::uint8_t> bytes{1, 255, 44, 3};
+    EXPECT_EQ(cppbp::simd_algo::find(bytes.begin(), bytes.end(), 300), bytes.end());
+    EXPECT_EQ(cppbp::simd_algo::find(bytes.begin(), bytes.end(), -1), bytes.end());
+    EXPECT_EQ(cppbp::simd_algo::find(bytes.begin(), bytes.end(), 255u), bytes.begin() + 1);
+    EXPECT_EQ(cppbp::simd_algo::count(bytes.begin(), bytes.end(), 44LL), 1);
+
+    const std::vector<std::uint32_t> words{0xffffffffu, 1};
+    EXPECT_EQ(cppbp::simd_algo::find(words.begin(), words.end(), -1), std::find(words.begin(), words.end(), -1));
+    const std::vector<std::int32_t> ints{-1, 1};
+    EXPECT_EQ(cppbp::simd_algo::count(ints.begin(), ints.end(), std::uint64_t{0xffffffffu}),
+              std::count(ints.begin(), ints.end(), std::uint64_t{0xffffffffu}));
+}
+
+TEST(simd_algo_test, fallback_to_std)
+{
+    const std::list<int> list{3, 1, 4, 1, 5};
+    EXPECT_EQ(*cppbp::simd_algo::find(list.begin(), list.end(), 4), 4);
+    EXPECT_EQ(cppbp::simd_algo::count(list.begin(), list.end(), 1), 2);
+    EXPECT_EQ(*cppbp::simd_algo::max_element(list.begin(), list.end()), 5);
+
+    const std::vector<double> doubles{0.5, -0.0, 2.0};
+    EXPECT_EQ(cppbp::simd_algo::find(doubles.begin(), doubles.end(), 0.0), doubles.begin() + 1);
+    EXPECT_EQ(cppbp::simd_algo::min_element(doubles.begin(), doubles.end()), doubles.begin() + 1);
+    EXPECT_FALSE(cppbp::simd_algo::equal(doubles.begin(), doubles.end(), list.begin(), list.end()));
+}
+
+TEST(simd_algo_test, spans)
+{
+    std::vector<std::int16_t> values{5, -3, 9, -3, 9};
+    const cppbp::span<const std::int16_t> view{values};
+    EXPECT_EQ(cppbp::simd_algo::find(view, 9), view.begin() + 2);
+    EXPECT_EQ(cppbp::simd_algo::count(view, -3), 2u);
+    EXPECT_EQ(cppbp::simd_algo::min_element(view), view.begin() + 1);
+    EXPECT_EQ(cppbp::simd_algo::max_element(view), view.begin() + 2);
+    EXPECT_EQ(cppbp::simd_algo::minmax_element(view).second, view.begin() + 4);
+
+    const std::vector<std::int16_t> prefix{5, -3, 9};
+    const cppbp::span<const std::int16_t> other{prefix};
+    EXPECT_FALSE(cppbp::simd_algo::equal(view, other));
+    EXPECT_TRUE(cppbp::simd_algo::equal(view.first(3), other));
+    EXPECT_EQ(cppbp::simd_algo::mismatch(view, other).first, view.begin() + 3);
+    EXPECT_TRUE(cppbp::simd_algo::lexicographical_compare(other, view));
+    EXPECT_FALSE(cppbp::simd_algo::lexicographical_compare(view, other));
+}
@@ -0,0 +1,97 @@
+#include <cppbp/span.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST(span_test, construction)
+{
+    cppbp::span<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.data(), nullptr);
+
+    int arr[] = {1, 2, 3, 4};
+    cppbp::span<int> from_array{arr};
+    EXPECT_EQ(from_array.size(), 4u);
+    EXPECT_EQ(from_array.size_bytes(), 4 * sizeof(int));
+
+    cppbp::span<int, 4> fixed{arr};
+    EXPECT_EQ(fixed.extent, 4u);
+    cppbp::span<const int> from_fixed{fixed};
+    EXPECT_EQ(from_fixed.data(), arr);
+
+    std::vector<int> vec = {5, 6, 7};
+    cppbp::span<int> from_vector{vec};
+    from_vector[1] = 60;
+    EXPECT_EQ(vec[1], 60);
+
+    const std::vector<int> &cvec = vec;
+    cppbp::span<const int> from_const_vector{cvec};
+    EXPECT_EQ(from_const_vector.back(), 7);
+
+    std::array<int, 2> std_arr = {{8, 9}};
+    cppbp::span<const int, 2> from_std_array{std_arr};
+    EXPECT_EQ(from_std_array.front(), 8);
+
+    const std::string str = "abc";
+    cppbp::span<const char> from_string{str};
+    EXPECT_EQ(from_string.size(), 3u);
+
+    cppbp::span<int> from_range{arr + 1, arr + 3};
+    EXPECT_EQ(from_range.size(), 2u);
+    cppbp::span<int> from_count{arr, 0};
+    EXPECT_TRUE(from_count.empty());
+
+    // Static extents from a run time size must be spelled out.
+    cppbp::span<int, 2> fixed_count{arr, 2};
+    cppbp::span<int, 4> fixed_from_dynamic{from_array};
+    EXPECT_EQ(fixed_count.data(), fixed_from_dynamic.data());
+    static_assert(!std::is_convertible<cppbp::span<int>, cppbp::span<int, 4>>::value, "dynamic to static is explicit");
+    static_assert(std::is_convertible<cppbp::span<int, 4>, cppbp::span<int>>::value, "static to dynamic is implicit");
+    static_assert(std::is_convertible<cppbp::span<int, 4>, cppbp::span<const int, 4>>::value, "same extent is implicit");
+    static_assert(!std::is_convertible<std::vector<int>&, cppbp::span<int, 3>>::value, "containers to static are explicit");
+    static_assert(std::is_constructible<cppbp::span<int, 3>, std::vector<int>&>::value, "containers to static are explicit");
+}
+
+TEST(span_test, subviews)
+{
+    int arr[] = {0, 1, 2, 3, 4, 5};
+    cppbp::span<int> s{arr};
+
+    EXPECT_EQ(s.first(2).size(), 2u);
+    EXPECT_EQ(s.last(2).front(), 4);
+    EXPECT_EQ(s.subspan(1, 3).back(), 3);
+    EXPECT_EQ(s.subspan(4).size(), 2u);
+
+    auto first = s.first<3>();
+    EXPECT_EQ(first.extent, 3u);
+    EXPECT_EQ(first.back(), 2);
+    auto sub = cppbp::span<int, 6>{arr}.subspan<2>();
+    EXPECT_EQ(sub.extent, 4u);
+    EXPECT_EQ(sub.front(), 2);
+
+    int sum = 0;
+    for(auto value : s) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 15);
+    EXPECT_EQ(*s.rbegin(), 5);
+}
+
+TEST(span_test, as_bytes)
+{
+    std::uint32_t values[] = {0x01020304u, 0x05060708u};
+    auto bytes = cppbp::as_bytes(cppbp::span<std::uint32_t>{values});
+    EXPECT_EQ(bytes.size(), 8u);
+
+    auto writable = cppbp::as_writable_bytes(cppbp::span<std::uint32_t, 2>{values});
+    EXPECT_EQ(writable.extent, 8u);
+    writable[0] = 0;
+    writable[1] = 0;
+    writable[2] = 0;
+    writable[3] = 0;
+    EXPECT_EQ(values[0], 0u);
+}
@@ -0,0 +1,115 @@
+#include <cppbp/stream_searcher.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+// Random split points of text into chunks of 0 to max_chunk bytes.
+std::vector<cppbp::string_view> split(const std::string &text, std::size_t max_chunk, std::mt19937 &random)
+{
+    std::vector<cppbp::string_view> chunks;
+    std::size_t pos = 0;
+    while(pos < text.size()) {
+        const std::size_t n = std::min<std::size_t>(random() % (max_chunk + 1), text.size() - pos);
+        chunks.emplace_back(text.data() + pos, n);
+        pos += n;
+    }
+    return chunks;
+}
+
+std::vector<std::size_t> expected_positions(const std::string &text, cppbp::string_view needle, cppbp::search_mode mode)
+{
+    std::vector<std::size_t> result;
+    for(const std::size_t pos : cppbp::find_all(cppbp::string_view{text.data(), text.size()}, needle, mode)) {
+        result.push_back(pos);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(stream_searcher_test, match_straddling_chunks)
+{
+    cppbp::stream_searcher searcher{"needle"sv};
+    std::vector<std::size_t> found;
+    const auto collect = [&](std::size_t pos) { found.push_back(pos); };
+    searcher.feed("hay ne"sv, collect);
+    searcher.feed("e"sv, collect);
+    searcher.feed(""sv, collect);
+    searcher.feed("dle hay needle"sv, collect);
+    EXPECT_EQ(found, (std::vector<std::size_t>{4, 15}));
+    EXPECT_EQ(searcher.consumed(), 21u);
+    EXPECT_EQ(searcher.needle(), "needle"sv);
+
+    searcher.reset();
+    found.clear();
+    searcher.feed("needle"sv, collect);
+    EXPECT_EQ(found, std::vector<std::size_t>{0});
+}
+
+TEST(stream_searcher_test, matches_whole_text_search)
+{
+    std::mt19937 random{12};
+    std::string text(5000, 'a');
+    for(auto &c : text) {
+        c = static_cast<char>('a' + random() % 2);
+    }
+    for(const cppbp::string_view needle : {"a"sv, "ab"sv, "aba"sv, "abbab"sv, "aaaaaaaa"sv}) {
+        for(const auto mode : {cppbp::search_mode::overlapping, cppbp::search_mode::non_overlapping}) {
+            for(const std::size_t max_chunk : {1u, 3u, 10u, 700u}) {
+                cppbp::stream_searcher searcher{needle, mode};
+                std::vector<std::size_t> found;
+                for(const auto chunk : split(text, max_chunk, random)) {
+                    searcher.feed(chunk, [&](std::size_t pos) { found.push_back(pos); });
+                }
+                EXPECT_EQ(found, expected_positions(text, needle, mode)) << needle << " " << max_chunk;
+            }
+        }
+    }
+}
+
+TEST(stream_searcher_test, copy_and_swap)
+{
+    cppbp::stream_searcher a{"abc"sv};
+    std::vector<std::size_t> found;
+    a.feed("xxab"sv, [](std::size_t) {});
+    cppbp::stream_searcher b = a;
+    b.feed("c"sv, [&](std::size_t pos) { found.push_back(pos); });
+    EXPECT_EQ(found, std::vector<std::size_t>{2});
+
+    cppbp::stream_searcher c{"zz"sv};
+    c.swap(a);
+    c.feed("c"sv, [&](std::size_t pos) { found.push_back(pos); });
+    a.feed("z"sv, [&](std::size_t pos) { found.push_back(pos); });
+    EXPECT_EQ(found, (std::vector<std::size_t>{2, 2}));
+    EXPECT_THROW(cppbp::stream_searcher{""sv}, std::invalid_argument);
+}
+
+TEST(stream_searcher_test, multi_pattern)
+{
+    std::mt19937 random{13};
+    std::string text(5000, 'a');
+    for(auto &c : text) {
+        c = static_cast<char>('a' + random() % 3);
+    }
+    const cppbp::multi_searcher patterns{{"abc"sv, "cab"sv, "b"sv, "cccc"sv, "abcabc"sv}};
+    const auto expected = patterns.find_all(cppbp::string_view{text.data(), text.size()});
+    for(const std::size_t max_chunk : {1u, 4u, 1000u}) {
+        cppbp::multi_stream_searcher searcher{patterns};
+        std::vector<cppbp::multi_searcher::match> found;
+        for(const auto chunk : split(text, max_chunk, random)) {
+            searcher.feed(chunk, [&](const cppbp::multi_searcher::match &m) { found.push_back(m); });
+        }
+        EXPECT_EQ(searcher.consumed(), text.size());
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected) << max_chunk;
+    }
+}
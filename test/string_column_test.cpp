@@ -0,0 +1,118 @@
+#include <cppbp/string_column.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+using rows = std::vector<std::size_t>;
+
+template<typename Column>
+rows selected(const Column &, const std::vector<std::uint64_t> &mask)
+{
+    return cppbp::mask_to_selection(cppbp::span<const std::uint64_t>{mask.data(), mask.size()});
+}
+
+} // namespace
+
+TEST(string_column_test, push_back_and_access)
+{
+    cppbp::string_column column;
+    EXPECT_TRUE(column.empty());
+    column.push_back("apple"sv);
+    column.push_back(""sv);
+    column.push_back("banana"sv);
+    EXPECT_EQ(column.size(), 3u);
+    EXPECT_EQ(column.data_size(), 11u);
+    EXPECT_TRUE(column[0] == "apple"sv);
+    EXPECT_TRUE(column[1].empty());
+    EXPECT_TRUE(column.at(2) == "banana"sv);
+    EXPECT_THROW(column.at(3), std::out_of_range);
+    EXPECT_EQ(column.offsets().size(), 4u);
+    EXPECT_EQ(column.offsets()[3], 11);
+}
+
+TEST(string_column_test, arrow_buffers)
+{
+    // A sliced Arrow array: offsets need not start at zero and data may continue past the end.
+    const std::string data = "xxhelloworldyy";
+    const cppbp::large_string_column column{std::vector<std::int64_t>{2, 7, 12}, std::vector<char>(data.begin(), data.end())};
+    EXPECT_EQ(column.size(), 2u);
+    EXPECT_TRUE(column[1] == "world"sv);
+    EXPECT_EQ(selected(column, column.contains("ow"sv)), rows{});
+    EXPECT_EQ(selected(column, column.contains("or"sv)), rows{1});
+    EXPECT_EQ(selected(column, column.contains("xx"sv)), rows{});
+
+    EXPECT_THROW(cppbp::string_column(std::vector<std::int32_t>{}, std::vector<char>{}), std::invalid_argument);
+    EXPECT_THROW(cppbp::string_column(std::vector<std::int32_t>{0, 3, 2}, std::vector<char>(3)), std::invalid_argument);
+    EXPECT_THROW(cppbp::string_column(std::vector<std::int32_t>{0, 4}, std::vector<char>(3)), std::invalid_argument);
+    EXPECT_THROW(cppbp::string_column(std::vector<std::int32_t>{-1, 2}, std::vector<char>(3)), std::invalid_argument);
+}
+
+TEST(string_column_test, kernels)
+{
+    cppbp::string_column column;
+    for(const auto s : {"cat"sv, "category"sv, ""sv, "dog"sv, "concatenate"sv, "ca"sv, "cat"sv}) {
+        column.push_back(s);
+    }
+    EXPECT_EQ(selected(column, column.equals("cat"sv)), (rows{0, 6}));
+    EXPECT_EQ(selected(column, column.equals(""sv)), (rows{2}));
+    EXPECT_EQ(selected(column, column.equals("concatenate"sv)), (rows{4}));
+    EXPECT_EQ(selected(column, column.starts_with("cat"sv)), (rows{0, 1, 6}));
+    EXPECT_EQ(selected(column, column.starts_with(""sv)).size(), 7u);
+    EXPECT_EQ(selected(column, column.starts_with("concatenat"sv)), (rows{4}));
+    EXPECT_EQ(selected(column, column.contains("cat"sv)), (rows{0, 1, 4, 6}));
+    // "ca" + "cat" would match across the row boundary.
+    EXPECT_EQ(selected(column, column.contains("acat"sv)), rows{});
+    EXPECT_EQ(selected(column, column.contains(""sv)).size(), 7u);
+
+    const std::vector<std::uint64_t> hashes = column.hash_all(7);
+    for(std::size_t i = 0; i < column.size(); ++i) {
+        EXPECT_EQ(hashes[i], cppbp::detail::hash_key(column[i], 7));
+    }
+}
+
+TEST(string_column_test, random_kernels_match_scalar)
+{
+    std::mt19937_64 random{4};
+    cppbp::string_column column;
+    std::vector<std::string> values;
+    for(int i = 0; i < 1000; ++i) {
+        std::string s(random() % 12, '\0');
+        for(auto &c : s) {
+            c = static_cast<char>('a' + random() % 3);
+        }
+        column.push_back(cppbp::string_view{s.data(), s.size()});
+        values.push_back(s);
+    }
+    const cppbp::large_string_column large{std::vector<std::int64_t>(column.offsets().begin(), column.offsets().end()),
+                                           std::vector<char>(column.data().begin(), column.data().end())};
+    for(const std::string probe : {"a", "ab", "abc", "abca", "aaaaaaaa", "abcabcabc"}) {
+        rows equal, prefix, contained;
+        for(std::size_t i = 0; i < values.size(); ++i) {
+            if(values[i] == probe) {
+                equal.push_back(i);
+            }
+            if(values[i].compare(0, probe.size(), probe) == 0) {
+                prefix.push_back(i);
+            }
+            if(values[i].find(probe) != std::string::npos) {
+                contained.push_back(i);
+            }
+        }
+        const cppbp::string_view p{probe.data(), probe.size()};
+        EXPECT_EQ(selected(column, column.equals(p)), equal) << probe;
+        EXPECT_EQ(selected(column, column.starts_with(p)), prefix) << probe;
+        EXPECT_EQ(selected(column, column.contains(p)), contained) << probe;
+        EXPECT_EQ(selected(large, large.equals(p)), equal) << probe;
+        EXPECT_EQ(selected(large, large.starts_with(p)), prefix) << probe;
+        EXPECT_EQ(selected(large, large.contains(p)), contained) << probe;
+    }
+}
@@ -0,0 +1,107 @@
+#include <cppbp/string_dictionary.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+struct posting
+{
+    std::uint32_t   document;
+    std::uint32_t   frequency;
+};
+
+} // namespace
+
+TEST(string_dictionary_test, build_and_lookup)
+{
+    cppbp::string_dictionary_builder builder{sizeof(posting)};
+    builder.add("apple"sv, posting{1, 10});
+    builder.add("banana"sv, posting{2, 20});
+    builder.add(""sv, posting{3, 30});
+    EXPECT_THROW(builder.add("cherry"sv, std::uint16_t{1}), std::invalid_argument);
+    EXPECT_EQ(builder.size(), 3u);
+
+    const std::vector<unsigned char> bytes = builder.build();
+    const cppbp::string_dictionary dict{cppbp::span<const unsigned char>{bytes.data(), bytes.size()}};
+    EXPECT_EQ(dict.size(), 3u);
+    EXPECT_EQ(dict.value_size(), sizeof(posting));
+
+    EXPECT_EQ(dict.find("banana"sv), 1u);
+    EXPECT_EQ(dict.find(""sv), 2u);
+    EXPECT_FALSE(dict.contains("cherry"sv));
+    EXPECT_TRUE(dict.key(0) == "apple"sv);
+    EXPECT_EQ(dict.value_as<posting>(1).frequency, 20u);
+    EXPECT_EQ(dict.value(2).size(), sizeof(posting));
+    EXPECT_THROW(dict.key(3), std::out_of_range);
+    EXPECT_THROW(dict.value_as<std::uint16_t>(0), std::invalid_argument);
+
+    posting p{};
+    EXPECT_TRUE(dict.get("apple"sv, p));
+    EXPECT_EQ(p.document, 1u);
+    EXPECT_FALSE(dict.get("kiwi"sv, p));
+}
+
+TEST(string_dictionary_test, rejects_bad_input)
+{
+    cppbp::string_dictionary_builder duplicates{0};
+    duplicates.add("x"sv, static_cast<const void*>(nullptr));
+    duplicates.add("x"sv, static_cast<const void*>(nullptr));
+    EXPECT_THROW(duplicates.build(), std::invalid_argument);
+
+    cppbp::string_dictionary_builder builder{4};
+    builder.add("key"sv, std::uint32_t{7});
+    std::vector<unsigned char> bytes = builder.build();
+    EXPECT_THROW(cppbp::string_dictionary(cppbp::span<const unsigned char>{bytes.data(), bytes.size() - 1}),
+                 std::invalid_argument);
+
+    // 2^61 slots of 8 bytes wrap around to 0 bytes.
+    std::vector<unsigned char> huge_index = bytes;
+    const std::uint64_t slots = std::uint64_t{1} << 61;
+    std::memcpy(huge_index.data() + 72, &slots, sizeof(slots));
+    EXPECT_THROW(cppbp::string_dictionary(cppbp::span<const unsigned char>{huge_index.data(), huge_index.size()}),
+                 std::invalid_argument);
+
+    bytes[1] = 'X';
+    EXPECT_THROW(cppbp::string_dictionary(cppbp::span<const unsigned char>{bytes.data(), bytes.size()}),
+                 std::invalid_argument);
+
+    const std::vector<unsigned char> empty = cppbp::string_dictionary_builder{8}.build();
+    const cppbp::string_dictionary dict{cppbp::span<const unsigned char>{empty.data(), empty.size()}};
+    EXPECT_TRUE(dict.empty());
+    EXPECT_FALSE(dict.contains("key"sv));
+}
+
+TEST(string_dictionary_test, mapped_file)
+{
+    const std::string path = ::testing::TempDir() + "cppbp_string_dictionary_test.dict";
+    {
+        cppbp::string_dictionary_builder builder{sizeof(std::uint64_t)};
+        for(std::uint64_t i = 0; i < 50000; ++i) {
+            const std::string key = "term/" + std::to_string(i);
+            builder.add(cppbp::string_view{key.data(), key.size()}, i * 3);
+        }
+        builder.write(path);
+    }
+
+    const auto dict = cppbp::string_dictionary::open(path);
+    EXPECT_EQ(dict.size(), 50000u);
+    for(std::uint64_t i = 0; i < 50000; i += 997) {
+        const std::string key = "term/" + std::to_string(i);
+        std::uint64_t value = 0;
+        ASSERT_TRUE(dict.get(cppbp::string_view{key.data(), key.size()}, value));
+        EXPECT_EQ(value, i * 3);
+        EXPECT_EQ(dict.find(cppbp::string_view{key.data(), key.size()}), static_cast<std::size_t>(i));
+    }
+    EXPECT_FALSE(dict.contains("term/50000"sv));
+    std::remove(path.c_str());
+
+    EXPECT_THROW(cppbp::string_dictionary::open(path), std::system_error);
+}
@@ -0,0 +1,68 @@
+#include <cppbp/string_search.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+TEST(string_search_test, count_char)
+{
+    EXPECT_EQ(cppbp::count(cppbp::string_view{}, 'a'), 0u);
+    EXPECT_EQ(cppbp::count("banana"sv, 'a'), 3u);
+    EXPECT_EQ(cppbp::count("banana"sv, 'x'), 0u);
+
+    std::string text;
+    for(int i = 0; i < 1000; ++i) {
+        text += "line\n";
+    }
+    EXPECT_EQ(cppbp::count(cppbp::string_view{text.data(), text.size()}, '\n'), 1000u);
+    EXPECT_EQ(cppbp::count(cppbp::string_view{text.data() + 3, text.size() - 7}, '\n'), 999u);
+
+    EXPECT_EQ(cppbp::count(U"aéaé"sv, U'é'), 2u);
+}
+
+TEST(string_search_test, count_substring)
+{
+    EXPECT_EQ(cppbp::count("aaaa"sv, "aa"), 2u);
+    EXPECT_EQ(cppbp::count("aaaa"sv, "aa", cppbp::search_mode::overlapping), 3u);
+    EXPECT_EQ(cppbp::count("abcabcab"sv, "abc"), 2u);
+    EXPECT_EQ(cppbp::count("abc"sv, "abcd"), 0u);
+    EXPECT_EQ(cppbp::count("abc"sv, ""), 4u);
+    EXPECT_EQ(cppbp::count(u"xyxyx"sv, u"xyx", cppbp::search_mode::overlapping), 2u);
+}
+
+TEST(string_search_test, searcher_matches_find)
+{
+    const std::string text = "the quick brown fox jumps over the lazy dog; the end";
+    const cppbp::string_view view{text.data(), text.size()};
+    const cppbp::string_view needles[] = {"the", "e", "dog", "end", "fox jumps", "cat", "the end", ""};
+
+    for(const auto needle : needles) {
+        const cppbp::searcher searcher{needle};
+        for(std::size_t pos = 0; pos <= text.size() + 1; ++pos) {
+            const auto expected = text.find(std::string(needle.data(), needle.size()), pos);
+            const auto actual = searcher.search(view, pos);
+            EXPECT_EQ(actual, expected == std::string::npos ? cppbp::string_view::npos : expected);
+        }
+    }
+}
+
+TEST(string_search_test, find_all)
+{
+    std::vector<std::size_t> positions;
+    for(auto pos : cppbp::find_all("abababa"sv, "aba")) {
+        positions.push_back(pos);
+    }
+    EXPECT_EQ(positions, (std::vector<std::size_t>{0, 4}));
+
+    positions.clear();
+    for(auto pos : cppbp::find_all("abababa"sv, "aba", cppbp::search_mode::overlapping)) {
+        positions.push_back(pos);
+    }
+    EXPECT_EQ(positions, (std::vector<std::size_t>{0, 2, 4}));
+
+    const auto none = cppbp::find_all("abc"sv, "x");
+    EXPECT_TRUE(none.begin() == none.end());
+}
@@ -1,6 +1,87 @@
+#include <cppbp/string_view.hpp>
+
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <string>
+
+using namespace cppbp::literals;
+
 TEST(sample_test_case, sample_test)
 {
     EXPECT_EQ(1, 1);
-}
\ No newline at end of file
+}
+
+TEST(string_view_test, element_access)
+{
+    const cppbp::string_view view = "abc"sv;
+    EXPECT_EQ(view.front(), 'a');
+    EXPECT_EQ(view.back(), 'c');
+    EXPECT_EQ(view[1], 'b');
+    EXPECT_THROW(view.at(3), std::out_of_range);
+
+    cppbp::string_view other;
+    other = view;
+    EXPECT_EQ(other.data(), view.data());
+    EXPECT_EQ(other.size(), 3u);
+}
+
+TEST(string_view_test, substr)
+{
+    const cppbp::string_view view = "abcdef"sv;
+    EXPECT_TRUE(view.substr(2, 3) == "cde"sv);
+    EXPECT_TRUE(view.substr(4) == "ef"sv);
+    EXPECT_TRUE(view.substr(6).empty());
+    try {
+        view.substr(7);
+        FAIL() << "substr past the end must throw";
+    } catch(const std::out_of_range &e) {
+        EXPECT_NE(std::string(e.what()).find("substr"), std::string::npos);
+    }
+}
+
+TEST(string_view_test, find_and_rfind)
+{
+    const cppbp::string_view view = "hello world, hello"sv;
+    EXPECT_EQ(view.find("world"sv), 6u);
+    EXPECT_EQ(view.find("hello"sv, 1), 13u);
+    EXPECT_EQ(view.find("xyz"sv), cppbp::string_view::npos);
+    EXPECT_EQ(view.find(""sv, 3), 3u);
+
+    EXPECT_EQ(view.rfind("hello"sv), 13u);
+    EXPECT_EQ(view.rfind("hello"sv, 12), 0u);
+    EXPECT_EQ(view.rfind("lo"sv, 4), 3u);
+    EXPECT_EQ("ab"sv.rfind("abc"sv), cppbp::string_view::npos);
+    EXPECT_EQ(view.rfind("xyz"sv), cppbp::string_view::npos);
+}
+
+TEST(string_view_test, find_last_of)
+{
+    const cppbp::string_view view = "a,b;c"sv;
+    EXPECT_EQ(view.find_last_of(",;"sv), 3u);
+    EXPECT_EQ(view.find_last_of(",;"sv, 2), 1u);
+    EXPECT_EQ(view.find_last_of("a"sv), 0u);
+    EXPECT_EQ(view.find_last_of("xyz"sv), cppbp::string_view::npos);
+    EXPECT_EQ(""sv.find_last_of("a"sv), cppbp::string_view::npos);
+
+    const cppbp::string_view padded = "value   "sv;
+    EXPECT_EQ(padded.find_last_not_of(" "sv), 4u);
+    EXPECT_EQ(padded.find_last_not_of("eu "sv), 2u);
+    EXPECT_EQ("   "sv.find_last_not_of(" "sv), cppbp::string_view::npos);
+}
+
+TEST(string_view_test, relational_operators)
+{
+    const cppbp::string_view abc = "abc"sv;
+    const cppbp::string_view abd = "abd"sv;
+    EXPECT_TRUE(abc < abd);
+    EXPECT_TRUE(abd > abc);
+    EXPECT_TRUE(abc <= abc);
+    EXPECT_TRUE(abd >= abc);
+    EXPECT_FALSE(abd < abc);
+    EXPECT_TRUE(abc < "abca");
+    EXPECT_TRUE("ab" < abc);
+    EXPECT_TRUE(abc >= "abc");
+    EXPECT_TRUE("abd" > abc);
+    EXPECT_TRUE(abc <= "b");
+}
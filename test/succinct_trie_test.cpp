@@ -0,0 +1,135 @@
+#include <cppbp/succinct_trie.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+cppbp::succinct_trie make_trie(const std::vector<std::string> &keys)
+{
+    std::vector<cppbp::string_view> views;
+    for(const auto &key : keys) {
+        views.emplace_back(key.data(), key.size());
+    }
+    return cppbp::succinct_trie{cppbp::span<const cppbp::string_view>{views.data(), views.size()}};
+}
+
+} // namespace
+
+TEST(succinct_trie_test, empty)
+{
+    const cppbp::succinct_trie trie;
+    const std::size_t npos = cppbp::succinct_trie::npos;
+    EXPECT_TRUE(trie.empty());
+    EXPECT_FALSE(trie.contains(""sv));
+    EXPECT_FALSE(trie.contains("a"sv));
+    EXPECT_EQ(trie.longest_prefix("abc"sv), npos);
+    EXPECT_TRUE(trie.keys_with_prefix(""sv).empty());
+}
+
+TEST(succinct_trie_test, contains)
+{
+    const std::vector<std::string> keys = {"", "a", "ab", "abc", "abd", "b", "bcd", "zz"};
+    const cppbp::succinct_trie trie = make_trie(keys);
+    EXPECT_EQ(trie.size(), keys.size());
+    for(const auto &key : keys) {
+        EXPECT_TRUE(trie.contains(cppbp::string_view{key.data(), key.size()})) << key;
+    }
+    for(const auto key : {"abcd"sv, "bc"sv, "c"sv, "z"sv, "zzz"sv, "ac"sv}) {
+        EXPECT_FALSE(trie.contains(key));
+    }
+}
+
+TEST(succinct_trie_test, rejects_unsorted_or_duplicate_keys)
+{
+    EXPECT_THROW(make_trie({"b", "a"}), std::invalid_argument);
+    EXPECT_THROW(make_trie({"a", "a"}), std::invalid_argument);
+}
+
+TEST(succinct_trie_test, prefix_enumeration)
+{
+    const cppbp::succinct_trie trie = make_trie({"car", "card", "care", "cat", "do", "dog"});
+    EXPECT_EQ(trie.keys_with_prefix("car"sv), (std::vector<std::string>{"car", "card", "care"}));
+    EXPECT_EQ(trie.keys_with_prefix("ca"sv, 2), (std::vector<std::string>{"car", "card"}));
+    EXPECT_EQ(trie.keys_with_prefix("d"sv), (std::vector<std::string>{"do", "dog"}));
+    EXPECT_EQ(trie.keys_with_prefix(""sv).size(), 6u);
+    EXPECT_TRUE(trie.keys_with_prefix("cab"sv).empty());
+    EXPECT_TRUE(trie.keys_with_prefix("cards"sv).empty());
+    EXPECT_TRUE(trie.keys_with_prefix("c"sv, 0).empty());
+    EXPECT_EQ(trie.keys_with_prefix(""sv, 1), (std::vector<std::string>{"car"}));
+
+    // A callback returning bool ends the walk; one returning nothing sees every key.
+    int visited = 0;
+    trie.for_each_with_prefix(""sv, [&](cppbp::string_view) { return ++visited < 3; });
+    EXPECT_EQ(visited, 3);
+    visited = 0;
+    trie.for_each_with_prefix("ca"sv, [&](cppbp::string_view) { ++visited; });
+    EXPECT_EQ(visited, 4);
+}
+
+TEST(succinct_trie_test, longest_prefix)
+{
+    const std::size_t npos = cppbp::succinct_trie::npos;
+    const cppbp::succinct_trie trie = make_trie({"/usr", "/usr/lib", "/usr/local", "/var"});
+    EXPECT_EQ(trie.longest_prefix("/usr/lib/x86_64"sv), 8u);
+    EXPECT_EQ(trie.longest_prefix("/usr/li"sv), 4u);
+    EXPECT_EQ(trie.longest_prefix("/usr"sv), 4u);
+    EXPECT_EQ(trie.longest_prefix("/us"sv), npos);
+    EXPECT_EQ(trie.longest_prefix("/home"sv), npos);
+}
+
+TEST(succinct_trie_test, random_keys_match_set)
+{
+    std::mt19937_64 random{3};
+    std::set<std::string> set;
+    while(set.size() < 3000) {
+        std::string key(random() % 12, '\0');
+        for(auto &c : key) {
+            c = static_cast<char>('a' + random() % 4);
+        }
+        set.insert(key);
+    }
+    const std::vector<std::string> keys(set.begin(), set.end());
+    const cppbp::succinct_trie trie = make_trie(keys);
+    EXPECT_EQ(trie.keys_with_prefix(""sv), keys);
+    for(int i = 0; i < 3000; ++i) {
+        std::string probe(random() % 12, '\0');
+        for(auto &c : probe) {
+            c = static_cast<char>('a' + random() % 4);
+        }
+        ASSERT_EQ(trie.contains(cppbp::string_view{probe.data(), probe.size()}), set.count(probe) == 1) << probe;
+    }
+}
+
+TEST(succinct_trie_test, serialize_and_borrow)
+{
+    const std::vector<std::string> keys = {"", "alpha", "alps", "beta", "\xff\x01"};
+    const cppbp::succinct_trie trie = make_trie(keys);
+    const std::vector<unsigned char> bytes = trie.serialize();
+    EXPECT_EQ(bytes.size(), trie.serialized_size());
+
+    const cppbp::succinct_trie borrowed = cppbp::succinct_trie::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    EXPECT_EQ(borrowed.size(), keys.size());
+    EXPECT_EQ(borrowed.keys_with_prefix(""sv), keys);
+    EXPECT_TRUE(borrowed.contains("alps"sv));
+    EXPECT_FALSE(borrowed.contains("alp"sv));
+
+    const cppbp::succinct_trie copy = borrowed;
+    EXPECT_EQ(copy.keys_with_prefix("al"sv), (std::vector<std::string>{"alpha", "alps"}));
+
+    std::vector<unsigned char> corrupt = bytes;
+    corrupt[0] = 'X';
+    EXPECT_THROW(cppbp::succinct_trie::borrow(cppbp::span<const unsigned char>{corrupt.data(), corrupt.size()}),
+                 std::invalid_argument);
+    EXPECT_THROW(cppbp::succinct_trie::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size() - 8}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+#include <cppbp/text_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppbp::literals;
+
+namespace {
+
+std::vector<std::size_t> naive_locate(const std::string &text, const std::string &pattern)
+{
+    std::vector<std::size_t> result;
+    for(std::size_t i = 0; i + pattern.size() <= text.size(); ++i) {
+        if(text.compare(i, pattern.size(), pattern) == 0) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+cppbp::string_view view(const std::string &s)
+{
+    return cppbp::string_view{s.data(), s.size()};
+}
+
+} // namespace
+
+TEST(text_index_test, suffix_array_matches_sort)
+{
+    std::mt19937_64 random{11};
+    for(int round = 0; round < 50; ++round) {
+        std::string text(random() % 300, '\0');
+        const unsigned alphabet = 1 + random() % 4;
+        for(auto &c : text) {
+            c = static_cast<char>('a' + random() % alphabet);
+        }
+        const auto *s = reinterpret_cast<const unsigned char*>(text.data());
+        std::vector<std::uint32_t> sa(text.size());
+        cppbp::detail::suffix_array<std::uint32_t, unsigned char>(s, static_cast<std::uint32_t>(text.size()), 255, sa.data());
+        for(std::size_t i = 1; i < sa.size(); ++i) {
+            ASSERT_LT(text.compare(sa[i - 1], std::string::npos, text, sa[i], std::string::npos), 0) << text;
+        }
+    }
+}
+
+TEST(text_index_test, count_and_locate)
+{
+    const std::string text = "abracadabra";
+    const std::size_t npos = cppbp::text_index::npos;
+    const cppbp::text_index index{view(text), 1};
+    EXPECT_EQ(index.size(), text.size());
+    EXPECT_EQ(index.count("abra"sv), 2u);
+    EXPECT_EQ(index.count("a"sv), 5u);
+    EXPECT_EQ(index.count("cad"sv), 1u);
+    EXPECT_EQ(index.count("abracadabrax"sv), 0u);
+    EXPECT_EQ(index.count(""sv), text.size() + 1);
+    EXPECT_TRUE(index.contains("dab"sv));
+    EXPECT_FALSE(index.contains("bad"sv));
+    EXPECT_EQ(index.locate("abra"sv), (std::vector<std::size_t>{0, 7}));
+    EXPECT_EQ(index.find("bra"sv), 1u);
+    EXPECT_EQ(index.find("z"sv), npos);
+}
+
+TEST(text_index_test, empty_text)
+{
+    const cppbp::text_index index{""sv};
+    EXPECT_EQ(index.count("a"sv), 0u);
+    EXPECT_EQ(index.count(""sv), 1u);
+    EXPECT_TRUE(index.locate("a"sv).empty());
+    EXPECT_THROW(cppbp::text_index(""sv, 0), std::invalid_argument);
+}
+
+TEST(text_index_test, random_text_matches_naive_search)
+{
+    std::mt19937_64 random{5};
+    std::string text(20000, '\0');
+    for(auto &c : text) {
+        // Includes zero bytes, which share their code with the sentinel.
+        c = static_cast<char>(random() % 3);
+    }
+    cppbp::thread_pool pool{2};
+    for(const std::size_t rate : {std::size_t{1}, std::size_t{7}, std::size_t{64}}) {
+        const cppbp::text_index index{view(text), rate, pool};
+        for(int i = 0; i < 40; ++i) {
+            const std::size_t start = random() % text.size();
+            const std::string pattern = text.substr(start, 1 + random() % 12);
+            const std::vector<std::size_t> expected = naive_locate(text, pattern);
+            ASSERT_EQ(index.count(view(pattern)), expected.size());
+            ASSERT_EQ(index.locate(view(pattern)), expected);
+            ASSERT_EQ(index.find(view(pattern)), expected.front());
+        }
+    }
+}
+
+TEST(text_index_test, serialize_and_borrow)
+{
+    const std::string text = "the quick brown fox jumps over the lazy dog; the end";
+    const cppbp::text_index index{view(text), 4};
+    const std::vector<unsigned char> bytes = index.serialize();
+    EXPECT_EQ(bytes.size(), index.serialized_size());
+
+    const cppbp::text_index borrowed = cppbp::text_index::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    const cppbp::text_index copy = cppbp::text_index::deserialize(cppbp::span<const unsigned char>{bytes.data(), bytes.size()});
+    for(const auto pattern : {"the"sv, "o"sv, "lazy dog"sv, "cat"sv}) {
+        const std::vector<std::size_t> expected = naive_locate(text, std::string(pattern.data(), pattern.size()));
+        EXPECT_EQ(borrowed.locate(pattern), expected);
+        EXPECT_EQ(copy.locate(pattern), expected);
+    }
+
+    EXPECT_THROW(cppbp::text_index::borrow(cppbp::span<const unsigned char>{bytes.data(), bytes.size() - 8}), std::invalid_argument);
+    std::vector<unsigned char> corrupt = bytes;
+    corrupt[2] = 'X';
+    EXPECT_THROW(cppbp::text_index::borrow(cppbp::span<const unsigned char>{corrupt.data(), corrupt.size()}), std::invalid_argument);
+}
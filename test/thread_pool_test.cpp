@@ -0,0 +1,68 @@
+#include <cppbp/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+TEST(thread_pool_test, submit_returns_results)
+{
+    cppbp::thread_pool pool{3};
+    EXPECT_EQ(pool.size(), 3u);
+    std::vector<std::future<int>> results;
+    for(int i = 0; i < 20; ++i) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    for(int i = 0; i < 20; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+    std::future<void> failing = pool.submit([] { throw std::runtime_error("task"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(thread_pool_test, parallel_for_covers_range_once)
+{
+    cppbp::thread_pool pool{4};
+    for(const std::size_t count : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{10000}}) {
+        std::vector<std::atomic<int>> hits(count);
+        for(auto &hit : hits) {
+            hit = 0;
+        }
+        pool.parallel_for(count, [&](std::size_t begin, std::size_t end) {
+            ASSERT_LT(begin, end);
+            for(std::size_t i = begin; i < end; ++i) {
+                ++hits[i];
+            }
+        });
+        for(const auto &hit : hits) {
+            ASSERT_EQ(hit.load(), 1);
+        }
+    }
+}
+
+TEST(thread_pool_test, parallel_for_rethrows)
+{
+    cppbp::thread_pool pool{2};
+    std::atomic<std::size_t> done{0};
+    EXPECT_THROW(pool.parallel_for(1000, [&](std::size_t begin, std::size_t end) {
+        if(begin <= 500 && 500 < end) {
+            throw std::logic_error("chunk");
+        }
+        done += end - begin;
+    }), std::logic_error);
+    EXPECT_LT(done.load(), 1000u);
+}
+
+TEST(thread_pool_test, destructor_finishes_queued_tasks)
+{
+    std::atomic<int> ran{0};
+    {
+        cppbp::thread_pool pool{1};
+        for(int i = 0; i < 100; ++i) {
+            pool.submit([&ran] { ++ran; });
+        }
+    }
+    EXPECT_EQ(ran.load(), 100);
+}